@@ -0,0 +1,271 @@
+# Pico-RTOS Linux Host Simulator Port
+# Builds the kernel as a normal Linux static library (pico_rtos_host) so that
+# the test and benchmark programs can run on a development machine or CI
+# runner without an RP2040. Tasks are ucontext coroutines on the main thread,
+# the system tick is a SIGALRM driven by a timer thread, and critical
+# sections mask that signal.
+
+set(PICO_RTOS_HOST_DIR ${CMAKE_CURRENT_SOURCE_DIR}/src/host)
+
+# RP2040-specific sources have no host equivalent
+set(PICO_RTOS_HOST_EXCLUDED_SOURCES
+    src/context_switch.c
+    src/context_switch.S
+    src/smp.c
+    src/ipc.c
+    src/mpu.c
+    src/watchdog.c
+    src/hires_timer.c
+)
+
+set(PICO_RTOS_HOST_SOURCES ${PICO_RTOS_SOURCES})
+list(REMOVE_ITEM PICO_RTOS_HOST_SOURCES ${PICO_RTOS_HOST_EXCLUDED_SOURCES})
+list(APPEND PICO_RTOS_HOST_SOURCES
+    src/host/host_port.c
+    src/host/host_context_switch.c
+)
+
+# libc calls that must not be preempted mid-way (see src/host/host_port.c)
+set(PICO_RTOS_HOST_WRAPPED_SYMBOLS
+    malloc calloc realloc free
+    printf vprintf fprintf vfprintf
+    puts putchar fputs fputc fwrite fflush
+)
+
+find_package(Threads REQUIRED)
+
+# Same warnings as the firmware build (see cmake/PicoRTOSToolchain.cmake)
+set(PICO_RTOS_HOST_WARNING_FLAGS -Wall -Wextra -Wno-unused-parameter)
+
+# Builds one variant of the host kernel library; extra arguments are
+# compile definitions that only apply to that variant
+function(pico_rtos_add_host_library name)
+    add_library(${name} STATIC ${PICO_RTOS_HOST_SOURCES})
+
+    target_include_directories(${name} PUBLIC
+        ${CMAKE_CURRENT_SOURCE_DIR}/include
+        ${PICO_RTOS_HOST_DIR}/include
+    )
+
+    target_compile_definitions(${name} PUBLIC
+        PICO_PLATFORM=host
+        PICO_RTOS_HOST_PORT=1
+        ${ARGN}
+    )
+
+    # Fortified stdio (__printf_chk) would bypass the wrappers
+    target_compile_options(${name} PUBLIC -U_FORTIFY_SOURCE)
+    target_compile_options(${name} PRIVATE ${PICO_RTOS_HOST_WARNING_FLAGS})
+
+    foreach(symbol ${PICO_RTOS_HOST_WRAPPED_SYMBOLS})
+        target_link_options(${name} INTERFACE "LINKER:--wrap=${symbol}")
+    endforeach()
+
+    target_link_libraries(${name} PUBLIC Threads::Threads m)
+endfunction()
+
+pico_rtos_add_host_library(pico_rtos_host)
+
+# Helper to build a host program against the simulator
+function(pico_rtos_add_host_executable name)
+    add_executable(${name} ${ARGN})
+    target_link_libraries(${name} pico_rtos_host)
+    target_compile_options(${name} PRIVATE ${PICO_RTOS_HOST_WARNING_FLAGS})
+endfunction()
+
+# Same, against a kernel built with tickless idle on the simulated clock
+function(pico_rtos_add_host_tickless_executable name)
+    add_executable(${name} ${ARGN})
+    target_link_libraries(${name} pico_rtos_host_tickless)
+    target_compile_options(${name} PRIVATE ${PICO_RTOS_HOST_WARNING_FLAGS})
+endfunction()
+
+# Same, against a kernel on the simulated clock (see src/host/host_port.c)
+function(pico_rtos_add_host_virtual_executable name)
+    add_executable(${name} ${ARGN})
+    target_link_libraries(${name} pico_rtos_host_virtual)
+    target_compile_options(${name} PRIVATE ${PICO_RTOS_HOST_WARNING_FLAGS})
+endfunction()
+
+# Same, against a kernel built without dynamic allocation
+function(pico_rtos_add_host_static_executable name)
+    add_executable(${name} ${ARGN})
+    target_link_libraries(${name} pico_rtos_host_static)
+    target_compile_options(${name} PRIVATE ${PICO_RTOS_HOST_WARNING_FLAGS})
+endfunction()
+
+if(PICO_RTOS_BUILD_TESTS)
+    enable_testing()
+
+    # Tickless idle is off by default, so its tests get their own kernel build;
+    # it runs on the simulated clock so idle periods are checked to the tick
+    pico_rtos_add_host_library(pico_rtos_host_tickless PICO_RTOS_ENABLE_TICKLESS_IDLE=1 PICO_RTOS_HOST_VIRTUAL_TIME=1)
+
+    # Discrete-event build: time jumps to the next event whenever all tasks
+    # wait, so timing tests run faster than real time and repeat exactly
+    pico_rtos_add_host_library(pico_rtos_host_virtual PICO_RTOS_HOST_VIRTUAL_TIME=1)
+
+    # No pico_rtos_malloc, no heap, only the _static create/init variants
+    pico_rtos_add_host_library(pico_rtos_host_static PICO_RTOS_STATIC_ALLOCATION_ONLY=1)
+
+    # Self-checking programs that terminate are registered with CTest
+    pico_rtos_add_host_executable(host_port_test tests/host_port_test.c)
+    add_test(NAME host_port_test COMMAND host_port_test)
+    # Checks the real tick itself, so it runs alone with loose bounds
+    set_tests_properties(host_port_test PROPERTIES TIMEOUT 60 RUN_SERIAL TRUE)
+
+    pico_rtos_add_host_executable(scheduler_performance_test tests/scheduler_performance_test.c)
+    add_test(NAME scheduler_performance_test COMMAND scheduler_performance_test)
+    set_tests_properties(scheduler_performance_test PROPERTIES TIMEOUT 120)
+
+    pico_rtos_add_host_executable(time_slice_test tests/time_slice_test.c)
+    add_test(NAME time_slice_test COMMAND time_slice_test)
+    set_tests_properties(time_slice_test PROPERTIES TIMEOUT 60)
+
+    # Deadlines are checked to the tick, so host load must not move them
+    if(PICO_RTOS_ENABLE_EDF_SCHEDULING)
+        pico_rtos_add_host_virtual_executable(edf_scheduling_test tests/edf_scheduling_test.c)
+        add_test(NAME edf_scheduling_test COMMAND edf_scheduling_test)
+        set_tests_properties(edf_scheduling_test PROPERTIES TIMEOUT 60)
+    endif()
+
+    pico_rtos_add_host_executable(delay_list_test tests/delay_list_test.c)
+    add_test(NAME delay_list_test COMMAND delay_list_test)
+    set_tests_properties(delay_list_test PROPERTIES TIMEOUT 60)
+
+    pico_rtos_add_host_executable(timer_wheel_test tests/timer_wheel_test.c)
+    add_test(NAME timer_wheel_test COMMAND timer_wheel_test)
+    set_tests_properties(timer_wheel_test PROPERTIES TIMEOUT 60)
+
+    if(PICO_RTOS_ENABLE_RUNTIME_STATS)
+        pico_rtos_add_host_virtual_executable(cpu_accounting_test tests/cpu_accounting_test.c)
+        add_test(NAME cpu_accounting_test COMMAND cpu_accounting_test)
+        set_tests_properties(cpu_accounting_test PROPERTIES TIMEOUT 60)
+    endif()
+
+    pico_rtos_add_host_executable(timeout_queue_test tests/timeout_queue_test.c)
+    add_test(NAME timeout_queue_test COMMAND timeout_queue_test)
+    set_tests_properties(timeout_queue_test PROPERTIES TIMEOUT 60)
+
+    pico_rtos_add_host_executable(task_reaping_test tests/task_reaping_test.c)
+    add_test(NAME task_reaping_test COMMAND task_reaping_test)
+    set_tests_properties(task_reaping_test PROPERTIES TIMEOUT 60)
+
+    # Checks that a task woken from an interrupt runs on the same tick
+    if(PICO_RTOS_ENABLE_TASK_NOTIFICATIONS)
+        pico_rtos_add_host_virtual_executable(task_notification_test tests/task_notification_test.c)
+        add_test(NAME task_notification_test COMMAND task_notification_test)
+        set_tests_properties(task_notification_test PROPERTIES TIMEOUT 60)
+    endif()
+
+    if(PICO_RTOS_ENABLE_DEFERRED_WORK)
+        pico_rtos_add_host_executable(deferred_work_test tests/deferred_work_test.c)
+        add_test(NAME deferred_work_test COMMAND deferred_work_test)
+        set_tests_properties(deferred_work_test PROPERTIES TIMEOUT 60)
+    endif()
+
+    if(PICO_RTOS_ENABLE_TIMER_DAEMON)
+        pico_rtos_add_host_executable(timer_daemon_test tests/timer_daemon_test.c)
+        add_test(NAME timer_daemon_test COMMAND timer_daemon_test)
+        set_tests_properties(timer_daemon_test PROPERTIES TIMEOUT 60 RUN_SERIAL TRUE)
+    endif()
+
+    pico_rtos_add_host_executable(static_allocation_test tests/static_allocation_test.c)
+    add_test(NAME static_allocation_test COMMAND static_allocation_test)
+    set_tests_properties(static_allocation_test PROPERTIES TIMEOUT 60)
+
+    pico_rtos_add_host_static_executable(static_allocation_test_static_only tests/static_allocation_test.c)
+    add_test(NAME static_allocation_test_static_only COMMAND static_allocation_test_static_only)
+    set_tests_properties(static_allocation_test_static_only PROPERTIES TIMEOUT 60)
+
+    if(PICO_RTOS_ENABLE_HEAP)
+        pico_rtos_add_host_executable(heap_test tests/heap_test.c)
+        add_test(NAME heap_test COMMAND heap_test)
+        set_tests_properties(heap_test PROPERTIES TIMEOUT 60)
+    endif()
+
+    pico_rtos_add_host_tickless_executable(tickless_idle_test tests/tickless_idle_test.c)
+    add_test(NAME tickless_idle_test COMMAND tickless_idle_test)
+    set_tests_properties(tickless_idle_test PROPERTIES TIMEOUT 60)
+
+    pico_rtos_add_host_virtual_executable(virtual_time_test tests/virtual_time_test.c)
+    add_test(NAME virtual_time_test COMMAND virtual_time_test)
+    set_tests_properties(virtual_time_test PROPERTIES TIMEOUT 60)
+
+    # Timing tests that only block also run on the simulated clock, where
+    # their timeouts take no wall time and cannot be disturbed by host load
+    pico_rtos_add_host_virtual_executable(timeout_queue_test_virtual tests/timeout_queue_test.c)
+    add_test(NAME timeout_queue_test_virtual COMMAND timeout_queue_test_virtual)
+    set_tests_properties(timeout_queue_test_virtual PROPERTIES TIMEOUT 60)
+
+    pico_rtos_add_host_virtual_executable(queue_batch_test tests/queue_batch_test.c)
+    add_test(NAME queue_batch_test COMMAND queue_batch_test)
+    set_tests_properties(queue_batch_test PROPERTIES TIMEOUT 60)
+
+    if(PICO_RTOS_ENABLE_QUEUE_SETS)
+        pico_rtos_add_host_virtual_executable(queue_set_test tests/queue_set_test.c)
+        add_test(NAME queue_set_test COMMAND queue_set_test)
+        set_tests_properties(queue_set_test PROPERTIES TIMEOUT 60)
+    endif()
+
+    if(PICO_RTOS_ENABLE_MPMC_RINGS)
+        # Host only: producers and consumers also run as plain threads
+        pico_rtos_add_host_executable(mpmc_ring_test tests/mpmc_ring_test.c)
+        add_test(NAME mpmc_ring_test COMMAND mpmc_ring_test)
+        set_tests_properties(mpmc_ring_test PROPERTIES TIMEOUT 60)
+    endif()
+
+    # Preemption order depends on where ticks fall inside busy waits, and
+    # priorities are checked at fixed points in the tasks' progress
+    pico_rtos_add_host_virtual_executable(priority_ceiling_test tests/priority_ceiling_test.c)
+    add_test(NAME priority_ceiling_test COMMAND priority_ceiling_test)
+    set_tests_properties(priority_ceiling_test PROPERTIES TIMEOUT 60)
+
+    pico_rtos_add_host_virtual_executable(priority_inheritance_test tests/priority_inheritance_test.c)
+    add_test(NAME priority_inheritance_test COMMAND priority_inheritance_test)
+    set_tests_properties(priority_inheritance_test PROPERTIES TIMEOUT 60)
+
+    pico_rtos_add_host_virtual_executable(rwlock_test tests/rwlock_test.c)
+    add_test(NAME rwlock_test COMMAND rwlock_test)
+    set_tests_properties(rwlock_test PROPERTIES TIMEOUT 60)
+
+    # Same timers on the simulated clock, where every callback runs on its expiry tick
+    pico_rtos_add_host_virtual_executable(timer_wheel_test_virtual tests/timer_wheel_test.c)
+    add_test(NAME timer_wheel_test_virtual COMMAND timer_wheel_test_virtual)
+    set_tests_properties(timer_wheel_test_virtual PROPERTIES TIMEOUT 60)
+
+    if(PICO_RTOS_ENABLE_TIMER_DAEMON)
+        pico_rtos_add_host_virtual_executable(timer_daemon_test_virtual tests/timer_daemon_test.c)
+        add_test(NAME timer_daemon_test_virtual COMMAND timer_daemon_test_virtual)
+        set_tests_properties(timer_daemon_test_virtual PROPERTIES TIMEOUT 60)
+    endif()
+
+    pico_rtos_add_host_executable(blocking_performance_test tests/blocking_performance_test.c)
+    add_test(NAME blocking_performance_test COMMAND blocking_performance_test)
+    set_tests_properties(blocking_performance_test PROPERTIES TIMEOUT 60)
+
+    pico_rtos_add_host_executable(queue_spsc_performance_test tests/queue_spsc_performance_test.c)
+    add_test(NAME queue_spsc_performance_test COMMAND queue_spsc_performance_test)
+    set_tests_properties(queue_spsc_performance_test PROPERTIES TIMEOUT 120)
+
+    if(PICO_RTOS_ENABLE_MEMORY_POOLS)
+        # Built but not registered: single pool operations finish well below
+        # the 1 us timer resolution on a host, so its ratios are noise
+        pico_rtos_add_host_executable(memory_pool_performance_test tests/memory_pool_performance_test.c)
+    endif()
+
+    if(PICO_RTOS_ENABLE_STREAM_BUFFERS)
+        pico_rtos_add_host_executable(stream_buffer_performance_test tests/stream_buffer_performance_test.c)
+        add_test(NAME stream_buffer_performance_test COMMAND stream_buffer_performance_test)
+        set_tests_properties(stream_buffer_performance_test PROPERTIES TIMEOUT 120)
+    endif()
+
+    pico_rtos_add_host_executable(performance_regression_test tests/performance_regression_test.c)
+    add_test(NAME performance_regression_test COMMAND performance_regression_test)
+    set_tests_properties(performance_regression_test PROPERTIES TIMEOUT 120)
+endif()
+
+if(PICO_RTOS_BUILD_EXAMPLES)
+    # Runs until interrupted, like on target; not registered with CTest
+    pico_rtos_add_host_executable(performance_benchmark examples/performance_benchmark/main.c)
+endif()
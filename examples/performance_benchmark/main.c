@@ -169,12 +169,12 @@ static void calculate_statistics(uint32_t *measurements, uint32_t count, benchma
  */
 static void print_benchmark_result(const benchmark_result_t *result) {
     printf("=== %s ===\n", result->test_name);
-    printf("Iterations: %lu\n", result->iterations);
-    printf("Min Time: %lu μs\n", result->min_time_us);
-    printf("Max Time: %lu μs\n", result->max_time_us);
-    printf("Avg Time: %lu μs\n", result->avg_time_us);
-    printf("Std Dev: %lu μs\n", result->std_deviation_us);
-    printf("Total Time: %lu μs\n", result->total_time_us);
+    printf("Iterations: %lu\n", (unsigned long)result->iterations);
+    printf("Min Time: %lu μs\n", (unsigned long)result->min_time_us);
+    printf("Max Time: %lu μs\n", (unsigned long)result->max_time_us);
+    printf("Avg Time: %lu μs\n", (unsigned long)result->avg_time_us);
+    printf("Std Dev: %lu μs\n", (unsigned long)result->std_deviation_us);
+    printf("Total Time: %lu μs\n", (unsigned long)result->total_time_us);
     printf("Status: %s\n", result->test_passed ? "PASS" : "FAIL");
     if (result->notes) {
         printf("Notes: %s\n", result->notes);
@@ -505,22 +505,22 @@ static void print_baseline_metrics(void) {
     
     // System information
     printf("RTOS Version: %s\n", pico_rtos_get_version_string());
-    printf("System Clock: %lu Hz\n", clock_get_hz(clk_sys));
+    printf("System Clock: %lu Hz\n", (unsigned long)clock_get_hz(clk_sys));
     printf("Tick Rate: 1000 Hz (1ms)\n"); // Assuming default tick rate
     
     // Memory information
     uint32_t current_memory, peak_memory, allocations;
     pico_rtos_get_memory_stats(&current_memory, &peak_memory, &allocations);
     printf("Memory - Current: %lu bytes, Peak: %lu bytes, Allocations: %lu\n",
-           current_memory, peak_memory, allocations);
+           (unsigned long)current_memory, (unsigned long)peak_memory, (unsigned long)allocations);
     
     // System statistics
     pico_rtos_system_stats_t stats;
     pico_rtos_get_system_stats(&stats);
     printf("Tasks - Total: %lu, Ready: %lu, Blocked: %lu\n",
-           stats.total_tasks, stats.ready_tasks, stats.blocked_tasks);
-    printf("System Uptime: %lu ms\n", stats.system_uptime);
-    printf("Idle Counter: %lu\n", stats.idle_counter);
+           (unsigned long)stats.total_tasks, (unsigned long)stats.ready_tasks, (unsigned long)stats.blocked_tasks);
+    printf("System Uptime: %lu ms\n", (unsigned long)stats.system_uptime);
+    printf("Idle Counter: %lu\n", (unsigned long)stats.idle_counter);
     
     printf("================================\n\n");
 }
@@ -538,14 +538,14 @@ static void print_benchmark_summary(void) {
         printf("%-30s: %s (%lu μs avg)\n", 
                benchmark_results[i].test_name,
                benchmark_results[i].test_passed ? "PASS" : "FAIL",
-               benchmark_results[i].avg_time_us);
+               (unsigned long)benchmark_results[i].avg_time_us);
         if (benchmark_results[i].test_passed) {
             passed_tests++;
         }
     }
     
     printf("\nOverall Result: %lu/%lu tests passed (%.1f%%)\n",
-           passed_tests, total_tests, 
+           (unsigned long)passed_tests, (unsigned long)total_tests, 
            total_tests > 0 ? (float)passed_tests * 100.0f / total_tests : 0.0f);
     
     if (passed_tests == total_tests) {
@@ -630,7 +630,7 @@ void benchmark_controller_task(void *param) {
     // Keep task alive for continuous monitoring
     while (1) {
         pico_rtos_task_delay(10000); // Report every 10 seconds
-        printf("System still running - uptime: %lu ms\n", pico_rtos_get_uptime_ms());
+        printf("System still running - uptime: %lu ms\n", (unsigned long)pico_rtos_get_uptime_ms());
     }
 }
 
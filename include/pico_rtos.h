@@ -8,8 +8,11 @@
 #include "pico_rtos/mutex.h"
 #include "pico_rtos/queue.h"
 #include "pico_rtos/semaphore.h"
+#include "pico_rtos/rwlock.h"
 #include "pico_rtos/task.h"
 #include "pico_rtos/timer.h"
+#include "pico_rtos/deferred.h"
+#include "pico_rtos/heap.h"
 
 // v0.3.1 Advanced Synchronization Primitives
 #ifdef PICO_RTOS_ENABLE_EVENT_GROUPS
@@ -20,6 +23,14 @@
 #include "pico_rtos/stream_buffer.h"
 #endif
 
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+#include "pico_rtos/queue_set.h"
+#endif
+
+#if PICO_RTOS_ENABLE_MPMC_RINGS
+#include "pico_rtos/mpmc_ring.h"
+#endif
+
 // v0.3.1 Enhanced Memory Management
 #ifdef PICO_RTOS_ENABLE_MEMORY_POOLS
 #include "pico_rtos/memory_pool.h"
@@ -118,6 +129,16 @@ void pico_rtos_start(void);
  */
 uint32_t pico_rtos_get_tick_count(void);
 
+/**
+ * @brief Get the number of periodic tick interrupts taken
+ * 
+ * Equals the tick count unless tickless idle skipped ticks while the
+ * system was idle.
+ * 
+ * @return Number of tick interrupts since the scheduler started
+ */
+uint32_t pico_rtos_get_tick_interrupt_count(void);
+
 /**
  * @brief Get the system uptime
  * 
@@ -132,6 +153,23 @@ uint32_t pico_rtos_get_uptime_ms(void);
  */
 uint32_t pico_rtos_get_tick_rate_hz(void);
 
+/**
+ * @brief Set the system round-robin time slice
+ * 
+ * Applies to every task without a time slice of its own. Equal-priority
+ * ready tasks take turns every this many ticks; 0 disables time slicing.
+ * 
+ * @param ticks Time slice in ticks
+ */
+void pico_rtos_set_time_slice(uint32_t ticks);
+
+/**
+ * @brief Get the system round-robin time slice
+ * 
+ * @return Time slice in ticks, 0 if time slicing is disabled
+ */
+uint32_t pico_rtos_get_time_slice(void);
+
 /**
  * @brief Get the RTOS version string
  * 
@@ -156,17 +194,44 @@ void pico_rtos_check_timers(void);
 void pico_rtos_scheduler_add_task(pico_rtos_task_t *task);
 void pico_rtos_scheduler_remove_task(pico_rtos_task_t *task);
 void pico_rtos_cleanup_terminated_tasks(void);
+uint32_t pico_rtos_reap_terminated_tasks(uint32_t max_tasks);
+void pico_rtos_reap_task(pico_rtos_task_t *task);
 void pico_rtos_schedule_next_task(void);
 pico_rtos_task_t *pico_rtos_scheduler_get_highest_priority_task(void);
+void pico_rtos_scheduler_set_task_state(pico_rtos_task_t *task, pico_rtos_task_state_t state);
+void pico_rtos_scheduler_set_task_priority(pico_rtos_task_t *task, uint32_t priority);
+void pico_rtos_mutex_update_priority(pico_rtos_task_t *task);
+void pico_rtos_scheduler_delay_task(pico_rtos_task_t *task, uint32_t ticks);
+void pico_rtos_scheduler_timeout_task(pico_rtos_task_t *task, uint32_t ticks);
 pico_rtos_timer_t *pico_rtos_get_first_timer(void);
 pico_rtos_timer_t *pico_rtos_get_next_timer(pico_rtos_timer_t *timer);
 void pico_rtos_add_timer(pico_rtos_timer_t *timer);
 void pico_rtos_remove_timer(pico_rtos_timer_t *timer);
+void pico_rtos_timer_wheel_arm(pico_rtos_timer_t *timer);
+void pico_rtos_timer_wheel_disarm(pico_rtos_timer_t *timer);
+#if PICO_RTOS_ENABLE_TIMER_DAEMON
+bool pico_rtos_timer_daemon_init(void);
+void pico_rtos_timer_daemon_defer(pico_rtos_timer_t *timer);
+void pico_rtos_timer_daemon_flush(void);
+#endif
+#if PICO_RTOS_ENABLE_DEFERRED_WORK
+bool pico_rtos_deferred_init(void);
+#endif
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+void pico_rtos_queue_set_notify(pico_rtos_queue_set_member_t *member);
+bool pico_rtos_queue_set_notify_from_isr(pico_rtos_queue_set_member_t *member);
+void pico_rtos_queue_set_leave(pico_rtos_queue_set_member_t *member);
+#endif
+#if PICO_RTOS_ENABLE_HEAP
+void pico_rtos_heap_init(void);
+#endif
 void pico_rtos_task_resume_highest_priority(void);
 
 // Memory management functions
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
 void *pico_rtos_malloc(size_t size);
 void pico_rtos_free(void *ptr, size_t size);
+#endif
 void pico_rtos_get_memory_stats(uint32_t *current, uint32_t *peak, uint32_t *allocations);
 
 // Stack overflow protection
@@ -176,6 +241,17 @@ void pico_rtos_handle_stack_overflow(pico_rtos_task_t *task);
 // System statistics
 uint32_t pico_rtos_get_idle_counter(void);
 
+/**
+ * @brief Get the number of ended tasks whose stacks are not yet freed
+ * 
+ * Deleted tasks and tasks whose function returned leave the task list at
+ * once and wait on a zombie list; the idle task frees their stacks,
+ * PICO_RTOS_TASK_REAP_BATCH per pass, so the tick never calls the allocator.
+ * 
+ * @return Terminated tasks waiting to be reaped
+ */
+uint32_t pico_rtos_get_terminated_task_count(void);
+
 // Idle task hook support
 typedef void (*pico_rtos_idle_hook_t)(void);
 void pico_rtos_set_idle_hook(pico_rtos_idle_hook_t hook);
@@ -184,6 +260,7 @@ void pico_rtos_clear_idle_hook(void);
 // Debug system accessor functions
 pico_rtos_task_t *pico_rtos_debug_get_current_task(void);
 pico_rtos_task_t *pico_rtos_debug_get_task_list(void);
+pico_rtos_task_t *pico_rtos_debug_get_idle_task(void);
 uint32_t pico_rtos_debug_get_system_tick_count(void);
 
 // Interrupt handling
@@ -207,4 +284,34 @@ typedef struct {
 
 void pico_rtos_get_system_stats(pico_rtos_system_stats_t *stats);
 
+/**
+ * @brief Cost of the periodic tick interrupt
+ * 
+ * Measured with the port cycle counter (CPU cycles on RP2040, nanoseconds
+ * on the host simulator) from entry to exit of the tick handler.
+ * delay_list_visits counts the work behind that cost independently of the
+ * clock: the expired entries plus the head whose count-down was updated.
+ */
+typedef struct {
+    uint32_t last_cycles;       ///< Cost of the most recent tick
+    uint32_t max_cycles;        ///< Most expensive tick since the last reset
+    uint32_t average_cycles;    ///< Mean cost since the last reset
+    uint32_t sample_count;      ///< Ticks measured since the last reset
+    uint32_t delay_list_visits; ///< Delay list entries the tick looked at since the last reset
+} pico_rtos_tick_stats_t;
+
+/**
+ * @brief Get tick interrupt cost statistics
+ * 
+ * Requires PICO_RTOS_ENABLE_RUNTIME_STATS; all fields read zero otherwise.
+ * 
+ * @param stats Pointer to structure to fill
+ */
+void pico_rtos_get_tick_stats(pico_rtos_tick_stats_t *stats);
+
+/**
+ * @brief Reset tick interrupt cost statistics
+ */
+void pico_rtos_reset_tick_stats(void);
+
 #endif // PICO_RTOS_H
\ No newline at end of file
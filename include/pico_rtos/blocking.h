@@ -8,10 +8,13 @@
 
 // Forward declarations
 typedef struct pico_rtos_task pico_rtos_task_t;
+struct pico_rtos_block_object;
 
-// Structure to hold information about a blocked task
+// Wait list entry of a blocked task; embedded in the task itself since a
+// task waits on at most one object at a time
 typedef struct pico_rtos_blocked_task {
     pico_rtos_task_t *task;
+    struct pico_rtos_block_object *owner; // Wait list the node is linked into (NULL when not waiting)
     uint32_t timeout_time;
     uint32_t priority;                    // Cached priority for O(1) access
     struct pico_rtos_blocked_task *next;
@@ -26,16 +29,29 @@ typedef struct pico_rtos_block_object {
     uint32_t blocked_count;                     // Number of blocked tasks
     critical_section_t cs;                      // Critical section for thread safety
     bool priority_ordered;                      // Flag to enable priority-ordered insertion
+    bool dynamically_allocated;                 // Storage came from pico_rtos_malloc()
 } pico_rtos_block_object_t;
 
 /**
  * @brief Create a new blocking object
  * 
+ * Allocates the object with pico_rtos_malloc(). Always fails when the
+ * kernel is built with PICO_RTOS_STATIC_ALLOCATION_ONLY.
+ * 
  * @param sync_object Pointer to the synchronization object (mutex, semaphore, etc.)
  * @return pico_rtos_block_object_t* Pointer to the created blocking object, or NULL on failure
  */
 pico_rtos_block_object_t *pico_rtos_block_object_create(void *sync_object);
 
+/**
+ * @brief Create a blocking object in caller-provided storage
+ * 
+ * @param storage Storage for the object; must stay valid until it is deleted
+ * @param sync_object Pointer to the synchronization object (mutex, semaphore, etc.)
+ * @return pico_rtos_block_object_t* storage, or NULL if storage is NULL
+ */
+pico_rtos_block_object_t *pico_rtos_block_object_create_static(pico_rtos_block_object_t *storage, void *sync_object);
+
 /**
  * @brief Delete a blocking object and unblock all waiting tasks
  * 
@@ -63,9 +79,36 @@ bool pico_rtos_block_task(pico_rtos_block_object_t *block_obj, pico_rtos_task_t
  */
 pico_rtos_task_t *pico_rtos_unblock_highest_priority_task(pico_rtos_block_object_t *block_obj);
 
+/**
+ * @brief Remove a task from a blocking object's wait list without waking it
+ * 
+ * Used when a blocked task is deleted so that a later unblock cannot hand
+ * the object to (or make ready) a task that no longer exists.
+ * 
+ * @param block_obj Pointer to the blocking object
+ * @param task Pointer to the task to remove
+ */
+void pico_rtos_block_object_remove_task(pico_rtos_block_object_t *block_obj, pico_rtos_task_t *task);
+
+/**
+ * @brief Move a waiting task to the place its current priority gives it
+ * 
+ * Call after changing the priority of a task that is on the object's wait
+ * list, so that the list stays in priority order. Does nothing if the
+ * task is not waiting on the object.
+ * 
+ * @param block_obj Pointer to the blocking object
+ * @param task Pointer to the waiting task
+ */
+void pico_rtos_block_object_reprioritize_task(pico_rtos_block_object_t *block_obj, pico_rtos_task_t *task);
+
 /**
  * @brief Check for timed out tasks and unblock them
  * 
+ * Not needed in normal operation: every timed wait is registered with the
+ * kernel's timeout queue and expires on its own tick. Walks the object's
+ * whole wait list.
+ * 
  * @param block_obj Pointer to the blocking object
  */
 void pico_rtos_check_blocked_timeouts(pico_rtos_block_object_t *block_obj);
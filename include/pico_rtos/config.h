@@ -57,6 +57,41 @@
  */
 #define PICO_RTOS_TICK_PERIOD_US (1000000UL / PICO_RTOS_TICK_RATE_HZ)
 
+/**
+ * @brief Enable tickless idle
+ * 
+ * When enabled and no idle hook is registered, the idle task stops the
+ * periodic tick and sleeps until the next delayed task, blocking timeout or
+ * timer is due, then advances the tick count by the time actually slept.
+ * Tick count and delays keep their meaning; only the idle wakeups go away.
+ * Can be enabled via CMake: -DPICO_RTOS_ENABLE_TICKLESS_IDLE=ON
+ */
+#ifndef PICO_RTOS_ENABLE_TICKLESS_IDLE
+#define PICO_RTOS_ENABLE_TICKLESS_IDLE 0
+#endif
+
+/**
+ * @brief Shortest idle period (in ticks) worth stopping the tick for
+ * 
+ * Shorter idle periods just wait for the next periodic tick.
+ */
+#ifndef PICO_RTOS_TICKLESS_MIN_IDLE_TICKS
+#define PICO_RTOS_TICKLESS_MIN_IDLE_TICKS 2
+#endif
+
+/**
+ * @brief Longest single tickless sleep (in ticks)
+ * 
+ * Bounds the sleep when nothing is scheduled at all.
+ */
+#ifndef PICO_RTOS_TICKLESS_MAX_IDLE_TICKS
+#define PICO_RTOS_TICKLESS_MAX_IDLE_TICKS (PICO_RTOS_TICK_RATE_HZ * 10)
+#endif
+
+#if PICO_RTOS_TICKLESS_MIN_IDLE_TICKS < 1
+#error "PICO_RTOS_TICKLESS_MIN_IDLE_TICKS must be at least 1"
+#endif
+
 // =============================================================================
 // SYSTEM LIMITS AND SIZING
 // =============================================================================
@@ -71,6 +106,21 @@
 #define PICO_RTOS_MAX_TASKS 16
 #endif
 
+/**
+ * @brief Terminated tasks the idle task reaps per pass
+ * 
+ * Deleted and finished tasks wait on a zombie list until the idle task
+ * frees their stacks. Bounding each pass keeps the idle loop, and anything
+ * it delays, responsive when many tasks end at once.
+ */
+#ifndef PICO_RTOS_TASK_REAP_BATCH
+#define PICO_RTOS_TASK_REAP_BATCH 4
+#endif
+
+#if PICO_RTOS_TASK_REAP_BATCH < 1
+#error "PICO_RTOS_TASK_REAP_BATCH must be at least 1"
+#endif
+
 /**
  * @brief Maximum number of software timers supported
  * 
@@ -81,6 +131,63 @@
 #define PICO_RTOS_MAX_TIMERS 8
 #endif
 
+/**
+ * @brief Size of the innermost software timer wheel level (log2 of slots)
+ * 
+ * Timers due within 2^bits ticks sit in a slot of their own tick; later ones
+ * are kept in three coarser levels of 64 slots and moved down as their time
+ * approaches. Each slot costs one pointer of RAM.
+ * Can be overridden via CMake: -DPICO_RTOS_TIMER_WHEEL_ROOT_BITS=6
+ */
+#ifndef PICO_RTOS_TIMER_WHEEL_ROOT_BITS
+#define PICO_RTOS_TIMER_WHEEL_ROOT_BITS 8
+#endif
+
+#if PICO_RTOS_TIMER_WHEEL_ROOT_BITS < 4 || PICO_RTOS_TIMER_WHEEL_ROOT_BITS > 12
+#error "PICO_RTOS_TIMER_WHEEL_ROOT_BITS must be between 4 and 12"
+#endif
+
+/**
+ * @brief Run software timer callbacks in a timer service task
+ * 
+ * The tick only moves expired timers onto a pending list and wakes the
+ * timer service task once; callbacks then run in that task instead of the
+ * tick interrupt. When disabled, callbacks run inside the tick.
+ * Can be overridden via CMake: -DPICO_RTOS_ENABLE_TIMER_DAEMON=OFF
+ */
+#ifndef PICO_RTOS_ENABLE_TIMER_DAEMON
+#define PICO_RTOS_ENABLE_TIMER_DAEMON 1
+#endif
+
+/**
+ * @brief Priority of the timer service task
+ * 
+ * Defaults to the highest ready queue level so that callbacks run right
+ * after the tick that expired them.
+ */
+#ifndef PICO_RTOS_TIMER_DAEMON_PRIORITY
+#define PICO_RTOS_TIMER_DAEMON_PRIORITY (PICO_RTOS_PRIORITY_LEVELS - 1)
+#endif
+
+/**
+ * @brief Stack size of the timer service task in bytes
+ * 
+ * Timer callbacks run on this stack.
+ */
+#ifndef PICO_RTOS_TIMER_DAEMON_STACK_SIZE
+#define PICO_RTOS_TIMER_DAEMON_STACK_SIZE 1024
+#endif
+
+/**
+ * @brief Length of the timer service command queue
+ * 
+ * Bounds how many *_from_isr timer commands can be waiting for the timer
+ * service task at once.
+ */
+#ifndef PICO_RTOS_TIMER_DAEMON_QUEUE_LENGTH
+#define PICO_RTOS_TIMER_DAEMON_QUEUE_LENGTH 8
+#endif
+
 // =============================================================================
 // FEATURE ENABLE/DISABLE FLAGS
 // =============================================================================
@@ -223,6 +330,170 @@
 #define PICO_RTOS_IDLE_TASK_STACK_SIZE 64
 #endif
 
+/**
+ * @brief Number of distinct scheduler priority levels
+ * 
+ * Each level has its own ready queue and a bit in the ready bitmap, so the
+ * scheduler finds the highest priority ready task in constant time. Tasks
+ * with a priority at or above this value share the top level and are
+ * scheduled round-robin among themselves. At most 1024 levels.
+ */
+#ifndef PICO_RTOS_PRIORITY_LEVELS
+#define PICO_RTOS_PRIORITY_LEVELS 64
+#endif
+
+/**
+ * @brief Default round-robin time slice in ticks
+ * 
+ * A running task that has used up this many ticks is moved behind the other
+ * ready tasks of its priority, so CPU-bound peers share the CPU without
+ * calling pico_rtos_task_yield(). 0 disables time slicing; tasks then run
+ * until they block or yield. Can be changed at run time with
+ * pico_rtos_set_time_slice() or per task with pico_rtos_task_set_time_slice().
+ * Can be overridden via CMake: -DPICO_RTOS_TIME_SLICE_TICKS=10
+ */
+#ifndef PICO_RTOS_TIME_SLICE_TICKS
+#define PICO_RTOS_TIME_SLICE_TICKS 0
+#endif
+
+/**
+ * @brief Enable the earliest-deadline-first scheduling class
+ * 
+ * Tasks given a deadline with pico_rtos_task_set_deadline() move into the
+ * EDF priority band, where the ready task with the earliest absolute
+ * deadline runs first. Fixed-priority tasks above the band still preempt
+ * them and tasks below only run when no EDF task is ready.
+ * Can be overridden via CMake: -DPICO_RTOS_ENABLE_EDF_SCHEDULING=OFF
+ */
+#ifndef PICO_RTOS_ENABLE_EDF_SCHEDULING
+#define PICO_RTOS_ENABLE_EDF_SCHEDULING 1
+#endif
+
+/**
+ * @brief Priority level of the EDF band
+ * 
+ * Must be below PICO_RTOS_PRIORITY_LEVELS so that the band has a ready
+ * queue of its own.
+ * Can be overridden via CMake: -DPICO_RTOS_EDF_PRIORITY=20
+ */
+#ifndef PICO_RTOS_EDF_PRIORITY
+#define PICO_RTOS_EDF_PRIORITY (PICO_RTOS_PRIORITY_LEVELS / 2)
+#endif
+
+/**
+ * @brief Enable direct-to-task notifications
+ * 
+ * Gives every task a 32-bit notification value that other tasks and
+ * interrupts can update, waking the task directly without a semaphore or
+ * event group in between.
+ * Can be overridden via CMake: -DPICO_RTOS_ENABLE_TASK_NOTIFICATIONS=OFF
+ */
+#ifndef PICO_RTOS_ENABLE_TASK_NOTIFICATIONS
+#define PICO_RTOS_ENABLE_TASK_NOTIFICATIONS 1
+#endif
+
+/**
+ * @brief Enable the deferred interrupt work queue
+ * 
+ * Interrupt handlers queue a function and argument with
+ * pico_rtos_defer_from_isr() and return; a kernel task runs the functions.
+ * Requires task notifications.
+ * Can be overridden via CMake: -DPICO_RTOS_ENABLE_DEFERRED_WORK=OFF
+ */
+#ifndef PICO_RTOS_ENABLE_DEFERRED_WORK
+#define PICO_RTOS_ENABLE_DEFERRED_WORK 1
+#endif
+
+/**
+ * @brief Priority of the deferred work task
+ * 
+ * Defaults to just below the timer service task so deferred work runs
+ * ahead of every application task.
+ */
+#ifndef PICO_RTOS_DEFERRED_WORK_PRIORITY
+#define PICO_RTOS_DEFERRED_WORK_PRIORITY (PICO_RTOS_PRIORITY_LEVELS - 2)
+#endif
+
+/**
+ * @brief Stack size of the deferred work task in bytes
+ * 
+ * Deferred functions run on this stack.
+ */
+#ifndef PICO_RTOS_DEFERRED_WORK_STACK_SIZE
+#define PICO_RTOS_DEFERRED_WORK_STACK_SIZE 1024
+#endif
+
+/**
+ * @brief Length of the deferred work queue
+ * 
+ * Bounds how many items can wait for the deferred work task at once.
+ * Must be a power of two.
+ */
+#ifndef PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH
+#define PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH 32
+#endif
+
+/**
+ * @brief Enable queue sets
+ * 
+ * Lets one task wait on several queues, semaphores, stream buffers and
+ * event groups at once. Adds a set link to each of those objects.
+ * Can be overridden via CMake: -DPICO_RTOS_ENABLE_QUEUE_SETS=OFF
+ */
+#ifndef PICO_RTOS_ENABLE_QUEUE_SETS
+#define PICO_RTOS_ENABLE_QUEUE_SETS 1
+#endif
+
+/**
+ * @brief Enable multi-producer/multi-consumer rings
+ * 
+ * Builds pico_rtos_mpmc_ring_t, a bounded ring that several tasks,
+ * interrupts and cores push to and pop from without a shared lock.
+ * Can be overridden via CMake: -DPICO_RTOS_ENABLE_MPMC_RINGS=OFF
+ */
+#ifndef PICO_RTOS_ENABLE_MPMC_RINGS
+#define PICO_RTOS_ENABLE_MPMC_RINGS 1
+#endif
+
+/**
+ * @brief Build the kernel without dynamic allocation
+ * 
+ * Removes pico_rtos_malloc(), pico_rtos_free(), the real-time heap and
+ * every create/init function that allocates, leaving only the _static
+ * variants that take caller-provided control block, stack and wait list
+ * storage. Kernel tasks and queues always use static storage.
+ * Can be overridden via CMake: -DPICO_RTOS_STATIC_ALLOCATION_ONLY=ON
+ */
+#ifndef PICO_RTOS_STATIC_ALLOCATION_ONLY
+#define PICO_RTOS_STATIC_ALLOCATION_ONLY 0
+#endif
+
+/**
+ * @brief Enable the real-time heap
+ * 
+ * Serves pico_rtos_malloc() and pico_rtos_free(), and so task stacks, from
+ * a Two-Level Segregated Fit allocator over a static region instead of
+ * the C library heap. Allocation and free take bounded time.
+ * Can be overridden via CMake: -DPICO_RTOS_ENABLE_HEAP=OFF
+ */
+#ifndef PICO_RTOS_ENABLE_HEAP
+#define PICO_RTOS_ENABLE_HEAP 1
+#endif
+
+/**
+ * @brief Size of the real-time heap region in bytes
+ * 
+ * Each block costs a small header on top of its size. At most 256 KB.
+ */
+#ifndef PICO_RTOS_HEAP_SIZE
+#define PICO_RTOS_HEAP_SIZE 65536
+#endif
+
+#if PICO_RTOS_STATIC_ALLOCATION_ONLY
+#undef PICO_RTOS_ENABLE_HEAP
+#define PICO_RTOS_ENABLE_HEAP 0
+#endif
+
 /**
  * @brief Default task stack size in bytes
  * 
@@ -257,6 +528,14 @@
 #error "PICO_RTOS_IDLE_TASK_STACK_SIZE must be at least 32 words (128 bytes)"
 #endif
 
+#if PICO_RTOS_PRIORITY_LEVELS < 1 || PICO_RTOS_PRIORITY_LEVELS > 1024
+#error "PICO_RTOS_PRIORITY_LEVELS must be between 1 and 1024"
+#endif
+
+#if PICO_RTOS_ENABLE_EDF_SCHEDULING && (PICO_RTOS_EDF_PRIORITY < 1 || PICO_RTOS_EDF_PRIORITY >= PICO_RTOS_PRIORITY_LEVELS)
+#error "PICO_RTOS_EDF_PRIORITY must be between 1 and PICO_RTOS_PRIORITY_LEVELS - 1"
+#endif
+
 #if PICO_RTOS_DEFAULT_TASK_STACK_SIZE < 256
 #error "PICO_RTOS_DEFAULT_TASK_STACK_SIZE must be at least 256 bytes"
 #endif
@@ -101,4 +101,35 @@ void pico_rtos_perform_context_switch(pico_rtos_task_t *current, pico_rtos_task_
  */
 void pico_rtos_context_switch_init(void);
 
+/**
+ * @brief Valid bits of pico_rtos_port_get_cycle_count()
+ * 
+ * The RP2040 SysTick counter is 24 bits wide; the host counter is 32 bits.
+ */
+#ifdef PICO_RTOS_HOST_PORT
+#define PICO_RTOS_PORT_CYCLE_COUNTER_MASK 0xFFFFFFFFu
+#else
+#define PICO_RTOS_PORT_CYCLE_COUNTER_MASK 0x00FFFFFFu
+#endif
+
+/**
+ * @brief Read the free-running cycle counter used for kernel statistics
+ * 
+ * Counts up; intervals are (end - start) & PICO_RTOS_PORT_CYCLE_COUNTER_MASK.
+ * CPU cycles on RP2040, nanoseconds on the host simulator.
+ * 
+ * @return Current counter value
+ */
+uint32_t pico_rtos_port_get_cycle_count(void);
+
+#ifdef PICO_RTOS_HOST_PORT
+/**
+ * @brief Return from pico_rtos_start() to its caller (host simulator only)
+ * 
+ * Called by the idle task once no application task is left, so that host
+ * test programs can report their results and exit.
+ */
+void pico_rtos_port_stop_scheduler(void);
+#endif
+
 #endif // PICO_RTOS_CONTEXT_SWITCH_H
\ No newline at end of file
@@ -0,0 +1,100 @@
+#ifndef PICO_RTOS_DEFERRED_H
+#define PICO_RTOS_DEFERRED_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico_rtos/config.h"
+#include "pico_rtos/task.h"
+
+/**
+ * @file deferred.h
+ * @brief Deferred interrupt work
+ *
+ * Interrupt handlers hand work to a kernel worker task by queueing a
+ * function and its argument; the handler returns straight away and the
+ * function runs later in task context, where it may take as long as it
+ * needs and use blocking calls. Queueing is a handful of stores into a
+ * fixed ring with interrupts masked; the worker is woken only when the
+ * ring goes from empty to non-empty and then runs everything queued in
+ * one batch.
+ */
+
+#if PICO_RTOS_ENABLE_DEFERRED_WORK
+
+/**
+ * @brief Function run by the deferred work task
+ */
+typedef void (*pico_rtos_deferred_function_t)(void *param);
+
+/**
+ * @brief Deferred work statistics
+ *
+ * Latencies are measured from the call that queued an item to the moment
+ * its function starts, with pico_rtos_port_get_cycle_count(): CPU cycles
+ * on RP2040, nanoseconds on the host simulator.
+ */
+typedef struct {
+    uint32_t queued;                   ///< Items accepted into the queue
+    uint32_t processed;                ///< Items whose function has run
+    uint32_t dropped;                  ///< Items rejected because the queue was full
+    uint32_t batches;                  ///< Times the worker woke and drained the queue
+    uint32_t max_depth;                ///< Most items ever waiting at once
+    uint32_t last_latency_cycles;      ///< Latency of the most recent item
+    uint32_t max_latency_cycles;       ///< Longest latency seen
+    uint32_t average_latency_cycles;   ///< Mean latency over all processed items
+} pico_rtos_deferred_stats_t;
+
+/**
+ * @brief Queue a function to run in the deferred work task
+ *
+ * Safe to call from interrupt handlers and tasks. Items run in the order
+ * they were queued.
+ *
+ * @param function Function to run
+ * @param param Argument passed to the function
+ * @return true if the item was queued, false if the queue is full or
+ *         function is NULL
+ */
+bool pico_rtos_defer_from_isr(pico_rtos_deferred_function_t function, void *param);
+
+/**
+ * @brief Queue a function to run in the deferred work task from a task
+ *
+ * Same as pico_rtos_defer_from_isr().
+ *
+ * @param function Function to run
+ * @param param Argument passed to the function
+ * @return true if the item was queued, false if the queue is full or
+ *         function is NULL
+ */
+bool pico_rtos_defer(pico_rtos_deferred_function_t function, void *param);
+
+/**
+ * @brief Get the number of items waiting for the deferred work task
+ *
+ * @return Items queued but not yet started
+ */
+uint32_t pico_rtos_deferred_get_pending(void);
+
+/**
+ * @brief Get deferred work statistics
+ *
+ * @param stats Structure to fill
+ */
+void pico_rtos_deferred_get_stats(pico_rtos_deferred_stats_t *stats);
+
+/**
+ * @brief Reset deferred work statistics
+ */
+void pico_rtos_deferred_reset_stats(void);
+
+/**
+ * @brief Get the deferred work task
+ *
+ * @return Pointer to the kernel task that runs deferred work
+ */
+pico_rtos_task_t *pico_rtos_deferred_get_task(void);
+
+#endif // PICO_RTOS_ENABLE_DEFERRED_WORK
+
+#endif // PICO_RTOS_DEFERRED_H
@@ -59,6 +59,7 @@ typedef enum {
     PICO_RTOS_ERROR_MUTEX_TIMEOUT = 300,
     PICO_RTOS_ERROR_MUTEX_NOT_OWNED = 301,
     PICO_RTOS_ERROR_MUTEX_RECURSIVE_LOCK = 302,
+    PICO_RTOS_ERROR_MUTEX_CEILING_VIOLATION = 303,
     PICO_RTOS_ERROR_SEMAPHORE_TIMEOUT = 310,
     PICO_RTOS_ERROR_SEMAPHORE_OVERFLOW = 311,
     PICO_RTOS_ERROR_SEMAPHORE_INVALID_COUNT = 312,
@@ -73,6 +74,12 @@ typedef enum {
     PICO_RTOS_ERROR_EVENT_GROUP_INVALID = 340,
     PICO_RTOS_ERROR_EVENT_GROUP_TIMEOUT = 341,
     PICO_RTOS_ERROR_EVENT_GROUP_DELETED = 342,
+    PICO_RTOS_ERROR_RWLOCK_TIMEOUT = 350,
+    PICO_RTOS_ERROR_RWLOCK_NOT_HELD = 351,
+    PICO_RTOS_ERROR_RWLOCK_WOULD_DEADLOCK = 352,
+    PICO_RTOS_ERROR_QUEUE_SET_TIMEOUT = 360,
+    PICO_RTOS_ERROR_QUEUE_SET_ALREADY_MEMBER = 361,
+    PICO_RTOS_ERROR_QUEUE_SET_NOT_MEMBER = 362,
     
     // System errors (400-499)
     PICO_RTOS_ERROR_SYSTEM_NOT_INITIALIZED = 400,
@@ -5,6 +5,7 @@
 #include <stdbool.h>
 #include "pico/critical_section.h"
 #include "types.h"
+#include "config.h"
 
 /**
  * @file event_group.h
@@ -74,6 +75,9 @@ typedef struct {
     uint32_t total_sets;                    ///< Statistics: total set operations
     uint32_t total_clears;                  ///< Statistics: total clear operations
     uint32_t total_waits;                   ///< Statistics: total wait operations
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    pico_rtos_queue_set_member_t set_member; ///< Queue set the event group is in
+#endif
 } pico_rtos_event_group_t;
 
 /**
@@ -104,8 +108,22 @@ typedef struct {
  * @return true if initialization was successful, false otherwise
  * 
  * @note This function is thread-safe and can be called from any context
+ * @note Allocates the event group's wait list with pico_rtos_malloc()
  */
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
 bool pico_rtos_event_group_init(pico_rtos_event_group_t *event_group);
+#endif
+
+/**
+ * @brief Initialize an event group without allocating
+ * 
+ * @param event_group Pointer to event group structure to initialize
+ * @param wait_storage Storage for the event group's wait list; must stay
+ *                     valid until the event group is deleted
+ * @return true if initialization was successful, false otherwise
+ */
+bool pico_rtos_event_group_init_static(pico_rtos_event_group_t *event_group,
+                                       struct pico_rtos_block_object *wait_storage);
 
 /**
  * @brief Set event bits in an event group
@@ -0,0 +1,128 @@
+#ifndef PICO_RTOS_HEAP_H
+#define PICO_RTOS_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico_rtos/config.h"
+
+/**
+ * @file heap.h
+ * @brief Real-time heap
+ *
+ * A Two-Level Segregated Fit allocator over a static region of
+ * PICO_RTOS_HEAP_SIZE bytes. Free blocks are kept in lists by size class:
+ * a first level per power of two and 16 linear steps within each, with a
+ * bitmap per level. Allocation finds a list that is certain to fit with
+ * two bit scans, and free merges with both neighbours in place, so both
+ * take the same bounded time however many blocks exist.
+ * pico_rtos_malloc() and pico_rtos_free() allocate from this heap.
+ */
+
+#if PICO_RTOS_ENABLE_HEAP
+
+/**
+ * @brief Number of size classes reported by pico_rtos_heap_get_class_stats()
+ *
+ * Class 0 holds blocks below 128 bytes; class n holds blocks from
+ * 64 << n up to (but not including) 128 << n bytes.
+ */
+#define PICO_RTOS_HEAP_CLASS_COUNT 12
+
+/**
+ * @brief Alignment of every block returned by the heap
+ */
+#define PICO_RTOS_HEAP_ALIGNMENT 8
+
+/**
+ * @brief Heap statistics
+ *
+ * Sizes are in bytes of usable block space; the per-block header is not
+ * counted as used or free.
+ */
+typedef struct {
+    uint32_t heap_size;               ///< Size of the heap region
+    uint32_t used_bytes;              ///< Space in allocated blocks
+    uint32_t free_bytes;              ///< Space in free blocks
+    uint32_t peak_used_bytes;         ///< Highest used_bytes seen
+    uint32_t largest_free_block;      ///< Largest single allocation that would succeed
+    uint32_t used_blocks;             ///< Allocated blocks
+    uint32_t free_blocks;             ///< Free blocks
+    uint32_t allocations;             ///< Successful allocations
+    uint32_t frees;                   ///< Blocks freed
+    uint32_t failed_allocations;      ///< Allocations that found no block
+    uint32_t fragmentation_percent;   ///< Share of free space outside the largest free block
+} pico_rtos_heap_stats_t;
+
+/**
+ * @brief Statistics for one size class
+ */
+typedef struct {
+    uint32_t min_size;       ///< Smallest block size in the class
+    uint32_t max_size;       ///< Largest block size in the class
+    uint32_t allocations;    ///< Blocks of this class handed out so far
+    uint32_t used_blocks;    ///< Blocks of this class currently allocated
+    uint32_t free_blocks;    ///< Blocks of this class currently free
+} pico_rtos_heap_class_stats_t;
+
+/**
+ * @brief Allocate a block from the heap
+ *
+ * Runs in bounded time. Safe to call from tasks and interrupt handlers.
+ *
+ * @param size Bytes needed
+ * @return Block aligned to PICO_RTOS_HEAP_ALIGNMENT, or NULL if size is 0
+ *         or no free block is large enough
+ */
+void *pico_rtos_heap_alloc(size_t size);
+
+/**
+ * @brief Return a block to the heap
+ *
+ * Runs in bounded time. Pointers that were not returned by
+ * pico_rtos_heap_alloc(), and blocks that are already free, are reported
+ * as errors and ignored.
+ *
+ * @param ptr Block to free, or NULL
+ * @return true if the block was freed or ptr is NULL, false if it was
+ *         rejected
+ */
+bool pico_rtos_heap_free(void *ptr);
+
+/**
+ * @brief Get the usable size of an allocated block
+ *
+ * @param ptr Block returned by pico_rtos_heap_alloc()
+ * @return Usable bytes, at least the size requested; 0 for an invalid pointer
+ */
+size_t pico_rtos_heap_block_size(void *ptr);
+
+/**
+ * @brief Get heap statistics
+ *
+ * @param stats Structure to fill
+ */
+void pico_rtos_heap_get_stats(pico_rtos_heap_stats_t *stats);
+
+/**
+ * @brief Get statistics for one size class
+ *
+ * @param class_index Class from 0 to PICO_RTOS_HEAP_CLASS_COUNT - 1
+ * @param stats Structure to fill
+ * @return false if class_index is out of range or stats is NULL
+ */
+bool pico_rtos_heap_get_class_stats(uint32_t class_index, pico_rtos_heap_class_stats_t *stats);
+
+/**
+ * @brief Check the heap's internal consistency
+ *
+ * Walks every block, so it takes time proportional to the number of
+ * blocks; meant for tests and debugging.
+ *
+ * @return true if block headers, neighbour links and free lists agree
+ */
+bool pico_rtos_heap_check(void);
+
+#endif // PICO_RTOS_ENABLE_HEAP
+
+#endif // PICO_RTOS_HEAP_H
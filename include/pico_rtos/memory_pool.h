@@ -126,11 +126,30 @@ typedef struct {
  * 
  * @note The actual block size may be larger than requested due to alignment
  * @note The memory region must remain valid for the lifetime of the pool
+ * @note Allocates the pool's wait list with pico_rtos_malloc()
  */
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
 bool pico_rtos_memory_pool_init(pico_rtos_memory_pool_t *pool, 
                                void *memory, 
                                uint32_t block_size, 
                                uint32_t block_count);
+#endif
+
+/**
+ * @brief Initialize a memory pool without allocating
+ * 
+ * @param pool Pointer to memory pool structure to initialize
+ * @param memory Pointer to memory region for the pool
+ * @param block_size Size of each block in bytes (will be aligned)
+ * @param block_count Number of blocks to create in the pool
+ * @param wait_storage Storage for the list of tasks waiting for a block
+ * @return true if initialization successful, false otherwise
+ */
+bool pico_rtos_memory_pool_init_static(pico_rtos_memory_pool_t *pool,
+                                      void *memory,
+                                      uint32_t block_size,
+                                      uint32_t block_count,
+                                      struct pico_rtos_block_object *wait_storage);
 
 /**
  * @brief Allocate a block from the memory pool
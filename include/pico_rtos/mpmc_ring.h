@@ -0,0 +1,205 @@
+#ifndef PICO_RTOS_MPMC_RING_H
+#define PICO_RTOS_MPMC_RING_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include "pico_rtos/config.h"
+#include "pico_rtos/task.h"
+#include "hardware/sync.h"
+
+// Forward declare the blocking object structure
+struct pico_rtos_block_object;
+
+// Producers and consumers each update their own position. On the host the
+// two are kept a cache line apart so they do not bounce one line between
+// threads; the RP2040 has no data cache and stripes SRAM across banks by
+// word, so a word apart is enough there
+#ifdef PICO_RTOS_HOST_PORT
+#define PICO_RTOS_MPMC_RING_PAD 64
+#else
+#define PICO_RTOS_MPMC_RING_PAD 4
+#endif
+
+/**
+ * @brief Bytes one slot takes: a sequence word, then the item rounded up
+ *        to whole words
+ */
+#define PICO_RTOS_MPMC_RING_SLOT_SIZE(item_size) \
+    (sizeof(uint32_t) + (((item_size) + sizeof(uint32_t) - 1) & ~(sizeof(uint32_t) - 1)))
+
+/**
+ * @brief Words of buffer a ring of capacity items of item_size bytes needs
+ */
+#define PICO_RTOS_MPMC_RING_BUFFER_WORDS(item_size, capacity) \
+    ((PICO_RTOS_MPMC_RING_SLOT_SIZE(item_size) / sizeof(uint32_t)) * (capacity))
+
+/**
+ * @brief Contention statistics of a ring
+ */
+typedef struct {
+    uint32_t pushes;          ///< Items pushed
+    uint32_t pops;            ///< Items popped
+    uint32_t push_retries;    ///< Times a producer lost a slot to another and tried the next
+    uint32_t pop_retries;     ///< Times a consumer lost a slot to another and tried the next
+    uint32_t push_full;       ///< Pushes that found the ring full
+    uint32_t pop_empty;       ///< Pops that found the ring empty
+} pico_rtos_mpmc_ring_stats_t;
+
+typedef struct {
+    uint8_t *slots;                                   // capacity slots of slot_size bytes
+    uint32_t slot_size;
+    uint32_t item_size;
+    uint32_t mask;                                    // capacity - 1
+    struct pico_rtos_block_object *push_block_obj;    // For tasks blocked trying to push
+    struct pico_rtos_block_object *pop_block_obj;     // For tasks blocked trying to pop
+    uint32_t stats_push_base;                         // Positions at the last statistics reset
+    uint32_t stats_pop_base;
+#ifndef PICO_RTOS_HOST_PORT
+    spin_lock_t *cas_lock;                            // Guards compare-and-swap on the RP2040
+    bool cas_lock_claimed;                            // Claimed for this ring, not a striped lock
+#endif
+
+    // Written by producers only
+    volatile uint32_t push_pos __attribute__((aligned(PICO_RTOS_MPMC_RING_PAD)));
+    volatile uint32_t push_retries;
+    volatile uint32_t push_full;
+
+    // Written by consumers only
+    volatile uint32_t pop_pos __attribute__((aligned(PICO_RTOS_MPMC_RING_PAD)));
+    volatile uint32_t pop_retries;
+    volatile uint32_t pop_empty;
+} pico_rtos_mpmc_ring_t;
+
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+/**
+ * @brief Initialize a multi-producer/multi-consumer ring
+ *
+ * Any number of tasks, interrupts and cores may push and pop at once.
+ * Each slot carries a sequence number that says whether it is free or
+ * full for the current lap, so a push or pop claims its slot with one
+ * compare-and-swap on its position and copies the item without a lock.
+ * Allocates the ring's two wait lists with pico_rtos_malloc(). On the
+ * RP2040 the ring also claims a hardware spinlock for its compare-and-swap
+ * until it is deleted, or shares a striped one once none are free.
+ *
+ * @param ring Pointer to ring structure
+ * @param buffer Word-aligned buffer of
+ *               PICO_RTOS_MPMC_RING_BUFFER_WORDS(item_size, capacity) words
+ * @param item_size Size of each item in bytes
+ * @param capacity Number of slots; a power of two of at least 2
+ * @return true if initialized successfully, false otherwise
+ */
+bool pico_rtos_mpmc_ring_init(pico_rtos_mpmc_ring_t *ring, void *buffer, size_t item_size, size_t capacity);
+#endif
+
+/**
+ * @brief Initialize a multi-producer/multi-consumer ring without allocating
+ *
+ * @param ring Pointer to ring structure
+ * @param buffer Word-aligned buffer of
+ *               PICO_RTOS_MPMC_RING_BUFFER_WORDS(item_size, capacity) words
+ * @param item_size Size of each item in bytes
+ * @param capacity Number of slots; a power of two of at least 2
+ * @param push_wait_storage Storage for the list of tasks waiting to push
+ * @param pop_wait_storage Storage for the list of tasks waiting to pop
+ * @return true if initialized successfully, false otherwise
+ */
+bool pico_rtos_mpmc_ring_init_static(pico_rtos_mpmc_ring_t *ring, void *buffer, size_t item_size, size_t capacity,
+                                     pico_rtos_block_object_t *push_wait_storage,
+                                     pico_rtos_block_object_t *pop_wait_storage);
+
+/**
+ * @brief Push an item if there is room
+ *
+ * Never waits. Wakes a task waiting in pico_rtos_mpmc_ring_pop() if
+ * there is one; with no task waiting it makes no kernel call. From an
+ * interrupt, call it between pico_rtos_interrupt_enter() and
+ * pico_rtos_interrupt_exit() so the switch to a woken task waits for the
+ * interrupt to return.
+ *
+ * @param ring Pointer to ring structure
+ * @param item Pointer to the item to push
+ * @return true if pushed, false if the ring is full
+ */
+bool pico_rtos_mpmc_ring_try_push(pico_rtos_mpmc_ring_t *ring, const void *item);
+
+/**
+ * @brief Pop the oldest item if there is one
+ *
+ * Never waits. Wakes a task waiting in pico_rtos_mpmc_ring_push() if
+ * there is one. From an interrupt, call it as pico_rtos_mpmc_ring_try_push().
+ *
+ * @param ring Pointer to ring structure
+ * @param item Pointer to store the item
+ * @return true if popped, false if the ring is empty
+ */
+bool pico_rtos_mpmc_ring_try_pop(pico_rtos_mpmc_ring_t *ring, void *item);
+
+/**
+ * @brief Push an item, waiting for room
+ *
+ * Tries without a lock first and joins the ring's wait list only while
+ * the ring is full. Only tasks can wait; from an interrupt use
+ * pico_rtos_mpmc_ring_try_push().
+ *
+ * @param ring Pointer to ring structure
+ * @param item Pointer to the item to push
+ * @param timeout Timeout in milliseconds, PICO_RTOS_WAIT_FOREVER to wait
+ *                forever, or PICO_RTOS_NO_WAIT for immediate return
+ * @return true if pushed, false if timeout occurred
+ */
+bool pico_rtos_mpmc_ring_push(pico_rtos_mpmc_ring_t *ring, const void *item, uint32_t timeout);
+
+/**
+ * @brief Pop the oldest item, waiting for one
+ *
+ * @param ring Pointer to ring structure
+ * @param item Pointer to store the item
+ * @param timeout Timeout in milliseconds, PICO_RTOS_WAIT_FOREVER to wait
+ *                forever, or PICO_RTOS_NO_WAIT for immediate return
+ * @return true if popped, false if timeout occurred
+ */
+bool pico_rtos_mpmc_ring_pop(pico_rtos_mpmc_ring_t *ring, void *item, uint32_t timeout);
+
+/**
+ * @brief Get the number of items in a ring
+ *
+ * With pushes and pops running at the same time the count is only a
+ * snapshot.
+ *
+ * @param ring Pointer to ring structure
+ * @return Number of items
+ */
+uint32_t pico_rtos_mpmc_ring_get_count(pico_rtos_mpmc_ring_t *ring);
+
+/**
+ * @brief Get the contention statistics of a ring
+ *
+ * @param ring Pointer to ring structure
+ * @param stats Filled with the counts since initialization or the last reset
+ * @return true if the statistics were read, false for a NULL argument
+ */
+bool pico_rtos_mpmc_ring_get_stats(pico_rtos_mpmc_ring_t *ring, pico_rtos_mpmc_ring_stats_t *stats);
+
+/**
+ * @brief Reset the contention statistics of a ring
+ *
+ * Call while no push or pop is running, or counts made meanwhile may be
+ * lost.
+ *
+ * @param ring Pointer to ring structure
+ */
+void pico_rtos_mpmc_ring_reset_stats(pico_rtos_mpmc_ring_t *ring);
+
+/**
+ * @brief Delete a ring
+ *
+ * Waiting tasks wake and their push or pop fails. No push or pop may be
+ * running on another core or thread.
+ *
+ * @param ring Pointer to ring structure
+ */
+void pico_rtos_mpmc_ring_delete(pico_rtos_mpmc_ring_t *ring);
+
+#endif // PICO_RTOS_MPMC_RING_H
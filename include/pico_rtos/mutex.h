@@ -8,24 +8,76 @@
 // Forward declare the blocking object structure
 struct pico_rtos_block_object;
 
-typedef struct {
+typedef struct pico_rtos_mutex {
     pico_rtos_task_t *owner;
     uint32_t lock_count;
     critical_section_t cs;
     struct pico_rtos_block_object *block_obj;
+    uint32_t ceiling;                   // Ceiling priority, 0 for priority inheritance
+    struct pico_rtos_mutex *held_next;  // Next mutex in the owner's held list
 } pico_rtos_mutex_t;
 
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
 /**
  * @brief Initialize a mutex
  * 
+ * Allocates the mutex's wait list with pico_rtos_malloc().
+ * 
  * @param mutex Pointer to mutex structure
  * @return true if initialization was successful, false otherwise
  */
 bool pico_rtos_mutex_init(pico_rtos_mutex_t *mutex);
+#endif
+
+/**
+ * @brief Initialize a mutex without allocating
+ * 
+ * @param mutex Pointer to mutex structure
+ * @param wait_storage Storage for the mutex's wait list; must stay valid
+ *                     until the mutex is deleted
+ * @return true if initialization was successful, false otherwise
+ */
+bool pico_rtos_mutex_init_static(pico_rtos_mutex_t *mutex, pico_rtos_block_object_t *wait_storage);
+
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+/**
+ * @brief Initialize a priority-ceiling mutex
+ * 
+ * A task that acquires the mutex runs at the ceiling priority at once and
+ * returns to its previous priority when it releases it (immediate priority
+ * ceiling protocol). Set the ceiling to the highest priority of any task
+ * that locks the mutex: no such task can then preempt the owner to contend
+ * for it, so a locker blocks at most once per critical section and the
+ * owner never needs to inherit a waiter's priority. Tasks whose base
+ * priority is above the ceiling are refused the lock.
+ * 
+ * Allocates the mutex's wait list with pico_rtos_malloc().
+ * 
+ * @param mutex Pointer to mutex structure
+ * @param ceiling Ceiling priority, at least 1
+ * @return true if initialization was successful, false otherwise
+ */
+bool pico_rtos_mutex_init_ceiling(pico_rtos_mutex_t *mutex, uint32_t ceiling);
+#endif
+
+/**
+ * @brief Initialize a priority-ceiling mutex without allocating
+ * 
+ * @param mutex Pointer to mutex structure
+ * @param ceiling Ceiling priority, at least 1
+ * @param wait_storage Storage for the mutex's wait list; must stay valid
+ *                     until the mutex is deleted
+ * @return true if initialization was successful, false otherwise
+ */
+bool pico_rtos_mutex_init_ceiling_static(pico_rtos_mutex_t *mutex, uint32_t ceiling,
+                                         pico_rtos_block_object_t *wait_storage);
 
 /**
  * @brief Acquire a mutex lock
  * 
+ * Fails with PICO_RTOS_ERROR_MUTEX_CEILING_VIOLATION if the mutex has a
+ * ceiling below the calling task's base priority.
+ * 
  * @param mutex Pointer to mutex structure
  * @param timeout Timeout in milliseconds, PICO_RTOS_WAIT_FOREVER to wait
  *                forever, or PICO_RTOS_NO_WAIT for immediate return
@@ -15,17 +15,24 @@ typedef struct {
     void *buffer;
     size_t item_size;
     size_t max_items;
-    size_t head;
-    size_t tail;
-    size_t count;
+    volatile size_t head;                             // Written only by the receiver in SPSC mode
+    volatile size_t tail;                             // Written only by the sender in SPSC mode
+    size_t count;                                     // Unused in SPSC mode
+    bool spsc;                                        // Single-producer/single-consumer mode
     critical_section_t cs;
     struct pico_rtos_block_object *send_block_obj;    // For tasks blocked trying to send
     struct pico_rtos_block_object *receive_block_obj; // For tasks blocked trying to receive
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    pico_rtos_queue_set_member_t set_member;          // Queue set the queue is in
+#endif
 } pico_rtos_queue_t;
 
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
 /**
  * @brief Initialize a queue
  * 
+ * Allocates the queue's two wait lists with pico_rtos_malloc().
+ * 
  * @param queue Pointer to queue structure
  * @param buffer Buffer to store queue items
  * @param item_size Size of each item in bytes
@@ -33,6 +40,59 @@ typedef struct {
  * @return true if initialized successfully, false otherwise
  */
 bool pico_rtos_queue_init(pico_rtos_queue_t *queue, void *buffer, size_t item_size, size_t max_items);
+#endif
+
+/**
+ * @brief Initialize a queue without allocating
+ * 
+ * @param queue Pointer to queue structure
+ * @param buffer Buffer to store queue items
+ * @param item_size Size of each item in bytes
+ * @param max_items Maximum number of items in the queue
+ * @param send_wait_storage Storage for the list of tasks waiting to send
+ * @param receive_wait_storage Storage for the list of tasks waiting to receive
+ * @return true if initialized successfully, false otherwise
+ */
+bool pico_rtos_queue_init_static(pico_rtos_queue_t *queue, void *buffer, size_t item_size, size_t max_items,
+                                 pico_rtos_block_object_t *send_wait_storage,
+                                 pico_rtos_block_object_t *receive_wait_storage);
+
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+/**
+ * @brief Initialize a single-producer/single-consumer queue
+ * 
+ * For a queue with exactly one sending task or interrupt and exactly one
+ * receiving task. Sends and receives then take no lock: the sender owns
+ * the tail index and the receiver the head, and memory barriers order
+ * each side's copy against publishing its index. A side touches the
+ * queue's wait lists only when it has to sleep or the other side is
+ * asleep. The usual queue calls, batched calls and queue sets all work
+ * on it; a second sender or receiver is not detected and corrupts the
+ * queue. Allocates the two wait lists with pico_rtos_malloc().
+ * 
+ * @param queue Pointer to queue structure
+ * @param buffer Buffer to store queue items
+ * @param item_size Size of each item in bytes
+ * @param max_items Maximum number of items in the queue
+ * @return true if initialized successfully, false otherwise
+ */
+bool pico_rtos_queue_init_spsc(pico_rtos_queue_t *queue, void *buffer, size_t item_size, size_t max_items);
+#endif
+
+/**
+ * @brief Initialize a single-producer/single-consumer queue without allocating
+ * 
+ * @param queue Pointer to queue structure
+ * @param buffer Buffer to store queue items
+ * @param item_size Size of each item in bytes
+ * @param max_items Maximum number of items in the queue
+ * @param send_wait_storage Storage for the sender's wait list
+ * @param receive_wait_storage Storage for the receiver's wait list
+ * @return true if initialized successfully, false otherwise
+ */
+bool pico_rtos_queue_init_spsc_static(pico_rtos_queue_t *queue, void *buffer, size_t item_size, size_t max_items,
+                                      pico_rtos_block_object_t *send_wait_storage,
+                                      pico_rtos_block_object_t *receive_wait_storage);
 
 /**
  * @brief Send an item to the queue
@@ -45,6 +105,37 @@ bool pico_rtos_queue_init(pico_rtos_queue_t *queue, void *buffer, size_t item_si
  */
 bool pico_rtos_queue_send(pico_rtos_queue_t *queue, const void *item, uint32_t timeout);
 
+/**
+ * @brief Send an item to the queue from an interrupt
+ * 
+ * Never waits and never switches tasks. If a task waiting to receive was
+ * made ready, *task_woken is set to true (it is not cleared otherwise);
+ * the caller then asks for the switch, typically with
+ * pico_rtos_request_context_switch() before pico_rtos_interrupt_exit().
+ * 
+ * @param queue Pointer to queue structure
+ * @param item Pointer to the item to send
+ * @param task_woken Set to true if a task was woken; may be NULL
+ * @return true if item was sent, false if the queue was full
+ */
+bool pico_rtos_queue_send_from_isr(pico_rtos_queue_t *queue, const void *item, bool *task_woken);
+
+/**
+ * @brief Send several items to the queue at once
+ * 
+ * Copies as many of the items as there is room for under one lock, and
+ * wakes a waiting receiver per item copied. Waits only while the queue is
+ * completely full; call again with the rest if fewer were sent.
+ * 
+ * @param queue Pointer to queue structure
+ * @param items Array of count items
+ * @param count Number of items to send
+ * @param timeout Timeout in milliseconds, PICO_RTOS_WAIT_FOREVER to wait
+ *                forever, or PICO_RTOS_NO_WAIT for immediate return
+ * @return Number of items sent, 0 if timeout occurred
+ */
+size_t pico_rtos_queue_send_many(pico_rtos_queue_t *queue, const void *items, size_t count, uint32_t timeout);
+
 /**
  * @brief Receive an item from the queue
  * 
@@ -56,6 +147,22 @@ bool pico_rtos_queue_send(pico_rtos_queue_t *queue, const void *item, uint32_t t
  */
 bool pico_rtos_queue_receive(pico_rtos_queue_t *queue, void *item, uint32_t timeout);
 
+/**
+ * @brief Receive several items from the queue at once
+ * 
+ * Copies out as many items as are queued, up to max_count, under one lock,
+ * and wakes a waiting sender per item taken. Waits only while the queue is
+ * empty.
+ * 
+ * @param queue Pointer to queue structure
+ * @param items Array with room for max_count items
+ * @param max_count Most items to receive
+ * @param timeout Timeout in milliseconds, PICO_RTOS_WAIT_FOREVER to wait
+ *                forever, or PICO_RTOS_NO_WAIT for immediate return
+ * @return Number of items received, 0 if timeout occurred
+ */
+size_t pico_rtos_queue_receive_many(pico_rtos_queue_t *queue, void *items, size_t max_count, uint32_t timeout);
+
 /**
  * @brief Check if a queue is empty
  * 
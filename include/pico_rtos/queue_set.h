@@ -0,0 +1,156 @@
+#ifndef PICO_RTOS_QUEUE_SET_H
+#define PICO_RTOS_QUEUE_SET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico_rtos/task.h"
+#include "pico_rtos/queue.h"
+#include "pico_rtos/semaphore.h"
+#include "pico/critical_section.h"
+
+#ifdef PICO_RTOS_ENABLE_EVENT_GROUPS
+#include "pico_rtos/event_group.h"
+#endif
+
+#ifdef PICO_RTOS_ENABLE_STREAM_BUFFERS
+#include "pico_rtos/stream_buffer.h"
+#endif
+
+// Forward declare the blocking object structure
+struct pico_rtos_block_object;
+
+typedef struct pico_rtos_queue_set {
+    pico_rtos_queue_set_member_t *members;      // Members, most recently added first
+    pico_rtos_queue_set_member_t *next_scan;    // Member the next select checks first, or NULL for the head
+    uint32_t member_count;
+    critical_section_t cs;
+    struct pico_rtos_block_object *block_obj;   // Tasks waiting in select
+} pico_rtos_queue_set_t;
+
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+/**
+ * @brief Initialize a queue set
+ *
+ * Allocates the set's wait list with pico_rtos_malloc().
+ *
+ * @param set Pointer to queue set structure
+ * @return true if initialization was successful, false otherwise
+ */
+bool pico_rtos_queue_set_init(pico_rtos_queue_set_t *set);
+#endif
+
+/**
+ * @brief Initialize a queue set without allocating
+ *
+ * @param set Pointer to queue set structure
+ * @param wait_storage Storage for the set's wait list; must stay valid
+ *                     until the set is deleted
+ * @return true if initialization was successful, false otherwise
+ */
+bool pico_rtos_queue_set_init_static(pico_rtos_queue_set_t *set, pico_rtos_block_object_t *wait_storage);
+
+/**
+ * @brief Add a queue to a set
+ *
+ * The queue is ready while it holds at least one item. An object belongs
+ * to at most one set; the link is stored in the object, so adding never
+ * allocates and a set has no size limit.
+ *
+ * @param set Pointer to queue set structure
+ * @param queue Queue to add
+ * @return true if added, false if the queue is already in a set
+ */
+bool pico_rtos_queue_set_add_queue(pico_rtos_queue_set_t *set, pico_rtos_queue_t *queue);
+
+/**
+ * @brief Add a semaphore to a set
+ *
+ * The semaphore is ready while its count is above zero.
+ *
+ * @param set Pointer to queue set structure
+ * @param semaphore Semaphore to add
+ * @return true if added, false if the semaphore is already in a set
+ */
+bool pico_rtos_queue_set_add_semaphore(pico_rtos_queue_set_t *set, pico_rtos_semaphore_t *semaphore);
+
+#ifdef PICO_RTOS_ENABLE_STREAM_BUFFERS
+/**
+ * @brief Add a stream buffer to a set
+ *
+ * The stream buffer is ready while it holds at least one message.
+ *
+ * @param set Pointer to queue set structure
+ * @param stream Stream buffer to add
+ * @return true if added, false if the stream buffer is already in a set
+ */
+bool pico_rtos_queue_set_add_stream_buffer(pico_rtos_queue_set_t *set, pico_rtos_stream_buffer_t *stream);
+#endif
+
+#ifdef PICO_RTOS_ENABLE_EVENT_GROUPS
+/**
+ * @brief Add an event group to a set
+ *
+ * The event group is ready while any of the given bits is set. Select
+ * does not clear them.
+ *
+ * @param set Pointer to queue set structure
+ * @param event_group Event group to add
+ * @param bits Bits that make the event group ready; must not be 0
+ * @return true if added, false if the event group is already in a set
+ */
+bool pico_rtos_queue_set_add_event_group(pico_rtos_queue_set_t *set, pico_rtos_event_group_t *event_group,
+                                         uint32_t bits);
+#endif
+
+/**
+ * @brief Remove an object from a set
+ *
+ * Deleting a queue, semaphore, stream buffer or event group removes it
+ * from its set as well.
+ *
+ * @param set Pointer to queue set structure
+ * @param object Queue, semaphore, stream buffer or event group to remove
+ * @return true if removed, false if the object is not in this set
+ */
+bool pico_rtos_queue_set_remove(pico_rtos_queue_set_t *set, void *object);
+
+/**
+ * @brief Wait until a member of the set is ready
+ *
+ * Returns a member that is ready: a queue or stream buffer with data, a
+ * semaphore that can be taken, or an event group with one of its bits
+ * set. Select does not take anything; the caller then receives from the
+ * returned member with a timeout of 0. Successive calls start checking
+ * after the member returned last, so a busy member cannot hide the rest.
+ * A member that is ready again straight after is returned again, so one
+ * call per item or token is enough. With several tasks selecting on one
+ * set, another task may empty the member first and the call with a
+ * timeout of 0 fails.
+ *
+ * @param set Pointer to queue set structure
+ * @param timeout Timeout in milliseconds, PICO_RTOS_WAIT_FOREVER to wait
+ *                forever, or PICO_RTOS_NO_WAIT for immediate return
+ * @return The ready queue, semaphore, stream buffer or event group, or
+ *         NULL on timeout or error
+ */
+void *pico_rtos_queue_set_select(pico_rtos_queue_set_t *set, uint32_t timeout);
+
+/**
+ * @brief Get the number of objects in a set
+ *
+ * @param set Pointer to queue set structure
+ * @return Number of members
+ */
+uint32_t pico_rtos_queue_set_get_member_count(pico_rtos_queue_set_t *set);
+
+/**
+ * @brief Delete a queue set
+ *
+ * Removes every member from the set. Waiting tasks wake and their select
+ * returns NULL.
+ *
+ * @param set Pointer to queue set structure
+ */
+void pico_rtos_queue_set_delete(pico_rtos_queue_set_t *set);
+
+#endif // PICO_RTOS_QUEUE_SET_H
@@ -0,0 +1,151 @@
+#ifndef PICO_RTOS_RWLOCK_H
+#define PICO_RTOS_RWLOCK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "pico_rtos/task.h"
+#include "pico/critical_section.h"
+
+// Forward declare the blocking object structure
+struct pico_rtos_block_object;
+
+/**
+ * @brief Who goes first when readers and writers contend
+ */
+typedef enum {
+    PICO_RTOS_RWLOCK_PREFER_WRITERS,    ///< New readers wait while a writer waits; writers are handed the lock first
+    PICO_RTOS_RWLOCK_PREFER_READERS     ///< Readers join a read-held lock even if a writer waits
+} pico_rtos_rwlock_policy_t;
+
+typedef struct pico_rtos_rwlock {
+    uint32_t readers;                           // Tasks holding the lock for reading
+    pico_rtos_task_t *writer;                   // Task holding the lock for writing, or NULL
+    pico_rtos_rwlock_policy_t policy;
+    critical_section_t cs;
+    struct pico_rtos_block_object *read_wait;   // Readers waiting for the lock
+    struct pico_rtos_block_object *write_wait;  // Writers waiting for the lock
+    struct pico_rtos_rwlock *held_next;         // Next lock in the writer's held list
+} pico_rtos_rwlock_t;
+
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+/**
+ * @brief Initialize a reader-writer lock
+ *
+ * Allocates the lock's two wait lists with pico_rtos_malloc().
+ *
+ * @param rwlock Pointer to reader-writer lock structure
+ * @param policy Whether waiting writers or arriving readers go first
+ * @return true if initialization was successful, false otherwise
+ */
+bool pico_rtos_rwlock_init(pico_rtos_rwlock_t *rwlock, pico_rtos_rwlock_policy_t policy);
+#endif
+
+/**
+ * @brief Initialize a reader-writer lock without allocating
+ *
+ * @param rwlock Pointer to reader-writer lock structure
+ * @param policy Whether waiting writers or arriving readers go first
+ * @param read_wait_storage Storage for the list of waiting readers
+ * @param write_wait_storage Storage for the list of waiting writers
+ * @return true if initialization was successful, false otherwise
+ */
+bool pico_rtos_rwlock_init_static(pico_rtos_rwlock_t *rwlock, pico_rtos_rwlock_policy_t policy,
+                                  pico_rtos_block_object_t *read_wait_storage,
+                                  pico_rtos_block_object_t *write_wait_storage);
+
+/**
+ * @brief Lock for reading
+ *
+ * Any number of tasks may hold the lock for reading at once. Waits while a
+ * writer holds the lock, and with PICO_RTOS_RWLOCK_PREFER_WRITERS also
+ * while a writer waits for it. A reader that waits raises the writer
+ * holding the lock to its own priority. Read locks do not nest: locking
+ * again for reading can wait behind a writer that waits for the first.
+ *
+ * @param rwlock Pointer to reader-writer lock structure
+ * @param timeout Timeout in milliseconds, PICO_RTOS_WAIT_FOREVER to wait
+ *                forever, or PICO_RTOS_NO_WAIT for immediate return
+ * @return true if the lock was acquired, false on timeout or error
+ */
+bool pico_rtos_rwlock_read_lock(pico_rtos_rwlock_t *rwlock, uint32_t timeout);
+
+/**
+ * @brief Lock for reading without waiting
+ *
+ * @param rwlock Pointer to reader-writer lock structure
+ * @return true if the lock was acquired, false otherwise
+ */
+bool pico_rtos_rwlock_try_read_lock(pico_rtos_rwlock_t *rwlock);
+
+/**
+ * @brief Release a read lock
+ *
+ * The last reader to leave hands the lock to the highest priority waiting
+ * writer.
+ *
+ * @param rwlock Pointer to reader-writer lock structure
+ * @return true if released, false if the lock was not held for reading
+ */
+bool pico_rtos_rwlock_read_unlock(pico_rtos_rwlock_t *rwlock);
+
+/**
+ * @brief Lock for writing
+ *
+ * Waits until no task holds the lock. A task that waits for the lock while
+ * the caller holds it for writing raises the caller to its own priority,
+ * as with a mutex. Readers are not tracked individually and are not
+ * raised. Write locks do not nest.
+ *
+ * @param rwlock Pointer to reader-writer lock structure
+ * @param timeout Timeout in milliseconds, PICO_RTOS_WAIT_FOREVER to wait
+ *                forever, or PICO_RTOS_NO_WAIT for immediate return
+ * @return true if the lock was acquired, false on timeout or error
+ */
+bool pico_rtos_rwlock_write_lock(pico_rtos_rwlock_t *rwlock, uint32_t timeout);
+
+/**
+ * @brief Lock for writing without waiting
+ *
+ * @param rwlock Pointer to reader-writer lock structure
+ * @return true if the lock was acquired, false otherwise
+ */
+bool pico_rtos_rwlock_try_write_lock(pico_rtos_rwlock_t *rwlock);
+
+/**
+ * @brief Release a write lock
+ *
+ * Hands the lock to the highest priority waiting writer if the policy
+ * prefers writers or no reader waits, otherwise to all waiting readers at
+ * once, and drops any priority inherited through it.
+ *
+ * @param rwlock Pointer to reader-writer lock structure
+ * @return true if released, false if the calling task is not the writer
+ */
+bool pico_rtos_rwlock_write_unlock(pico_rtos_rwlock_t *rwlock);
+
+/**
+ * @brief Get the number of tasks holding the lock for reading
+ *
+ * @param rwlock Pointer to reader-writer lock structure
+ * @return Number of readers
+ */
+uint32_t pico_rtos_rwlock_get_readers(pico_rtos_rwlock_t *rwlock);
+
+/**
+ * @brief Get the task holding the lock for writing
+ *
+ * @param rwlock Pointer to reader-writer lock structure
+ * @return Pointer to the writer, or NULL if not write-locked
+ */
+pico_rtos_task_t *pico_rtos_rwlock_get_writer(pico_rtos_rwlock_t *rwlock);
+
+/**
+ * @brief Delete a reader-writer lock
+ *
+ * Waiting tasks wake without the lock.
+ *
+ * @param rwlock Pointer to reader-writer lock structure
+ */
+void pico_rtos_rwlock_delete(pico_rtos_rwlock_t *rwlock);
+
+#endif // PICO_RTOS_RWLOCK_H
@@ -14,17 +14,37 @@ typedef struct {
     uint32_t max_count;
     critical_section_t cs;
     struct pico_rtos_block_object *block_obj;
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    pico_rtos_queue_set_member_t set_member;    // Queue set the semaphore is in
+#endif
 } pico_rtos_semaphore_t;
 
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
 /**
  * @brief Initialize a semaphore
  * 
+ * Allocates the semaphore's wait list with pico_rtos_malloc().
+ * 
  * @param semaphore Pointer to semaphore structure
  * @param initial_count Initial count value (0 for binary semaphore)
  * @param max_count Maximum count value (1 for binary semaphore)
  * @return true if initialized successfully, false otherwise
  */
 bool pico_rtos_semaphore_init(pico_rtos_semaphore_t *semaphore, uint32_t initial_count, uint32_t max_count);
+#endif
+
+/**
+ * @brief Initialize a semaphore without allocating
+ * 
+ * @param semaphore Pointer to semaphore structure
+ * @param initial_count Initial count value (0 for binary semaphore)
+ * @param max_count Maximum count value (1 for binary semaphore)
+ * @param wait_storage Storage for the semaphore's wait list; must stay
+ *                     valid until the semaphore is deleted
+ * @return true if initialized successfully, false otherwise
+ */
+bool pico_rtos_semaphore_init_static(pico_rtos_semaphore_t *semaphore, uint32_t initial_count, uint32_t max_count,
+                                     pico_rtos_block_object_t *wait_storage);
 
 /**
  * @brief Give (increment) a semaphore
@@ -7,6 +7,7 @@
 #include <string.h>
 #include "pico/critical_section.h"
 #include "pico_rtos/types.h"
+#include "pico_rtos/config.h"
 #include "pico_rtos/error.h"
 
 /**
@@ -107,6 +108,10 @@ typedef struct {
     // Configuration flags
     bool wrap_around_enabled;                  ///< Allow buffer wrap-around
     bool overwrite_on_full;                    ///< Overwrite old data when full
+    
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    pico_rtos_queue_set_member_t set_member;   ///< Queue set the stream buffer is in
+#endif
 } pico_rtos_stream_buffer_t;
 
 /**
@@ -160,10 +165,29 @@ typedef struct {
  * 
  * @note The buffer parameter must point to valid memory that remains accessible
  *       for the lifetime of the stream buffer.
+ * @note Allocates the reader and writer wait lists with pico_rtos_malloc().
  */
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
 bool pico_rtos_stream_buffer_init(pico_rtos_stream_buffer_t *stream, 
                                  uint8_t *buffer, 
                                  uint32_t buffer_size);
+#endif
+
+/**
+ * @brief Initialize a stream buffer without allocating
+ * 
+ * @param stream Pointer to stream buffer structure to initialize
+ * @param buffer Pointer to storage buffer (must be at least PICO_RTOS_STREAM_BUFFER_MIN_SIZE)
+ * @param buffer_size Size of the storage buffer in bytes
+ * @param reader_wait_storage Storage for the list of tasks waiting to receive
+ * @param writer_wait_storage Storage for the list of tasks waiting to send
+ * @return true if initialization successful, false on error
+ */
+bool pico_rtos_stream_buffer_init_static(pico_rtos_stream_buffer_t *stream,
+                                        uint8_t *buffer,
+                                        uint32_t buffer_size,
+                                        struct pico_rtos_block_object *reader_wait_storage,
+                                        struct pico_rtos_block_object *writer_wait_storage);
 
 /**
  * @brief Send data to a stream buffer
@@ -5,11 +5,36 @@
 #include <stdbool.h>
 #include "platform.h"
 #include "types.h"
+#include "config.h"
+#include "blocking.h"
 
 
 
 // Forward declaration for blocking objects
 struct pico_rtos_block_object;
+struct pico_rtos_mutex;
+struct pico_rtos_rwlock;
+
+/**
+ * @brief Measurement window for a task's CPU usage
+ *
+ * Holds the task's CPU time and the time when the window started, so
+ * usage over the window is the ratio of the two deltas.
+ */
+typedef struct {
+    uint64_t cpu_time_us;      // Task CPU time when the window started
+    uint64_t start_us;         // When the window started
+    float usage_percent;       // Usage over the last completed window
+} pico_rtos_cpu_window_t;
+
+/**
+ * @brief Per-task run time statistics
+ */
+typedef struct {
+    uint64_t cpu_time_us;           // Time spent running, including the current run
+    uint32_t context_switches;      // Times the task was switched in
+    uint32_t preemptions;           // Times it was switched out while still ready to run
+} pico_rtos_task_runtime_stats_t;
 
 typedef struct pico_rtos_task {
     const char *name;
@@ -17,7 +42,7 @@ typedef struct pico_rtos_task {
     void *param;
     uint32_t stack_size;
     uint32_t priority;
-    uint32_t original_priority; // For priority inheritance
+    uint32_t original_priority; // Base priority, before inheritance and ceilings
     pico_rtos_task_state_t state;
     uint32_t *stack_ptr;
     uint32_t *stack_base;
@@ -25,15 +50,46 @@ typedef struct pico_rtos_task {
     bool auto_delete;
     pico_rtos_block_reason_t block_reason;
     struct pico_rtos_block_object *blocking_object;
+    pico_rtos_blocked_task_t wait_node;     // Entry in the wait list of blocking_object
+    struct pico_rtos_mutex *held_mutexes;   // Mutexes the task owns, most recently acquired first
+    struct pico_rtos_rwlock *held_rwlocks;  // Reader-writer locks the task holds for writing
     struct pico_rtos_task *next;  // For linked list of tasks
+    struct pico_rtos_task *ready_next;  // Ready queue links (NULL when not queued)
+    struct pico_rtos_task *ready_prev;
+    uint32_t ready_level;               // Ready queue the task is linked into
+    struct pico_rtos_task *delay_next;  // Delay list links, ordered by wake-up tick
+    struct pico_rtos_task *delay_prev;
+    uint32_t delay_delta;               // Ticks after the previous delay list entry
+    bool delay_queued;                  // Task is linked into the delay list
+    uint32_t time_slice;                // Round-robin quantum in ticks (0 = system default)
+    uint32_t slice_remaining;           // Ticks left in the current quantum
+#if PICO_RTOS_ENABLE_EDF_SCHEDULING
+    bool edf;                           // Scheduled by deadline in the EDF band
+    bool deadline_missed;               // Current job already counted as a miss
+    uint32_t deadline;                  // Absolute deadline tick of the current job
+    uint32_t relative_deadline;         // Deadline of each job after its release
+    uint32_t period;                    // Ticks between job releases (0 = aperiodic)
+    uint32_t release_time;              // Release tick of the current job
+    uint32_t deadline_misses;           // Jobs that ran past their deadline
+    uint32_t edf_base_priority;         // Base priority to return to on leaving the band
+#endif
+#if PICO_RTOS_ENABLE_TASK_NOTIFICATIONS
+    uint32_t notify_value;              // Direct-to-task notification value
+    uint8_t notify_state;               // Not waiting, waiting, or notification pending
+#endif
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+    uint64_t cpu_time_us;               // Run time up to the last switch-out
+    uint64_t switched_in_us;            // When the task last started running
+    uint32_t context_switch_count;      // Times the task was switched in
+    uint32_t preemption_count;          // Times it was switched out while still ready
+    pico_rtos_cpu_window_t cpu_window;  // Window used by the debug CPU usage report
+#endif
     pico_rtos_critical_section_t cs;
     
     // SMP-specific fields (v0.3.1)
 #ifdef PICO_RTOS_ENABLE_MULTI_CORE
     uint32_t core_affinity;                     // Core affinity setting (pico_rtos_core_affinity_t)
     uint32_t assigned_core;                     // Currently assigned core
-    uint64_t cpu_time_us;                       // Total CPU time in microseconds
-    uint32_t context_switch_count;              // Number of context switches for this task
     uint32_t stack_high_water_mark;             // Peak stack usage
     uint32_t migration_count;                   // Number of times task was migrated
     bool migration_pending;                     // Task is pending migration
@@ -42,9 +98,13 @@ typedef struct pico_rtos_task {
 #endif
 } pico_rtos_task_t;
 
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
 /**
  * @brief Create a new task
  *
+ * Allocates the stack with pico_rtos_malloc(); it is freed once the task
+ * has ended and been reaped.
+ *
  * @param task Pointer to task structure
  * @param name Name of the task (for debugging)
  * @param function Task function to execute
@@ -56,6 +116,27 @@ typedef struct pico_rtos_task {
 bool pico_rtos_task_create(pico_rtos_task_t *task, const char *name, 
                           pico_rtos_task_function_t function, void *param, 
                           uint32_t stack_size, uint32_t priority);
+#endif
+
+/**
+ * @brief Create a new task on a caller-provided stack
+ *
+ * Nothing is allocated. The stack belongs to the kernel until the task has
+ * ended and pico_rtos_get_terminated_task_count() no longer counts it (or
+ * the control block is reused); it is never freed.
+ *
+ * @param task Pointer to task structure
+ * @param name Name of the task (for debugging)
+ * @param function Task function to execute
+ * @param param Parameter to pass to the task function
+ * @param stack_buffer Stack memory, at least stack_size bytes
+ * @param stack_size Size of the task's stack in bytes
+ * @param priority Priority of the task (higher number = higher priority)
+ * @return true if task creation was successful, false otherwise
+ */
+bool pico_rtos_task_create_static(pico_rtos_task_t *task, const char *name,
+                                  pico_rtos_task_function_t function, void *param,
+                                  uint32_t *stack_buffer, uint32_t stack_size, uint32_t priority);
 
 /**
  * @brief Suspend a task
@@ -110,10 +191,216 @@ void pico_rtos_task_yield(void);
 /**
  * @brief Change a task's priority
  *
+ * Sets the task's base priority. While it holds mutexes or write locks it
+ * keeps running at least at their ceilings and at the priority of their
+ * waiters. An EDF task stays in the EDF band and takes the new priority
+ * when pico_rtos_task_clear_deadline() takes it out.
+ *
  * @param task Task to change priority for, or NULL for current task
  * @param new_priority New priority value
  * @return true if priority was changed successfully, false otherwise
  */
 bool pico_rtos_task_set_priority(pico_rtos_task_t *task, uint32_t new_priority);
 
+/**
+ * @brief Set a task's round-robin time slice
+ *
+ * The task gives the CPU to the next ready task of its priority after
+ * running for this many ticks. Takes effect from the task's next slice.
+ *
+ * @param task Task to change, or NULL for current task
+ * @param ticks Time slice in ticks, or 0 to use the system time slice
+ * @return true if the time slice was changed successfully, false otherwise
+ */
+bool pico_rtos_task_set_time_slice(pico_rtos_task_t *task, uint32_t ticks);
+
+/**
+ * @brief Get a task's run time statistics
+ *
+ * The scheduler timestamps every switch with the microsecond timer, so
+ * the CPU time is exact to the microsecond rather than sampled on ticks.
+ * All zero when PICO_RTOS_ENABLE_RUNTIME_STATS is off.
+ *
+ * @param task Task to query, or NULL for current task
+ * @param stats Structure to fill
+ * @return true if the statistics were read, false if there is no task
+ */
+bool pico_rtos_task_get_runtime_stats(pico_rtos_task_t *task, pico_rtos_task_runtime_stats_t *stats);
+
+/**
+ * @brief Clear a task's run time statistics
+ *
+ * @param task Task to reset, or NULL for current task
+ */
+void pico_rtos_task_reset_runtime_stats(pico_rtos_task_t *task);
+
+/**
+ * @brief Start measuring a task's CPU usage
+ *
+ * @param task Task to measure, or NULL for current task
+ * @param window Window to start
+ */
+void pico_rtos_task_start_cpu_window(pico_rtos_task_t *task, pico_rtos_cpu_window_t *window);
+
+/**
+ * @brief Get a task's CPU usage since the window started, then restart it
+ *
+ * Calling this periodically with the same window gives the usage over
+ * each period. The result is also stored in window->usage_percent.
+ *
+ * @param task Task to measure, or NULL for current task
+ * @param window Window started with pico_rtos_task_start_cpu_window()
+ * @return Share of the elapsed time the task was running, 0.0 to 100.0
+ */
+float pico_rtos_task_sample_cpu_usage(pico_rtos_task_t *task, pico_rtos_cpu_window_t *window);
+
+#if PICO_RTOS_ENABLE_EDF_SCHEDULING
+/**
+ * @brief Schedule a task by earliest deadline first
+ *
+ * Moves the task into the EDF priority band (PICO_RTOS_EDF_PRIORITY) and
+ * releases its first job now, due relative_deadline ticks later. Among
+ * ready EDF tasks the one with the earliest absolute deadline runs.
+ *
+ * @param task Task to change, or NULL for current task
+ * @param relative_deadline Ticks from each release to its deadline
+ * @param period Ticks between releases for pico_rtos_task_wait_for_next_period(), or 0
+ * @return true if the task is now an EDF task, false otherwise
+ */
+bool pico_rtos_task_set_deadline(pico_rtos_task_t *task, uint32_t relative_deadline, uint32_t period);
+
+/**
+ * @brief Set the absolute deadline of a task's current job
+ *
+ * Makes the task an EDF task if it is not one yet.
+ *
+ * @param task Task to change, or NULL for current task
+ * @param deadline Tick by which the current job should complete
+ * @return true if the deadline was set, false otherwise
+ */
+bool pico_rtos_task_set_absolute_deadline(pico_rtos_task_t *task, uint32_t deadline);
+
+/**
+ * @brief Take a task out of the EDF band
+ *
+ * Returns the task to the base priority it had before it was given a
+ * deadline, or to the one set with pico_rtos_task_set_priority() since.
+ * Priority inheritance from mutexes it holds is kept.
+ *
+ * @param task Task to change, or NULL for current task
+ * @return true if the task left the band, false if it was not an EDF task
+ */
+bool pico_rtos_task_clear_deadline(pico_rtos_task_t *task);
+
+/**
+ * @brief Complete the current job and sleep until the next release
+ *
+ * Counts a deadline miss if the job finished late, then waits for the next
+ * period boundary, which becomes the release of the next job. Releases stay
+ * on the period grid; an overrun job releases the next one immediately.
+ */
+void pico_rtos_task_wait_for_next_period(void);
+
+/**
+ * @brief Get the absolute deadline of a task's current job
+ *
+ * @param task Task to query, or NULL for current task
+ * @return Deadline tick, or 0 if the task is not an EDF task
+ */
+uint32_t pico_rtos_task_get_deadline(pico_rtos_task_t *task);
+
+/**
+ * @brief Get the number of jobs of a task that missed their deadline
+ *
+ * @param task Task to query, or NULL for current task
+ * @return Deadline miss count
+ */
+uint32_t pico_rtos_task_get_deadline_misses(pico_rtos_task_t *task);
+#endif
+
+#if PICO_RTOS_ENABLE_TASK_NOTIFICATIONS
+/**
+ * @brief How a notification updates the receiving task's notification value
+ */
+typedef enum {
+    PICO_RTOS_NOTIFY_NO_ACTION,                 // Wake the task, leave the value alone
+    PICO_RTOS_NOTIFY_SET_BITS,                  // OR the given bits into the value
+    PICO_RTOS_NOTIFY_INCREMENT,                 // Add one to the value
+    PICO_RTOS_NOTIFY_SET_VALUE_WITH_OVERWRITE,  // Replace the value
+    PICO_RTOS_NOTIFY_SET_VALUE_WITHOUT_OVERWRITE // Replace the value unless one is still unread
+} pico_rtos_notify_action_t;
+
+/**
+ * @brief Send a notification to a task
+ *
+ * Updates the task's notification value and, if the task is waiting for a
+ * notification, makes it ready. No blocking object is involved.
+ *
+ * @param task Task to notify
+ * @param value Value or bits used by the action
+ * @param action How to update the notification value
+ * @return false if the task is NULL, or for
+ *         PICO_RTOS_NOTIFY_SET_VALUE_WITHOUT_OVERWRITE when an earlier
+ *         notification has not been received yet; true otherwise
+ */
+bool pico_rtos_task_notify(pico_rtos_task_t *task, uint32_t value, pico_rtos_notify_action_t action);
+
+/**
+ * @brief Send a notification to a task from an interrupt
+ *
+ * Updates the value like pico_rtos_task_notify() but does not switch
+ * tasks inside the handler. A woken task that outranks the interrupted one
+ * runs when pico_rtos_interrupt_exit() ends the outermost interrupt; in a
+ * handler not bracketed by pico_rtos_interrupt_enter()/exit() the switch
+ * is pended at once and taken when the handler returns.
+ *
+ * @param task Task to notify
+ * @param value Value or bits used by the action
+ * @param action How to update the notification value
+ * @return See pico_rtos_task_notify()
+ */
+bool pico_rtos_task_notify_from_isr(pico_rtos_task_t *task, uint32_t value, pico_rtos_notify_action_t action);
+
+/**
+ * @brief Increment a task's notification value, like giving a semaphore
+ *
+ * @param task Task to notify
+ * @return true if the notification was sent
+ */
+bool pico_rtos_task_notify_give(pico_rtos_task_t *task);
+
+/**
+ * @brief Increment a task's notification value from an interrupt
+ *
+ * @param task Task to notify
+ * @return true if the notification was sent
+ */
+bool pico_rtos_task_notify_give_from_isr(pico_rtos_task_t *task);
+
+/**
+ * @brief Wait for the notification value to become non-zero, like taking a semaphore
+ *
+ * @param clear_on_exit true to reset the value to zero (binary semaphore),
+ *        false to decrement it (counting semaphore)
+ * @param timeout Timeout in ticks (PICO_RTOS_WAIT_FOREVER or PICO_RTOS_NO_WAIT)
+ * @return The notification value before it was cleared or decremented,
+ *         or 0 on timeout
+ */
+uint32_t pico_rtos_task_notify_take(bool clear_on_exit, uint32_t timeout);
+
+/**
+ * @brief Wait for a notification to be sent to the current task
+ *
+ * @param bits_to_clear_on_entry Bits cleared in the value before waiting,
+ *        unless a notification is already pending
+ * @param bits_to_clear_on_exit Bits cleared once a notification is received
+ * @param value If not NULL, receives the notification value before the
+ *        exit bits are cleared
+ * @param timeout Timeout in ticks (PICO_RTOS_WAIT_FOREVER or PICO_RTOS_NO_WAIT)
+ * @return true if a notification was received, false on timeout
+ */
+bool pico_rtos_task_notify_wait(uint32_t bits_to_clear_on_entry, uint32_t bits_to_clear_on_exit,
+                                uint32_t *value, uint32_t timeout);
+#endif
+
 #endif // PICO_RTOS_TASK_H
\ No newline at end of file
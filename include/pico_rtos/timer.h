@@ -4,6 +4,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "pico/critical_section.h"
+#include "pico_rtos/config.h"
 
 #define PICO_RTOS_TIMER_NAME_MAX_LENGTH 32
 
@@ -21,6 +22,10 @@ typedef struct pico_rtos_timer {
     uint32_t expiry_time;
     critical_section_t cs;
     struct pico_rtos_timer *next;  // For linked list of timers
+    struct pico_rtos_timer *wheel_next;    // Timer wheel slot links (NULL when not armed)
+    struct pico_rtos_timer **wheel_pprev;
+    struct pico_rtos_timer *fire_next;     // Pending callback links (NULL when not pending)
+    struct pico_rtos_timer **fire_pprev;
 } pico_rtos_timer_t;
 
 /**
@@ -102,4 +107,53 @@ uint32_t pico_rtos_timer_get_remaining_time(pico_rtos_timer_t *timer);
  */
 void pico_rtos_timer_delete(pico_rtos_timer_t *timer);
 
+#if PICO_RTOS_ENABLE_TIMER_DAEMON
+/**
+ * @brief Start a timer from an interrupt handler
+ * 
+ * The command is queued for the timer service task; the period is counted
+ * from the tick on which this was called. Like the other *_from_isr timer
+ * calls it never switches tasks inside the handler: a woken timer service
+ * task runs once the interrupt returns (see pico_rtos_task_notify_from_isr()).
+ * 
+ * @param timer Pointer to timer structure
+ * @return true if the command was queued, false if the command queue is full
+ */
+bool pico_rtos_timer_start_from_isr(pico_rtos_timer_t *timer);
+
+/**
+ * @brief Stop a timer from an interrupt handler
+ * 
+ * @param timer Pointer to timer structure
+ * @return true if the command was queued, false if the command queue is full
+ */
+bool pico_rtos_timer_stop_from_isr(pico_rtos_timer_t *timer);
+
+/**
+ * @brief Reset a timer from an interrupt handler
+ * 
+ * The period is counted from the tick on which this was called.
+ * 
+ * @param timer Pointer to timer structure
+ * @return true if the command was queued, false if the command queue is full
+ */
+bool pico_rtos_timer_reset_from_isr(pico_rtos_timer_t *timer);
+
+/**
+ * @brief Change the period of a timer from an interrupt handler
+ * 
+ * @param timer Pointer to timer structure
+ * @param period New period in milliseconds
+ * @return true if the command was queued, false if the command queue is full
+ */
+bool pico_rtos_timer_change_period_from_isr(pico_rtos_timer_t *timer, uint32_t period);
+
+/**
+ * @brief Get the timer service task that runs timer callbacks
+ * 
+ * @return Pointer to the timer service task
+ */
+struct pico_rtos_task *pico_rtos_timer_daemon_get_task(void);
+#endif
+
 #endif // PICO_RTOS_TIMER_H
\ No newline at end of file
@@ -27,9 +27,22 @@ typedef enum {
     PICO_RTOS_BLOCK_REASON_SEMAPHORE,
     PICO_RTOS_BLOCK_REASON_MUTEX,
     PICO_RTOS_BLOCK_REASON_EVENT_GROUP,
-    PICO_RTOS_BLOCK_REASON_STREAM_BUFFER
+    PICO_RTOS_BLOCK_REASON_STREAM_BUFFER,
+    PICO_RTOS_BLOCK_REASON_NOTIFICATION,
+    PICO_RTOS_BLOCK_REASON_RWLOCK,
+    PICO_RTOS_BLOCK_REASON_QUEUE_SET
 } pico_rtos_block_reason_t;
 
+// Link from a queue, semaphore, stream buffer or event group to the queue
+// set it belongs to; embedded in the object so joining a set never allocates
+typedef struct pico_rtos_queue_set_member {
+    struct pico_rtos_queue_set *set;            // Set the object is in, or NULL
+    struct pico_rtos_queue_set_member *next;    // Next member of the same set
+    void *object;                               // The queue, semaphore, ... itself
+    uint32_t bits;                              // Event group bits that make it ready
+    uint8_t type;                               // Kind of object, for the readiness check
+} pico_rtos_queue_set_member_t;
+
 // Function pointer types
 typedef void (*pico_rtos_task_function_t)(void *param);
 
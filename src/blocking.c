@@ -5,21 +5,59 @@
 #include <stdlib.h>
 #include <string.h>
 
+// Create a blocking object in caller-provided storage
+pico_rtos_block_object_t *pico_rtos_block_object_create_static(pico_rtos_block_object_t *storage, void *sync_object) {
+    if (storage == NULL) {
+        return NULL;
+    }
+    
+    storage->sync_object = sync_object;
+    storage->blocked_tasks_head = NULL;
+    storage->blocked_tasks_tail = NULL;
+    storage->blocked_count = 0;
+    storage->priority_ordered = true;  // Enable priority ordering for real-time performance
+    storage->dynamically_allocated = false;
+    critical_section_init(&storage->cs);
+    
+    return storage;
+}
+
 // Create a new blocking object
 pico_rtos_block_object_t *pico_rtos_block_object_create(void *sync_object) {
+#if PICO_RTOS_STATIC_ALLOCATION_ONLY
+    (void)sync_object;
+    return NULL;
+#else
     pico_rtos_block_object_t *block_obj = (pico_rtos_block_object_t *)pico_rtos_malloc(sizeof(pico_rtos_block_object_t));
     if (block_obj == NULL) {
         return NULL;
     }
     
-    block_obj->sync_object = sync_object;
-    block_obj->blocked_tasks_head = NULL;
-    block_obj->blocked_tasks_tail = NULL;
-    block_obj->blocked_count = 0;
-    block_obj->priority_ordered = true;  // Enable priority ordering for real-time performance
-    critical_section_init(&block_obj->cs);
+    pico_rtos_block_object_create_static(block_obj, sync_object);
+    block_obj->dynamically_allocated = true;
     
     return block_obj;
+#endif
+}
+
+// Unlink a wait node from its list (caller holds the object's critical section)
+static void unlink_blocked_task(pico_rtos_block_object_t *block_obj, pico_rtos_blocked_task_t *node) {
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        block_obj->blocked_tasks_head = node->next;
+    }
+    
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    } else {
+        block_obj->blocked_tasks_tail = node->prev;
+    }
+    
+    node->next = NULL;
+    node->prev = NULL;
+    node->owner = NULL;
+    block_obj->blocked_count--;
 }
 
 // Delete a blocking object
@@ -31,27 +69,24 @@ void pico_rtos_block_object_delete(pico_rtos_block_object_t *block_obj) {
     critical_section_enter_blocking(&block_obj->cs);
     
     // Unblock all waiting tasks - O(n) but only during cleanup
-    pico_rtos_blocked_task_t *blocked_task = block_obj->blocked_tasks_head;
-    while (blocked_task != NULL) {
-        pico_rtos_blocked_task_t *next = blocked_task->next;
+    while (block_obj->blocked_tasks_head != NULL) {
+        pico_rtos_blocked_task_t *blocked_task = block_obj->blocked_tasks_head;
+        pico_rtos_task_t *task = blocked_task->task;
+        unlink_blocked_task(block_obj, blocked_task);
         
         // Mark task as ready and clear blocking reason
-        if (blocked_task->task != NULL) {
-            blocked_task->task->state = PICO_RTOS_TASK_STATE_READY;
-            blocked_task->task->block_reason = PICO_RTOS_BLOCK_REASON_NONE;
-            blocked_task->task->blocking_object = NULL;
-        }
-        
-        pico_rtos_free(blocked_task, sizeof(pico_rtos_blocked_task_t));
-        blocked_task = next;
+        pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_READY);
+        task->block_reason = PICO_RTOS_BLOCK_REASON_NONE;
+        task->blocking_object = NULL;
     }
     
-    block_obj->blocked_tasks_head = NULL;
-    block_obj->blocked_tasks_tail = NULL;
-    block_obj->blocked_count = 0;
-    
     critical_section_exit(&block_obj->cs);
-    pico_rtos_free(block_obj, sizeof(pico_rtos_block_object_t));
+    
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+    if (block_obj->dynamically_allocated) {
+        pico_rtos_free(block_obj, sizeof(pico_rtos_block_object_t));
+    }
+#endif
 }
 
 // PERFORMANCE CRITICAL: Insert task in priority order for O(1) unblocking
@@ -93,16 +128,23 @@ bool pico_rtos_block_task(pico_rtos_block_object_t *block_obj, pico_rtos_task_t
         return false;
     }
     
+    // A task waits on one object at a time; leave any stale wait list first
+    pico_rtos_blocked_task_t *blocked_task = &task->wait_node;
+    if (blocked_task->owner != NULL && blocked_task->owner != block_obj) {
+        pico_rtos_block_object_remove_task(blocked_task->owner, task);
+    }
+    
     critical_section_enter_blocking(&block_obj->cs);
     
-    // Create a new blocked task entry
-    pico_rtos_blocked_task_t *blocked_task = (pico_rtos_blocked_task_t *)pico_rtos_malloc(sizeof(pico_rtos_blocked_task_t));
-    if (blocked_task == NULL) {
+    // A task can only wait on an object once
+    if (blocked_task->owner == block_obj) {
         critical_section_exit(&block_obj->cs);
-        return false;
+        return true;
     }
     
+    // The wait node lives in the task, so blocking never allocates
     blocked_task->task = task;
+    blocked_task->owner = block_obj;
     blocked_task->timeout_time = (timeout == PICO_RTOS_WAIT_FOREVER) ? 
                                 UINT32_MAX : (pico_rtos_get_tick_count() + timeout);
     blocked_task->priority = task->priority;  // Cache priority for fast access
@@ -127,15 +169,26 @@ bool pico_rtos_block_task(pico_rtos_block_object_t *block_obj, pico_rtos_task_t
     block_obj->blocked_count++;
     
     // Update task state
-    task->state = PICO_RTOS_TASK_STATE_BLOCKED;
+    pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_BLOCKED);
     task->block_reason = reason;
     task->blocking_object = block_obj;
     task->delay_until = blocked_task->timeout_time;
     
+    // Timed waits expire through the kernel's timeout queue; being woken
+    // first takes the task off it again
+    pico_rtos_scheduler_timeout_task(task, timeout);
+    
     critical_section_exit(&block_obj->cs);
     return true;
 }
 
+// Make an unlinked waiter ready again after it got the object
+static void wake_blocked_task(pico_rtos_task_t *task) {
+    pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_READY);
+    task->block_reason = PICO_RTOS_BLOCK_REASON_NONE;
+    task->blocking_object = NULL;
+}
+
 // PERFORMANCE CRITICAL: O(1) unblocking for priority-ordered lists
 static pico_rtos_task_t *unblock_highest_priority_task_fast(pico_rtos_block_object_t *block_obj) {
     if (block_obj->blocked_tasks_head == NULL) {
@@ -146,75 +199,32 @@ static pico_rtos_task_t *unblock_highest_priority_task_fast(pico_rtos_block_obje
     pico_rtos_blocked_task_t *highest = block_obj->blocked_tasks_head;
     pico_rtos_task_t *task = highest->task;
     
-    // Remove from head - O(1) operation
-    block_obj->blocked_tasks_head = highest->next;
-    if (block_obj->blocked_tasks_head != NULL) {
-        block_obj->blocked_tasks_head->prev = NULL;
-    } else {
-        block_obj->blocked_tasks_tail = NULL;
-    }
-    
-    block_obj->blocked_count--;
-    
-    // Update task state
-    if (task != NULL) {
-        task->state = PICO_RTOS_TASK_STATE_READY;
-        task->block_reason = PICO_RTOS_BLOCK_REASON_NONE;
-        task->blocking_object = NULL;
-    }
-    
-    pico_rtos_free(highest, sizeof(pico_rtos_blocked_task_t));
+    unlink_blocked_task(block_obj, highest);
+    wake_blocked_task(task);
     return task;
 }
 
 // LEGACY: O(n) unblocking for non-priority-ordered lists (compatibility)
 static pico_rtos_task_t *unblock_highest_priority_task_legacy(pico_rtos_block_object_t *block_obj) {
-    pico_rtos_task_t *highest_priority_task = NULL;
     pico_rtos_blocked_task_t *highest_priority_blocked = NULL;
-    pico_rtos_blocked_task_t *prev_highest = NULL;
-    pico_rtos_blocked_task_t *prev = NULL;
     pico_rtos_blocked_task_t *current = block_obj->blocked_tasks_head;
     
     // Find the highest priority task in the blocked list - O(n)
     while (current != NULL) {
-        if (current->task != NULL && 
-            (highest_priority_task == NULL || 
-             current->priority > highest_priority_task->priority)) {
-            highest_priority_task = current->task;
+        if (highest_priority_blocked == NULL || current->priority > highest_priority_blocked->priority) {
             highest_priority_blocked = current;
-            prev_highest = prev;
         }
-        prev = current;
         current = current->next;
     }
     
-    if (highest_priority_blocked != NULL) {
-        // Remove from blocked list - O(1) with doubly-linked list
-        if (highest_priority_blocked->prev != NULL) {
-            highest_priority_blocked->prev->next = highest_priority_blocked->next;
-        } else {
-            block_obj->blocked_tasks_head = highest_priority_blocked->next;
-        }
-        
-        if (highest_priority_blocked->next != NULL) {
-            highest_priority_blocked->next->prev = highest_priority_blocked->prev;
-        } else {
-            block_obj->blocked_tasks_tail = highest_priority_blocked->prev;
-        }
-        
-        block_obj->blocked_count--;
-        
-        // Update task state
-        if (highest_priority_task != NULL) {
-            highest_priority_task->state = PICO_RTOS_TASK_STATE_READY;
-            highest_priority_task->block_reason = PICO_RTOS_BLOCK_REASON_NONE;
-            highest_priority_task->blocking_object = NULL;
-        }
-        
-        pico_rtos_free(highest_priority_blocked, sizeof(pico_rtos_blocked_task_t));
+    if (highest_priority_blocked == NULL) {
+        return NULL;
     }
     
-    return highest_priority_task;
+    pico_rtos_task_t *task = highest_priority_blocked->task;
+    unlink_blocked_task(block_obj, highest_priority_blocked);
+    wake_blocked_task(task);
+    return task;
 }
 
 // Unblock the highest priority task from the blocking object
@@ -239,7 +249,50 @@ pico_rtos_task_t *pico_rtos_unblock_highest_priority_task(pico_rtos_block_object
     return unblocked_task;
 }
 
-// Check for timed out tasks and unblock them
+// Remove a task from the wait list without changing its state
+void pico_rtos_block_object_remove_task(pico_rtos_block_object_t *block_obj, pico_rtos_task_t *task) {
+    if (block_obj == NULL || task == NULL) {
+        return;
+    }
+    
+    critical_section_enter_blocking(&block_obj->cs);
+    
+    // O(1): the task's own node is the list entry
+    if (task->wait_node.owner == block_obj) {
+        unlink_blocked_task(block_obj, &task->wait_node);
+    }
+    
+    if (task->blocking_object == block_obj) {
+        task->blocking_object = NULL;
+    }
+    
+    critical_section_exit(&block_obj->cs);
+}
+
+// Re-sort a waiter whose priority changed while it waited
+void pico_rtos_block_object_reprioritize_task(pico_rtos_block_object_t *block_obj, pico_rtos_task_t *task) {
+    if (block_obj == NULL || task == NULL) {
+        return;
+    }
+    
+    critical_section_enter_blocking(&block_obj->cs);
+    
+    pico_rtos_blocked_task_t *node = &task->wait_node;
+    if (node->owner == block_obj && node->priority != task->priority) {
+        node->priority = task->priority;
+        if (block_obj->priority_ordered) {
+            unlink_blocked_task(block_obj, node);
+            insert_blocked_task_priority_ordered(block_obj, node);
+            node->owner = block_obj;
+            block_obj->blocked_count++;
+        }
+    }
+    
+    critical_section_exit(&block_obj->cs);
+}
+
+// Check for timed out tasks and unblock them. Timed waits normally expire
+// from the kernel's timeout queue, so this sweep is not needed for them.
 void pico_rtos_check_blocked_timeouts(pico_rtos_block_object_t *block_obj) {
     if (block_obj == NULL || block_obj->blocked_count == 0) {
         return;
@@ -256,30 +309,12 @@ void pico_rtos_check_blocked_timeouts(pico_rtos_block_object_t *block_obj) {
         // Check if this task has timed out (overflow-safe comparison)
         if (current->timeout_time != UINT32_MAX && 
             (int32_t)(current_time - current->timeout_time) >= 0) {
-            
-            // PERFORMANCE OPTIMIZED: Use doubly-linked list for O(1) removal
-            if (current->prev != NULL) {
-                current->prev->next = current->next;
-            } else {
-                block_obj->blocked_tasks_head = current->next;
-            }
-            
-            if (current->next != NULL) {
-                current->next->prev = current->prev;
-            } else {
-                block_obj->blocked_tasks_tail = current->prev;
-            }
-            
-            block_obj->blocked_count--;
+            pico_rtos_task_t *task = current->task;
+            unlink_blocked_task(block_obj, current);
             
             // Update task state (keep block reason to indicate timeout)
-            if (current->task != NULL) {
-                current->task->state = PICO_RTOS_TASK_STATE_READY;
-                // Note: We keep the block_reason to indicate the operation timed out
-                current->task->blocking_object = NULL;
-            }
-            
-            pico_rtos_free(current, sizeof(pico_rtos_blocked_task_t));
+            pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_READY);
+            task->blocking_object = NULL;
         }
         
         current = next;
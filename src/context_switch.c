@@ -19,6 +19,14 @@ uint32_t *next_task_stack_ptr = NULL;
 #define PENDSV_PRIORITY_SHIFT   16
 #define LOWEST_INTERRUPT_PRIORITY 0xFF
 
+// SysTick, free-running from the processor clock as a cycle counter
+#define SYST_CSR_REG            (*(volatile uint32_t *)0xE000E010)
+#define SYST_RVR_REG            (*(volatile uint32_t *)0xE000E014)
+#define SYST_CVR_REG            (*(volatile uint32_t *)0xE000E018)
+#define SYST_CSR_ENABLE         (1u << 0)
+#define SYST_CSR_CLKSOURCE      (1u << 2)
+#define SYST_RELOAD_MAX         0x00FFFFFF
+
 // Initial PSR value for new tasks (Thumb mode enabled)
 #define INITIAL_PSR             0x01000000
 
@@ -81,14 +89,8 @@ void pico_rtos_task_exit_handler(void) {
     // Get the current task and mark it as terminated
     pico_rtos_task_t *current_task = pico_rtos_get_current_task();
     if (current_task != NULL) {
-        current_task->state = PICO_RTOS_TASK_STATE_TERMINATED;
-        
-        // Free the task's stack memory if it was dynamically allocated
-        if (current_task->auto_delete && current_task->stack_base != NULL) {
-            pico_rtos_free(current_task->stack_base, current_task->stack_size);
-            current_task->stack_base = NULL;
-            current_task->stack_ptr = NULL;
-        }
+        // Still running on its stack, so the idle task frees it later
+        pico_rtos_scheduler_remove_task(current_task);
     }
     
     pico_rtos_exit_critical();
@@ -143,4 +145,14 @@ void pico_rtos_context_switch_init(void) {
     // Initialize global pointers
     current_task_stack_ptr = NULL;
     next_task_stack_ptr = NULL;
+    
+    // Start SysTick as a cycle counter (no interrupt; the tick uses the timer alarm)
+    SYST_RVR_REG = SYST_RELOAD_MAX;
+    SYST_CVR_REG = 0;
+    SYST_CSR_REG = SYST_CSR_CLKSOURCE | SYST_CSR_ENABLE;
+}
+
+// SysTick counts down, so invert it to get an up-counter
+uint32_t pico_rtos_port_get_cycle_count(void) {
+    return (SYST_RELOAD_MAX - SYST_CVR_REG) & PICO_RTOS_PORT_CYCLE_COUNTER_MASK;
 }
\ No newline at end of file
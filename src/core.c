@@ -14,7 +14,7 @@
 #include "pico_rtos/deprecation.h"
 
 // Forward declarations (internal functions not exposed in header)
-static void pico_rtos_tick_handler(void);
+static int64_t pico_rtos_tick_handler(alarm_id_t id, void *user_data);
 void pico_rtos_init_system_timer(void);
 
 // Context switching functions (implemented in assembly)
@@ -25,10 +25,48 @@ extern void PendSV_Handler(void);
 // Global variables
 static pico_rtos_task_t *current_task = NULL;
 static pico_rtos_task_t *task_list = NULL;
+static pico_rtos_task_t *task_list_tail = NULL;
+static pico_rtos_task_t *zombie_list = NULL;  // Terminated tasks whose stacks the idle task has yet to free
+static uint32_t zombie_count = 0;
 static pico_rtos_timer_t *timer_list = NULL;
+
+// Hierarchical timer wheel: a root level with one slot per tick, then
+// coarser levels whose slots are redistributed as their time comes up
+#define TIMER_WHEEL_ROOT_SIZE (1u << PICO_RTOS_TIMER_WHEEL_ROOT_BITS)
+#define TIMER_WHEEL_ROOT_MASK (TIMER_WHEEL_ROOT_SIZE - 1)
+#define TIMER_WHEEL_LEVEL_BITS 6
+#define TIMER_WHEEL_LEVEL_SIZE (1u << TIMER_WHEEL_LEVEL_BITS)
+#define TIMER_WHEEL_LEVEL_MASK (TIMER_WHEEL_LEVEL_SIZE - 1)
+#define TIMER_WHEEL_OUTER_LEVELS 3
+#define TIMER_WHEEL_LEVEL_SHIFT(level) (PICO_RTOS_TIMER_WHEEL_ROOT_BITS + (level) * TIMER_WHEEL_LEVEL_BITS)
+#define TIMER_WHEEL_MAX_DELTA ((1u << TIMER_WHEEL_LEVEL_SHIFT(TIMER_WHEEL_OUTER_LEVELS)) - 1)
+
+static pico_rtos_timer_t *timer_wheel_root[TIMER_WHEEL_ROOT_SIZE];
+static pico_rtos_timer_t *timer_wheel_levels[TIMER_WHEEL_OUTER_LEVELS][TIMER_WHEEL_LEVEL_SIZE];
+static uint32_t timer_wheel_next_tick = 0;  // Next tick the wheel will process
 static uint32_t system_tick_count = 0;
+static uint32_t tick_interrupt_count = 0;
+static alarm_id_t tick_alarm_id = 0;
+static pico_rtos_task_t *delay_list = NULL;  // Delayed tasks and timed waits, earliest wake-up first
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+static pico_rtos_tick_stats_t tick_stats;
+static uint64_t tick_stats_total_cycles = 0;
+#endif
+#if PICO_RTOS_ENABLE_TICKLESS_IDLE
+static uint64_t last_tick_us = 0;
+static void pico_rtos_tickless_idle(void);
+static uint32_t pico_rtos_timer_wheel_ticks_until_next(uint32_t limit);
+#endif
 static bool scheduler_running = false;
 static pico_rtos_critical_section_t scheduler_cs;
+static uint32_t time_slice_ticks = PICO_RTOS_TIME_SLICE_TICKS;
+
+// Ready queues: a circular list per priority level plus a two-level bitmap of
+// the non-empty levels, so readying a task and picking the next one are O(1)
+#define PICO_RTOS_READY_BITMAP_WORDS ((PICO_RTOS_PRIORITY_LEVELS + 31) / 32)
+static pico_rtos_task_t *ready_queues[PICO_RTOS_PRIORITY_LEVELS];
+static uint32_t ready_bitmap[PICO_RTOS_READY_BITMAP_WORDS];
+static uint32_t ready_group_bitmap = 0;
 
 // Idle task variables
 static pico_rtos_task_t idle_task;
@@ -42,12 +80,6 @@ static pico_rtos_idle_hook_t idle_hook_function = NULL;
 extern uint32_t *current_task_stack_ptr;
 extern uint32_t *next_task_stack_ptr;
 
-// Define the block object for synchronization primitives
-typedef struct pico_rtos_block_object {
-    void *object;
-    pico_rtos_task_t *blocked_tasks;
-} pico_rtos_block_object_t;
-
 // Version string
 static const char *version_string = "0.2.1";
 
@@ -66,17 +98,291 @@ static bool pico_rtos_time_after(uint32_t time1, uint32_t time2) {
     return (int32_t)(time1 - time2) > 0;
 }
 
-// Helper function to safely check if a timeout has occurred
-static bool pico_rtos_timeout_expired(uint32_t start_time, uint32_t current_time, uint32_t timeout) {
-    if (timeout == PICO_RTOS_WAIT_FOREVER) {
+// =============================================================================
+// READY QUEUES
+// =============================================================================
+
+static inline uint32_t pico_rtos_ready_level(uint32_t priority) {
+    return (priority < PICO_RTOS_PRIORITY_LEVELS) ? priority : (PICO_RTOS_PRIORITY_LEVELS - 1);
+}
+
+#if PICO_RTOS_ENABLE_EDF_SCHEDULING
+// Whether a should run before b in the EDF band; tasks without a deadline
+// that end up at the band's priority go after every EDF task
+static inline bool pico_rtos_edf_before(const pico_rtos_task_t *a, const pico_rtos_task_t *b) {
+    if (!a->edf) {
         return false;
     }
+    return !b->edf || (int32_t)(a->deadline - b->deadline) < 0;
+}
+#endif
+
+// Whether a ready task should preempt the running one
+static inline bool pico_rtos_task_outranks(const pico_rtos_task_t *a, const pico_rtos_task_t *b) {
+#if PICO_RTOS_ENABLE_EDF_SCHEDULING
+    if (a->priority == PICO_RTOS_EDF_PRIORITY && b->priority == PICO_RTOS_EDF_PRIORITY) {
+        return pico_rtos_edf_before(a, b);
+    }
+#endif
+    return a->priority > b->priority;
+}
+
+// Append a task to the tail of its priority level; the EDF band is kept in
+// deadline order instead (caller holds the critical section)
+static void pico_rtos_ready_queue_insert(pico_rtos_task_t *task) {
+    if (task->ready_next != NULL) {
+        return; // Already queued
+    }
     
-    // Calculate elapsed time handling overflow
-    uint32_t elapsed = current_time - start_time;
-    return elapsed >= timeout;
+    uint32_t level = pico_rtos_ready_level(task->priority);
+    pico_rtos_task_t *head = ready_queues[level];
+    
+    task->ready_level = level;
+    if (head == NULL) {
+        task->ready_next = task;
+        task->ready_prev = task;
+        ready_queues[level] = task;
+        ready_bitmap[level >> 5] |= 1u << (level & 31);
+        ready_group_bitmap |= 1u << (level >> 5);
+        return;
+    }
+    
+    // Insert before this task; the head means at the tail
+    pico_rtos_task_t *next = head;
+#if PICO_RTOS_ENABLE_EDF_SCHEDULING
+    if (level == PICO_RTOS_EDF_PRIORITY) {
+        // Equal deadlines keep their arrival order
+        while (!pico_rtos_edf_before(task, next)) {
+            next = next->ready_next;
+            if (next == head) {
+                break;
+            }
+        }
+        if (next == head && pico_rtos_edf_before(task, head)) {
+            ready_queues[level] = task;
+        }
+    }
+#endif
+    task->ready_next = next;
+    task->ready_prev = next->ready_prev;
+    next->ready_prev->ready_next = task;
+    next->ready_prev = task;
+}
+
+// Unlink a task from its ready queue (caller holds the critical section)
+static void pico_rtos_ready_queue_remove(pico_rtos_task_t *task) {
+    if (task->ready_next == NULL) {
+        return; // Not queued
+    }
+    
+    uint32_t level = task->ready_level;
+    if (task->ready_next == task) {
+        ready_queues[level] = NULL;
+        ready_bitmap[level >> 5] &= ~(1u << (level & 31));
+        if (ready_bitmap[level >> 5] == 0) {
+            ready_group_bitmap &= ~(1u << (level >> 5));
+        }
+    } else {
+        task->ready_prev->ready_next = task->ready_next;
+        task->ready_next->ready_prev = task->ready_prev;
+        if (ready_queues[level] == task) {
+            ready_queues[level] = task->ready_next;
+        }
+    }
+    
+    task->ready_next = NULL;
+    task->ready_prev = NULL;
+}
+
+// Head of the highest non-empty ready queue (caller holds the critical section)
+static pico_rtos_task_t *pico_rtos_ready_queue_highest(void) {
+    if (ready_group_bitmap == 0) {
+        return NULL;
+    }
+    
+    uint32_t word = 31 - __builtin_clz(ready_group_bitmap);
+    uint32_t bit = 31 - __builtin_clz(ready_bitmap[word]);
+    return ready_queues[(word << 5) + bit];
+}
+
+// Round-robin quantum of a task in ticks, 0 if it is not time sliced
+static inline uint32_t pico_rtos_task_quantum(const pico_rtos_task_t *task) {
+    return (task->time_slice != 0) ? task->time_slice : time_slice_ticks;
+}
+
+// Charge elapsed ticks to the running task's slice and, once it is used up,
+// queue the task behind its equal-priority peers so the next schedule picks
+// one of them (caller holds the critical section)
+static void pico_rtos_time_slice_advance(uint32_t ticks) {
+    pico_rtos_task_t *task = current_task;
+    if (task == NULL || task == &idle_task || task->state != PICO_RTOS_TASK_STATE_RUNNING) {
+        return;
+    }
+    
+    uint32_t quantum = pico_rtos_task_quantum(task);
+    if (quantum == 0) {
+        return;
+    }
+    
+    if (task->slice_remaining > ticks) {
+        task->slice_remaining -= ticks;
+        return;
+    }
+    
+    task->slice_remaining = quantum;
+    if (ready_queues[pico_rtos_ready_level(task->priority)] != NULL) {
+        pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_READY);
+    }
 }
 
+#if PICO_RTOS_ENABLE_EDF_SCHEDULING
+// Count a miss as soon as the running job passes its deadline, once per job
+// (caller holds the critical section)
+static void pico_rtos_edf_check_deadline(void) {
+    pico_rtos_task_t *task = current_task;
+    if (task != NULL && task->edf && !task->deadline_missed &&
+        pico_rtos_time_after(system_tick_count, task->deadline)) {
+        task->deadline_missed = true;
+        task->deadline_misses++;
+    }
+}
+#endif
+
+// Link a task into the delay list so that it wakes after the given number
+// of ticks; each entry stores its distance from the previous one, so the
+// tick only ever has to look at the head (caller holds the critical section)
+static void pico_rtos_delay_list_insert(pico_rtos_task_t *task, uint32_t ticks) {
+    pico_rtos_task_t *prev = NULL;
+    pico_rtos_task_t *node = delay_list;
+    
+    // Equal wake-up times keep their insertion order
+    while (node != NULL && ticks >= node->delay_delta) {
+        ticks -= node->delay_delta;
+        prev = node;
+        node = node->delay_next;
+    }
+    
+    task->delay_delta = ticks;
+    task->delay_prev = prev;
+    task->delay_next = node;
+    if (node != NULL) {
+        node->delay_delta -= ticks;
+        node->delay_prev = task;
+    }
+    if (prev != NULL) {
+        prev->delay_next = task;
+    } else {
+        delay_list = task;
+    }
+    task->delay_queued = true;
+}
+
+// Unlink a task from the delay list, handing its delta to its successor
+// (caller holds the critical section)
+static void pico_rtos_delay_list_remove(pico_rtos_task_t *task) {
+    if (!task->delay_queued) {
+        return;
+    }
+    
+    if (task->delay_next != NULL) {
+        task->delay_next->delay_delta += task->delay_delta;
+        task->delay_next->delay_prev = task->delay_prev;
+    }
+    if (task->delay_prev != NULL) {
+        task->delay_prev->delay_next = task->delay_next;
+    } else {
+        delay_list = task->delay_next;
+    }
+    task->delay_next = NULL;
+    task->delay_prev = NULL;
+    task->delay_delta = 0;
+    task->delay_queued = false;
+}
+
+// Wake every delayed task whose time has come after the given number of
+// ticks, and time out every wait that has run out; only the entries that
+// expire are touched (caller holds the critical section)
+static void pico_rtos_delay_list_advance(uint32_t ticks) {
+    while (delay_list != NULL && delay_list->delay_delta <= ticks) {
+        pico_rtos_task_t *task = delay_list;
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+        tick_stats.delay_list_visits++;
+#endif
+        ticks -= task->delay_delta;
+        task->delay_delta = 0;
+        
+        if (task->blocking_object != NULL) {
+            // Timed out: leave the wait list and keep the block reason so the
+            // waiter can tell a timeout from being handed the object
+            pico_rtos_block_object_remove_task(task->blocking_object, task);
+            pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_READY);
+            continue;
+        }
+        
+        // Delays and notification waits just become ready again; leaving
+        // the blocked state unlinks the task
+        pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_READY);
+        task->block_reason = PICO_RTOS_BLOCK_REASON_NONE;
+    }
+    
+    if (delay_list != NULL) {
+        delay_list->delay_delta -= ticks;
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+        tick_stats.delay_list_visits++;
+#endif
+    }
+}
+
+// Append a task to the global task list (caller holds the critical section)
+static void pico_rtos_task_list_append(pico_rtos_task_t *task) {
+    task->next = NULL;
+    if (task_list_tail == NULL) {
+        task_list = task;
+    } else {
+        task_list_tail->next = task;
+    }
+    task_list_tail = task;
+}
+
+// Unlink a task from the global task list given its predecessor
+static void pico_rtos_task_list_unlink(pico_rtos_task_t *prev, pico_rtos_task_t *task) {
+    if (prev == NULL) {
+        task_list = task->next;
+    } else {
+        prev->next = task->next;
+    }
+    if (task_list_tail == task) {
+        task_list_tail = prev;
+    }
+    task->next = NULL;
+}
+
+#ifdef PICO_RTOS_HOST_PORT
+// Check whether any task other than the kernel's own tasks can still run
+static bool pico_rtos_has_application_tasks(void) {
+    bool found = false;
+    pico_rtos_enter_critical();
+    for (pico_rtos_task_t *task = task_list; task != NULL; task = task->next) {
+#if PICO_RTOS_ENABLE_TIMER_DAEMON
+        if (task == pico_rtos_timer_daemon_get_task()) {
+            continue;
+        }
+#endif
+#if PICO_RTOS_ENABLE_DEFERRED_WORK
+        if (task == pico_rtos_deferred_get_task()) {
+            continue;
+        }
+#endif
+        if (task != &idle_task && task->state != PICO_RTOS_TASK_STATE_TERMINATED) {
+            found = true;
+            break;
+        }
+    }
+    pico_rtos_exit_critical();
+    return found;
+}
+#endif
+
 // Idle task function - runs when no other tasks are ready
 static void pico_rtos_idle_task_function(void *param) {
     (void)param; // Unused parameter
@@ -90,12 +396,29 @@ static void pico_rtos_idle_task_function(void *param) {
             pico_rtos_check_stack_overflow();
         }
         
+        // Free the stacks of tasks that have ended, a few at a time
+        pico_rtos_reap_terminated_tasks(PICO_RTOS_TASK_REAP_BATCH);
+        
+#ifdef PICO_RTOS_HOST_PORT
+        // The simulator has nothing to fall back on once the application is
+        // done, so hand control back to the caller of pico_rtos_start()
+        if (!pico_rtos_has_application_tasks()) {
+            pico_rtos_port_stop_scheduler();
+            continue;
+        }
+#endif
+        
         // Call user-defined idle hook if registered
         if (idle_hook_function != NULL) {
             idle_hook_function();
         } else {
+#if PICO_RTOS_ENABLE_TICKLESS_IDLE
+            // Sleep until the next deadline instead of waking every tick
+            pico_rtos_tickless_idle();
+#else
             // Default behavior: put CPU to sleep to save power
             __wfi(); // Wait for interrupt
+#endif
         }
     }
 }
@@ -109,7 +432,6 @@ static bool pico_rtos_init_idle_task(void) {
     idle_task.param = NULL;
     idle_task.stack_size = sizeof(idle_task_stack);
     idle_task.priority = 0; // Lowest priority
-    idle_task.state = PICO_RTOS_TASK_STATE_READY;
     idle_task.block_reason = PICO_RTOS_BLOCK_REASON_NONE;
     idle_task.auto_delete = false; // Static task, don't delete
     
@@ -132,17 +454,9 @@ static bool pico_rtos_init_idle_task(void) {
     
     // Add to task list manually (don't use scheduler_add_task to avoid malloc tracking)
     pico_rtos_enter_critical();
-    if (task_list == NULL) {
-        task_list = &idle_task;
-    } else {
-        // Add to the end of the list
-        pico_rtos_task_t *last_task = task_list;
-        while (last_task->next != NULL) {
-            last_task = last_task->next;
-        }
-        last_task->next = &idle_task;
-    }
-    idle_task.next = NULL;
+    pico_rtos_task_list_append(&idle_task);
+    idle_task.state = PICO_RTOS_TASK_STATE_READY;
+    pico_rtos_ready_queue_insert(&idle_task);
     pico_rtos_exit_critical();
     
     return true;
@@ -178,10 +492,10 @@ __attribute__((weak)) void pico_rtos_handle_stack_overflow(pico_rtos_task_t *tas
     
     // Default handler - print error and halt
     printf("STACK OVERFLOW DETECTED in task: %s\n", task->name ? task->name : "Unknown");
-    printf("Task priority: %lu, Stack size: %lu\n", task->priority, task->stack_size);
+    printf("Task priority: %lu, Stack size: %lu\n", (unsigned long)task->priority, (unsigned long)task->stack_size);
     
     // Terminate the offending task
-    task->state = PICO_RTOS_TASK_STATE_TERMINATED;
+    pico_rtos_scheduler_remove_task(task);
     PICO_RTOS_LOG_CORE_WARN("Task %s terminated due to stack overflow", 
                            task->name ? task->name : "Unknown");
     
@@ -209,6 +523,12 @@ bool pico_rtos_init(void) {
     pico_rtos_critical_section_init(&scheduler_cs);
     PICO_RTOS_LOG_CORE_DEBUG("Scheduler critical section initialized");
     
+#if PICO_RTOS_ENABLE_HEAP
+    // Task stacks come from the heap, so it must exist before any task
+    pico_rtos_heap_init();
+    PICO_RTOS_LOG_CORE_DEBUG("Real-time heap initialized (%d bytes)", PICO_RTOS_HEAP_SIZE);
+#endif
+    
     // Initialize context switching system
     pico_rtos_context_switch_init();
     PICO_RTOS_LOG_CORE_DEBUG("Context switching system initialized");
@@ -220,6 +540,24 @@ bool pico_rtos_init(void) {
     }
     PICO_RTOS_LOG_CORE_DEBUG("Idle task initialized");
     
+#if PICO_RTOS_ENABLE_TIMER_DAEMON
+    // Initialize the task that runs software timer callbacks
+    if (!pico_rtos_timer_daemon_init()) {
+        PICO_RTOS_LOG_CORE_ERROR("Failed to initialize timer service task");
+        return false;
+    }
+    PICO_RTOS_LOG_CORE_DEBUG("Timer service task initialized");
+#endif
+    
+#if PICO_RTOS_ENABLE_DEFERRED_WORK
+    // Initialize the task that runs work deferred from interrupts
+    if (!pico_rtos_deferred_init()) {
+        PICO_RTOS_LOG_CORE_ERROR("Failed to initialize deferred work task");
+        return false;
+    }
+    PICO_RTOS_LOG_CORE_DEBUG("Deferred work task initialized");
+#endif
+    
     // Initialize system timer for tick generation
     pico_rtos_init_system_timer();
     PICO_RTOS_LOG_CORE_INFO("System timer initialized with %lu Hz tick rate", PICO_RTOS_TICK_RATE_HZ);
@@ -239,18 +577,7 @@ void pico_rtos_start(void) {
         scheduler_running = true;
         
         // Find the highest priority task to start with
-        pico_rtos_task_t *highest_priority_task = NULL;
-        pico_rtos_task_t *task = task_list;
-        
-        while (task != NULL) {
-            if (task->state == PICO_RTOS_TASK_STATE_READY) {
-                if (highest_priority_task == NULL || 
-                    task->priority > highest_priority_task->priority) {
-                    highest_priority_task = task;
-                }
-            }
-            task = task->next;
-        }
+        pico_rtos_task_t *highest_priority_task = pico_rtos_scheduler_get_highest_priority_task();
         
         if (highest_priority_task != NULL) {
             PICO_RTOS_LOG_CORE_INFO("Starting first task: %s (priority %lu)", 
@@ -259,7 +586,12 @@ void pico_rtos_start(void) {
             
             // Set current task and update stack pointer
             current_task = highest_priority_task;
-            current_task->state = PICO_RTOS_TASK_STATE_RUNNING;
+            pico_rtos_scheduler_set_task_state(current_task, PICO_RTOS_TASK_STATE_RUNNING);
+            current_task->slice_remaining = pico_rtos_task_quantum(current_task);
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+            current_task->switched_in_us = time_us_64();
+            current_task->context_switch_count++;
+#endif
             current_task_stack_ptr = current_task->stack_ptr;
             
             // Start the first task using assembly function
@@ -269,7 +601,12 @@ void pico_rtos_start(void) {
         }
         
         // We should never reach here unless scheduler is stopped
+#ifdef PICO_RTOS_HOST_PORT
+        PICO_RTOS_LOG_CORE_INFO("Scheduler stopped: no application tasks left");
+        current_task = NULL;
+#else
         PICO_RTOS_LOG_CORE_WARN("Scheduler stopped unexpectedly");
+#endif
         scheduler_running = false;
     } else {
         if (scheduler_running) {
@@ -289,6 +626,43 @@ uint32_t pico_rtos_get_tick_count(void) {
     return tick_count;
 }
 
+// Get tick interrupt cost statistics
+void pico_rtos_get_tick_stats(pico_rtos_tick_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+    
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+    pico_rtos_enter_critical();
+    *stats = tick_stats;
+    if (tick_stats.sample_count > 0) {
+        stats->average_cycles = (uint32_t)(tick_stats_total_cycles / tick_stats.sample_count);
+    }
+    pico_rtos_exit_critical();
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+// Reset tick interrupt cost statistics
+void pico_rtos_reset_tick_stats(void) {
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+    pico_rtos_enter_critical();
+    memset(&tick_stats, 0, sizeof(tick_stats));
+    tick_stats_total_cycles = 0;
+    pico_rtos_exit_critical();
+#endif
+}
+
+// Get the number of periodic tick interrupts taken so far
+uint32_t pico_rtos_get_tick_interrupt_count(void) {
+    uint32_t count;
+    pico_rtos_enter_critical();
+    count = tick_interrupt_count;
+    pico_rtos_exit_critical();
+    return count;
+}
+
 // Get system uptime in milliseconds
 uint32_t pico_rtos_get_uptime_ms(void) {
     return pico_rtos_get_tick_count(); // Use the thread-safe version
@@ -299,6 +673,18 @@ uint32_t pico_rtos_get_tick_rate_hz(void) {
     return PICO_RTOS_TICK_RATE_HZ;
 }
 
+// Set the round-robin time slice for tasks without one of their own
+void pico_rtos_set_time_slice(uint32_t ticks) {
+    pico_rtos_enter_critical();
+    time_slice_ticks = ticks;
+    pico_rtos_exit_critical();
+}
+
+// Get the round-robin time slice for tasks without one of their own
+uint32_t pico_rtos_get_time_slice(void) {
+    return time_slice_ticks;
+}
+
 // Get the RTOS version string
 const char *pico_rtos_get_version_string(void) {
     return version_string;
@@ -321,12 +707,14 @@ void pico_rtos_request_context_switch(void) {
     // If we're in an interrupt, defer the context switch
     if (interrupt_nesting_level > 0) {
         context_switch_pending = true;
-    } else {
-        // Trigger immediate context switch
-        pico_rtos_context_switch();
+        pico_rtos_exit_critical();
+        return;
     }
     
     pico_rtos_exit_critical();
+    
+    // Pick the task now; the port switches to it once interrupts allow
+    pico_rtos_schedule_next_task();
 }
 
 // Called when entering an interrupt
@@ -341,8 +729,7 @@ void pico_rtos_interrupt_exit(void) {
         
         // If this was the last nested interrupt and a context switch is pending
         if (interrupt_nesting_level == 0 && context_switch_pending) {
-            context_switch_pending = false;
-            pico_rtos_context_switch();
+            pico_rtos_schedule_next_task();
         }
     }
 }
@@ -351,171 +738,425 @@ void pico_rtos_interrupt_exit(void) {
 void pico_rtos_init_system_timer(void) {
     // Configure a timer with configurable tick period
     uint32_t tick_period_us = PICO_RTOS_TICK_PERIOD_US;
-    add_alarm_in_us(tick_period_us, (alarm_callback_t)pico_rtos_tick_handler, NULL, true);
+#if PICO_RTOS_ENABLE_TICKLESS_IDLE
+    last_tick_us = time_us_64();
+#endif
+    tick_alarm_id = add_alarm_in_us(tick_period_us, pico_rtos_tick_handler, NULL, true);
 }
 
-// Handle system tick
-static void pico_rtos_tick_handler(void) {
-    pico_rtos_interrupt_enter();
-    pico_rtos_enter_critical();
-    
+// Advance the tick count and process everything that became due
+// (caller holds the critical section)
+static void pico_rtos_tick_advance(uint32_t ticks) {
     // Increment tick counter
-    system_tick_count++;
+    system_tick_count += ticks;
     
-    // Check for any delayed tasks to unblock
-    pico_rtos_task_t *task = task_list;
-    while (task != NULL) {
-        if (task->state == PICO_RTOS_TASK_STATE_BLOCKED && 
-            task->block_reason == PICO_RTOS_BLOCK_REASON_DELAY &&
-            pico_rtos_time_after(system_tick_count, task->delay_until)) {
-            
-            // Task delay has expired, move to ready state
-            task->state = PICO_RTOS_TASK_STATE_READY;
-            task->block_reason = PICO_RTOS_BLOCK_REASON_NONE;
-        }
-        task = task->next;
-    }
+    // Wake delayed tasks whose time has come
+    pico_rtos_delay_list_advance(ticks);
     
     // Check for timer expiry
     pico_rtos_check_timers();
     
-    // Clean up terminated tasks periodically (every 100ms)
-    if (system_tick_count % 100 == 0) {
-        pico_rtos_cleanup_terminated_tasks();
-    }
+#if PICO_RTOS_ENABLE_EDF_SCHEDULING
+    pico_rtos_edf_check_deadline();
+#endif
+    
+    // Rotate equal-priority tasks once the running one has used its slice
+    pico_rtos_time_slice_advance(ticks);
+    
+    // Switch tasks if the current one stopped running or a woken task outranks it
+    pico_rtos_schedule_next_task();
+}
+
+// Handle system tick
+static int64_t pico_rtos_tick_handler(alarm_id_t id, void *user_data) {
+    (void)id;
+    (void)user_data;
     
-    // Check if we need to switch tasks
-    if (current_task->state != PICO_RTOS_TASK_STATE_RUNNING) {
-        pico_rtos_schedule_next_task();
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+    uint32_t start_cycles = pico_rtos_port_get_cycle_count();
+#endif
+    
+    pico_rtos_interrupt_enter();
+    pico_rtos_enter_critical();
+    
+    tick_interrupt_count++;
+#if PICO_RTOS_ENABLE_TICKLESS_IDLE
+    last_tick_us = time_us_64();
+#endif
+    pico_rtos_tick_advance(1);
+    
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+    uint32_t cycles = (pico_rtos_port_get_cycle_count() - start_cycles) & PICO_RTOS_PORT_CYCLE_COUNTER_MASK;
+    tick_stats.last_cycles = cycles;
+    if (cycles > tick_stats.max_cycles) {
+        tick_stats.max_cycles = cycles;
     }
+    tick_stats.sample_count++;
+    tick_stats_total_cycles += cycles;
+#endif
     
     pico_rtos_exit_critical();
     pico_rtos_interrupt_exit();
     
     // Re-add the alarm for the next tick
     uint32_t tick_period_us = PICO_RTOS_TICK_PERIOD_US;
-    add_alarm_in_us(tick_period_us, (alarm_callback_t)pico_rtos_tick_handler, NULL, true);
+    tick_alarm_id = add_alarm_in_us(tick_period_us, pico_rtos_tick_handler, NULL, true);
+    return 0;
+}
+
+#if PICO_RTOS_ENABLE_TICKLESS_IDLE
+// The wakeup alarm only has to end __wfi(); the idle task does the bookkeeping
+static int64_t pico_rtos_tickless_wakeup_handler(alarm_id_t id, void *user_data) {
+    (void)id;
+    (void)user_data;
+    return 0;
+}
+
+// Number of ticks until the kernel next has work to do (caller holds the
+// critical section). Considers delayed tasks and timed waits (both at the
+// head of the delay list), software timers and high-resolution timers.
+static uint32_t pico_rtos_tickless_ticks_until_next_event(void) {
+    uint32_t ticks = PICO_RTOS_TICKLESS_MAX_IDLE_TICKS;
+    
+    if (delay_list != NULL && delay_list->delay_delta < ticks) {
+        ticks = delay_list->delay_delta;
+    }
+    
+    ticks = pico_rtos_timer_wheel_ticks_until_next(ticks);
+    
+#ifdef PICO_RTOS_ENABLE_HIRES_TIMERS
+    // High-resolution timers have their own alarm; waking with them keeps
+    // the tick count current for anything their callbacks release
+    uint64_t hires_expiry = pico_rtos_hires_timer_get_next_expiration();
+    if (hires_expiry != 0) {
+        uint64_t now_us = time_us_64();
+        uint64_t remaining_us = (hires_expiry > now_us) ? (hires_expiry - now_us) : 0;
+        uint64_t remaining = remaining_us / PICO_RTOS_TICK_PERIOD_US;
+        if (remaining < ticks) {
+            ticks = (uint32_t)remaining;
+        }
+    }
+#endif
+    
+    return ticks;
 }
 
+// Sleep through idle periods with a single alarm instead of periodic ticks
+static void pico_rtos_tickless_idle(void) {
+    // Interrupts on this core stay masked from the decision to sleep until
+    // the tick count is current again, so none is serviced in between; a
+    // pending one still ends __wfi()
+    uint32_t irq_status = save_and_disable_interrupts();
+    pico_rtos_enter_critical();
+    
+    uint32_t idle_ticks = pico_rtos_tickless_ticks_until_next_event();
+    if (idle_ticks < PICO_RTOS_TICKLESS_MIN_IDLE_TICKS || pico_rtos_ready_queue_highest() != NULL) {
+        // Not worth stopping the tick, or something became ready meanwhile
+        pico_rtos_exit_critical();
+        restore_interrupts(irq_status);
+        __wfi();
+        return;
+    }
+    
+    cancel_alarm(tick_alarm_id);
+    uint64_t wakeup_us = last_tick_us + (uint64_t)idle_ticks * PICO_RTOS_TICK_PERIOD_US;
+    alarm_id_t wakeup_alarm = add_alarm_at(wakeup_us, pico_rtos_tickless_wakeup_handler, NULL, true);
+    
+    // Let go of the scheduler lock while asleep so the other core is not
+    // left spinning on it
+    pico_rtos_exit_critical();
+    __wfi();
+    pico_rtos_enter_critical();
+    
+    if (wakeup_alarm > 0) {
+        cancel_alarm(wakeup_alarm);
+    }
+    
+    // Account for every whole tick that passed while asleep in one step
+    uint32_t elapsed_ticks = (uint32_t)((time_us_64() - last_tick_us) / PICO_RTOS_TICK_PERIOD_US);
+    last_tick_us += (uint64_t)elapsed_ticks * PICO_RTOS_TICK_PERIOD_US;
+    
+    // Resume periodic ticks aligned to the original tick phase
+    tick_alarm_id = add_alarm_at(last_tick_us + PICO_RTOS_TICK_PERIOD_US, pico_rtos_tick_handler, NULL, true);
+    
+    if (elapsed_ticks > 0) {
+        pico_rtos_tick_advance(elapsed_ticks);
+    }
+    
+    pico_rtos_exit_critical();
+    restore_interrupts(irq_status);
+}
+#endif // PICO_RTOS_ENABLE_TICKLESS_IDLE
+
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+// Charge the outgoing task for its run and start timing the incoming one
+// (caller holds the critical section)
+static void pico_rtos_account_switch(pico_rtos_task_t *old_task, pico_rtos_task_t *new_task) {
+    uint64_t now = time_us_64();
+    old_task->cpu_time_us += now - old_task->switched_in_us;
+    if (old_task->state == PICO_RTOS_TASK_STATE_READY) {
+        old_task->preemption_count++;
+    }
+    new_task->switched_in_us = now;
+    new_task->context_switch_count++;
+}
+#endif
+
 // Schedule the next task to run
 void pico_rtos_schedule_next_task(void) {
+    // Nothing to switch between until pico_rtos_start() picked the first task
+    if (!scheduler_running || current_task == NULL) {
+        return;
+    }
+    
+    pico_rtos_enter_critical();
+    
+    // Any switch an interrupt asked for is decided here
+    context_switch_pending = false;
+    
     // Find the highest priority task that is ready to run
-    pico_rtos_task_t *highest_priority_task = pico_rtos_scheduler_get_highest_priority_task();
+    pico_rtos_task_t *highest_priority_task = pico_rtos_ready_queue_highest();
+    
+    // The running task is not in the ready set; keep it unless it is outranked
+    if (current_task->state == PICO_RTOS_TASK_STATE_RUNNING &&
+        (highest_priority_task == NULL || !pico_rtos_task_outranks(highest_priority_task, current_task))) {
+        pico_rtos_exit_critical();
+        return;
+    }
     
     // If no tasks are ready, run the idle task
     if (highest_priority_task == NULL) {
         highest_priority_task = &idle_task;
-        idle_task.state = PICO_RTOS_TASK_STATE_READY;
     }
     
-    // Switch to the highest priority task if it's different from current
-    if (current_task != highest_priority_task) {
-        pico_rtos_task_t *old_task = current_task;
-        
-        // Update task states
-        if (old_task != NULL && old_task->state != PICO_RTOS_TASK_STATE_TERMINATED) {
-            if (old_task->state == PICO_RTOS_TASK_STATE_RUNNING) {
-                old_task->state = PICO_RTOS_TASK_STATE_READY;
+    pico_rtos_task_t *old_task = current_task;
+    
+    // A preempted task goes to the back of its ready queue
+    if (old_task->state == PICO_RTOS_TASK_STATE_RUNNING) {
+        pico_rtos_scheduler_set_task_state(old_task, PICO_RTOS_TASK_STATE_READY);
+    }
+    
+    // Switch to new task
+    current_task = highest_priority_task;
+    pico_rtos_scheduler_set_task_state(current_task, PICO_RTOS_TASK_STATE_RUNNING);
+    
+    // Perform actual context switch if the task changed
+    if (old_task != current_task) {
+        current_task->slice_remaining = pico_rtos_task_quantum(current_task);
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+        pico_rtos_account_switch(old_task, current_task);
+#endif
+        pico_rtos_perform_context_switch(old_task, current_task);
+    }
+    
+    pico_rtos_exit_critical();
+}
+
+// Link a timer into a wheel slot list
+static void pico_rtos_timer_wheel_link(pico_rtos_timer_t **slot, pico_rtos_timer_t *timer) {
+    timer->wheel_next = *slot;
+    if (*slot != NULL) {
+        (*slot)->wheel_pprev = &timer->wheel_next;
+    }
+    timer->wheel_pprev = slot;
+    *slot = timer;
+}
+
+// Unlink a timer from whichever slot list holds it
+static void pico_rtos_timer_wheel_unlink(pico_rtos_timer_t *timer) {
+    if (timer->wheel_pprev == NULL) {
+        return;
+    }
+    *timer->wheel_pprev = timer->wheel_next;
+    if (timer->wheel_next != NULL) {
+        timer->wheel_next->wheel_pprev = timer->wheel_pprev;
+    }
+    timer->wheel_next = NULL;
+    timer->wheel_pprev = NULL;
+}
+
+// Put a timer in the slot matching its expiry (caller holds the critical section)
+static void pico_rtos_timer_wheel_place(pico_rtos_timer_t *timer) {
+    uint32_t expiry = timer->expiry_time;
+    uint32_t delta = expiry - timer_wheel_next_tick;
+    
+    if ((int32_t)delta < 0) {
+        // Already due: fire on the next processed tick
+        pico_rtos_timer_wheel_link(&timer_wheel_root[timer_wheel_next_tick & TIMER_WHEEL_ROOT_MASK], timer);
+        return;
+    }
+    
+    if (delta < TIMER_WHEEL_ROOT_SIZE) {
+        pico_rtos_timer_wheel_link(&timer_wheel_root[expiry & TIMER_WHEEL_ROOT_MASK], timer);
+        return;
+    }
+    
+    if (delta > TIMER_WHEEL_MAX_DELTA) {
+        // Beyond the wheel: park in the farthest slot and re-place on the way down
+        expiry = timer_wheel_next_tick + TIMER_WHEEL_MAX_DELTA;
+        delta = TIMER_WHEEL_MAX_DELTA;
+    }
+    
+    uint32_t level = 0;
+    while (delta >= (1u << TIMER_WHEEL_LEVEL_SHIFT(level + 1))) {
+        level++;
+    }
+    uint32_t index = (expiry >> TIMER_WHEEL_LEVEL_SHIFT(level)) & TIMER_WHEEL_LEVEL_MASK;
+    pico_rtos_timer_wheel_link(&timer_wheel_levels[level][index], timer);
+}
+
+// Move every timer of an outer slot one level closer; returns the slot index
+static uint32_t pico_rtos_timer_wheel_cascade(uint32_t level, uint32_t tick) {
+    uint32_t index = (tick >> TIMER_WHEEL_LEVEL_SHIFT(level)) & TIMER_WHEEL_LEVEL_MASK;
+    pico_rtos_timer_t *timer = timer_wheel_levels[level][index];
+    timer_wheel_levels[level][index] = NULL;
+    
+    while (timer != NULL) {
+        pico_rtos_timer_t *next = timer->wheel_next;
+        timer->wheel_next = NULL;
+        timer->wheel_pprev = NULL;
+        pico_rtos_timer_wheel_place(timer);
+        timer = next;
+    }
+    return index;
+}
+
+// Arm a timer at its expiry_time, replacing any previous arming (thread-safe)
+void pico_rtos_timer_wheel_arm(pico_rtos_timer_t *timer) {
+    if (timer == NULL) {
+        return;
+    }
+    
+    pico_rtos_enter_critical();
+    pico_rtos_timer_wheel_unlink(timer);
+    pico_rtos_timer_wheel_place(timer);
+    pico_rtos_exit_critical();
+}
+
+// Take a timer off the wheel (thread-safe)
+void pico_rtos_timer_wheel_disarm(pico_rtos_timer_t *timer) {
+    if (timer == NULL) {
+        return;
+    }
+    
+    pico_rtos_enter_critical();
+    pico_rtos_timer_wheel_unlink(timer);
+    pico_rtos_exit_critical();
+}
+
+#if PICO_RTOS_ENABLE_TICKLESS_IDLE
+// Ticks from now until the wheel next fires a timer or has to redistribute
+// an outer slot, capped at limit (caller holds the critical section)
+static uint32_t pico_rtos_timer_wheel_ticks_until_next(uint32_t limit) {
+    uint32_t base = timer_wheel_next_tick;
+    uint32_t boundary = (base + TIMER_WHEEL_ROOT_MASK) & ~TIMER_WHEEL_ROOT_MASK;
+    uint32_t next = system_tick_count + limit;
+    
+    // Root slots hold exact ticks; all of them lie before the second boundary
+    for (uint32_t k = 0; k < TIMER_WHEEL_ROOT_SIZE; k++) {
+        if (timer_wheel_root[(base + k) & TIMER_WHEEL_ROOT_MASK] != NULL) {
+            if (pico_rtos_time_after(next, base + k)) {
+                next = base + k;
             }
+            break;
+        }
+    }
+    
+    // Timers cascading down at a boundary can be due at that boundary
+    for (uint32_t b = boundary; pico_rtos_time_after(next, b); b += TIMER_WHEEL_ROOT_SIZE) {
+        uint32_t index = (b >> TIMER_WHEEL_LEVEL_SHIFT(0)) & TIMER_WHEEL_LEVEL_MASK;
+        if (index == 0 || timer_wheel_levels[0][index] != NULL) {
+            // Outer levels move too when the first one wraps; wake to be safe
+            next = b;
+            break;
         }
-        
-        // Switch to new task
-        current_task = highest_priority_task;
-        current_task->state = PICO_RTOS_TASK_STATE_RUNNING;
-        
-        // Perform actual context switch
-        pico_rtos_perform_context_switch(old_task, current_task);
     }
+    
+    return next - system_tick_count;
 }
+#endif // PICO_RTOS_ENABLE_TICKLESS_IDLE
 
-// Check and process expired timers
+// Process every wheel tick up to the current tick count, running the
+// callbacks of the timers that fire or handing them to the timer service
+// task (caller holds the critical section)
 void pico_rtos_check_timers(void) {
-    pico_rtos_timer_t *timer = timer_list;
-    uint32_t current_time = system_tick_count;
-    
-    // List to store expired timers to execute callbacks outside critical section
-    pico_rtos_timer_t *expired_timers[16]; // Support up to 16 expired timers per tick
-    int expired_count = 0;
-    
-    while (timer != NULL && expired_count < 16) {
-        // Handle timer overflow by checking if expiry time has passed
-        bool timer_expired = false;
-        if (timer->running && !timer->expired) {
-            // Handle 32-bit overflow: if current_time wrapped around but expiry_time didn't,
-            // or if both are in normal range and current >= expiry
-            if ((current_time < timer->start_time && timer->expiry_time >= timer->start_time) ||
-                (current_time >= timer->start_time && current_time >= timer->expiry_time)) {
-                timer_expired = true;
+    while (!pico_rtos_time_after(timer_wheel_next_tick, system_tick_count)) {
+        uint32_t tick = timer_wheel_next_tick;
+        uint32_t index = tick & TIMER_WHEEL_ROOT_MASK;
+        
+        // Refill the root level from the outer levels when it wraps
+        if (index == 0) {
+            for (uint32_t level = 0; level < TIMER_WHEEL_OUTER_LEVELS; level++) {
+                if (pico_rtos_timer_wheel_cascade(level, tick) != 0) {
+                    break;
+                }
             }
         }
+        timer_wheel_next_tick = tick + 1;
         
-        if (timer_expired) {
-            // Timer has expired
-            timer->expired = true;
-            
-            // Add to expired list for callback execution
-            if (timer->callback != NULL) {
-                expired_timers[expired_count++] = timer;
-            }
+        // Detach the slot so that timers re-armed by callbacks cannot land in it
+        pico_rtos_timer_t *expired = timer_wheel_root[index];
+        timer_wheel_root[index] = NULL;
+        if (expired != NULL) {
+            expired->wheel_pprev = &expired;
+        }
+        
+        while (expired != NULL) {
+            pico_rtos_timer_t *timer = expired;
+            pico_rtos_timer_wheel_unlink(timer);
             
-            // Handle auto-reload
+            // Handle auto-reload, keeping the period anchored to the expiry tick
             if (timer->auto_reload) {
                 timer->expired = false;
-                timer->start_time = current_time;
-                timer->expiry_time = current_time + timer->period;
+                timer->start_time = tick;
+                timer->expiry_time = tick + timer->period;
+                pico_rtos_timer_wheel_place(timer);
             } else {
+                timer->expired = true;
                 timer->running = false;
             }
-        }
-        timer = timer->next;
-    }
-    
-    // Execute timer callbacks outside critical section to prevent deadlocks
-    if (expired_count > 0) {
-        pico_rtos_exit_critical();
-        
-        for (int i = 0; i < expired_count; i++) {
-            if (expired_timers[i]->callback != NULL) {
-                expired_timers[i]->callback(expired_timers[i]->param);
+            
+            if (timer->callback != NULL) {
+#if PICO_RTOS_ENABLE_TIMER_DAEMON
+                pico_rtos_timer_daemon_defer(timer);
+#else
+                // Execute timer callbacks outside critical section to prevent deadlocks;
+                // a callback stopping a timer still in this slot unlinks it from here
+                pico_rtos_exit_critical();
+                timer->callback(timer->param);
+                pico_rtos_enter_critical();
+#endif
             }
         }
-        
-        pico_rtos_enter_critical();
     }
+    
+#if PICO_RTOS_ENABLE_TIMER_DAEMON
+    // One wakeup covers every timer that expired during this call
+    pico_rtos_timer_daemon_flush();
+#endif
 }
 
 // Get the current task (thread-safe)
 pico_rtos_task_t *pico_rtos_get_current_task(void) {
-    pico_rtos_task_t *task;
-    pico_rtos_enter_critical();
-    task = current_task;
-    pico_rtos_exit_critical();
-    return task;
+    // A single aligned pointer load needs no critical section, and a task
+    // asking always reads itself however it races with a switch
+    return current_task;
 }
 
 // Add a task to the scheduler
 void pico_rtos_scheduler_add_task(pico_rtos_task_t *task) {
     pico_rtos_enter_critical();
     
-    // Add task to the task list
-    if (task_list == NULL) {
-        task_list = task;
-    } else {
-        // Add to the end of the list
-        pico_rtos_task_t *last_task = task_list;
-        while (last_task->next != NULL) {
-            last_task = last_task->next;
-        }
-        last_task->next = task;
-    }
-    
-    task->next = NULL;
-    task->state = PICO_RTOS_TASK_STATE_READY;
+    // Add task to the task list and make it ready
+    pico_rtos_task_list_append(task);
+    pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_READY);
     
     pico_rtos_exit_critical();
 }
 
-// Remove a task from the scheduler and clean up its resources
+// Remove a task from the scheduler and move it to the zombie list, where
+// the idle task frees its stack. The stack stays valid until then, so a
+// task may retire itself and keep running until it is switched out.
 void pico_rtos_scheduler_remove_task(pico_rtos_task_t *task) {
     if (task == NULL) {
         return;
@@ -523,91 +1164,180 @@ void pico_rtos_scheduler_remove_task(pico_rtos_task_t *task) {
     
     pico_rtos_enter_critical();
     
-    // Find and remove the task from the list
-    if (task_list == task) {
-        // Removing the first task
-        task_list = task->next;
-    } else {
-        // Find the task in the list
-        pico_rtos_task_t *prev = task_list;
-        while (prev != NULL && prev->next != task) {
-            prev = prev->next;
-        }
-        
-        if (prev != NULL) {
-            prev->next = task->next;
-        }
+    // Find and remove the task from the list; a task that is not there has
+    // already been retired
+    pico_rtos_task_t *prev = NULL;
+    pico_rtos_task_t *current = task_list;
+    while (current != NULL && current != task) {
+        prev = current;
+        current = current->next;
     }
     
-    // Clean up task resources
-    if (task->auto_delete && task->stack_base != NULL) {
-        pico_rtos_free(task->stack_base, task->stack_size);
-        task->stack_base = NULL;
-        task->stack_ptr = NULL;
-    }
+    pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_TERMINATED);
     
-    // Clear task fields
-    task->next = NULL;
-    task->state = PICO_RTOS_TASK_STATE_TERMINATED;
+    if (current != NULL) {
+        pico_rtos_task_list_unlink(prev, task);
+        task->next = zombie_list;
+        zombie_list = task;
+        zombie_count++;
+    }
     
     pico_rtos_exit_critical();
 }
 
-// Clean up terminated tasks
-void pico_rtos_cleanup_terminated_tasks(void) {
+// Release a terminated task's stack (the task is already off every list)
+static void pico_rtos_release_task_stack(pico_rtos_task_t *task) {
     pico_rtos_enter_critical();
+    uint32_t *stack = task->auto_delete ? task->stack_base : NULL;
+    if (stack != NULL) {
+        task->stack_base = NULL;
+        task->stack_ptr = NULL;
+    }
+    pico_rtos_exit_critical();
     
-    pico_rtos_task_t *prev = NULL;
-    pico_rtos_task_t *current = task_list;
+    // The allocator runs with interrupts enabled
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+    if (stack != NULL) {
+        pico_rtos_free(stack, task->stack_size);
+    }
+#endif
+}
+
+// Free the stacks of up to max_tasks terminated tasks (task context only)
+uint32_t pico_rtos_reap_terminated_tasks(uint32_t max_tasks) {
+    uint32_t reaped = 0;
     
-    while (current != NULL) {
-        pico_rtos_task_t *next = current->next;
-        
-        if (current->state == PICO_RTOS_TASK_STATE_TERMINATED) {
-            // Remove from list
-            if (prev == NULL) {
-                task_list = next;
-            } else {
-                prev->next = next;
-            }
-            
-            // Clean up resources
-            if (current->auto_delete && current->stack_base != NULL) {
-                pico_rtos_free(current->stack_base, current->stack_size);
-                current->stack_base = NULL;
-                current->stack_ptr = NULL;
-            }
-            
-            // Don't advance prev since we removed current
-        } else {
-            prev = current;
+    while (reaped < max_tasks) {
+        pico_rtos_enter_critical();
+        pico_rtos_task_t *task = zombie_list;
+        if (task != NULL) {
+            zombie_list = task->next;
+            zombie_count--;
+            task->next = NULL;
         }
+        pico_rtos_exit_critical();
         
-        current = next;
+        if (task == NULL) {
+            break;
+        }
+        pico_rtos_release_task_stack(task);
+        reaped++;
     }
     
+    return reaped;
+}
+
+// Reap one task right away if it is still waiting on the zombie list, so
+// its control block can be reused
+void pico_rtos_reap_task(pico_rtos_task_t *task) {
+    pico_rtos_enter_critical();
+    pico_rtos_task_t **link = &zombie_list;
+    while (*link != NULL && *link != task) {
+        link = &(*link)->next;
+    }
+    bool found = (*link != NULL);
+    if (found) {
+        *link = task->next;
+        zombie_count--;
+        task->next = NULL;
+    }
+    pico_rtos_exit_critical();
+    
+    if (found) {
+        pico_rtos_release_task_stack(task);
+    }
+}
+
+// Clean up terminated tasks
+void pico_rtos_cleanup_terminated_tasks(void) {
+    pico_rtos_reap_terminated_tasks(UINT32_MAX);
+}
+
+// Get the number of terminated tasks waiting to be reaped
+uint32_t pico_rtos_get_terminated_task_count(void) {
+    pico_rtos_enter_critical();
+    uint32_t count = zombie_count;
     pico_rtos_exit_critical();
+    return count;
 }
 
 // Get the highest priority task (thread-safe)
 pico_rtos_task_t *pico_rtos_scheduler_get_highest_priority_task(void) {
     pico_rtos_enter_critical();
+    pico_rtos_task_t *highest_priority_task = pico_rtos_ready_queue_highest();
+    pico_rtos_exit_critical();
+    return highest_priority_task;
+}
+
+// Change a task's state, keeping the ready queues in sync (thread-safe)
+void pico_rtos_scheduler_set_task_state(pico_rtos_task_t *task, pico_rtos_task_state_t state) {
+    if (task == NULL) {
+        return;
+    }
     
-    pico_rtos_task_t *highest_priority_task = NULL;
-    pico_rtos_task_t *task = task_list;
+    pico_rtos_enter_critical();
+    task->state = state;
+    if (state == PICO_RTOS_TASK_STATE_READY) {
+        pico_rtos_ready_queue_insert(task);
+    } else {
+        pico_rtos_ready_queue_remove(task);
+    }
+    // Any state change ends a pending delay; pico_rtos_scheduler_delay_task()
+    // re-links the task afterwards
+    pico_rtos_delay_list_remove(task);
+    pico_rtos_exit_critical();
+}
+
+// Block a task for the given number of ticks (thread-safe)
+void pico_rtos_scheduler_delay_task(pico_rtos_task_t *task, uint32_t ticks) {
+    if (task == NULL) {
+        return;
+    }
     
-    while (task != NULL) {
-        if (task->state == PICO_RTOS_TASK_STATE_READY) {
-            if (highest_priority_task == NULL || 
-                task->priority > highest_priority_task->priority) {
-                highest_priority_task = task;
-            }
-        }
-        task = task->next;
+    pico_rtos_enter_critical();
+    pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_BLOCKED);
+    task->block_reason = PICO_RTOS_BLOCK_REASON_DELAY;
+    task->delay_until = system_tick_count + ticks;
+    
+    // The task wakes on the first tick after delay_until
+    pico_rtos_delay_list_insert(task, (ticks == UINT32_MAX) ? ticks : ticks + 1);
+    pico_rtos_exit_critical();
+}
+
+// Time out a task's wait on a blocking object or a notification after the
+// given number of ticks unless it is woken first (thread-safe). Timed waits
+// share the delay list with delayed tasks, so the tick expires them across
+// all objects without scanning any wait list.
+void pico_rtos_scheduler_timeout_task(pico_rtos_task_t *task, uint32_t ticks) {
+    if (task == NULL || ticks == PICO_RTOS_WAIT_FOREVER) {
+        return;
     }
     
+    pico_rtos_enter_critical();
+    task->delay_until = system_tick_count + ticks;
+    
+    // Like a delay, the wait ends on the first tick after delay_until
+    pico_rtos_delay_list_remove(task);
+    pico_rtos_delay_list_insert(task, ticks + 1);
+    pico_rtos_exit_critical();
+}
+
+// Change a task's effective priority, moving it between ready queues (thread-safe)
+void pico_rtos_scheduler_set_task_priority(pico_rtos_task_t *task, uint32_t priority) {
+    if (task == NULL) {
+        return;
+    }
+    
+    pico_rtos_enter_critical();
+    bool queued = (task->ready_next != NULL);
+    if (queued) {
+        pico_rtos_ready_queue_remove(task);
+    }
+    task->priority = priority;
+    if (queued) {
+        pico_rtos_ready_queue_insert(task);
+    }
     pico_rtos_exit_critical();
-    return highest_priority_task;
 }
 
 // Add a timer to the timer list
@@ -652,6 +1382,8 @@ void pico_rtos_remove_timer(pico_rtos_timer_t *timer) {
     
     pico_rtos_enter_critical();
     
+    pico_rtos_timer_wheel_unlink(timer);
+    
     // Find and remove the timer from the list
     if (timer_list == timer) {
         // Removing the first timer
@@ -699,15 +1431,20 @@ void pico_rtos_task_resume_highest_priority(void) {
     // It should trigger a context switch if a higher priority task becomes ready
     pico_rtos_task_t *highest_priority_task = pico_rtos_scheduler_get_highest_priority_task();
     if (highest_priority_task != NULL && 
-        (current_task == NULL || highest_priority_task->priority > current_task->priority)) {
+        (current_task == NULL || pico_rtos_task_outranks(highest_priority_task, current_task))) {
         // Trigger a context switch to the higher priority task
         pico_rtos_context_switch();
     }
 }
 
 // Memory tracking functions
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
 void *pico_rtos_malloc(size_t size) {
+#if PICO_RTOS_ENABLE_HEAP
+    void *ptr = pico_rtos_heap_alloc(size);
+#else
     void *ptr = malloc(size);
+#endif
     if (ptr != NULL) {
         pico_rtos_enter_critical();
         total_allocated_memory += size;
@@ -722,7 +1459,14 @@ void *pico_rtos_malloc(size_t size) {
 
 void pico_rtos_free(void *ptr, size_t size) {
     if (ptr != NULL) {
+#if PICO_RTOS_ENABLE_HEAP
+        // A rejected pointer was never counted, so leave the totals alone
+        if (!pico_rtos_heap_free(ptr)) {
+            return;
+        }
+#else
         free(ptr);
+#endif
         pico_rtos_enter_critical();
         if (total_allocated_memory >= size) {
             total_allocated_memory -= size;
@@ -730,6 +1474,7 @@ void pico_rtos_free(void *ptr, size_t size) {
         pico_rtos_exit_critical();
     }
 }
+#endif // !PICO_RTOS_STATIC_ALLOCATION_ONLY
 
 // Get memory statistics
 void pico_rtos_get_memory_stats(uint32_t *current, uint32_t *peak, uint32_t *allocations) {
@@ -788,6 +1533,9 @@ void pico_rtos_get_system_stats(pico_rtos_system_stats_t *stats) {
         task = task->next;
     }
     
+    // Ended tasks leave the task list straight away but stay counted until reaped
+    stats->terminated_tasks += zombie_count;
+    
     // Get memory statistics
     stats->current_memory = total_allocated_memory;
     stats->peak_memory = peak_allocated_memory;
@@ -867,6 +1615,15 @@ pico_rtos_task_t *pico_rtos_debug_get_task_list(void) {
     return list;
 }
 
+/**
+ * @brief Get the idle task (for debug system)
+ * 
+ * @return Pointer to the idle task
+ */
+pico_rtos_task_t *pico_rtos_debug_get_idle_task(void) {
+    return &idle_task;
+}
+
 /**
  * @brief Get the current system tick count (for debug system)
  * 
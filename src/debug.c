@@ -96,21 +96,6 @@ static pico_rtos_task_t *find_task_in_list(pico_rtos_task_t *target_task) {
     return NULL;
 }
 
-/**
- * @brief Count total tasks in the system
- */
-static uint32_t count_total_tasks(void) {
-    uint32_t count = 0;
-    pico_rtos_task_t *task = pico_rtos_debug_get_task_list();
-    
-    while (task) {
-        count++;
-        task = task->next;
-    }
-    
-    return count;
-}
-
 /**
  * @brief Count tasks by state
  */
@@ -194,10 +179,11 @@ bool pico_rtos_debug_get_task_info(pico_rtos_task_t *task, pico_rtos_task_info_t
         info->stack_usage_percent = 0.0f;
     }
     
-    // Runtime statistics (these would need to be tracked in the task structure)
-    // For now, we'll use placeholder values since the task structure doesn't have these fields yet
-    info->cpu_time_us = 0; // Would need to be tracked during context switches
-    info->context_switches = 0; // Would need to be tracked during context switches
+    // Runtime statistics, kept by the scheduler at every context switch
+    pico_rtos_task_runtime_stats_t runtime;
+    pico_rtos_task_get_runtime_stats(task, &runtime);
+    info->cpu_time_us = runtime.cpu_time_us;
+    info->context_switches = runtime.context_switches;
     info->last_run_time = pico_rtos_debug_get_system_tick_count();
     info->creation_time = 0; // Would need to be set during task creation
     
@@ -260,10 +246,18 @@ bool pico_rtos_debug_get_system_inspection(pico_rtos_system_inspection_t *summar
     summary->total_stack_used = 0;
     summary->highest_stack_usage_percent = 0.0f;
     
+    summary->total_context_switches = 0;
+    summary->total_cpu_time_us = 0;
+    
     pico_rtos_task_t *task = pico_rtos_debug_get_task_list();
     while (task) {
         summary->total_stack_allocated += task->stack_size;
         
+        pico_rtos_task_runtime_stats_t runtime;
+        pico_rtos_task_get_runtime_stats(task, &runtime);
+        summary->total_context_switches += runtime.context_switches;
+        summary->total_cpu_time_us += runtime.cpu_time_us;
+        
         uint32_t current_usage, peak_usage, free_space;
         if (pico_rtos_debug_calculate_stack_usage(task, &current_usage, &peak_usage, &free_space)) {
             summary->total_stack_used += current_usage;
@@ -276,10 +270,6 @@ bool pico_rtos_debug_get_system_inspection(pico_rtos_system_inspection_t *summar
         task = task->next;
     }
     
-    // Runtime statistics
-    summary->total_context_switches = 0; // Would need to be tracked globally
-    summary->total_cpu_time_us = 0; // Would need to be tracked globally
-    
     summary->inspection_timestamp = pico_rtos_debug_get_system_tick_count();
     
     pico_rtos_exit_critical();
@@ -434,8 +424,7 @@ bool pico_rtos_debug_reset_task_stats(pico_rtos_task_t *task) {
         return false;
     }
     
-    // Reset statistics (would need to be implemented in task structure)
-    // For now, this is a placeholder
+    pico_rtos_task_reset_runtime_stats(task);
     
     return true;
 }
@@ -464,9 +453,29 @@ float pico_rtos_debug_get_task_cpu_usage(pico_rtos_task_t *task, uint32_t period
         return 0.0f;
     }
     
-    // This would need to be implemented with proper CPU time tracking
-    // For now, return a placeholder value
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+    if (period_ms == 0) {
+        // Since the last reset; tasks created later are measured from creation
+        pico_rtos_task_runtime_stats_t runtime;
+        pico_rtos_task_get_runtime_stats(task, &runtime);
+        uint64_t since = (task->cpu_window.start_us > last_stats_reset_time) ?
+                         task->cpu_window.start_us : last_stats_reset_time;
+        uint64_t elapsed = get_time_us() - since;
+        return (elapsed > 0) ? (float)runtime.cpu_time_us * 100.0f / (float)elapsed : 0.0f;
+    }
+    
+    // Usage over the last completed window of at least period_ms
+    pico_rtos_enter_critical();
+    if (get_time_us() - task->cpu_window.start_us >= (uint64_t)period_ms * 1000u) {
+        pico_rtos_task_sample_cpu_usage(task, &task->cpu_window);
+    }
+    float usage = task->cpu_window.usage_percent;
+    pico_rtos_exit_critical();
+    return usage;
+#else
+    (void)period_ms;
     return 0.0f;
+#endif
 }
 
 uint32_t pico_rtos_debug_get_system_cpu_usage(float *task_usage, uint32_t max_tasks, 
@@ -486,10 +495,9 @@ uint32_t pico_rtos_debug_get_system_cpu_usage(float *task_usage, uint32_t max_ta
         task = task->next;
     }
     
-    pico_rtos_exit_critical();
+    *idle_percentage = pico_rtos_debug_get_task_cpu_usage(pico_rtos_debug_get_idle_task(), 0);
     
-    // Calculate idle percentage (placeholder)
-    *idle_percentage = 50.0f; // Would need proper calculation
+    pico_rtos_exit_critical();
     
     return task_count;
 }
@@ -531,6 +539,14 @@ const char *pico_rtos_debug_block_reason_to_string(pico_rtos_block_reason_t reas
             return "MUTEX";
         case PICO_RTOS_BLOCK_REASON_EVENT_GROUP:
             return "EVENT_GROUP";
+        case PICO_RTOS_BLOCK_REASON_STREAM_BUFFER:
+            return "STREAM_BUFFER";
+        case PICO_RTOS_BLOCK_REASON_NOTIFICATION:
+            return "NOTIFICATION";
+        case PICO_RTOS_BLOCK_REASON_RWLOCK:
+            return "RWLOCK";
+        case PICO_RTOS_BLOCK_REASON_QUEUE_SET:
+            return "QUEUE_SET";
         default:
             return "UNKNOWN";
     }
@@ -551,12 +567,12 @@ uint32_t pico_rtos_debug_format_task_info(const pico_rtos_task_info_t *info,
         "  CPU Time: %llu us\n"
         "  Context Switches: %lu\n",
         info->name,
-        info->priority, info->original_priority,
+        (unsigned long)info->priority, (unsigned long)info->original_priority,
         pico_rtos_debug_task_state_to_string(info->state),
         pico_rtos_debug_block_reason_to_string(info->block_reason),
-        info->stack_usage, info->stack_size, info->stack_usage_percent, info->stack_free,
-        info->cpu_time_us,
-        info->context_switches
+        (unsigned long)info->stack_usage, (unsigned long)info->stack_size, info->stack_usage_percent, (unsigned long)info->stack_free,
+        (unsigned long long)info->cpu_time_us,
+        (unsigned long)info->context_switches
     );
 }
 
@@ -576,17 +592,17 @@ void pico_rtos_debug_print_system_inspection(const pico_rtos_system_inspection_t
     }
     
     printf("System Inspection Summary:\n");
-    printf("  Total Tasks: %lu\n", summary->total_tasks);
+    printf("  Total Tasks: %lu\n", (unsigned long)summary->total_tasks);
     printf("  Task States: Ready=%lu, Running=%lu, Blocked=%lu, Suspended=%lu, Terminated=%lu\n",
-           summary->ready_tasks, summary->running_tasks, summary->blocked_tasks,
-           summary->suspended_tasks, summary->terminated_tasks);
+           (unsigned long)summary->ready_tasks, (unsigned long)summary->running_tasks, (unsigned long)summary->blocked_tasks,
+           (unsigned long)summary->suspended_tasks, (unsigned long)summary->terminated_tasks);
     printf("  Stack Usage: %lu/%lu bytes allocated, highest usage %.1lu%%\n",
-           summary->total_stack_used, summary->total_stack_allocated,
-           summary->highest_stack_usage_percent);
+           (unsigned long)summary->total_stack_used, (unsigned long)summary->total_stack_allocated,
+           (unsigned long)summary->highest_stack_usage_percent);
     printf("  Runtime: %lu context switches, %llu us total CPU time\n",
-           summary->total_context_switches, summary->total_cpu_time_us);
+           (unsigned long)summary->total_context_switches, (unsigned long long)summary->total_cpu_time_us);
     printf("  Inspection took %lu us at tick %lu\n",
-           summary->inspection_time_us, summary->inspection_timestamp);
+           (unsigned long)summary->inspection_time_us, (unsigned long)summary->inspection_timestamp);
 }
 
 #endif // PICO_RTOS_ENABLE_DEBUG
\ No newline at end of file
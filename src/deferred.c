@@ -0,0 +1,193 @@
+#include "pico_rtos/deferred.h"
+#include "pico_rtos.h"
+#include "pico_rtos/context_switch.h"
+#include "hardware/sync.h"
+
+/**
+ * @file deferred.c
+ * @brief Deferred interrupt work queue
+ *
+ * Items live in a fixed ring indexed by free-running counters: producers
+ * advance tail, the worker task advances head, and tail - head is the
+ * number of items waiting. Producers may be interrupts of any priority or
+ * the other core, so a producer claims its slot and fills it under a
+ * hardware spin lock with interrupts masked. The Cortex-M0+ has no
+ * exclusive load/store to build a lock-free multi-producer claim from, and
+ * the masked window is only a few stores long. The worker is the only
+ * consumer and never takes the lock: it copies an item out of its slot
+ * before publishing the new head, and producers never write a slot until
+ * head has moved past it.
+ */
+
+#if PICO_RTOS_ENABLE_DEFERRED_WORK
+
+#if (PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH & (PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH - 1)) != 0
+#error "PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH must be a power of two"
+#endif
+
+#if !PICO_RTOS_ENABLE_TASK_NOTIFICATIONS
+#error "PICO_RTOS_ENABLE_DEFERRED_WORK requires PICO_RTOS_ENABLE_TASK_NOTIFICATIONS"
+#endif
+
+#define DEFERRED_INDEX_MASK (PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH - 1)
+
+typedef struct {
+    pico_rtos_deferred_function_t function;
+    void *param;
+    uint32_t queued_cycles;    // Cycle counter when the item was queued
+} pico_rtos_deferred_item_t;
+
+static pico_rtos_task_t deferred_task;
+static uint32_t deferred_task_stack[PICO_RTOS_DEFERRED_WORK_STACK_SIZE / sizeof(uint32_t)] __attribute__((aligned(8)));
+static pico_rtos_deferred_item_t deferred_ring[PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH];
+static volatile uint32_t deferred_head = 0;   // Written by the worker only
+static volatile uint32_t deferred_tail = 0;   // Written by producers under deferred_lock
+static spin_lock_t *deferred_lock = NULL;
+
+// Producer-side counters, updated under deferred_lock
+static volatile uint32_t deferred_queued = 0;
+static volatile uint32_t deferred_dropped = 0;
+static volatile uint32_t deferred_max_depth = 0;
+
+// Worker-side counters
+static uint32_t deferred_processed = 0;
+static uint32_t deferred_batches = 0;
+static uint32_t deferred_last_latency = 0;
+static uint32_t deferred_max_latency = 0;
+static uint64_t deferred_total_latency = 0;
+
+static void pico_rtos_deferred_task_function(void *param) {
+    (void)param;
+
+    while (1) {
+        pico_rtos_task_notify_take(true, PICO_RTOS_WAIT_FOREVER);
+
+        // Keep going until the ring is seen empty; an item queued while the
+        // last one runs did not wake us, since the ring was not empty then
+        uint32_t head = deferred_head;
+        uint32_t tail = deferred_tail;
+        if (head != tail) {
+            deferred_batches++;
+        }
+        while (head != tail) {
+            __dmb();
+            do {
+                pico_rtos_deferred_item_t item = deferred_ring[head & DEFERRED_INDEX_MASK];
+                __dmb();
+                deferred_head = ++head;
+
+                uint32_t latency = (pico_rtos_port_get_cycle_count() - item.queued_cycles) &
+                                   PICO_RTOS_PORT_CYCLE_COUNTER_MASK;
+                deferred_last_latency = latency;
+                if (latency > deferred_max_latency) {
+                    deferred_max_latency = latency;
+                }
+                deferred_total_latency += latency;
+                deferred_processed++;
+
+                item.function(item.param);
+            } while (head != tail);
+            tail = deferred_tail;
+        }
+    }
+}
+
+bool pico_rtos_deferred_init(void) {
+    deferred_head = 0;
+    deferred_tail = 0;
+    if (deferred_lock == NULL) {
+        deferred_lock = spin_lock_init(spin_lock_claim_unused(true));
+    }
+    pico_rtos_deferred_reset_stats();
+
+    return pico_rtos_task_create_static(&deferred_task, "DEFER", pico_rtos_deferred_task_function, NULL,
+                                        deferred_task_stack, sizeof(deferred_task_stack),
+                                        PICO_RTOS_DEFERRED_WORK_PRIORITY);
+}
+
+bool pico_rtos_defer_from_isr(pico_rtos_deferred_function_t function, void *param) {
+    if (function == NULL) {
+        return false;
+    }
+
+    uint32_t now = pico_rtos_port_get_cycle_count();
+    uint32_t saved = spin_lock_blocking(deferred_lock);
+
+    uint32_t tail = deferred_tail;
+    uint32_t depth = tail - deferred_head;
+    if (depth >= PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH) {
+        deferred_dropped++;
+        spin_unlock(deferred_lock, saved);
+        return false;
+    }
+
+    pico_rtos_deferred_item_t *item = &deferred_ring[tail & DEFERRED_INDEX_MASK];
+    item->function = function;
+    item->param = param;
+    item->queued_cycles = now;
+    __dmb();
+    deferred_tail = tail + 1;
+
+    deferred_queued++;
+    if (depth + 1 > deferred_max_depth) {
+        deferred_max_depth = depth + 1;
+    }
+
+    spin_unlock(deferred_lock, saved);
+
+    // Only the item that makes the ring non-empty wakes the worker; it runs
+    // everything queued behind it in the same batch
+    if (depth == 0) {
+        pico_rtos_task_notify_give_from_isr(&deferred_task);
+    }
+    return true;
+}
+
+bool pico_rtos_defer(pico_rtos_deferred_function_t function, void *param) {
+    return pico_rtos_defer_from_isr(function, param);
+}
+
+uint32_t pico_rtos_deferred_get_pending(void) {
+    return deferred_tail - deferred_head;
+}
+
+void pico_rtos_deferred_get_stats(pico_rtos_deferred_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+
+    pico_rtos_enter_critical();
+    uint32_t saved = spin_lock_blocking(deferred_lock);
+    stats->queued = deferred_queued;
+    stats->processed = deferred_processed;
+    stats->dropped = deferred_dropped;
+    stats->batches = deferred_batches;
+    stats->max_depth = deferred_max_depth;
+    stats->last_latency_cycles = deferred_last_latency;
+    stats->max_latency_cycles = deferred_max_latency;
+    stats->average_latency_cycles = (deferred_processed > 0) ?
+        (uint32_t)(deferred_total_latency / deferred_processed) : 0;
+    spin_unlock(deferred_lock, saved);
+    pico_rtos_exit_critical();
+}
+
+void pico_rtos_deferred_reset_stats(void) {
+    pico_rtos_enter_critical();
+    uint32_t saved = spin_lock_blocking(deferred_lock);
+    deferred_queued = 0;
+    deferred_dropped = 0;
+    deferred_max_depth = 0;
+    deferred_processed = 0;
+    deferred_batches = 0;
+    deferred_last_latency = 0;
+    deferred_max_latency = 0;
+    deferred_total_latency = 0;
+    spin_unlock(deferred_lock, saved);
+    pico_rtos_exit_critical();
+}
+
+pico_rtos_task_t *pico_rtos_deferred_get_task(void) {
+    return &deferred_task;
+}
+
+#endif // PICO_RTOS_ENABLE_DEFERRED_WORK
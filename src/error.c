@@ -9,6 +9,7 @@
 #include "pico_rtos/error.h"
 #include "pico_rtos/task.h"
 #include "pico_rtos.h"
+#include "hardware/sync.h"
 #include <string.h>
 
 // =============================================================================
@@ -70,6 +71,7 @@ static const struct {
     {PICO_RTOS_ERROR_MUTEX_TIMEOUT, "Mutex lock operation timed out"},
     {PICO_RTOS_ERROR_MUTEX_NOT_OWNED, "Attempt to unlock mutex not owned by current task"},
     {PICO_RTOS_ERROR_MUTEX_RECURSIVE_LOCK, "Recursive mutex lock not supported"},
+    {PICO_RTOS_ERROR_MUTEX_CEILING_VIOLATION, "Task priority above mutex ceiling"},
     {PICO_RTOS_ERROR_SEMAPHORE_TIMEOUT, "Semaphore take operation timed out"},
     {PICO_RTOS_ERROR_SEMAPHORE_OVERFLOW, "Semaphore count would exceed maximum"},
     {PICO_RTOS_ERROR_SEMAPHORE_INVALID_COUNT, "Invalid semaphore count specified"},
@@ -81,6 +83,12 @@ static const struct {
     {PICO_RTOS_ERROR_TIMER_INVALID_PERIOD, "Invalid timer period specified"},
     {PICO_RTOS_ERROR_TIMER_NOT_RUNNING, "Timer is not running"},
     {PICO_RTOS_ERROR_TIMER_ALREADY_RUNNING, "Timer is already running"},
+    {PICO_RTOS_ERROR_RWLOCK_TIMEOUT, "Reader-writer lock operation timed out"},
+    {PICO_RTOS_ERROR_RWLOCK_NOT_HELD, "Attempt to unlock reader-writer lock not held by current task"},
+    {PICO_RTOS_ERROR_RWLOCK_WOULD_DEADLOCK, "Task already holds the reader-writer lock for writing"},
+    {PICO_RTOS_ERROR_QUEUE_SET_TIMEOUT, "No queue set member became ready before the timeout"},
+    {PICO_RTOS_ERROR_QUEUE_SET_ALREADY_MEMBER, "Object already belongs to a queue set"},
+    {PICO_RTOS_ERROR_QUEUE_SET_NOT_MEMBER, "Object is not a member of the queue set"},
     
     // System errors (400-499)
     {PICO_RTOS_ERROR_SYSTEM_NOT_INITIALIZED, "RTOS system not initialized"},
@@ -123,7 +131,7 @@ static const struct {
  */
 static uint32_t get_current_task_id(void) {
     pico_rtos_task_t *current_task = pico_rtos_get_current_task();
-    return current_task ? (uint32_t)current_task : 0;
+    return current_task ? (uint32_t)(uintptr_t)current_task : 0;
 }
 
 /**
@@ -517,7 +525,7 @@ void pico_rtos_handle_assert_failure(const char *expression,
             pico_rtos_enter_critical();
             while (1) {
                 // Halt execution
-                __asm volatile("wfi");
+                __wfi();
             }
             break;
             
@@ -537,7 +545,7 @@ void pico_rtos_handle_assert_failure(const char *expression,
             // For now, just halt
             pico_rtos_enter_critical();
             while (1) {
-                __asm volatile("wfi");
+                __wfi();
             }
             break;
     }
@@ -169,7 +169,9 @@ static void unblock_satisfied_tasks(pico_rtos_event_group_t *event_group) {
 // PUBLIC API IMPLEMENTATION
 // =============================================================================
 
-bool pico_rtos_event_group_init(pico_rtos_event_group_t *event_group) {
+// Shared by both initializers; wait_storage is NULL to allocate the wait list
+static bool pico_rtos_event_group_setup(pico_rtos_event_group_t *event_group,
+                                        pico_rtos_block_object_t *wait_storage) {
     if (event_group == NULL) {
         PICO_RTOS_LOG_EVENT_ERROR("Event group initialization failed: NULL pointer");
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
@@ -185,7 +187,8 @@ bool pico_rtos_event_group_init(pico_rtos_event_group_t *event_group) {
     critical_section_init(&event_group->cs);
     
     // Create blocking object for this event group
-    event_group->block_obj = pico_rtos_block_object_create(event_group);
+    event_group->block_obj = (wait_storage != NULL) ? pico_rtos_block_object_create_static(wait_storage, event_group)
+                                                    : pico_rtos_block_object_create(event_group);
     if (event_group->block_obj == NULL) {
         PICO_RTOS_LOG_EVENT_ERROR("Event group initialization failed: Could not create blocking object");
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_OUT_OF_MEMORY, 0);
@@ -196,6 +199,22 @@ bool pico_rtos_event_group_init(pico_rtos_event_group_t *event_group) {
     return true;
 }
 
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+bool pico_rtos_event_group_init(pico_rtos_event_group_t *event_group) {
+    return pico_rtos_event_group_setup(event_group, NULL);
+}
+#endif
+
+bool pico_rtos_event_group_init_static(pico_rtos_event_group_t *event_group,
+                                       pico_rtos_block_object_t *wait_storage) {
+    if (wait_storage == NULL) {
+        PICO_RTOS_LOG_EVENT_ERROR("Event group initialization failed: NULL wait list storage");
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    return pico_rtos_event_group_setup(event_group, wait_storage);
+}
+
 bool pico_rtos_event_group_set_bits(pico_rtos_event_group_t *event_group, uint32_t bits) {
     if (event_group == NULL) {
         PICO_RTOS_LOG_EVENT_ERROR("Event group set bits failed: NULL pointer");
@@ -227,6 +246,13 @@ bool pico_rtos_event_group_set_bits(pico_rtos_event_group_t *event_group, uint32
         unblock_satisfied_tasks(event_group);
     }
     
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    // Let a task waiting on the group's set check whether its bits are set
+    if (bits_changed) {
+        pico_rtos_queue_set_notify(&event_group->set_member);
+    }
+#endif
+    
     PICO_RTOS_LOG_EVENT_DEBUG("Event group %p now has bits 0x%08lx", 
                        (void*)event_group, event_group->event_bits);
     
@@ -289,14 +315,6 @@ uint32_t pico_rtos_event_group_wait_bits_config(pico_rtos_event_group_t *event_g
                        config->clear_on_exit ? "true" : "false",
                        config->timeout);
     
-    // Store wait configuration for this task (simple approach using static storage)
-    // In a full implementation, this would be stored per-task
-    static event_wait_info_t task_wait_info;
-    task_wait_info.bits_to_wait_for = config->bits_to_wait_for;
-    task_wait_info.wait_for_all = config->wait_for_all;
-    task_wait_info.clear_on_exit = config->clear_on_exit;
-    task_wait_info.timeout = config->timeout;
-    
     // Main wait loop - handles re-blocking if condition becomes unsatisfied
     uint32_t wait_start_time = pico_rtos_get_tick_count();
     bool first_iteration = true;
@@ -449,6 +467,10 @@ void pico_rtos_event_group_delete(pico_rtos_event_group_t *event_group) {
     
     PICO_RTOS_LOG_EVENT_DEBUG("Deleting event group at %p", (void*)event_group);
     
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    pico_rtos_queue_set_leave(&event_group->set_member);
+#endif
+    
     critical_section_enter_blocking(&event_group->cs);
     
     // Delete the blocking object (this will unblock all waiting tasks)
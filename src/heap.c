@@ -0,0 +1,452 @@
+#include <string.h>
+#include "pico_rtos/heap.h"
+#include "pico_rtos.h"
+#include "pico_rtos/error.h"
+
+/**
+ * @file heap.c
+ * @brief Two-Level Segregated Fit heap
+ *
+ * Every block starts with a header holding its payload size and a pointer
+ * to the block physically before it; a free block also keeps its free-list
+ * links in the first words of its payload. The region ends with a
+ * zero-sized allocated sentinel so the last real block never merges past
+ * the end.
+ *
+ * A size maps to a first-level index (its highest set bit) and a
+ * second-level index (the next four bits), i.e. one of 16 lists per power
+ * of two; sizes below 128 bytes share the first level in 8-byte steps.
+ * One bit per non-empty list in fl_bitmap/sl_bitmap lets allocation find
+ * the first list whose every block fits with two bit scans, after rounding
+ * the request up to the start of the next list. On the Cortex-M0+ the scans
+ * go through libgcc's table-driven __clzsi2/__ctzsi2, which take constant
+ * time.
+ */
+
+#if PICO_RTOS_ENABLE_HEAP
+
+#define HEAP_ALIGN PICO_RTOS_HEAP_ALIGNMENT
+#define HEAP_ALIGN_SHIFT 3                                      // log2(HEAP_ALIGN)
+#define HEAP_SL_INDEX_BITS 4
+#define HEAP_SL_INDEX_COUNT (1u << HEAP_SL_INDEX_BITS)
+#define HEAP_FL_INDEX_SHIFT (HEAP_SL_INDEX_BITS + HEAP_ALIGN_SHIFT)
+#define HEAP_SMALL_BLOCK_SIZE (1u << HEAP_FL_INDEX_SHIFT)
+#define HEAP_FL_INDEX_COUNT PICO_RTOS_HEAP_CLASS_COUNT
+#define HEAP_MAX_BLOCK_SIZE (1u << (HEAP_FL_INDEX_COUNT + HEAP_FL_INDEX_SHIFT - 1))
+
+#define HEAP_BLOCK_FREE 1u
+#define HEAP_BLOCK_SIZE_MASK (~(size_t)(HEAP_ALIGN - 1))
+
+#if PICO_RTOS_HEAP_SIZE > HEAP_MAX_BLOCK_SIZE
+#error "PICO_RTOS_HEAP_SIZE is larger than the heap's size classes cover"
+#endif
+
+typedef struct heap_block {
+    struct heap_block *prev_phys;   // Block physically before this one, NULL for the first
+    size_t size;                    // Payload size in bytes; the low bits hold flags
+    struct heap_block *next_free;   // Free-list links, only valid while the block is free
+    struct heap_block *prev_free;
+} heap_block_t;
+
+#define HEAP_HEADER_SIZE offsetof(heap_block_t, next_free)
+#define HEAP_MIN_PAYLOAD (sizeof(heap_block_t) - HEAP_HEADER_SIZE)
+
+_Static_assert((1u << HEAP_ALIGN_SHIFT) == HEAP_ALIGN, "HEAP_ALIGN_SHIFT must match PICO_RTOS_HEAP_ALIGNMENT");
+_Static_assert(HEAP_HEADER_SIZE % HEAP_ALIGN == 0, "heap block header must keep payloads aligned");
+
+static uint8_t heap_region[PICO_RTOS_HEAP_SIZE] __attribute__((aligned(HEAP_ALIGN)));
+static bool heap_initialized = false;
+
+static uint32_t fl_bitmap;
+static uint32_t sl_bitmap[HEAP_FL_INDEX_COUNT];
+static heap_block_t *free_lists[HEAP_FL_INDEX_COUNT][HEAP_SL_INDEX_COUNT];
+
+// Statistics, kept under the critical section with the lists
+static uint32_t heap_used_bytes;
+static uint32_t heap_free_bytes;
+static uint32_t heap_peak_used_bytes;
+static uint32_t heap_used_blocks;
+static uint32_t heap_free_blocks;
+static uint32_t heap_allocations;
+static uint32_t heap_frees;
+static uint32_t heap_failed_allocations;
+static uint32_t class_allocations[HEAP_FL_INDEX_COUNT];
+static uint32_t class_used_blocks[HEAP_FL_INDEX_COUNT];
+static uint32_t class_free_blocks[HEAP_FL_INDEX_COUNT];
+
+// =============================================================================
+// BLOCK HELPERS
+// =============================================================================
+
+static inline int heap_fls(uint32_t word) {
+    return 31 - __builtin_clz(word);
+}
+
+static inline int heap_ffs(uint32_t word) {
+    return __builtin_ctz(word);
+}
+
+static inline size_t block_size(const heap_block_t *block) {
+    return block->size & HEAP_BLOCK_SIZE_MASK;
+}
+
+static inline bool block_is_free(const heap_block_t *block) {
+    return (block->size & HEAP_BLOCK_FREE) != 0;
+}
+
+static inline void *block_to_ptr(heap_block_t *block) {
+    return (uint8_t *)block + HEAP_HEADER_SIZE;
+}
+
+static inline heap_block_t *block_from_ptr(void *ptr) {
+    return (heap_block_t *)((uint8_t *)ptr - HEAP_HEADER_SIZE);
+}
+
+static inline heap_block_t *block_next(heap_block_t *block) {
+    return (heap_block_t *)((uint8_t *)block_to_ptr(block) + block_size(block));
+}
+
+// List indices of the class a block of this size belongs to
+static void mapping_insert(size_t size, int *fl, int *sl) {
+    if (size < HEAP_SMALL_BLOCK_SIZE) {
+        *fl = 0;
+        *sl = (int)(size / (HEAP_SMALL_BLOCK_SIZE / HEAP_SL_INDEX_COUNT));
+    } else {
+        int bit = heap_fls((uint32_t)size);
+        *sl = (int)((size >> (bit - HEAP_SL_INDEX_BITS)) ^ HEAP_SL_INDEX_COUNT);
+        *fl = bit - (HEAP_FL_INDEX_SHIFT - 1);
+    }
+}
+
+// List indices of the first list whose every block is at least this size
+static void mapping_search(size_t size, int *fl, int *sl) {
+    if (size >= HEAP_SMALL_BLOCK_SIZE) {
+        size += (1u << (heap_fls((uint32_t)size) - HEAP_SL_INDEX_BITS)) - 1;
+    }
+    mapping_insert(size, fl, sl);
+}
+
+static void free_list_insert(heap_block_t *block) {
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+
+    heap_block_t *head = free_lists[fl][sl];
+    block->next_free = head;
+    block->prev_free = NULL;
+    if (head != NULL) {
+        head->prev_free = block;
+    }
+    free_lists[fl][sl] = block;
+    fl_bitmap |= 1u << fl;
+    sl_bitmap[fl] |= 1u << sl;
+
+    heap_free_bytes += (uint32_t)block_size(block);
+    heap_free_blocks++;
+    class_free_blocks[fl]++;
+}
+
+static void free_list_remove(heap_block_t *block) {
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+
+    if (block->prev_free != NULL) {
+        block->prev_free->next_free = block->next_free;
+    } else {
+        free_lists[fl][sl] = block->next_free;
+        if (block->next_free == NULL) {
+            sl_bitmap[fl] &= ~(1u << sl);
+            if (sl_bitmap[fl] == 0) {
+                fl_bitmap &= ~(1u << fl);
+            }
+        }
+    }
+    if (block->next_free != NULL) {
+        block->next_free->prev_free = block->prev_free;
+    }
+
+    heap_free_bytes -= (uint32_t)block_size(block);
+    heap_free_blocks--;
+    class_free_blocks[fl]--;
+}
+
+// Take a free block of at least size bytes off its list, or NULL
+static heap_block_t *free_list_take(size_t size) {
+    int fl, sl;
+    mapping_search(size, &fl, &sl);
+    if (fl >= HEAP_FL_INDEX_COUNT) {
+        return NULL;
+    }
+
+    uint32_t sl_map = sl_bitmap[fl] & (~0u << sl);
+    if (sl_map == 0) {
+        uint32_t fl_map = (fl + 1 < 32) ? (fl_bitmap & (~0u << (fl + 1))) : 0;
+        if (fl_map == 0) {
+            return NULL;
+        }
+        fl = heap_ffs(fl_map);
+        sl_map = sl_bitmap[fl];
+    }
+    sl = heap_ffs(sl_map);
+
+    heap_block_t *block = free_lists[fl][sl];
+    free_list_remove(block);
+    return block;
+}
+
+// Merge a free block, already off its list, with its free neighbours
+static heap_block_t *block_merge(heap_block_t *block) {
+    heap_block_t *prev = block->prev_phys;
+    if (prev != NULL && block_is_free(prev)) {
+        free_list_remove(prev);
+        prev->size = (block_size(prev) + HEAP_HEADER_SIZE + block_size(block)) | HEAP_BLOCK_FREE;
+        block = prev;
+        block_next(block)->prev_phys = block;
+    }
+
+    heap_block_t *next = block_next(block);
+    if (block_is_free(next)) {
+        free_list_remove(next);
+        block->size = (block_size(block) + HEAP_HEADER_SIZE + block_size(next)) | HEAP_BLOCK_FREE;
+        block_next(block)->prev_phys = block;
+    }
+
+    return block;
+}
+
+// Does ptr point at the payload of a block inside the heap region?
+static bool heap_ptr_valid(void *ptr) {
+    uint8_t *p = (uint8_t *)ptr;
+    if (p < heap_region + HEAP_HEADER_SIZE || p >= heap_region + PICO_RTOS_HEAP_SIZE ||
+        ((uintptr_t)p % HEAP_ALIGN) != 0) {
+        return false;
+    }
+    heap_block_t *block = block_from_ptr(ptr);
+    heap_block_t *next = block_next(block);
+    return (uint8_t *)next < heap_region + PICO_RTOS_HEAP_SIZE && next->prev_phys == block;
+}
+
+// =============================================================================
+// PUBLIC API
+// =============================================================================
+
+void pico_rtos_heap_init(void) {
+    if (heap_initialized) {
+        return;
+    }
+    heap_initialized = true;
+
+    memset(free_lists, 0, sizeof(free_lists));
+    memset(sl_bitmap, 0, sizeof(sl_bitmap));
+    fl_bitmap = 0;
+
+    // One free block spanning the region, then the end sentinel
+    heap_block_t *block = (heap_block_t *)heap_region;
+    heap_block_t *sentinel = (heap_block_t *)(heap_region + PICO_RTOS_HEAP_SIZE - HEAP_HEADER_SIZE);
+    block->prev_phys = NULL;
+    block->size = ((size_t)(PICO_RTOS_HEAP_SIZE - 2 * HEAP_HEADER_SIZE) & HEAP_BLOCK_SIZE_MASK) | HEAP_BLOCK_FREE;
+    sentinel->prev_phys = block;
+    sentinel->size = 0;
+    free_list_insert(block);
+}
+
+void *pico_rtos_heap_alloc(size_t size) {
+    if (size == 0 || size > HEAP_MAX_BLOCK_SIZE) {
+        return NULL;
+    }
+
+    // Allocations made before pico_rtos_init() set the heap up themselves
+    if (!heap_initialized) {
+        pico_rtos_heap_init();
+    }
+
+    size_t needed = (size + HEAP_ALIGN - 1) & HEAP_BLOCK_SIZE_MASK;
+    if (needed < HEAP_MIN_PAYLOAD) {
+        needed = HEAP_MIN_PAYLOAD;
+    }
+
+    pico_rtos_enter_critical();
+
+    heap_block_t *block = free_list_take(needed);
+    if (block == NULL) {
+        heap_failed_allocations++;
+        pico_rtos_exit_critical();
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_OUT_OF_MEMORY, (uint32_t)size);
+        return NULL;
+    }
+
+    // Give the tail back if it is big enough to be a block of its own
+    size_t available = block_size(block);
+    if (available >= needed + HEAP_HEADER_SIZE + HEAP_MIN_PAYLOAD) {
+        heap_block_t *rest = (heap_block_t *)((uint8_t *)block_to_ptr(block) + needed);
+        rest->prev_phys = block;
+        rest->size = (available - needed - HEAP_HEADER_SIZE) | HEAP_BLOCK_FREE;
+        block_next(rest)->prev_phys = rest;
+        block->size = needed;
+        free_list_insert(rest);
+    } else {
+        block->size = available;
+    }
+
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+    class_allocations[fl]++;
+    class_used_blocks[fl]++;
+    heap_used_blocks++;
+    heap_allocations++;
+    heap_used_bytes += (uint32_t)block_size(block);
+    if (heap_used_bytes > heap_peak_used_bytes) {
+        heap_peak_used_bytes = heap_used_bytes;
+    }
+
+    pico_rtos_exit_critical();
+    return block_to_ptr(block);
+}
+
+bool pico_rtos_heap_free(void *ptr) {
+    if (ptr == NULL) {
+        return true;
+    }
+
+    pico_rtos_enter_critical();
+
+    if (!heap_ptr_valid(ptr)) {
+        pico_rtos_exit_critical();
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, (uint32_t)(uintptr_t)ptr);
+        return false;
+    }
+
+    heap_block_t *block = block_from_ptr(ptr);
+    if (block_is_free(block)) {
+        pico_rtos_exit_critical();
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_DOUBLE_FREE, (uint32_t)(uintptr_t)ptr);
+        return false;
+    }
+
+    int fl, sl;
+    mapping_insert(block_size(block), &fl, &sl);
+    class_used_blocks[fl]--;
+    heap_used_blocks--;
+    heap_frees++;
+    heap_used_bytes -= (uint32_t)block_size(block);
+
+    block->size |= HEAP_BLOCK_FREE;
+    free_list_insert(block_merge(block));
+
+    pico_rtos_exit_critical();
+    return true;
+}
+
+size_t pico_rtos_heap_block_size(void *ptr) {
+    size_t size = 0;
+    pico_rtos_enter_critical();
+    if (ptr != NULL && heap_ptr_valid(ptr) && !block_is_free(block_from_ptr(ptr))) {
+        size = block_size(block_from_ptr(ptr));
+    }
+    pico_rtos_exit_critical();
+    return size;
+}
+
+void pico_rtos_heap_get_stats(pico_rtos_heap_stats_t *stats) {
+    if (stats == NULL) {
+        return;
+    }
+
+    pico_rtos_enter_critical();
+    stats->heap_size = PICO_RTOS_HEAP_SIZE;
+    stats->used_bytes = heap_used_bytes;
+    stats->free_bytes = heap_free_bytes;
+    stats->peak_used_bytes = heap_peak_used_bytes;
+    stats->used_blocks = heap_used_blocks;
+    stats->free_blocks = heap_free_blocks;
+    stats->allocations = heap_allocations;
+    stats->frees = heap_frees;
+    stats->failed_allocations = heap_failed_allocations;
+
+    // The largest free block sits in the highest non-empty list
+    stats->largest_free_block = 0;
+    if (fl_bitmap != 0) {
+        int fl = heap_fls(fl_bitmap);
+        int sl = heap_fls(sl_bitmap[fl]);
+        for (heap_block_t *block = free_lists[fl][sl]; block != NULL; block = block->next_free) {
+            if (block_size(block) > stats->largest_free_block) {
+                stats->largest_free_block = (uint32_t)block_size(block);
+            }
+        }
+    }
+    stats->fragmentation_percent = (heap_free_bytes > 0) ?
+        (uint32_t)(100u - (uint64_t)stats->largest_free_block * 100u / heap_free_bytes) : 0;
+    pico_rtos_exit_critical();
+}
+
+bool pico_rtos_heap_get_class_stats(uint32_t class_index, pico_rtos_heap_class_stats_t *stats) {
+    if (stats == NULL || class_index >= HEAP_FL_INDEX_COUNT) {
+        return false;
+    }
+
+    stats->min_size = (class_index == 0) ? 0 : (HEAP_SMALL_BLOCK_SIZE / 2) << class_index;
+    stats->max_size = (HEAP_SMALL_BLOCK_SIZE << class_index) - 1;
+
+    pico_rtos_enter_critical();
+    stats->allocations = class_allocations[class_index];
+    stats->used_blocks = class_used_blocks[class_index];
+    stats->free_blocks = class_free_blocks[class_index];
+    pico_rtos_exit_critical();
+    return true;
+}
+
+bool pico_rtos_heap_check(void) {
+    bool ok = true;
+    uint32_t free_bytes = 0;
+    uint32_t free_blocks = 0;
+    uint32_t listed_blocks = 0;
+
+    pico_rtos_enter_critical();
+
+    // Physical walk: links agree and no two free blocks are adjacent
+    heap_block_t *prev = NULL;
+    heap_block_t *block = (heap_block_t *)heap_region;
+    while (ok && block_size(block) != 0) {
+        heap_block_t *next = block_next(block);
+        if (block->prev_phys != prev || (uint8_t *)next > heap_region + PICO_RTOS_HEAP_SIZE - HEAP_HEADER_SIZE) {
+            ok = false;
+            break;
+        }
+        if (block_is_free(block)) {
+            if (prev != NULL && block_is_free(prev)) {
+                ok = false;
+            }
+            free_bytes += (uint32_t)block_size(block);
+            free_blocks++;
+        }
+        prev = block;
+        block = next;
+    }
+    ok = ok && block->prev_phys == prev &&
+         (uint8_t *)block == heap_region + PICO_RTOS_HEAP_SIZE - HEAP_HEADER_SIZE;
+
+    // Free lists: every block is free, in the right list, and flagged in the bitmaps
+    for (int fl = 0; ok && fl < HEAP_FL_INDEX_COUNT; fl++) {
+        for (int sl = 0; ok && sl < (int)HEAP_SL_INDEX_COUNT; sl++) {
+            heap_block_t *head = free_lists[fl][sl];
+            bool flagged = (fl_bitmap & (1u << fl)) && (sl_bitmap[fl] & (1u << sl));
+            if ((head != NULL) != flagged) {
+                ok = false;
+            }
+            for (heap_block_t *b = head; ok && b != NULL; b = b->next_free) {
+                int bfl, bsl;
+                mapping_insert(block_size(b), &bfl, &bsl);
+                if (!block_is_free(b) || bfl != fl || bsl != sl) {
+                    ok = false;
+                }
+                listed_blocks++;
+            }
+        }
+    }
+
+    ok = ok && free_bytes == heap_free_bytes && free_blocks == heap_free_blocks && listed_blocks == free_blocks;
+
+    pico_rtos_exit_critical();
+    return ok;
+}
+
+#endif // PICO_RTOS_ENABLE_HEAP
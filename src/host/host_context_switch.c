@@ -0,0 +1,253 @@
+/**
+ * @file host_context_switch.c
+ * @brief ucontext-based context switching for the Linux host simulator port
+ *
+ * Implements the context_switch.h API for the host. Each task gets a host
+ * frame holding a ucontext_t and a native stack large enough for libc; the
+ * RTOS-side stack allocated by pico_rtos_task_create() is kept (so stack
+ * accounting and canaries behave as on target) but never executed on.
+ * task->stack_ptr points at the frame instead of a saved register block.
+ *
+ * Every switch happens inside pico_rtos_host_pendsv_handler() (or the
+ * start/stop paths) with simulated interrupts masked exactly once, so a
+ * resumed context always unmasks on its way out.
+ */
+
+#define _GNU_SOURCE
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <ucontext.h>
+
+#include "pico_rtos.h"
+#include "pico_rtos/context_switch.h"
+#include "pico_rtos/task.h"
+#include "hardware/sync.h"
+#include "host_port.h"
+
+#ifndef PICO_RTOS_HOST_TASK_STACK_SIZE
+#define PICO_RTOS_HOST_TASK_STACK_SIZE (128 * 1024)
+#endif
+
+#define HOST_FRAME_MAGIC 0x484F5354u // "HOST"
+
+typedef struct host_frame {
+    uint32_t magic;
+    ucontext_t context;
+    uint32_t *stack_base;
+    pico_rtos_task_function_t function;
+    void *param;
+    void *host_stack;
+    struct host_frame *next;
+} host_frame_t;
+
+// Global variables for context switching (kept for API compatibility)
+uint32_t *current_task_stack_ptr = NULL;
+uint32_t *next_task_stack_ptr = NULL;
+
+// Frames are reused when a stack address is handed out again
+static host_frame_t *frame_registry = NULL;
+
+// Context of main() while the scheduler runs
+static host_frame_t main_frame = { .magic = HOST_FRAME_MAGIC };
+static host_frame_t *running_frame = &main_frame;
+static bool scheduler_started = false;
+
+static host_frame_t *host_frame_from_stack_ptr(uint32_t *stack_ptr) {
+    host_frame_t *frame = (host_frame_t *)stack_ptr;
+    if (frame == NULL || frame->magic != HOST_FRAME_MAGIC) {
+        return NULL;
+    }
+    return frame;
+}
+
+static void host_task_trampoline(void) {
+    host_frame_t *frame = running_frame;
+
+    // Leave the masked region of the switch that started us
+    restore_interrupts(0);
+
+    frame->function(frame->param);
+    pico_rtos_task_exit_handler();
+}
+
+// Switch from the running frame to another one; interrupts must be masked once
+static void host_switch_to(host_frame_t *next) {
+    host_frame_t *previous = running_frame;
+    if (next == NULL || next == previous) {
+        return;
+    }
+    running_frame = next;
+    swapcontext(&previous->context, &next->context);
+}
+
+uint32_t *pico_rtos_init_task_stack(uint32_t *stack_base, uint32_t stack_size,
+                                   pico_rtos_task_function_t task_function, void *param) {
+    if (stack_base == NULL || stack_size == 0 || task_function == NULL) {
+        return NULL;
+    }
+
+    uint32_t save = save_and_disable_interrupts();
+
+    host_frame_t *frame = frame_registry;
+    while (frame != NULL && frame->stack_base != stack_base) {
+        frame = frame->next;
+    }
+
+    if (frame == NULL) {
+        frame = (host_frame_t *)calloc(1, sizeof(host_frame_t));
+        void *host_stack = malloc(PICO_RTOS_HOST_TASK_STACK_SIZE);
+        if (frame == NULL || host_stack == NULL) {
+            free(frame);
+            free(host_stack);
+            restore_interrupts(save);
+            return NULL;
+        }
+        frame->magic = HOST_FRAME_MAGIC;
+        frame->stack_base = stack_base;
+        frame->host_stack = host_stack;
+        frame->next = frame_registry;
+        frame_registry = frame;
+    }
+
+    frame->function = task_function;
+    frame->param = param;
+
+    getcontext(&frame->context);
+    frame->context.uc_stack.ss_sp = frame->host_stack;
+    frame->context.uc_stack.ss_size = PICO_RTOS_HOST_TASK_STACK_SIZE;
+    frame->context.uc_link = NULL;
+    sigemptyset(&frame->context.uc_sigmask);
+    makecontext(&frame->context, host_task_trampoline, 0);
+
+    restore_interrupts(save);
+    return (uint32_t *)frame;
+}
+
+void pico_rtos_context_switch(void) {
+    if (!scheduler_started) {
+        return;
+    }
+    pico_rtos_host_pend_sv();
+}
+
+void pico_rtos_host_pendsv_handler(void) {
+    uint32_t save = save_and_disable_interrupts();
+
+    while (pico_rtos_host_take_pend_sv()) {
+        // A bare pico_rtos_context_switch() request has no task selected yet
+        if (next_task_stack_ptr == NULL) {
+            pico_rtos_schedule_next_task();
+            pico_rtos_host_take_pend_sv();
+        }
+        current_task_stack_ptr = NULL;
+        next_task_stack_ptr = NULL;
+
+        pico_rtos_task_t *task = pico_rtos_get_current_task();
+        if (task != NULL) {
+            host_switch_to(host_frame_from_stack_ptr(task->stack_ptr));
+        }
+    }
+
+    restore_interrupts(save);
+}
+
+void pico_rtos_start_first_task(void) {
+    pico_rtos_task_t *task = pico_rtos_get_current_task();
+    host_frame_t *frame = task != NULL ? host_frame_from_stack_ptr(task->stack_ptr) : NULL;
+    if (frame == NULL) {
+        return;
+    }
+
+    uint32_t save = save_and_disable_interrupts();
+    scheduler_started = true;
+    current_task_stack_ptr = NULL;
+    next_task_stack_ptr = NULL;
+    host_switch_to(frame);
+
+    // Back on main() after pico_rtos_port_stop_scheduler()
+    scheduler_started = false;
+    restore_interrupts(save);
+}
+
+void pico_rtos_port_stop_scheduler(void) {
+    if (!scheduler_started) {
+        return;
+    }
+    uint32_t save = save_and_disable_interrupts();
+    host_switch_to(&main_frame);
+    restore_interrupts(save);
+}
+
+void pico_rtos_save_context(void) {
+    // Contexts are saved by swapcontext() in the PendSV handler
+}
+
+void pico_rtos_restore_context(void) {
+    // Contexts are restored by swapcontext() in the PendSV handler
+}
+
+void pico_rtos_setup_pendsv(void) {
+    // PendSV is a flag serviced when simulated interrupts are unmasked
+}
+
+void pico_rtos_task_exit_handler(void) {
+    // This function is called when a task function returns
+    pico_rtos_enter_critical();
+
+    pico_rtos_task_t *current_task = pico_rtos_get_current_task();
+    if (current_task != NULL) {
+        // Still running on its stack, so the idle task frees it later
+        pico_rtos_scheduler_remove_task(current_task);
+    }
+
+    pico_rtos_exit_critical();
+
+    // Schedule the next task - this should not return
+    pico_rtos_schedule_next_task();
+
+    while (1) {
+        __wfi();
+    }
+}
+
+void pico_rtos_prepare_context_switch(pico_rtos_task_t *current, pico_rtos_task_t *next) {
+    current_task_stack_ptr = current != NULL ? current->stack_ptr : NULL;
+    next_task_stack_ptr = next != NULL ? next->stack_ptr : NULL;
+}
+
+void pico_rtos_perform_context_switch(pico_rtos_task_t *current, pico_rtos_task_t *next) {
+    if (next == NULL) {
+        return;
+    }
+
+    pico_rtos_prepare_context_switch(current, next);
+
+    if (current == NULL) {
+        pico_rtos_start_first_task();
+    } else {
+        pico_rtos_context_switch();
+    }
+}
+
+void pico_rtos_context_switch_init(void) {
+    pico_rtos_setup_pendsv();
+
+    current_task_stack_ptr = NULL;
+    next_task_stack_ptr = NULL;
+}
+
+// Nanoseconds stand in for CPU cycles on the host
+uint32_t pico_rtos_port_get_cycle_count(void) {
+#if PICO_RTOS_HOST_VIRTUAL_TIME
+    // Follow the simulated clock so cycle-based measurements are repeatable
+    return (uint32_t)(time_us_64() * 1000u);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec);
+#endif
+}
@@ -0,0 +1,835 @@
+/**
+ * @file host_port.c
+ * @brief Interrupt and timer emulation for the Linux host simulator port
+ *
+ * The RP2040 timer, alarm pool, NVIC and GPIO bank are modelled just far
+ * enough for Pico-RTOS and its tests to run unmodified:
+ *
+ * - time_us_64() is CLOCK_MONOTONIC relative to process start.
+ * - A helper thread sleeps until the earliest alarm is due and then sends
+ *   SIGALRM to the scheduler thread. The signal handler is the "interrupt":
+ *   it runs alarm callbacks and raised IRQ lines on the current task's stack.
+ * - save_and_disable_interrupts() increments a nesting counter. A signal
+ *   arriving while the counter is non-zero is latched and serviced by the
+ *   outermost restore_interrupts(), followed by any pending PendSV.
+ * - libc allocation and stdio entry points are wrapped (see PicoRTOSHost.cmake)
+ *   so that a task is never preempted while holding a libc-internal lock.
+ *
+ * Built with PICO_RTOS_HOST_VIRTUAL_TIME the clock is a counter instead, and
+ * there is no timer thread. Code runs in zero simulated time; time moves only
+ * when the CPU would wait: __wfi() jumps straight to the earliest alarm and
+ * busy_wait_us()/sleep_until() step through the alarms due before they end.
+ * Alarms are serviced at exactly their target time, so a run is a
+ * discrete-event simulation whose results do not depend on host load.
+ */
+
+#define _GNU_SOURCE
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "pico/stdlib.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "hardware/timer.h"
+#include "host_port.h"
+
+#ifndef PICO_RTOS_HOST_MAX_ALARMS
+#define PICO_RTOS_HOST_MAX_ALARMS 32
+#endif
+
+#define HOST_IRQ_SIGNAL SIGALRM
+#define HOST_NUM_SPIN_LOCKS 32
+
+typedef struct host_alarm {
+    alarm_id_t id;
+    absolute_time_t target;
+    alarm_callback_t callback;
+    void *user_data;
+    struct host_alarm *next;
+} host_alarm_t;
+
+// Scheduler thread and time base
+static pthread_t scheduler_thread;
+static struct timespec boot_time;
+#if PICO_RTOS_HOST_VIRTUAL_TIME
+static volatile uint64_t virtual_time_us = 0;
+#endif
+
+// Simulated interrupt state (only touched by the scheduler thread)
+static volatile uint32_t irq_mask_depth = 0;
+static volatile uint32_t isr_depth = 0;
+static volatile sig_atomic_t irq_pending = 0;
+static volatile sig_atomic_t pendsv_pending = 0;
+static volatile uint32_t irq_lines_pending = 0;
+
+// IRQ lines
+static irq_handler_t irq_handlers[NUM_IRQS];
+static uint32_t irq_lines_enabled = 0;
+
+// Alarm pool, shared with the timer thread
+static pthread_mutex_t alarm_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t alarm_cond;
+static host_alarm_t alarm_slots[PICO_RTOS_HOST_MAX_ALARMS];
+static host_alarm_t *alarm_free_list = NULL;
+static host_alarm_t *alarm_queue = NULL;
+static alarm_id_t next_alarm_id = 1;
+static bool alarm_signalled = false;
+static bool timer_thread_started = false;
+static pthread_t timer_thread;
+
+// Spin locks and timer registers
+static spin_lock_t spin_locks[HOST_NUM_SPIN_LOCKS];
+static uint32_t spin_locks_claimed = 0;
+static timer_hw_t host_timer_regs;
+
+// GPIO bank
+static uint32_t gpio_out_state = 0;
+static uint32_t gpio_dir_out = 0;
+static uint8_t gpio_irq_mask[NUM_BANK0_GPIOS];
+static volatile uint32_t gpio_irq_events[NUM_BANK0_GPIOS];
+static gpio_irq_callback_t gpio_callback = NULL;
+
+// Real libc entry points (see the --wrap list in cmake/PicoRTOSHost.cmake)
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t nmemb, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+void __real_free(void *ptr);
+int __real_vprintf(const char *format, va_list ap);
+int __real_vfprintf(FILE *stream, const char *format, va_list ap);
+int __real_puts(const char *s);
+int __real_putchar(int c);
+int __real_fputs(const char *s, FILE *stream);
+int __real_fputc(int c, FILE *stream);
+size_t __real_fwrite(const void *ptr, size_t size, size_t nmemb, FILE *stream);
+int __real_fflush(FILE *stream);
+
+static void host_service_interrupts(void);
+
+// =============================================================================
+// TIME BASE
+// =============================================================================
+
+#if PICO_RTOS_HOST_VIRTUAL_TIME
+
+uint64_t time_us_64(void) {
+    return virtual_time_us;
+}
+
+// Earliest alarm target, or UINT64_MAX if no alarm is set
+static uint64_t host_next_alarm_target(void) {
+    pthread_mutex_lock(&alarm_lock);
+    uint64_t target = (alarm_queue != NULL) ? alarm_queue->target : UINT64_MAX;
+    pthread_mutex_unlock(&alarm_lock);
+    return target;
+}
+
+// Move the clock forward to target, servicing each alarm at its own time.
+// With interrupts masked the clock goes straight to target and the timer
+// interrupt stays pending until they are restored, as on hardware.
+static void host_advance_time(uint64_t target) {
+    do {
+        uint64_t next = host_next_alarm_target();
+        bool deliverable = (irq_mask_depth == 0 && isr_depth == 0);
+
+        uint64_t step = (deliverable && next < target) ? next : target;
+        if (step > virtual_time_us) {
+            virtual_time_us = step;
+        }
+        if (next <= virtual_time_us) {
+            irq_pending = 1;
+        }
+        if (!deliverable) {
+            return;
+        }
+        if (irq_pending) {
+            host_service_interrupts();
+        }
+    } while (virtual_time_us < target);
+}
+
+#else
+
+uint64_t time_us_64(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t sec = (int64_t)now.tv_sec - (int64_t)boot_time.tv_sec;
+    int64_t nsec = (int64_t)now.tv_nsec - (int64_t)boot_time.tv_nsec;
+    return (uint64_t)(sec * 1000000 + nsec / 1000);
+}
+
+#endif // PICO_RTOS_HOST_VIRTUAL_TIME
+
+static struct timespec host_time_to_timespec(absolute_time_t t) {
+    struct timespec ts = boot_time;
+    ts.tv_sec += (time_t)(t / 1000000u);
+    ts.tv_nsec += (long)(t % 1000000u) * 1000;
+    if (ts.tv_nsec >= 1000000000L) {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return ts;
+}
+
+timer_hw_t *pico_rtos_host_timer_hw(void) {
+    uint64_t now = time_us_64();
+    host_timer_regs.timerawh = (uint32_t)(now >> 32);
+    host_timer_regs.timerawl = (uint32_t)now;
+    host_timer_regs.timehr = host_timer_regs.timerawh;
+    host_timer_regs.timelr = host_timer_regs.timerawl;
+    return &host_timer_regs;
+}
+
+void busy_wait_us(uint64_t delay_us) {
+    uint64_t target = time_us_64() + delay_us;
+#if PICO_RTOS_HOST_VIRTUAL_TIME
+    if (pico_rtos_host_is_scheduler_thread()) {
+        // An interrupt serviced on the way may switch tasks; the wait still
+        // ends at target, however long the others ran
+        host_advance_time(target);
+    } else {
+        // Other threads are outside the simulation and wait in real time
+        struct timespec ts = { (time_t)(delay_us / 1000000u), (long)(delay_us % 1000000u) * 1000 };
+        while (nanosleep(&ts, &ts) == EINTR) {
+        }
+    }
+#else
+    while (time_us_64() < target) {
+        __compiler_memory_barrier();
+    }
+#endif
+}
+
+void sleep_until(absolute_time_t target) {
+#if PICO_RTOS_HOST_VIRTUAL_TIME
+    uint64_t now = time_us_64();
+    busy_wait_us(target > now ? target - now : 0);
+#else
+    struct timespec ts = host_time_to_timespec(target);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {
+    }
+#endif
+}
+
+void sleep_us(uint64_t us) {
+    sleep_until(delayed_by_us(get_absolute_time(), us));
+}
+
+void sleep_ms(uint32_t ms) {
+    sleep_us((uint64_t)ms * 1000u);
+}
+
+bool stdio_init_all(void) {
+    // Keep output ordered with respect to crashes and ctest capture
+    setvbuf(stdout, NULL, _IOLBF, 0);
+    return true;
+}
+
+// =============================================================================
+// INTERRUPT MASKING
+// =============================================================================
+
+bool pico_rtos_host_is_scheduler_thread(void) {
+    return pthread_equal(pthread_self(), scheduler_thread);
+}
+
+bool pico_rtos_host_in_isr(void) {
+    return isr_depth > 0;
+}
+
+uint32_t save_and_disable_interrupts(void) {
+    if (!pico_rtos_host_is_scheduler_thread()) {
+        return 0;
+    }
+    uint32_t previous = irq_mask_depth;
+    irq_mask_depth = previous + 1;
+    __compiler_memory_barrier();
+    return previous;
+}
+
+void restore_interrupts(uint32_t status) {
+    (void)status;
+    if (!pico_rtos_host_is_scheduler_thread() || irq_mask_depth == 0) {
+        return;
+    }
+    __compiler_memory_barrier();
+    irq_mask_depth = irq_mask_depth - 1;
+    if (irq_mask_depth == 0 && isr_depth == 0 && (irq_pending || pendsv_pending)) {
+        host_service_interrupts();
+    }
+}
+
+void __wfi(void) {
+    if (!pico_rtos_host_is_scheduler_thread()) {
+        sched_yield();
+        return;
+    }
+
+    sigset_t irq_set;
+    sigset_t previous;
+    sigemptyset(&irq_set);
+    sigaddset(&irq_set, HOST_IRQ_SIGNAL);
+    pthread_sigmask(SIG_BLOCK, &irq_set, &previous);
+
+    if (irq_pending) {
+        pthread_sigmask(SIG_SETMASK, &previous, NULL);
+        if (irq_mask_depth == 0 && isr_depth == 0) {
+            host_service_interrupts();
+        }
+        return;
+    }
+
+#if PICO_RTOS_HOST_VIRTUAL_TIME
+    // Nothing can happen before the next alarm, so skip to it. Without one
+    // only an IRQ line raised by another thread can end the wait.
+    uint64_t next = host_next_alarm_target();
+    if (next != UINT64_MAX) {
+        pthread_sigmask(SIG_SETMASK, &previous, NULL);
+        host_advance_time(next);
+        return;
+    }
+#endif
+
+    // Sleep until the next signal; its handler runs before sigsuspend returns
+    sigset_t wait_set = previous;
+    sigdelset(&wait_set, HOST_IRQ_SIGNAL);
+    sigsuspend(&wait_set);
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+}
+
+void pico_rtos_host_pend_sv(void) {
+    pendsv_pending = 1;
+    if (pico_rtos_host_is_scheduler_thread() && irq_mask_depth == 0 && isr_depth == 0) {
+        host_service_interrupts();
+    }
+}
+
+bool pico_rtos_host_take_pend_sv(void) {
+    if (!pendsv_pending) {
+        return false;
+    }
+    pendsv_pending = 0;
+    return true;
+}
+
+// =============================================================================
+// SPIN LOCKS
+// =============================================================================
+
+spin_lock_t *spin_lock_instance(uint lock_num) {
+    return &spin_locks[lock_num % HOST_NUM_SPIN_LOCKS];
+}
+
+spin_lock_t *spin_lock_init(uint lock_num) {
+    spin_lock_t *lock = spin_lock_instance(lock_num);
+    *lock = 0;
+    return lock;
+}
+
+int spin_lock_claim_unused(bool required) {
+    uint32_t save = save_and_disable_interrupts();
+    for (int i = 16; i < HOST_NUM_SPIN_LOCKS; i++) {
+        if (!(spin_locks_claimed & (1u << i))) {
+            spin_locks_claimed |= 1u << i;
+            restore_interrupts(save);
+            return i;
+        }
+    }
+    restore_interrupts(save);
+    if (required) {
+        fprintf(stderr, "No spin locks are available\n");
+        abort();
+    }
+    return -1;
+}
+
+void spin_lock_claim(uint lock_num) {
+    uint32_t save = save_and_disable_interrupts();
+    spin_locks_claimed |= 1u << (lock_num % HOST_NUM_SPIN_LOCKS);
+    restore_interrupts(save);
+}
+
+void spin_lock_unclaim(uint lock_num) {
+    uint32_t save = save_and_disable_interrupts();
+    spin_locks_claimed &= ~(1u << (lock_num % HOST_NUM_SPIN_LOCKS));
+    restore_interrupts(save);
+}
+
+// =============================================================================
+// ALARM POOL
+// =============================================================================
+
+static void alarm_queue_insert(host_alarm_t *alarm) {
+    host_alarm_t **link = &alarm_queue;
+    while (*link != NULL && (*link)->target <= alarm->target) {
+        link = &(*link)->next;
+    }
+    alarm->next = *link;
+    *link = alarm;
+}
+
+static void *host_timer_thread(void *arg) {
+    (void)arg;
+
+    pthread_mutex_lock(&alarm_lock);
+    while (1) {
+        if (alarm_queue == NULL || alarm_signalled) {
+            pthread_cond_wait(&alarm_cond, &alarm_lock);
+            continue;
+        }
+
+        absolute_time_t target = alarm_queue->target;
+        if (time_us_64() < target) {
+            struct timespec ts = host_time_to_timespec(target);
+            pthread_cond_timedwait(&alarm_cond, &alarm_lock, &ts);
+            continue;
+        }
+
+        // Raise the timer interrupt and wait for it to be serviced
+        alarm_signalled = true;
+        pthread_kill(scheduler_thread, HOST_IRQ_SIGNAL);
+    }
+    return NULL;
+}
+
+static void host_start_timer_thread(void) {
+#if PICO_RTOS_HOST_VIRTUAL_TIME
+    // Alarms are raised by whatever advances the virtual clock
+    return;
+#endif
+    if (timer_thread_started) {
+        return;
+    }
+    timer_thread_started = true;
+
+    // The timer thread must never take the simulated interrupt
+    sigset_t irq_set;
+    sigset_t previous;
+    sigemptyset(&irq_set);
+    sigaddset(&irq_set, HOST_IRQ_SIGNAL);
+    pthread_sigmask(SIG_BLOCK, &irq_set, &previous);
+    pthread_create(&timer_thread, NULL, host_timer_thread, NULL);
+    pthread_sigmask(SIG_SETMASK, &previous, NULL);
+}
+
+alarm_id_t add_alarm_at(absolute_time_t time, alarm_callback_t callback, void *user_data, bool fire_if_past) {
+    if (callback == NULL) {
+        return -1;
+    }
+    if (!fire_if_past && time <= time_us_64()) {
+        return 0;
+    }
+
+    uint32_t save = save_and_disable_interrupts();
+    pthread_mutex_lock(&alarm_lock);
+
+    host_start_timer_thread();
+
+    host_alarm_t *alarm = alarm_free_list;
+    if (alarm == NULL) {
+        pthread_mutex_unlock(&alarm_lock);
+        restore_interrupts(save);
+        return -1;
+    }
+    alarm_free_list = alarm->next;
+
+    alarm->id = next_alarm_id++;
+    if (next_alarm_id <= 0) {
+        next_alarm_id = 1;
+    }
+    alarm->target = time;
+    alarm->callback = callback;
+    alarm->user_data = user_data;
+    alarm_queue_insert(alarm);
+    alarm_id_t id = alarm->id;
+
+#if PICO_RTOS_HOST_VIRTUAL_TIME
+    // An alarm already due fires as soon as interrupts are enabled
+    if (time <= time_us_64() && pico_rtos_host_is_scheduler_thread()) {
+        irq_pending = 1;
+    }
+#endif
+
+    pthread_cond_signal(&alarm_cond);
+    pthread_mutex_unlock(&alarm_lock);
+    restore_interrupts(save);
+
+    return id;
+}
+
+bool cancel_alarm(alarm_id_t alarm_id) {
+    bool found = false;
+
+    uint32_t save = save_and_disable_interrupts();
+    pthread_mutex_lock(&alarm_lock);
+
+    host_alarm_t **link = &alarm_queue;
+    while (*link != NULL) {
+        if ((*link)->id == alarm_id) {
+            host_alarm_t *alarm = *link;
+            *link = alarm->next;
+            alarm->next = alarm_free_list;
+            alarm_free_list = alarm;
+            found = true;
+            break;
+        }
+        link = &(*link)->next;
+    }
+
+    pthread_cond_signal(&alarm_cond);
+    pthread_mutex_unlock(&alarm_lock);
+    restore_interrupts(save);
+
+    return found;
+}
+
+// Run every due alarm callback (simulated timer interrupt)
+static void host_dispatch_alarms(void) {
+    pthread_mutex_lock(&alarm_lock);
+    alarm_signalled = false;
+
+    while (alarm_queue != NULL && alarm_queue->target <= time_us_64()) {
+        host_alarm_t *alarm = alarm_queue;
+        alarm_queue = alarm->next;
+
+        pthread_mutex_unlock(&alarm_lock);
+        int64_t reschedule = alarm->callback(alarm->id, alarm->user_data);
+        pthread_mutex_lock(&alarm_lock);
+
+        if (reschedule > 0) {
+            alarm->target += (uint64_t)reschedule;
+            alarm_queue_insert(alarm);
+        } else if (reschedule < 0) {
+            alarm->target = time_us_64() + (uint64_t)(-reschedule);
+            alarm_queue_insert(alarm);
+        } else {
+            alarm->next = alarm_free_list;
+            alarm_free_list = alarm;
+        }
+    }
+
+    pthread_cond_signal(&alarm_cond);
+    pthread_mutex_unlock(&alarm_lock);
+}
+
+// =============================================================================
+// IRQ LINES
+// =============================================================================
+
+void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    if (num < NUM_IRQS) {
+        irq_handlers[num] = handler;
+    }
+}
+
+irq_handler_t irq_get_exclusive_handler(uint num) {
+    return num < NUM_IRQS ? irq_handlers[num] : NULL;
+}
+
+void irq_set_enabled(uint num, bool enabled) {
+    if (num >= NUM_IRQS) {
+        return;
+    }
+    if (enabled) {
+        __atomic_or_fetch(&irq_lines_enabled, 1u << num, __ATOMIC_SEQ_CST);
+    } else {
+        __atomic_and_fetch(&irq_lines_enabled, ~(1u << num), __ATOMIC_SEQ_CST);
+    }
+}
+
+bool irq_is_enabled(uint num) {
+    return num < NUM_IRQS && (irq_lines_enabled & (1u << num)) != 0;
+}
+
+void irq_set_priority(uint num, uint8_t hardware_priority) {
+    (void)num;
+    (void)hardware_priority;
+}
+
+void irq_set_pending(uint num) {
+    if (num >= NUM_IRQS) {
+        return;
+    }
+    __atomic_or_fetch(&irq_lines_pending, 1u << num, __ATOMIC_SEQ_CST);
+
+    if (!pico_rtos_host_is_scheduler_thread()) {
+        pthread_kill(scheduler_thread, HOST_IRQ_SIGNAL);
+        return;
+    }
+
+    irq_pending = 1;
+    if (irq_mask_depth == 0 && isr_depth == 0) {
+        host_service_interrupts();
+    }
+}
+
+static void host_dispatch_irq_lines(void) {
+    uint32_t lines = __atomic_exchange_n(&irq_lines_pending, 0, __ATOMIC_SEQ_CST);
+    lines &= irq_lines_enabled;
+
+    for (uint num = 0; lines != 0; num++, lines >>= 1) {
+        if ((lines & 1u) && irq_handlers[num] != NULL) {
+            irq_handlers[num]();
+        }
+    }
+}
+
+// =============================================================================
+// INTERRUPT DELIVERY
+// =============================================================================
+
+static void host_service_interrupts(void) {
+    while (irq_pending) {
+        irq_pending = 0;
+        isr_depth++;
+        host_dispatch_alarms();
+        host_dispatch_irq_lines();
+        isr_depth--;
+    }
+
+    if (pendsv_pending && irq_mask_depth == 0) {
+        pico_rtos_host_pendsv_handler();
+    }
+}
+
+static void host_signal_handler(int sig) {
+    (void)sig;
+    int saved_errno = errno;
+
+    irq_pending = 1;
+    if (irq_mask_depth == 0 && isr_depth == 0) {
+        host_service_interrupts();
+    }
+
+    errno = saved_errno;
+}
+
+__attribute__((constructor))
+static void host_port_init(void) {
+    clock_gettime(CLOCK_MONOTONIC, &boot_time);
+    scheduler_thread = pthread_self();
+
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&alarm_cond, &attr);
+    pthread_condattr_destroy(&attr);
+
+    for (int i = 0; i < PICO_RTOS_HOST_MAX_ALARMS; i++) {
+        alarm_slots[i].next = alarm_free_list;
+        alarm_free_list = &alarm_slots[i];
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = host_signal_handler;
+    action.sa_flags = SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    sigaction(HOST_IRQ_SIGNAL, &action, NULL);
+}
+
+// =============================================================================
+// GPIO
+// =============================================================================
+
+static void host_gpio_irq_handler(void) {
+    for (uint gpio = 0; gpio < NUM_BANK0_GPIOS; gpio++) {
+        uint32_t events = __atomic_exchange_n(&gpio_irq_events[gpio], 0, __ATOMIC_SEQ_CST);
+        if (events != 0 && gpio_callback != NULL) {
+            gpio_callback(gpio, events);
+        }
+    }
+}
+
+void gpio_init(uint gpio) {
+    if (gpio < NUM_BANK0_GPIOS) {
+        gpio_dir_out &= ~(1u << gpio);
+        gpio_out_state &= ~(1u << gpio);
+    }
+}
+
+void gpio_set_dir(uint gpio, bool out) {
+    if (gpio >= NUM_BANK0_GPIOS) {
+        return;
+    }
+    if (out) {
+        gpio_dir_out |= 1u << gpio;
+    } else {
+        gpio_dir_out &= ~(1u << gpio);
+    }
+}
+
+void gpio_put(uint gpio, bool value) {
+    if (gpio >= NUM_BANK0_GPIOS) {
+        return;
+    }
+
+    bool previous = (gpio_out_state & (1u << gpio)) != 0;
+    if (value) {
+        gpio_out_state |= 1u << gpio;
+    } else {
+        gpio_out_state &= ~(1u << gpio);
+    }
+
+    uint32_t events = 0;
+    if (value && !previous) {
+        events |= GPIO_IRQ_EDGE_RISE;
+    } else if (!value && previous) {
+        events |= GPIO_IRQ_EDGE_FALL;
+    }
+    events |= value ? GPIO_IRQ_LEVEL_HIGH : GPIO_IRQ_LEVEL_LOW;
+    events &= gpio_irq_mask[gpio];
+
+    if (events != 0) {
+        __atomic_or_fetch(&gpio_irq_events[gpio], events, __ATOMIC_SEQ_CST);
+        irq_set_pending(IO_IRQ_BANK0);
+    }
+}
+
+bool gpio_get(uint gpio) {
+    return gpio < NUM_BANK0_GPIOS && (gpio_out_state & (1u << gpio)) != 0;
+}
+
+void gpio_pull_up(uint gpio) {
+    if (gpio < NUM_BANK0_GPIOS && !(gpio_dir_out & (1u << gpio))) {
+        gpio_out_state |= 1u << gpio;
+    }
+}
+
+void gpio_pull_down(uint gpio) {
+    if (gpio < NUM_BANK0_GPIOS && !(gpio_dir_out & (1u << gpio))) {
+        gpio_out_state &= ~(1u << gpio);
+    }
+}
+
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled) {
+    if (gpio >= NUM_BANK0_GPIOS) {
+        return;
+    }
+    if (enabled) {
+        gpio_irq_mask[gpio] |= (uint8_t)event_mask;
+    } else {
+        gpio_irq_mask[gpio] &= (uint8_t)~event_mask;
+    }
+}
+
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback) {
+    gpio_set_irq_enabled(gpio, event_mask, enabled);
+    gpio_callback = callback;
+    irq_set_exclusive_handler(IO_IRQ_BANK0, host_gpio_irq_handler);
+    irq_set_enabled(IO_IRQ_BANK0, true);
+}
+
+// =============================================================================
+// LIBC GUARDS
+// =============================================================================
+
+// glibc's allocator and stdio locks are not reentrant across ucontext
+// switches on one thread, so a task must not be preempted inside them.
+
+void *__wrap_malloc(size_t size) {
+    uint32_t save = save_and_disable_interrupts();
+    void *ptr = __real_malloc(size);
+    restore_interrupts(save);
+    return ptr;
+}
+
+void *__wrap_calloc(size_t nmemb, size_t size) {
+    uint32_t save = save_and_disable_interrupts();
+    void *ptr = __real_calloc(nmemb, size);
+    restore_interrupts(save);
+    return ptr;
+}
+
+void *__wrap_realloc(void *ptr, size_t size) {
+    uint32_t save = save_and_disable_interrupts();
+    void *result = __real_realloc(ptr, size);
+    restore_interrupts(save);
+    return result;
+}
+
+void __wrap_free(void *ptr) {
+    uint32_t save = save_and_disable_interrupts();
+    __real_free(ptr);
+    restore_interrupts(save);
+}
+
+int __wrap_vprintf(const char *format, va_list ap) {
+    uint32_t save = save_and_disable_interrupts();
+    int result = __real_vprintf(format, ap);
+    restore_interrupts(save);
+    return result;
+}
+
+int __wrap_printf(const char *format, ...) {
+    va_list ap;
+    va_start(ap, format);
+    int result = __wrap_vprintf(format, ap);
+    va_end(ap);
+    return result;
+}
+
+int __wrap_vfprintf(FILE *stream, const char *format, va_list ap) {
+    uint32_t save = save_and_disable_interrupts();
+    int result = __real_vfprintf(stream, format, ap);
+    restore_interrupts(save);
+    return result;
+}
+
+int __wrap_fprintf(FILE *stream, const char *format, ...) {
+    va_list ap;
+    va_start(ap, format);
+    int result = __wrap_vfprintf(stream, format, ap);
+    va_end(ap);
+    return result;
+}
+
+int __wrap_puts(const char *s) {
+    uint32_t save = save_and_disable_interrupts();
+    int result = __real_puts(s);
+    restore_interrupts(save);
+    return result;
+}
+
+int __wrap_putchar(int c) {
+    uint32_t save = save_and_disable_interrupts();
+    int result = __real_putchar(c);
+    restore_interrupts(save);
+    return result;
+}
+
+int __wrap_fputs(const char *s, FILE *stream) {
+    uint32_t save = save_and_disable_interrupts();
+    int result = __real_fputs(s, stream);
+    restore_interrupts(save);
+    return result;
+}
+
+int __wrap_fputc(int c, FILE *stream) {
+    uint32_t save = save_and_disable_interrupts();
+    int result = __real_fputc(c, stream);
+    restore_interrupts(save);
+    return result;
+}
+
+size_t __wrap_fwrite(const void *ptr, size_t size, size_t nmemb, FILE *stream) {
+    uint32_t save = save_and_disable_interrupts();
+    size_t result = __real_fwrite(ptr, size, nmemb, stream);
+    restore_interrupts(save);
+    return result;
+}
+
+int __wrap_fflush(FILE *stream) {
+    uint32_t save = save_and_disable_interrupts();
+    int result = __real_fflush(stream);
+    restore_interrupts(save);
+    return result;
+}
@@ -0,0 +1,53 @@
+/**
+ * @file host_port.h
+ * @brief Internal interface of the Linux host simulator port
+ *
+ * The host port runs every RTOS task on the thread that called main(),
+ * switching between them with ucontext. host_port.c emulates the interrupt
+ * controller (tick alarms delivered as SIGALRM, interrupt masking, pending
+ * PendSV) and host_context_switch.c implements the context_switch.h API on
+ * top of it. Nothing here is part of the public Pico-RTOS API.
+ */
+
+#ifndef PICO_RTOS_HOST_PORT_H
+#define PICO_RTOS_HOST_PORT_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @brief Check whether the caller is the thread that runs the RTOS
+ *
+ * Other pthreads (for example producers in a host-only stress test) behave
+ * like another core: they cannot mask the simulated interrupts and must
+ * stick to lock-free APIs.
+ */
+bool pico_rtos_host_is_scheduler_thread(void);
+
+/**
+ * @brief Check whether a simulated interrupt handler is executing
+ */
+bool pico_rtos_host_in_isr(void);
+
+/**
+ * @brief Request a PendSV
+ *
+ * The switch runs as soon as the scheduler thread is back in thread mode
+ * with interrupts unmasked, which may be before this call returns.
+ */
+void pico_rtos_host_pend_sv(void);
+
+/**
+ * @brief PendSV handler, implemented by host_context_switch.c
+ *
+ * Called by the interrupt emulation with interrupts unmasked and outside of
+ * any simulated ISR.
+ */
+void pico_rtos_host_pendsv_handler(void);
+
+/**
+ * @brief Check for and clear a pending PendSV request
+ */
+bool pico_rtos_host_take_pend_sv(void);
+
+#endif // PICO_RTOS_HOST_PORT_H
@@ -0,0 +1,38 @@
+/**
+ * @file clocks.h
+ * @brief Host simulator stand-in for hardware/clocks.h
+ */
+
+#ifndef _HARDWARE_CLOCKS_H
+#define _HARDWARE_CLOCKS_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+enum clock_index {
+    clk_gpout0 = 0,
+    clk_gpout1,
+    clk_gpout2,
+    clk_gpout3,
+    clk_ref,
+    clk_sys,
+    clk_peri,
+    clk_usb,
+    clk_adc,
+    clk_rtc,
+    CLK_COUNT
+};
+
+static inline uint32_t clock_get_hz(enum clock_index clk_index) {
+    (void)clk_index;
+    return PICO_RTOS_HOST_CLOCK_HZ;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _HARDWARE_CLOCKS_H
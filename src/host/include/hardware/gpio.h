@@ -0,0 +1,55 @@
+/**
+ * @file gpio.h
+ * @brief Host simulator stand-in for hardware/gpio.h
+ *
+ * Pins are plain bits in a simulated register. Driving an output pin
+ * produces the matching edge events on that pin, so a test can raise its own
+ * GPIO interrupt with gpio_put(); the callback runs through IO_IRQ_BANK0 in
+ * simulated interrupt context.
+ */
+
+#ifndef _HARDWARE_GPIO_H
+#define _HARDWARE_GPIO_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define NUM_BANK0_GPIOS 30
+
+#define GPIO_OUT 1
+#define GPIO_IN 0
+
+enum gpio_irq_level {
+    GPIO_IRQ_LEVEL_LOW = 0x1u,
+    GPIO_IRQ_LEVEL_HIGH = 0x2u,
+    GPIO_IRQ_EDGE_FALL = 0x4u,
+    GPIO_IRQ_EDGE_RISE = 0x8u,
+};
+
+typedef void (*gpio_irq_callback_t)(uint gpio, uint32_t event_mask);
+
+void gpio_init(uint gpio);
+void gpio_set_dir(uint gpio, bool out);
+void gpio_put(uint gpio, bool value);
+bool gpio_get(uint gpio);
+void gpio_pull_up(uint gpio);
+void gpio_pull_down(uint gpio);
+void gpio_set_irq_enabled(uint gpio, uint32_t event_mask, bool enabled);
+void gpio_set_irq_enabled_with_callback(uint gpio, uint32_t event_mask, bool enabled, gpio_irq_callback_t callback);
+
+static inline void gpio_xor_mask(uint32_t mask) {
+    for (uint gpio = 0; gpio < NUM_BANK0_GPIOS; gpio++) {
+        if (mask & (1u << gpio)) {
+            gpio_put(gpio, !gpio_get(gpio));
+        }
+    }
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _HARDWARE_GPIO_H
@@ -0,0 +1,107 @@
+/**
+ * @file sync.h
+ * @brief Host simulator stand-in for hardware/sync.h
+ *
+ * "Interrupts" on the host are POSIX signals delivered to the scheduler
+ * thread. Disabling them is a plain nesting counter; a signal that arrives
+ * while the counter is non-zero is latched and serviced when the outermost
+ * restore_interrupts() runs. Spin locks reduce to the same mechanism since
+ * the simulator models a single core.
+ */
+
+#ifndef _HARDWARE_SYNC_H
+#define _HARDWARE_SYNC_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef volatile uint32_t spin_lock_t;
+
+#define PICO_SPINLOCK_ID_OS1 14
+#define PICO_SPINLOCK_ID_OS2 15
+
+uint32_t save_and_disable_interrupts(void);
+void restore_interrupts(uint32_t status);
+
+void __wfi(void);
+
+static inline void __wfe(void) {
+    __wfi();
+}
+
+static inline void __sev(void) {
+}
+
+static inline void __nop(void) {
+    __asm__ volatile ("" ::: "memory");
+}
+
+static inline void __compiler_memory_barrier(void) {
+    __asm__ volatile ("" ::: "memory");
+}
+
+static inline void __dmb(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __mem_fence_acquire(void) {
+    __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+
+static inline void __mem_fence_release(void) {
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+static inline void __dsb(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void __isb(void) {
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline uint get_core_num(void) {
+    return 0;
+}
+
+spin_lock_t *spin_lock_instance(uint lock_num);
+spin_lock_t *spin_lock_init(uint lock_num);
+int spin_lock_claim_unused(bool required);
+void spin_lock_claim(uint lock_num);
+void spin_lock_unclaim(uint lock_num);
+
+static inline uint spin_lock_get_num(spin_lock_t *lock) {
+    return (uint)(lock - spin_lock_instance(0));
+}
+
+static inline void spin_lock_unsafe_blocking(spin_lock_t *lock) {
+    (void)lock;
+}
+
+static inline void spin_unlock_unsafe(spin_lock_t *lock) {
+    (void)lock;
+}
+
+static inline uint32_t spin_lock_blocking(spin_lock_t *lock) {
+    (void)lock;
+    return save_and_disable_interrupts();
+}
+
+static inline void spin_unlock(spin_lock_t *lock, uint32_t saved_irq) {
+    (void)lock;
+    restore_interrupts(saved_irq);
+}
+
+static inline bool is_spin_locked(spin_lock_t *lock) {
+    (void)lock;
+    return false;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _HARDWARE_SYNC_H
@@ -0,0 +1,61 @@
+/**
+ * @file timer.h
+ * @brief Host simulator stand-in for hardware/timer.h
+ *
+ * The 64-bit microsecond timer is backed by CLOCK_MONOTONIC. timer_hw
+ * resolves to a register block whose TIMERAWH/TIMERAWL fields are refreshed
+ * on every access, so code that reads timer_hw->timerawl for cycle-style
+ * measurements works unchanged. The alarm/interrupt registers exist only so
+ * that RP2040-specific code still compiles; writing them has no effect.
+ */
+
+#ifndef _HARDWARE_TIMER_H
+#define _HARDWARE_TIMER_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    volatile uint32_t timehw;
+    volatile uint32_t timelw;
+    volatile uint32_t timehr;
+    volatile uint32_t timelr;
+    volatile uint32_t alarm[4];
+    volatile uint32_t armed;
+    volatile uint32_t timerawh;
+    volatile uint32_t timerawl;
+    volatile uint32_t dbgpause;
+    volatile uint32_t pause;
+    volatile uint32_t intr;
+    volatile uint32_t inte;
+    volatile uint32_t intf;
+    volatile uint32_t ints;
+} timer_hw_t;
+
+timer_hw_t *pico_rtos_host_timer_hw(void);
+#define timer_hw (pico_rtos_host_timer_hw())
+
+uint64_t time_us_64(void);
+
+static inline uint32_t time_us_32(void) {
+    return (uint32_t)time_us_64();
+}
+
+void busy_wait_us(uint64_t delay_us);
+
+static inline void busy_wait_us_32(uint32_t delay_us) {
+    busy_wait_us(delay_us);
+}
+
+static inline void busy_wait_ms(uint32_t delay_ms) {
+    busy_wait_us((uint64_t)delay_ms * 1000u);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _HARDWARE_TIMER_H
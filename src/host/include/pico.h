@@ -0,0 +1,37 @@
+/**
+ * @file pico.h
+ * @brief Host simulator stand-in for the Pico SDK base header
+ *
+ * Only the handful of types and attributes used by Pico-RTOS, its tests and
+ * its examples are provided. Everything here is compiled for the Linux host
+ * build (PICO_RTOS_HOST_PORT) and never for the RP2040.
+ */
+
+#ifndef _PICO_H
+#define _PICO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef unsigned int uint;
+
+#ifndef __unused
+#define __unused __attribute__((unused))
+#endif
+
+#ifndef __always_inline
+#define __always_inline inline __attribute__((always_inline))
+#endif
+
+#define __not_in_flash_func(func_name) func_name
+#define __time_critical_func(func_name) func_name
+#define __no_inline_not_in_flash_func(func_name) __attribute__((noinline)) func_name
+
+#ifndef count_of
+#define count_of(a) (sizeof(a) / sizeof((a)[0]))
+#endif
+
+#define PICO_RTOS_HOST_CLOCK_HZ 125000000u
+
+#endif // _PICO_H
@@ -0,0 +1,48 @@
+/**
+ * @file multicore.h
+ * @brief Host simulator stand-in for pico/multicore.h
+ *
+ * The simulator models a single core. Core 1 is never started and the
+ * inter-core FIFO is always empty.
+ */
+
+#ifndef _PICO_MULTICORE_H
+#define _PICO_MULTICORE_H
+
+#include "pico.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+static inline void multicore_launch_core1(void (*entry)(void)) {
+    (void)entry;
+}
+
+static inline void multicore_reset_core1(void) {
+}
+
+static inline bool multicore_fifo_rvalid(void) {
+    return false;
+}
+
+static inline bool multicore_fifo_wready(void) {
+    return true;
+}
+
+static inline void multicore_fifo_push_blocking(uint32_t data) {
+    (void)data;
+}
+
+static inline uint32_t multicore_fifo_pop_blocking(void) {
+    return 0;
+}
+
+static inline void multicore_fifo_drain(void) {
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PICO_MULTICORE_H
@@ -0,0 +1,36 @@
+/**
+ * @file stdlib.h
+ * @brief Host simulator stand-in for pico/stdlib.h
+ */
+
+#ifndef _PICO_STDLIB_H
+#define _PICO_STDLIB_H
+
+#include "pico.h"
+#include "pico/time.h"
+#include "hardware/gpio.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef PICO_DEFAULT_LED_PIN
+#define PICO_DEFAULT_LED_PIN 25
+#endif
+
+bool stdio_init_all(void);
+
+static inline void tight_loop_contents(void) {
+}
+
+static inline bool set_sys_clock_khz(uint32_t freq_khz, bool required) {
+    (void)freq_khz;
+    (void)required;
+    return true;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _PICO_STDLIB_H
@@ -49,7 +49,7 @@ static bool validate_pool_structure(pico_rtos_memory_pool_t *pool) {
     }
     
     if (pool->magic != PICO_RTOS_MEMORY_POOL_MAGIC) {
-        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_CORRUPTION, (uint32_t)pool);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_CORRUPTION, (uint32_t)(uintptr_t)pool);
         return false;
     }
     
@@ -58,7 +58,7 @@ static bool validate_pool_structure(pico_rtos_memory_pool_t *pool) {
     }
     
     if (!is_aligned(pool->pool_start)) {
-        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_ALIGNMENT, (uint32_t)pool->pool_start);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_ALIGNMENT, (uint32_t)(uintptr_t)pool->pool_start);
         return false;
     }
     
@@ -136,6 +136,12 @@ static bool validate_block_ownership(pico_rtos_memory_pool_t *pool, void *block)
  * @return true if block is free, false if allocated or invalid
  */
 static bool is_block_in_free_list(pico_rtos_memory_pool_t *pool, void *block) {
+    // Allocation clears the block header, so only a block still carrying the
+    // free magic can be on the free list; skip the O(n) walk otherwise
+    if (((pico_rtos_memory_block_t *)block)->magic != PICO_RTOS_MEMORY_POOL_FREE_MAGIC) {
+        return false;
+    }
+    
     pico_rtos_memory_block_t *current = pool->free_list;
     
     while (current) {
@@ -145,7 +151,7 @@ static bool is_block_in_free_list(pico_rtos_memory_pool_t *pool, void *block) {
                 return true;
             } else {
                 // Corruption detected
-                PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_CORRUPTION, (uint32_t)current);
+                PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_CORRUPTION, (uint32_t)(uintptr_t)current);
                 return false;
             }
         }
@@ -209,17 +215,19 @@ static void update_free_stats(pico_rtos_memory_pool_t *pool, uint32_t free_cycle
 // PUBLIC API IMPLEMENTATION
 // =============================================================================
 
-bool pico_rtos_memory_pool_init(pico_rtos_memory_pool_t *pool, 
-                               void *memory, 
-                               uint32_t block_size, 
-                               uint32_t block_count) {
+// Shared by both initializers; wait_storage is NULL to allocate the wait list
+static bool pico_rtos_memory_pool_setup(pico_rtos_memory_pool_t *pool,
+                                        void *memory,
+                                        uint32_t block_size,
+                                        uint32_t block_count,
+                                        pico_rtos_block_object_t *wait_storage) {
     if (!pool || !memory || block_size == 0 || block_count == 0) {
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_INVALID_PARAM, 0);
         return false;
     }
     
     if (!is_aligned(memory)) {
-        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_ALIGNMENT, (uint32_t)memory);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_ALIGNMENT, (uint32_t)(uintptr_t)memory);
         return false;
     }
     
@@ -247,7 +255,8 @@ bool pico_rtos_memory_pool_init(pico_rtos_memory_pool_t *pool,
 #endif
     
     // Create blocking object for timeout support
-    pool->block_obj = pico_rtos_block_object_create(pool);
+    pool->block_obj = (wait_storage != NULL) ? pico_rtos_block_object_create_static(wait_storage, pool)
+                                             : pico_rtos_block_object_create(pool);
     if (!pool->block_obj) {
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_OUT_OF_MEMORY, 0);
         return false;
@@ -264,9 +273,30 @@ bool pico_rtos_memory_pool_init(pico_rtos_memory_pool_t *pool,
     return true;
 }
 
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+bool pico_rtos_memory_pool_init(pico_rtos_memory_pool_t *pool, 
+                               void *memory, 
+                               uint32_t block_size, 
+                               uint32_t block_count) {
+    return pico_rtos_memory_pool_setup(pool, memory, block_size, block_count, NULL);
+}
+#endif
+
+bool pico_rtos_memory_pool_init_static(pico_rtos_memory_pool_t *pool,
+                                      void *memory,
+                                      uint32_t block_size,
+                                      uint32_t block_count,
+                                      pico_rtos_block_object_t *wait_storage) {
+    if (wait_storage == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_INVALID_PARAM, 0);
+        return false;
+    }
+    return pico_rtos_memory_pool_setup(pool, memory, block_size, block_count, wait_storage);
+}
+
 void *pico_rtos_memory_pool_alloc(pico_rtos_memory_pool_t *pool, uint32_t timeout) {
     if (!validate_pool_structure(pool)) {
-        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_NOT_INITIALIZED, (uint32_t)pool);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_NOT_INITIALIZED, (uint32_t)(uintptr_t)pool);
         return NULL;
     }
     
@@ -287,7 +317,7 @@ void *pico_rtos_memory_pool_alloc(pico_rtos_memory_pool_t *pool, uint32_t timeou
             // Validate magic number
             if (block->magic != PICO_RTOS_MEMORY_POOL_FREE_MAGIC) {
                 critical_section_exit(&pool->cs);
-                PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_CORRUPTION, (uint32_t)block);
+                PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_CORRUPTION, (uint32_t)(uintptr_t)block);
 #if PICO_RTOS_ENABLE_MEMORY_TRACKING
                 pool->stats.corruption_detected++;
 #endif
@@ -348,7 +378,7 @@ void *pico_rtos_memory_pool_alloc(pico_rtos_memory_pool_t *pool, uint32_t timeou
 
 bool pico_rtos_memory_pool_free(pico_rtos_memory_pool_t *pool, void *block) {
     if (!validate_pool_structure(pool) || !block) {
-        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_INVALID_PARAM, (uint32_t)block);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_INVALID_PARAM, (uint32_t)(uintptr_t)block);
         return false;
     }
     
@@ -361,14 +391,14 @@ bool pico_rtos_memory_pool_free(pico_rtos_memory_pool_t *pool, void *block) {
     // Validate block ownership
     if (!validate_block_ownership(pool, block)) {
         critical_section_exit(&pool->cs);
-        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_INVALID_BLOCK, (uint32_t)block);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_INVALID_BLOCK, (uint32_t)(uintptr_t)block);
         return false;
     }
     
     // Check for double-free
     if (is_block_in_free_list(pool, block)) {
         critical_section_exit(&pool->cs);
-        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_DOUBLE_FREE, (uint32_t)block);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_DOUBLE_FREE, (uint32_t)(uintptr_t)block);
 #if PICO_RTOS_ENABLE_MEMORY_TRACKING
         pool->stats.double_free_detected++;
 #endif
@@ -576,7 +606,7 @@ bool pico_rtos_memory_pool_validate(pico_rtos_memory_pool_t *pool) {
         // Validate magic number
         if (current->magic != PICO_RTOS_MEMORY_POOL_FREE_MAGIC) {
             critical_section_exit(&pool->cs);
-            PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_CORRUPTION, (uint32_t)current);
+            PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MEMORY_POOL_CORRUPTION, (uint32_t)(uintptr_t)current);
             return false;
         }
         
@@ -0,0 +1,406 @@
+/**
+ * @file mpmc_ring.c
+ * @brief Bounded multi-producer/multi-consumer ring
+ *
+ * Dmitry Vyukov's sequence-numbered ring. Slot i starts with sequence i.
+ * A producer at position pos owns the slot once its sequence equals pos
+ * and it has moved push_pos from pos to pos + 1; it then copies the item
+ * in and publishes sequence pos + 1. A consumer at pos waits for sequence
+ * pos + 1, moves pop_pos on the same way, copies the item out and hands
+ * the slot to the next lap with sequence pos + capacity. A sequence behind
+ * the position means full (or empty), one ahead means another producer
+ * (or consumer) got there first. Producers and consumers only meet in the
+ * sequence words, so neither side serializes the other.
+ *
+ * The blocking calls sleep on the ring's wait lists. A waiter joins its
+ * list, then checks the ring once more behind a full barrier; a push or
+ * pop finishes its slot before a full barrier and then looks for waiters,
+ * so one of the two always sees the other.
+ */
+
+#include "pico_rtos/mpmc_ring.h"
+#include "pico_rtos/blocking.h"
+#include "pico_rtos/error.h"
+#include "pico_rtos.h"
+#include "hardware/sync.h"
+#include <string.h>
+
+#ifdef PICO_RTOS_HOST_PORT
+static inline bool pico_rtos_mpmc_ring_cas(pico_rtos_mpmc_ring_t *ring, volatile uint32_t *value,
+                                           uint32_t expected, uint32_t desired) {
+    (void)ring;
+    return __atomic_compare_exchange_n(value, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_RELAXED);
+}
+
+static inline void pico_rtos_mpmc_ring_count(pico_rtos_mpmc_ring_t *ring, volatile uint32_t *counter) {
+    (void)ring;
+    __atomic_fetch_add(counter, 1, __ATOMIC_RELAXED);
+}
+#else
+// The Cortex-M0+ has no exclusive loads and stores, so compare-and-swap
+// holds the ring's hardware spinlock for just the compare and the store
+static bool pico_rtos_mpmc_ring_cas(pico_rtos_mpmc_ring_t *ring, volatile uint32_t *value,
+                                    uint32_t expected, uint32_t desired) {
+    uint32_t save = spin_lock_blocking(ring->cas_lock);
+    bool swapped = (*value == expected);
+    if (swapped) {
+        *value = desired;
+    }
+    spin_unlock(ring->cas_lock, save);
+    return swapped;
+}
+
+static void pico_rtos_mpmc_ring_count(pico_rtos_mpmc_ring_t *ring, volatile uint32_t *counter) {
+    uint32_t save = spin_lock_blocking(ring->cas_lock);
+    (*counter)++;
+    spin_unlock(ring->cas_lock, save);
+}
+
+// Each ring claims a spinlock of its own, so rings do not contend with
+// each other or with the kernel's critical sections. Only 8 of the 32 can
+// be claimed; rings made after those run out share the SDK's striped
+// locks, which are spread over other striped users
+static void pico_rtos_mpmc_ring_claim_lock(pico_rtos_mpmc_ring_t *ring) {
+    int lock_num = spin_lock_claim_unused(false);
+    ring->cas_lock_claimed = (lock_num >= 0);
+    if (lock_num < 0) {
+        lock_num = (int)next_striped_spin_lock_num();
+    }
+    ring->cas_lock = spin_lock_instance((uint)lock_num);
+}
+
+static void pico_rtos_mpmc_ring_release_lock(pico_rtos_mpmc_ring_t *ring) {
+    if (ring->cas_lock_claimed) {
+        spin_lock_unclaim(spin_lock_get_num(ring->cas_lock));
+        ring->cas_lock_claimed = false;
+    }
+}
+#endif
+
+static inline uint8_t *pico_rtos_mpmc_ring_slot(const pico_rtos_mpmc_ring_t *ring, uint32_t pos) {
+    return ring->slots + (pos & ring->mask) * ring->slot_size;
+}
+
+static inline volatile uint32_t *pico_rtos_mpmc_ring_sequence(uint8_t *slot) {
+    return (volatile uint32_t *)slot;
+}
+
+// Shared by both initializers; the storage pointers are NULL to allocate the wait lists
+static bool pico_rtos_mpmc_ring_setup(pico_rtos_mpmc_ring_t *ring, void *buffer, size_t item_size,
+                                      size_t capacity, pico_rtos_block_object_t *push_wait_storage,
+                                      pico_rtos_block_object_t *pop_wait_storage) {
+    if (ring == NULL || buffer == NULL || ((uintptr_t)buffer & (sizeof(uint32_t) - 1)) != 0) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+
+    if (item_size == 0) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_QUEUE_INVALID_ITEM_SIZE, item_size);
+        return false;
+    }
+
+    // A single slot cannot tell a full ring from an empty one
+    if (capacity < 2 || (capacity & (capacity - 1)) != 0 || capacity > UINT32_MAX / 2) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_QUEUE_INVALID_SIZE, capacity);
+        return false;
+    }
+
+    ring->slots = (uint8_t *)buffer;
+    ring->slot_size = PICO_RTOS_MPMC_RING_SLOT_SIZE(item_size);
+    ring->item_size = item_size;
+    ring->mask = capacity - 1;
+    for (uint32_t i = 0; i < capacity; i++) {
+        *pico_rtos_mpmc_ring_sequence(pico_rtos_mpmc_ring_slot(ring, i)) = i;
+    }
+    ring->push_pos = 0;
+    ring->pop_pos = 0;
+    ring->push_retries = 0;
+    ring->pop_retries = 0;
+    ring->push_full = 0;
+    ring->pop_empty = 0;
+    ring->stats_push_base = 0;
+    ring->stats_pop_base = 0;
+#ifndef PICO_RTOS_HOST_PORT
+    pico_rtos_mpmc_ring_claim_lock(ring);
+#endif
+
+    if (push_wait_storage != NULL) {
+        ring->push_block_obj = pico_rtos_block_object_create_static(push_wait_storage, ring);
+        ring->pop_block_obj = pico_rtos_block_object_create_static(pop_wait_storage, ring);
+    } else {
+        ring->push_block_obj = pico_rtos_block_object_create(ring);
+        ring->pop_block_obj = pico_rtos_block_object_create(ring);
+    }
+    if (ring->push_block_obj == NULL || ring->pop_block_obj == NULL) {
+        pico_rtos_block_object_delete(ring->push_block_obj);
+        pico_rtos_block_object_delete(ring->pop_block_obj);
+        ring->push_block_obj = NULL;
+        ring->pop_block_obj = NULL;
+        ring->slots = NULL;
+#ifndef PICO_RTOS_HOST_PORT
+        pico_rtos_mpmc_ring_release_lock(ring);
+#endif
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_OUT_OF_MEMORY, 0);
+        return false;
+    }
+
+    __dmb();
+    return true;
+}
+
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+bool pico_rtos_mpmc_ring_init(pico_rtos_mpmc_ring_t *ring, void *buffer, size_t item_size, size_t capacity) {
+    return pico_rtos_mpmc_ring_setup(ring, buffer, item_size, capacity, NULL, NULL);
+}
+#endif
+
+bool pico_rtos_mpmc_ring_init_static(pico_rtos_mpmc_ring_t *ring, void *buffer, size_t item_size, size_t capacity,
+                                     pico_rtos_block_object_t *push_wait_storage,
+                                     pico_rtos_block_object_t *pop_wait_storage) {
+    if (push_wait_storage == NULL || pop_wait_storage == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    return pico_rtos_mpmc_ring_setup(ring, buffer, item_size, capacity, push_wait_storage, pop_wait_storage);
+}
+
+static bool pico_rtos_mpmc_ring_push_item(pico_rtos_mpmc_ring_t *ring, const void *item) {
+    if (ring->slots == NULL) {
+        return false;
+    }
+
+    uint32_t pos = ring->push_pos;
+    for (;;) {
+        uint8_t *slot = pico_rtos_mpmc_ring_slot(ring, pos);
+        volatile uint32_t *sequence = pico_rtos_mpmc_ring_sequence(slot);
+        int32_t diff = (int32_t)(*sequence - pos);
+        __mem_fence_acquire();
+
+        if (diff < 0) {
+            // The consumer a lap behind has not freed the slot yet
+            pico_rtos_mpmc_ring_count(ring, &ring->push_full);
+            return false;
+        }
+        if (diff == 0 && pico_rtos_mpmc_ring_cas(ring, &ring->push_pos, pos, pos + 1)) {
+            memcpy(slot + sizeof(uint32_t), item, ring->item_size);
+            __mem_fence_release();
+            *sequence = pos + 1;
+            return true;
+        }
+
+        // Another producer took this slot first
+        pico_rtos_mpmc_ring_count(ring, &ring->push_retries);
+        pos = ring->push_pos;
+    }
+}
+
+static bool pico_rtos_mpmc_ring_pop_item(pico_rtos_mpmc_ring_t *ring, void *item) {
+    if (ring->slots == NULL) {
+        return false;
+    }
+
+    uint32_t pos = ring->pop_pos;
+    for (;;) {
+        uint8_t *slot = pico_rtos_mpmc_ring_slot(ring, pos);
+        volatile uint32_t *sequence = pico_rtos_mpmc_ring_sequence(slot);
+        int32_t diff = (int32_t)(*sequence - (pos + 1));
+        __mem_fence_acquire();
+
+        if (diff < 0) {
+            // No producer has filled the slot yet
+            pico_rtos_mpmc_ring_count(ring, &ring->pop_empty);
+            return false;
+        }
+        if (diff == 0 && pico_rtos_mpmc_ring_cas(ring, &ring->pop_pos, pos, pos + 1)) {
+            memcpy(item, slot + sizeof(uint32_t), ring->item_size);
+            __mem_fence_release();
+            *sequence = pos + ring->mask + 1;
+            return true;
+        }
+
+        // Another consumer took this slot first
+        pico_rtos_mpmc_ring_count(ring, &ring->pop_retries);
+        pos = ring->pop_pos;
+    }
+}
+
+// Whether a push or pop could succeed now, without counting anything
+static bool pico_rtos_mpmc_ring_ready(pico_rtos_mpmc_ring_t *ring, bool push) {
+    if (ring->slots == NULL) {
+        return false;
+    }
+    uint32_t pos = push ? ring->push_pos : ring->pop_pos;
+    uint32_t wanted = push ? pos : pos + 1;
+    return (int32_t)(*pico_rtos_mpmc_ring_sequence(pico_rtos_mpmc_ring_slot(ring, pos)) - wanted) >= 0;
+}
+
+// Wake the highest priority task waiting on the other side, if any. The
+// barrier orders the slot just finished before the look at the wait list.
+// Inside pico_rtos_interrupt_enter()/exit() the switch waits for the
+// interrupt to return
+static void pico_rtos_mpmc_ring_wake(pico_rtos_block_object_t *wait) {
+    __dmb();
+    if (pico_rtos_unblock_highest_priority_task(wait) != NULL) {
+        pico_rtos_request_context_switch();
+    }
+}
+
+// Sleep on one of the ring's wait lists until woken or timed out. Returns
+// true to try again and false on a timeout or if the ring was deleted
+static bool pico_rtos_mpmc_ring_wait(pico_rtos_mpmc_ring_t *ring, bool push, uint32_t start, uint32_t timeout) {
+    uint32_t remaining = timeout;
+    if (timeout != PICO_RTOS_WAIT_FOREVER) {
+        uint32_t elapsed = pico_rtos_get_tick_count() - start;
+        remaining = (elapsed < timeout) ? timeout - elapsed : 0;
+    }
+
+    pico_rtos_block_object_t *wait = push ? ring->push_block_obj : ring->pop_block_obj;
+    pico_rtos_block_reason_t reason = push ? PICO_RTOS_BLOCK_REASON_QUEUE_FULL : PICO_RTOS_BLOCK_REASON_QUEUE_EMPTY;
+    pico_rtos_task_t *current_task = pico_rtos_get_current_task();
+    if (remaining == 0 || wait == NULL || current_task == NULL ||
+        !pico_rtos_block_task(wait, current_task, reason, remaining)) {
+        return false;
+    }
+
+    // A slot that changed before we joined may have been finished by a task
+    // that found no one waiting; wake the best waiter for it, maybe us
+    __dmb();
+    if (pico_rtos_mpmc_ring_ready(ring, push)) {
+        pico_rtos_unblock_highest_priority_task(wait);
+    }
+
+    pico_rtos_schedule_next_task();
+
+    // Still marked blocked means we timed out
+    return current_task->block_reason == PICO_RTOS_BLOCK_REASON_NONE;
+}
+
+bool pico_rtos_mpmc_ring_try_push(pico_rtos_mpmc_ring_t *ring, const void *item) {
+    if (ring == NULL || item == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+
+    if (!pico_rtos_mpmc_ring_push_item(ring, item)) {
+        return false;
+    }
+    pico_rtos_mpmc_ring_wake(ring->pop_block_obj);
+    return true;
+}
+
+bool pico_rtos_mpmc_ring_try_pop(pico_rtos_mpmc_ring_t *ring, void *item) {
+    if (ring == NULL || item == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+
+    if (!pico_rtos_mpmc_ring_pop_item(ring, item)) {
+        return false;
+    }
+    pico_rtos_mpmc_ring_wake(ring->push_block_obj);
+    return true;
+}
+
+bool pico_rtos_mpmc_ring_push(pico_rtos_mpmc_ring_t *ring, const void *item, uint32_t timeout) {
+    if (ring == NULL || item == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+
+    uint32_t start = 0;
+    bool waited = false;
+    while (!pico_rtos_mpmc_ring_push_item(ring, item)) {
+        // The clock is read only once the ring turns out full or empty
+        if (!waited) {
+            start = pico_rtos_get_tick_count();
+            waited = true;
+        }
+        if (timeout == 0 || !pico_rtos_mpmc_ring_wait(ring, true, start, timeout)) {
+            return false;
+        }
+    }
+
+    pico_rtos_mpmc_ring_wake(ring->pop_block_obj);
+    return true;
+}
+
+bool pico_rtos_mpmc_ring_pop(pico_rtos_mpmc_ring_t *ring, void *item, uint32_t timeout) {
+    if (ring == NULL || item == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+
+    uint32_t start = 0;
+    bool waited = false;
+    while (!pico_rtos_mpmc_ring_pop_item(ring, item)) {
+        // The clock is read only once the ring turns out full or empty
+        if (!waited) {
+            start = pico_rtos_get_tick_count();
+            waited = true;
+        }
+        if (timeout == 0 || !pico_rtos_mpmc_ring_wait(ring, false, start, timeout)) {
+            return false;
+        }
+    }
+
+    pico_rtos_mpmc_ring_wake(ring->push_block_obj);
+    return true;
+}
+
+uint32_t pico_rtos_mpmc_ring_get_count(pico_rtos_mpmc_ring_t *ring) {
+    if (ring == NULL || ring->slots == NULL) {
+        return 0;
+    }
+
+    // Read the consumers' position first so the difference cannot go
+    // negative; claimed but unfinished slots can push it past capacity
+    uint32_t pop_pos = ring->pop_pos;
+    __dmb();
+    uint32_t count = ring->push_pos - pop_pos;
+    return (count > ring->mask + 1) ? ring->mask + 1 : count;
+}
+
+bool pico_rtos_mpmc_ring_get_stats(pico_rtos_mpmc_ring_t *ring, pico_rtos_mpmc_ring_stats_t *stats) {
+    if (ring == NULL || stats == NULL) {
+        return false;
+    }
+
+    stats->pushes = ring->push_pos - ring->stats_push_base;
+    stats->pops = ring->pop_pos - ring->stats_pop_base;
+    stats->push_retries = ring->push_retries;
+    stats->pop_retries = ring->pop_retries;
+    stats->push_full = ring->push_full;
+    stats->pop_empty = ring->pop_empty;
+    return true;
+}
+
+void pico_rtos_mpmc_ring_reset_stats(pico_rtos_mpmc_ring_t *ring) {
+    if (ring == NULL) {
+        return;
+    }
+
+    ring->stats_push_base = ring->push_pos;
+    ring->stats_pop_base = ring->pop_pos;
+    ring->push_retries = 0;
+    ring->pop_retries = 0;
+    ring->push_full = 0;
+    ring->pop_empty = 0;
+}
+
+void pico_rtos_mpmc_ring_delete(pico_rtos_mpmc_ring_t *ring) {
+    if (ring == NULL) {
+        return;
+    }
+
+    // Tasks woken below try once more and find no slots
+    ring->slots = NULL;
+    __dmb();
+
+    pico_rtos_block_object_delete(ring->push_block_obj);
+    pico_rtos_block_object_delete(ring->pop_block_obj);
+    ring->push_block_obj = NULL;
+    ring->pop_block_obj = NULL;
+#ifndef PICO_RTOS_HOST_PORT
+    pico_rtos_mpmc_ring_release_lock(ring);
+#endif
+}
@@ -1,10 +1,15 @@
 #include "pico_rtos/mutex.h"
+#include "pico_rtos/rwlock.h"
 #include "pico_rtos/blocking.h"
 #include "pico_rtos/error.h"
 #include "pico_rtos/logging.h"
+#include "pico_rtos.h"
 #include "pico/critical_section.h"
 
-bool pico_rtos_mutex_init(pico_rtos_mutex_t *mutex) {
+// Shared by all initializers; ceiling is 0 for priority inheritance and
+// wait_storage is NULL to allocate the wait list
+static bool pico_rtos_mutex_setup(pico_rtos_mutex_t *mutex, uint32_t ceiling,
+                                  pico_rtos_block_object_t *wait_storage) {
     if (mutex == NULL) {
         PICO_RTOS_LOG_MUTEX_ERROR("Mutex initialization failed: NULL pointer");
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
@@ -15,10 +20,13 @@ bool pico_rtos_mutex_init(pico_rtos_mutex_t *mutex) {
     
     mutex->owner = NULL;
     mutex->lock_count = 0;
+    mutex->ceiling = ceiling;
+    mutex->held_next = NULL;
     critical_section_init(&mutex->cs);
     
     // Create blocking object for this mutex
-    mutex->block_obj = pico_rtos_block_object_create(mutex);
+    mutex->block_obj = (wait_storage != NULL) ? pico_rtos_block_object_create_static(wait_storage, mutex)
+                                              : pico_rtos_block_object_create(mutex);
     if (mutex->block_obj == NULL) {
         PICO_RTOS_LOG_MUTEX_ERROR("Mutex initialization failed: Could not create blocking object");
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_OUT_OF_MEMORY, 0);
@@ -29,6 +37,146 @@ bool pico_rtos_mutex_init(pico_rtos_mutex_t *mutex) {
     return true;
 }
 
+// A ceiling of 0 would mean priority inheritance, so it cannot be asked for
+static bool pico_rtos_mutex_check_ceiling(uint32_t ceiling) {
+    if (ceiling == 0) {
+        PICO_RTOS_LOG_MUTEX_ERROR("Mutex initialization failed: ceiling priority 0");
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_CONFIGURATION, ceiling);
+        return false;
+    }
+    return true;
+}
+
+static bool pico_rtos_mutex_check_wait_storage(pico_rtos_block_object_t *wait_storage) {
+    if (wait_storage == NULL) {
+        PICO_RTOS_LOG_MUTEX_ERROR("Mutex initialization failed: NULL wait list storage");
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    return true;
+}
+
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+bool pico_rtos_mutex_init(pico_rtos_mutex_t *mutex) {
+    return pico_rtos_mutex_setup(mutex, 0, NULL);
+}
+
+bool pico_rtos_mutex_init_ceiling(pico_rtos_mutex_t *mutex, uint32_t ceiling) {
+    return pico_rtos_mutex_check_ceiling(ceiling) && pico_rtos_mutex_setup(mutex, ceiling, NULL);
+}
+#endif
+
+bool pico_rtos_mutex_init_static(pico_rtos_mutex_t *mutex, pico_rtos_block_object_t *wait_storage) {
+    return pico_rtos_mutex_check_wait_storage(wait_storage) && pico_rtos_mutex_setup(mutex, 0, wait_storage);
+}
+
+bool pico_rtos_mutex_init_ceiling_static(pico_rtos_mutex_t *mutex, uint32_t ceiling,
+                                         pico_rtos_block_object_t *wait_storage) {
+    return pico_rtos_mutex_check_ceiling(ceiling) && pico_rtos_mutex_check_wait_storage(wait_storage) &&
+           pico_rtos_mutex_setup(mutex, ceiling, wait_storage);
+}
+
+// Priority of the top waiter on a wait list, or 0 if none waits
+static inline uint32_t pico_rtos_mutex_top_waiter_priority(const pico_rtos_block_object_t *wait) {
+    // Wait lists are priority ordered, so the head is the top waiter
+    const pico_rtos_blocked_task_t *top = (wait != NULL) ? wait->blocked_tasks_head : NULL;
+    return (top != NULL) ? top->priority : 0;
+}
+
+// Priority a task runs at: its base priority, raised to the ceiling of
+// every ceiling mutex it holds and to the highest waiter on every mutex or
+// write lock it holds (caller holds the kernel critical section)
+static uint32_t pico_rtos_mutex_effective_priority(const pico_rtos_task_t *task) {
+    uint32_t priority = task->original_priority;
+    
+    for (const pico_rtos_mutex_t *held = task->held_mutexes; held != NULL; held = held->held_next) {
+        if (held->ceiling > priority) {
+            priority = held->ceiling;
+        }
+        uint32_t waiter = pico_rtos_mutex_top_waiter_priority(held->block_obj);
+        if (waiter > priority) {
+            priority = waiter;
+        }
+    }
+    
+    // Readers and writers waiting for a write lock both wait on the writer
+    for (const pico_rtos_rwlock_t *held = task->held_rwlocks; held != NULL; held = held->held_next) {
+        uint32_t reader = pico_rtos_mutex_top_waiter_priority(held->read_wait);
+        uint32_t writer = pico_rtos_mutex_top_waiter_priority(held->write_wait);
+        if (reader > priority) {
+            priority = reader;
+        }
+        if (writer > priority) {
+            priority = writer;
+        }
+    }
+    
+    return priority;
+}
+
+// Recompute a task's priority from its base priority and the mutexes and
+// write locks it holds. If it is waiting for a mutex or a write-held lock,
+// its place in the wait list and with it the owner's priority change too,
+// so keep going along the chain of owners until a priority stays the same
+// (thread-safe)
+void pico_rtos_mutex_update_priority(pico_rtos_task_t *task) {
+    pico_rtos_enter_critical();
+    
+    while (task != NULL) {
+        uint32_t priority = pico_rtos_mutex_effective_priority(task);
+        if (priority == task->priority) {
+            break;
+        }
+        
+        PICO_RTOS_LOG_MUTEX_DEBUG("Task %s priority %lu -> %lu",
+                                 task->name ? task->name : "unnamed", task->priority, priority);
+        pico_rtos_scheduler_set_task_priority(task, priority);
+        
+        pico_rtos_block_object_t *wait = task->wait_node.owner;
+        if (task->state != PICO_RTOS_TASK_STATE_BLOCKED || wait == NULL) {
+            break;
+        }
+        pico_rtos_block_object_reprioritize_task(wait, task);
+        if (task->block_reason == PICO_RTOS_BLOCK_REASON_MUTEX) {
+            task = ((pico_rtos_mutex_t *)wait->sync_object)->owner;
+        } else if (task->block_reason == PICO_RTOS_BLOCK_REASON_RWLOCK) {
+            // A read-held lock has no owner to pass the boost to
+            task = ((pico_rtos_rwlock_t *)wait->sync_object)->writer;
+        } else {
+            break;
+        }
+    }
+    
+    pico_rtos_exit_critical();
+}
+
+// Make a task the owner and add the mutex to its held list; a ceiling
+// mutex raises it to the ceiling at once, and the remaining waiters keep
+// it at least at their priority (caller holds the mutex's critical section)
+static void pico_rtos_mutex_take_ownership(pico_rtos_mutex_t *mutex, pico_rtos_task_t *task) {
+    pico_rtos_enter_critical();
+    mutex->owner = task;
+    mutex->lock_count = 1;
+    mutex->held_next = task->held_mutexes;
+    task->held_mutexes = mutex;
+    pico_rtos_mutex_update_priority(task);
+    pico_rtos_exit_critical();
+}
+
+// Take the mutex off its owner's held list (caller holds the kernel
+// critical section); usually the most recent, so the head
+static void pico_rtos_mutex_release_ownership(pico_rtos_mutex_t *mutex) {
+    pico_rtos_mutex_t **link = &mutex->owner->held_mutexes;
+    while (*link != NULL && *link != mutex) {
+        link = &(*link)->held_next;
+    }
+    if (*link != NULL) {
+        *link = mutex->held_next;
+    }
+    mutex->held_next = NULL;
+    mutex->owner = NULL;
+}
+
 bool pico_rtos_mutex_lock(pico_rtos_mutex_t *mutex, uint32_t timeout) {
     if (mutex == NULL) {
         PICO_RTOS_LOG_MUTEX_ERROR("Mutex lock failed: NULL pointer");
@@ -47,12 +195,20 @@ bool pico_rtos_mutex_lock(pico_rtos_mutex_t *mutex, uint32_t timeout) {
                              current_task->name ? current_task->name : "unnamed", 
                              (void*)mutex, timeout);
 
+    // A ceiling below the locker's own priority would let the owner be preempted
+    if (mutex->ceiling != 0 && current_task->original_priority > mutex->ceiling) {
+        PICO_RTOS_LOG_MUTEX_ERROR("Task %s priority %lu is above the ceiling %lu of mutex %p",
+                                 current_task->name ? current_task->name : "unnamed",
+                                 current_task->original_priority, mutex->ceiling, (void*)mutex);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_MUTEX_CEILING_VIOLATION, current_task->original_priority);
+        return false;
+    }
+
     critical_section_enter_blocking(&mutex->cs);
 
     // Case 1: Mutex is available
     if (mutex->owner == NULL) {
-        mutex->owner = current_task;
-        mutex->lock_count = 1;
+        pico_rtos_mutex_take_ownership(mutex, current_task);
         critical_section_exit(&mutex->cs);
         PICO_RTOS_LOG_MUTEX_DEBUG("Task %s acquired mutex %p", 
                                  current_task->name ? current_task->name : "unnamed", 
@@ -76,14 +232,6 @@ bool pico_rtos_mutex_lock(pico_rtos_mutex_t *mutex, uint32_t timeout) {
                              mutex->owner->name ? mutex->owner->name : "unnamed",
                              current_task->name ? current_task->name : "unnamed");
     
-    // Implement priority inheritance - boost owner's priority if needed
-    if (current_task->priority > mutex->owner->priority) {
-        PICO_RTOS_LOG_MUTEX_DEBUG("Priority inheritance: boosting task %s priority from %lu to %lu", 
-                                 mutex->owner->name ? mutex->owner->name : "unnamed",
-                                 mutex->owner->priority, current_task->priority);
-        mutex->owner->priority = current_task->priority;
-    }
-    
     // If timeout is zero, don't wait
     if (timeout == 0) {
         critical_section_exit(&mutex->cs);
@@ -93,17 +241,21 @@ bool pico_rtos_mutex_lock(pico_rtos_mutex_t *mutex, uint32_t timeout) {
         return false;
     }
     
-    // Block task until mutex becomes available or timeout
-    critical_section_exit(&mutex->cs);
-    
-    // Use the blocking mechanism to block the task
+    // Join the wait list before letting go of the mutex, so an unlock on
+    // the other core cannot slip in between and find no waiter to hand to
     if (!pico_rtos_block_task(mutex->block_obj, current_task, PICO_RTOS_BLOCK_REASON_MUTEX, timeout)) {
+        critical_section_exit(&mutex->cs);
         PICO_RTOS_LOG_MUTEX_WARN("Task %s failed to block on mutex %p", 
                                 current_task->name ? current_task->name : "unnamed", 
                                 (void*)mutex);
         return false;
     }
     
+    // Priority inheritance: now that we wait, the owner runs at least at our
+    // priority, and so does whatever it is waiting for in turn
+    pico_rtos_mutex_update_priority(mutex->owner);
+    critical_section_exit(&mutex->cs);
+    
     // Trigger scheduler to switch to another task
     extern void pico_rtos_scheduler(void);
     pico_rtos_scheduler();
@@ -112,6 +264,10 @@ bool pico_rtos_mutex_lock(pico_rtos_mutex_t *mutex, uint32_t timeout) {
     // Check if we got the mutex or timed out
     critical_section_enter_blocking(&mutex->cs);
     bool success = (mutex->owner == current_task);
+    if (!success) {
+        // We no longer wait, so the owner may have inherited too much
+        pico_rtos_mutex_update_priority(mutex->owner);
+    }
     critical_section_exit(&mutex->cs);
     
     if (success) {
@@ -160,33 +316,40 @@ bool pico_rtos_mutex_unlock(pico_rtos_mutex_t *mutex) {
                              (void*)mutex, mutex->lock_count);
     
     // Decrement lock count, release mutex if count reaches 0
+    bool lowered = false;
     mutex->lock_count--;
     if (mutex->lock_count == 0) {
-        // Restore original priority (priority inheritance cleanup)
-        if (current_task->priority != current_task->original_priority) {
-            PICO_RTOS_LOG_MUTEX_DEBUG("Restoring task %s priority from %lu to %lu", 
-                                     current_task->name ? current_task->name : "unnamed",
-                                     current_task->priority, current_task->original_priority);
-            current_task->priority = current_task->original_priority;
-        }
+        pico_rtos_enter_critical();
+        pico_rtos_mutex_release_ownership(mutex);
         
         // Unblock the highest priority waiting task and give it the mutex
         pico_rtos_task_t *unblocked_task = pico_rtos_unblock_highest_priority_task(mutex->block_obj);
         if (unblocked_task != NULL) {
             // Give the mutex to the unblocked task
-            mutex->owner = unblocked_task;
-            mutex->lock_count = 1;
+            pico_rtos_mutex_take_ownership(mutex, unblocked_task);
             PICO_RTOS_LOG_MUTEX_DEBUG("Mutex %p transferred to task %s", 
                                      (void*)mutex,
                                      unblocked_task->name ? unblocked_task->name : "unnamed");
         } else {
-            // No tasks waiting, release the mutex
-            mutex->owner = NULL;
             PICO_RTOS_LOG_MUTEX_DEBUG("Mutex %p released (no waiting tasks)", (void*)mutex);
         }
+        
+        // Drop the ceiling and whatever was inherited through this mutex
+        // alone; mutexes still held keep their share
+        uint32_t previous_priority = current_task->priority;
+        pico_rtos_mutex_update_priority(current_task);
+        lowered = (current_task->priority < previous_priority);
+        pico_rtos_exit_critical();
     }
 
     critical_section_exit(&mutex->cs);
+    
+    // A task that became ready while we ran raised may now outrank us
+    if (lowered) {
+        extern void pico_rtos_schedule_next_task(void);
+        pico_rtos_schedule_next_task();
+    }
+    
     return true;
 }
 
@@ -216,7 +379,15 @@ void pico_rtos_mutex_delete(pico_rtos_mutex_t *mutex) {
         mutex->block_obj = NULL;
     }
     
-    mutex->owner = NULL;
+    // Don't leave an owner raised by a mutex that no longer exists
+    if (mutex->owner != NULL) {
+        pico_rtos_task_t *owner = mutex->owner;
+        pico_rtos_enter_critical();
+        pico_rtos_mutex_release_ownership(mutex);
+        pico_rtos_mutex_update_priority(owner);
+        pico_rtos_exit_critical();
+    }
+    
     mutex->lock_count = 0;
     
     critical_section_exit(&mutex->cs);
@@ -1,10 +1,15 @@
 #include "pico_rtos/queue.h"
+#include "pico_rtos/blocking.h"
 #include "pico_rtos/error.h"
 #include "pico_rtos.h"
 #include "pico/critical_section.h"
+#include "hardware/sync.h"
 #include <string.h>
 
-bool pico_rtos_queue_init(pico_rtos_queue_t *queue, void *buffer, size_t item_size, size_t max_items) {
+// Shared by the initializers; the storage pointers are NULL to allocate the wait lists
+static bool pico_rtos_queue_setup(pico_rtos_queue_t *queue, void *buffer, size_t item_size, size_t max_items,
+                                  bool spsc, pico_rtos_block_object_t *send_wait_storage,
+                                  pico_rtos_block_object_t *receive_wait_storage) {
     if (queue == NULL || buffer == NULL) {
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
         return false;
@@ -26,148 +31,510 @@ bool pico_rtos_queue_init(pico_rtos_queue_t *queue, void *buffer, size_t item_si
     queue->head = 0;
     queue->tail = 0;
     queue->count = 0;
+    queue->spsc = spsc;
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    queue->set_member.set = NULL;
+    queue->set_member.next = NULL;
+#endif
     
     critical_section_init(&queue->cs);
     
-    queue->send_block_obj = NULL;
-    queue->receive_block_obj = NULL;
+    if (send_wait_storage != NULL) {
+        queue->send_block_obj = pico_rtos_block_object_create_static(send_wait_storage, queue);
+        queue->receive_block_obj = pico_rtos_block_object_create_static(receive_wait_storage, queue);
+    } else {
+        queue->send_block_obj = pico_rtos_block_object_create(queue);
+        queue->receive_block_obj = pico_rtos_block_object_create(queue);
+    }
+    if (queue->send_block_obj == NULL || queue->receive_block_obj == NULL) {
+        pico_rtos_block_object_delete(queue->send_block_obj);
+        pico_rtos_block_object_delete(queue->receive_block_obj);
+        queue->send_block_obj = NULL;
+        queue->receive_block_obj = NULL;
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_OUT_OF_MEMORY, 0);
+        return false;
+    }
+    
+    return true;
+}
+
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+bool pico_rtos_queue_init(pico_rtos_queue_t *queue, void *buffer, size_t item_size, size_t max_items) {
+    return pico_rtos_queue_setup(queue, buffer, item_size, max_items, false, NULL, NULL);
+}
+
+bool pico_rtos_queue_init_spsc(pico_rtos_queue_t *queue, void *buffer, size_t item_size, size_t max_items) {
+    return pico_rtos_queue_setup(queue, buffer, item_size, max_items, true, NULL, NULL);
+}
+#endif
+
+bool pico_rtos_queue_init_static(pico_rtos_queue_t *queue, void *buffer, size_t item_size, size_t max_items,
+                                 pico_rtos_block_object_t *send_wait_storage,
+                                 pico_rtos_block_object_t *receive_wait_storage) {
+    if (send_wait_storage == NULL || receive_wait_storage == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    return pico_rtos_queue_setup(queue, buffer, item_size, max_items, false, send_wait_storage,
+                                 receive_wait_storage);
+}
+
+bool pico_rtos_queue_init_spsc_static(pico_rtos_queue_t *queue, void *buffer, size_t item_size, size_t max_items,
+                                      pico_rtos_block_object_t *send_wait_storage,
+                                      pico_rtos_block_object_t *receive_wait_storage) {
+    if (send_wait_storage == NULL || receive_wait_storage == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    return pico_rtos_queue_setup(queue, buffer, item_size, max_items, true, send_wait_storage,
+                                 receive_wait_storage);
+}
+
+// Wait on one of the queue's wait lists until woken or timed out, for
+// what is left of a timeout that began at start (caller holds the queue
+// lock). Returns true with the lock held again if woken; a woken task
+// re-checks, as another may have got there first. Returns false with the
+// lock released on a timeout, if it cannot wait or if the queue was
+// deleted meanwhile
+static bool pico_rtos_queue_wait(pico_rtos_queue_t *queue, pico_rtos_block_object_t *wait,
+                                 pico_rtos_block_reason_t reason, uint32_t start, uint32_t timeout) {
+    uint32_t remaining = timeout;
+    if (timeout != PICO_RTOS_WAIT_FOREVER) {
+        uint32_t elapsed = pico_rtos_get_tick_count() - start;
+        remaining = (elapsed < timeout) ? timeout - elapsed : 0;
+    }
+    
+    // Block the current task; joining the wait list before releasing the
+    // queue lock means a send or receive in between cannot miss us
+    pico_rtos_task_t *current_task = pico_rtos_get_current_task();
+    if (remaining == 0 || current_task == NULL ||
+        !pico_rtos_block_task(wait, current_task, reason, remaining)) {
+        critical_section_exit(&queue->cs);
+        return false;
+    }
+    critical_section_exit(&queue->cs);
+    
+    // Trigger scheduler to switch to another task
+    pico_rtos_schedule_next_task();
+    
+    // When we return, check if we're still blocked (timed out) or woken
+    if (current_task->block_reason != PICO_RTOS_BLOCK_REASON_NONE) {
+        return false;  // Timed out
+    }
     
+    // Deleting the queue wakes its waiters too, and clears its wait lists
+    critical_section_enter_blocking(&queue->cs);
+    if (queue->send_block_obj == NULL) {
+        critical_section_exit(&queue->cs);
+        return false;
+    }
     return true;
 }
 
+// Copy items into the buffer from a slot on, in at most two spans around
+// the end of the buffer
+static void pico_rtos_queue_copy_to(pico_rtos_queue_t *queue, size_t slot, const void *items, size_t count) {
+    size_t first = queue->max_items - slot;
+    if (first > count) {
+        first = count;
+    }
+    
+    uint8_t *buffer = (uint8_t *)queue->buffer;
+    memcpy(buffer + slot * queue->item_size, items, first * queue->item_size);
+    memcpy(buffer, (const uint8_t *)items + first * queue->item_size, (count - first) * queue->item_size);
+}
+
+// Copy items out of the buffer from a slot on, in at most two spans
+static void pico_rtos_queue_copy_from(pico_rtos_queue_t *queue, size_t slot, void *items, size_t count) {
+    size_t first = queue->max_items - slot;
+    if (first > count) {
+        first = count;
+    }
+    
+    const uint8_t *buffer = (const uint8_t *)queue->buffer;
+    memcpy(items, buffer + slot * queue->item_size, first * queue->item_size);
+    memcpy((uint8_t *)items + first * queue->item_size, buffer, (count - first) * queue->item_size);
+}
+
+// Copy items in at the tail (caller holds the queue lock and has checked
+// there is room)
+static void pico_rtos_queue_copy_in(pico_rtos_queue_t *queue, const void *items, size_t count) {
+    pico_rtos_queue_copy_to(queue, queue->tail, items, count);
+    queue->tail = (queue->tail + count) % queue->max_items;
+    queue->count += count;
+}
+
+// Copy items out from the head (caller holds the queue lock and has
+// checked there are that many)
+static void pico_rtos_queue_copy_out(pico_rtos_queue_t *queue, void *items, size_t count) {
+    pico_rtos_queue_copy_from(queue, queue->head, items, count);
+    queue->head = (queue->head + count) % queue->max_items;
+    queue->count -= count;
+}
+
+// Wake one waiter per item moved, as that many single sends or receives
+// would; returns true if any task was woken (caller holds the queue lock)
+static bool pico_rtos_queue_wake(pico_rtos_block_object_t *wait, size_t count) {
+    bool woke = false;
+    while (count-- > 0 && pico_rtos_unblock_highest_priority_task(wait) != NULL) {
+        woke = true;
+    }
+    return woke;
+}
+
+// SPSC mode. Head and tail run over [0, 2 * max_items) so that a full
+// queue (tail - head == max_items) and an empty one (tail == head) differ
+// without a shared count; each index is written by one side only, so the
+// data path needs no lock. An index maps to slot index % max_items, which
+// is at most one subtraction here.
+
+static size_t pico_rtos_queue_spsc_slot(const pico_rtos_queue_t *queue, size_t index) {
+    return (index < queue->max_items) ? index : index - queue->max_items;
+}
+
+static size_t pico_rtos_queue_spsc_advance(const pico_rtos_queue_t *queue, size_t index, size_t count) {
+    index += count;
+    return (index < 2 * queue->max_items) ? index : index - 2 * queue->max_items;
+}
+
+static size_t pico_rtos_queue_spsc_count(const pico_rtos_queue_t *queue, size_t head, size_t tail) {
+    return (tail >= head) ? tail - head : tail + 2 * queue->max_items - head;
+}
+
+// Sleep until the other side moves its index away from seen. The waiter
+// joins its wait list, then looks at the index once more: the other side
+// publishes its index before looking at the wait list, and the barriers
+// on both sides mean at least one of them sees the other. Returns true to
+// try again and false on a timeout or if the queue was deleted
+static bool pico_rtos_queue_spsc_wait(pico_rtos_block_object_t *wait, pico_rtos_block_reason_t reason,
+                                      const volatile size_t *other_index, size_t seen, uint32_t start,
+                                      uint32_t timeout) {
+    uint32_t remaining = timeout;
+    if (timeout != PICO_RTOS_WAIT_FOREVER) {
+        uint32_t elapsed = pico_rtos_get_tick_count() - start;
+        remaining = (elapsed < timeout) ? timeout - elapsed : 0;
+    }
+    
+    pico_rtos_task_t *current_task = pico_rtos_get_current_task();
+    if (remaining == 0 || wait == NULL || current_task == NULL ||
+        !pico_rtos_block_task(wait, current_task, reason, remaining)) {
+        return false;
+    }
+    
+    // Only one task uses each side, so the one waiter is this task; the
+    // scheduler puts it back to running, or runs whatever now outranks it
+    __dmb();
+    if (*other_index != seen) {
+        pico_rtos_unblock_highest_priority_task(wait);
+    }
+    
+    pico_rtos_schedule_next_task();
+    
+    // Still marked blocked means we timed out
+    return current_task->block_reason == PICO_RTOS_BLOCK_REASON_NONE;
+}
+
+// Sets *woken if a waiting receiver was made ready; the caller switches
+static size_t pico_rtos_queue_spsc_send(pico_rtos_queue_t *queue, const void *items, size_t count,
+                                        uint32_t timeout, bool *woken) {
+    size_t tail = queue->tail;
+    size_t head = queue->head;
+    uint32_t start = 0;
+    bool waited = false;
+    
+    // Wait only while nothing at all fits; the clock is read only then
+    while (pico_rtos_queue_spsc_count(queue, head, tail) == queue->max_items) {
+        if (!waited) {
+            start = pico_rtos_get_tick_count();
+            waited = true;
+        }
+        if (timeout == 0 ||
+            !pico_rtos_queue_spsc_wait(queue->send_block_obj, PICO_RTOS_BLOCK_REASON_QUEUE_FULL,
+                                       &queue->head, head, start, timeout) ||
+            queue->send_block_obj == NULL) {
+            return 0;
+        }
+        head = queue->head;
+    }
+    
+    size_t space = queue->max_items - pico_rtos_queue_spsc_count(queue, head, tail);
+    if (count > space) {
+        count = space;
+    }
+    
+    // The receiver has finished reading the slots before we overwrite them,
+    // and the items are in place before the new tail is visible. The full
+    // barrier after publishing pairs with the one in a waiting receiver
+    __mem_fence_acquire();
+    pico_rtos_queue_copy_to(queue, pico_rtos_queue_spsc_slot(queue, tail), items, count);
+    __mem_fence_release();
+    queue->tail = pico_rtos_queue_spsc_advance(queue, tail, count);
+    __dmb();
+    
+    *woken = pico_rtos_queue_wake(queue->receive_block_obj, 1);
+    
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    *woken |= pico_rtos_queue_set_notify_from_isr(&queue->set_member);
+#endif
+    
+    return count;
+}
+
+static size_t pico_rtos_queue_spsc_receive(pico_rtos_queue_t *queue, void *items, size_t max_count,
+                                           uint32_t timeout) {
+    size_t head = queue->head;
+    size_t tail = queue->tail;
+    uint32_t start = 0;
+    bool waited = false;
+    
+    // Wait only while there is nothing at all
+    while (tail == head) {
+        if (!waited) {
+            start = pico_rtos_get_tick_count();
+            waited = true;
+        }
+        if (timeout == 0 ||
+            !pico_rtos_queue_spsc_wait(queue->receive_block_obj, PICO_RTOS_BLOCK_REASON_QUEUE_EMPTY,
+                                       &queue->tail, tail, start, timeout) ||
+            queue->send_block_obj == NULL) {
+            return 0;
+        }
+        tail = queue->tail;
+    }
+    
+    size_t available = pico_rtos_queue_spsc_count(queue, head, tail);
+    size_t count = (available < max_count) ? available : max_count;
+    
+    // Read the items only after seeing the tail that covers them, and
+    // finish reading before the sender may reuse the slots
+    __mem_fence_acquire();
+    pico_rtos_queue_copy_from(queue, pico_rtos_queue_spsc_slot(queue, head), items, count);
+    __mem_fence_release();
+    queue->head = pico_rtos_queue_spsc_advance(queue, head, count);
+    __dmb();
+    
+    if (pico_rtos_queue_wake(queue->send_block_obj, 1)) {
+        pico_rtos_schedule_next_task();
+    }
+    return count;
+}
+
 bool pico_rtos_queue_send(pico_rtos_queue_t *queue, const void *item, uint32_t timeout) {
     if (queue == NULL || item == NULL) {
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
         return false;
     }
+    
+    if (queue->spsc) {
+        bool woken = false;
+        bool sent = pico_rtos_queue_spsc_send(queue, item, 1, timeout, &woken) == 1;
+        if (woken) {
+            pico_rtos_schedule_next_task();
+        }
+        return sent;
+    }
 
+    uint32_t start = 0;
+    bool waited = false;
+    
     critical_section_enter_blocking(&queue->cs);
 
-    // Check if queue is full
-    if (queue->count == queue->max_items) {
-        // If timeout is 0, return immediately
-        if (timeout == 0) {
-            critical_section_exit(&queue->cs);
+    // Wait for space
+    while (queue->count == queue->max_items) {
+        if (!waited) {
+            start = pico_rtos_get_tick_count();
+            waited = true;
+        }
+        if (!pico_rtos_queue_wait(queue, queue->send_block_obj, PICO_RTOS_BLOCK_REASON_QUEUE_FULL, start, timeout)) {
             return false;
         }
-        
-        // Block the current task
-        pico_rtos_task_t *current_task = pico_rtos_get_current_task();
-        if (current_task != NULL) {
-            current_task->state = PICO_RTOS_TASK_STATE_BLOCKED;
-            current_task->block_reason = PICO_RTOS_BLOCK_REASON_QUEUE_FULL;
-            current_task->blocking_object = queue->send_block_obj;
-            
-            if (timeout != PICO_RTOS_WAIT_FOREVER) {
-                current_task->delay_until = pico_rtos_get_tick_count() + timeout;
-            }
-            
-            critical_section_exit(&queue->cs);
-            
-            // Trigger scheduler to switch to another task
-            extern void pico_rtos_scheduler(void);
-            pico_rtos_scheduler();
-            
-            // When we return, check if we're still blocked (timed out) or ready to send
-            if (current_task->block_reason != PICO_RTOS_BLOCK_REASON_NONE) {
-                return false;  // Timed out
-            }
-            
-            // Reacquire lock to continue sending
-            critical_section_enter_blocking(&queue->cs);
-        }
-    }
-
-    // At this point, we should have space in the queue
-    if (queue->count < queue->max_items) {
-        // Copy item to queue
-        uint8_t *dest = (uint8_t *)queue->buffer + queue->tail * queue->item_size;
-        memcpy(dest, item, queue->item_size);
-        
-        // Update tail and count
-        queue->tail = (queue->tail + 1) % queue->max_items;
-        queue->count++;
-        
-        // Unblock any tasks waiting to receive
-        if (queue->receive_block_obj != NULL) {
-            extern void pico_rtos_task_resume_highest_priority(void);
-            pico_rtos_task_resume_highest_priority();
+    }
+
+    pico_rtos_queue_copy_in(queue, item, 1);
+    
+    // Unblock the highest priority task waiting to receive
+    bool woke = pico_rtos_queue_wake(queue->receive_block_obj, 1);
+    
+    critical_section_exit(&queue->cs);
+    
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    // Tell a task waiting on the queue's set, after letting go of the queue
+    pico_rtos_queue_set_notify(&queue->set_member);
+#endif
+    
+    if (woke) {
+        pico_rtos_schedule_next_task();
+    }
+    return true;
+}
+
+bool pico_rtos_queue_send_from_isr(pico_rtos_queue_t *queue, const void *item, bool *task_woken) {
+    if (queue == NULL || item == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    
+    bool woken = false;
+    bool sent;
+    
+    if (queue->spsc) {
+        sent = pico_rtos_queue_spsc_send(queue, item, 1, PICO_RTOS_NO_WAIT, &woken) == 1;
+    } else {
+        critical_section_enter_blocking(&queue->cs);
+        sent = (queue->count < queue->max_items);
+        if (sent) {
+            pico_rtos_queue_copy_in(queue, item, 1);
+            woken = pico_rtos_queue_wake(queue->receive_block_obj, 1);
         }
-        
         critical_section_exit(&queue->cs);
-        return true;
+        
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+        if (sent) {
+            woken |= pico_rtos_queue_set_notify_from_isr(&queue->set_member);
+        }
+#endif
+    }
+    
+    // Left alone otherwise, so one flag can collect several calls
+    if (woken && task_woken != NULL) {
+        *task_woken = true;
+    }
+    return sent;
+}
+
+size_t pico_rtos_queue_send_many(pico_rtos_queue_t *queue, const void *items, size_t count, uint32_t timeout) {
+    if (queue == NULL || items == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return 0;
+    }
+    
+    if (count == 0) {
+        return 0;
     }
     
-    // This should not happen if the blocking mechanism works correctly
+    if (queue->spsc) {
+        bool woken = false;
+        size_t sent = pico_rtos_queue_spsc_send(queue, items, count, timeout, &woken);
+        if (woken) {
+            pico_rtos_schedule_next_task();
+        }
+        return sent;
+    }
+
+    uint32_t start = 0;
+    bool waited = false;
+    
+    critical_section_enter_blocking(&queue->cs);
+
+    // Wait only while nothing at all fits
+    while (queue->count == queue->max_items) {
+        if (!waited) {
+            start = pico_rtos_get_tick_count();
+            waited = true;
+        }
+        if (!pico_rtos_queue_wait(queue, queue->send_block_obj, PICO_RTOS_BLOCK_REASON_QUEUE_FULL, start, timeout)) {
+            return 0;
+        }
+    }
+
+    size_t space = queue->max_items - queue->count;
+    if (count > space) {
+        count = space;
+    }
+    pico_rtos_queue_copy_in(queue, items, count);
+    
+    bool woke = pico_rtos_queue_wake(queue->receive_block_obj, count);
+    
     critical_section_exit(&queue->cs);
-    return false;
+    
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    pico_rtos_queue_set_notify(&queue->set_member);
+#endif
+    
+    if (woke) {
+        pico_rtos_schedule_next_task();
+    }
+    return count;
 }
 
 bool pico_rtos_queue_receive(pico_rtos_queue_t *queue, void *item, uint32_t timeout) {
     if (queue == NULL || item == NULL) {
         return false;
     }
+    
+    if (queue->spsc) {
+        return pico_rtos_queue_spsc_receive(queue, item, 1, timeout) == 1;
+    }
 
+    uint32_t start = 0;
+    bool waited = false;
+    
     critical_section_enter_blocking(&queue->cs);
 
-    // Check if queue is empty
-    if (queue->count == 0) {
-        // If timeout is 0, return immediately
-        if (timeout == 0) {
-            critical_section_exit(&queue->cs);
+    // Wait for an item
+    while (queue->count == 0) {
+        if (!waited) {
+            start = pico_rtos_get_tick_count();
+            waited = true;
+        }
+        if (!pico_rtos_queue_wait(queue, queue->receive_block_obj, PICO_RTOS_BLOCK_REASON_QUEUE_EMPTY, start, timeout)) {
             return false;
         }
-        
-        // Block the current task
-        pico_rtos_task_t *current_task = pico_rtos_get_current_task();
-        if (current_task != NULL) {
-            current_task->state = PICO_RTOS_TASK_STATE_BLOCKED;
-            current_task->block_reason = PICO_RTOS_BLOCK_REASON_QUEUE_EMPTY;
-            current_task->blocking_object = queue->receive_block_obj;
-            
-            if (timeout != PICO_RTOS_WAIT_FOREVER) {
-                current_task->delay_until = pico_rtos_get_tick_count() + timeout;
-            }
-            
-            critical_section_exit(&queue->cs);
-            
-            // Trigger scheduler to switch to another task
-            extern void pico_rtos_scheduler(void);
-            pico_rtos_scheduler();
-            
-            // When we return, check if we're still blocked (timed out) or ready to receive
-            if (current_task->block_reason != PICO_RTOS_BLOCK_REASON_NONE) {
-                return false;  // Timed out
-            }
-            
-            // Reacquire lock to continue receiving
-            critical_section_enter_blocking(&queue->cs);
-        }
-    }
-
-    // At this point, we should have an item in the queue
-    if (queue->count > 0) {
-        // Copy item from queue
-        uint8_t *src = (uint8_t *)queue->buffer + queue->head * queue->item_size;
-        memcpy(item, src, queue->item_size);
-        
-        // Update head and count
-        queue->head = (queue->head + 1) % queue->max_items;
-        queue->count--;
-        
-        // Unblock any tasks waiting to send
-        if (queue->send_block_obj != NULL) {
-            extern void pico_rtos_task_resume_highest_priority(void);
-            pico_rtos_task_resume_highest_priority();
+    }
+
+    pico_rtos_queue_copy_out(queue, item, 1);
+    
+    // Unblock the highest priority task waiting to send
+    bool woke = pico_rtos_queue_wake(queue->send_block_obj, 1);
+    
+    critical_section_exit(&queue->cs);
+    
+    if (woke) {
+        pico_rtos_schedule_next_task();
+    }
+    return true;
+}
+
+size_t pico_rtos_queue_receive_many(pico_rtos_queue_t *queue, void *items, size_t max_count, uint32_t timeout) {
+    if (queue == NULL || items == NULL) {
+        return 0;
+    }
+    
+    if (max_count == 0) {
+        return 0;
+    }
+    
+    if (queue->spsc) {
+        return pico_rtos_queue_spsc_receive(queue, items, max_count, timeout);
+    }
+
+    uint32_t start = 0;
+    bool waited = false;
+    
+    critical_section_enter_blocking(&queue->cs);
+
+    // Wait only while there is nothing at all
+    while (queue->count == 0) {
+        if (!waited) {
+            start = pico_rtos_get_tick_count();
+            waited = true;
+        }
+        if (!pico_rtos_queue_wait(queue, queue->receive_block_obj, PICO_RTOS_BLOCK_REASON_QUEUE_EMPTY, start, timeout)) {
+            return 0;
         }
-        
-        critical_section_exit(&queue->cs);
-        return true;
     }
+
+    size_t count = (queue->count < max_count) ? queue->count : max_count;
+    pico_rtos_queue_copy_out(queue, items, count);
+    
+    bool woke = pico_rtos_queue_wake(queue->send_block_obj, count);
     
-    // This should not happen if the blocking mechanism works correctly
     critical_section_exit(&queue->cs);
-    return false;
+    
+    if (woke) {
+        pico_rtos_schedule_next_task();
+    }
+    return count;
 }
 
 bool pico_rtos_queue_is_empty(pico_rtos_queue_t *queue) {
@@ -175,6 +542,10 @@ bool pico_rtos_queue_is_empty(pico_rtos_queue_t *queue) {
         return true;
     }
     
+    if (queue->spsc) {
+        return queue->tail == queue->head;
+    }
+    
     critical_section_enter_blocking(&queue->cs);
     bool is_empty = (queue->count == 0);
     critical_section_exit(&queue->cs);
@@ -187,6 +558,10 @@ bool pico_rtos_queue_is_full(pico_rtos_queue_t *queue) {
         return true;
     }
     
+    if (queue->spsc) {
+        return pico_rtos_queue_spsc_count(queue, queue->head, queue->tail) == queue->max_items;
+    }
+    
     critical_section_enter_blocking(&queue->cs);
     bool is_full = (queue->count == queue->max_items);
     critical_section_exit(&queue->cs);
@@ -199,15 +574,20 @@ void pico_rtos_queue_delete(pico_rtos_queue_t *queue) {
         return;
     }
     
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    pico_rtos_queue_set_leave(&queue->set_member);
+#endif
+    
     critical_section_enter_blocking(&queue->cs);
     
-    // Release any waiting tasks
-    if (queue->send_block_obj != NULL || queue->receive_block_obj != NULL) {
-        // Unblock waiting tasks
-        extern void pico_rtos_task_resume_highest_priority(void);
-        pico_rtos_task_resume_highest_priority();
-    }
+    // Release any waiting tasks; they see the operation fail
+    pico_rtos_block_object_delete(queue->send_block_obj);
+    pico_rtos_block_object_delete(queue->receive_block_obj);
+    queue->send_block_obj = NULL;
+    queue->receive_block_obj = NULL;
     
+    queue->head = 0;
+    queue->tail = 0;
     queue->count = 0;
     
     critical_section_exit(&queue->cs);
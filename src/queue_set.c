@@ -0,0 +1,355 @@
+#include "pico_rtos/queue_set.h"
+#include "pico_rtos/blocking.h"
+#include "pico_rtos/error.h"
+#include "pico_rtos.h"
+#include "pico/critical_section.h"
+
+// Kinds of set member, for the readiness check
+enum {
+    PICO_RTOS_QUEUE_SET_QUEUE,
+    PICO_RTOS_QUEUE_SET_SEMAPHORE,
+    PICO_RTOS_QUEUE_SET_STREAM_BUFFER,
+    PICO_RTOS_QUEUE_SET_EVENT_GROUP
+};
+
+// Shared by both initializers; wait_storage is NULL to allocate the wait list
+static bool pico_rtos_queue_set_setup(pico_rtos_queue_set_t *set, pico_rtos_block_object_t *wait_storage) {
+    if (set == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+
+    set->members = NULL;
+    set->next_scan = NULL;
+    set->member_count = 0;
+    critical_section_init(&set->cs);
+
+    set->block_obj = (wait_storage != NULL) ? pico_rtos_block_object_create_static(wait_storage, set)
+                                            : pico_rtos_block_object_create(set);
+    if (set->block_obj == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_OUT_OF_MEMORY, 0);
+        return false;
+    }
+
+    return true;
+}
+
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+bool pico_rtos_queue_set_init(pico_rtos_queue_set_t *set) {
+    return pico_rtos_queue_set_setup(set, NULL);
+}
+#endif
+
+bool pico_rtos_queue_set_init_static(pico_rtos_queue_set_t *set, pico_rtos_block_object_t *wait_storage) {
+    if (wait_storage == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    return pico_rtos_queue_set_setup(set, wait_storage);
+}
+
+// Whether a member has something to take, checked under the member's own
+// lock (caller holds the set lock; members never take it while holding
+// theirs, so the two cannot deadlock)
+static bool pico_rtos_queue_set_member_ready(const pico_rtos_queue_set_member_t *member) {
+    bool ready = false;
+
+    switch (member->type) {
+        case PICO_RTOS_QUEUE_SET_QUEUE: {
+            // Takes the queue lock itself, or none for an SPSC queue
+            ready = !pico_rtos_queue_is_empty((pico_rtos_queue_t *)member->object);
+            break;
+        }
+        case PICO_RTOS_QUEUE_SET_SEMAPHORE: {
+            pico_rtos_semaphore_t *semaphore = (pico_rtos_semaphore_t *)member->object;
+            critical_section_enter_blocking(&semaphore->cs);
+            ready = (semaphore->count > 0);
+            critical_section_exit(&semaphore->cs);
+            break;
+        }
+#ifdef PICO_RTOS_ENABLE_STREAM_BUFFERS
+        case PICO_RTOS_QUEUE_SET_STREAM_BUFFER: {
+            pico_rtos_stream_buffer_t *stream = (pico_rtos_stream_buffer_t *)member->object;
+            critical_section_enter_blocking(&stream->cs);
+            ready = (stream->bytes_available > 0);
+            critical_section_exit(&stream->cs);
+            break;
+        }
+#endif
+#ifdef PICO_RTOS_ENABLE_EVENT_GROUPS
+        case PICO_RTOS_QUEUE_SET_EVENT_GROUP: {
+            pico_rtos_event_group_t *event_group = (pico_rtos_event_group_t *)member->object;
+            critical_section_enter_blocking(&event_group->cs);
+            ready = ((event_group->event_bits & member->bits) != 0);
+            critical_section_exit(&event_group->cs);
+            break;
+        }
+#endif
+        default:
+            break;
+    }
+
+    return ready;
+}
+
+// First ready member, starting after the one returned last and wrapping
+// around (caller holds the set lock)
+static pico_rtos_queue_set_member_t *pico_rtos_queue_set_find_ready(pico_rtos_queue_set_t *set) {
+    pico_rtos_queue_set_member_t *member = (set->next_scan != NULL) ? set->next_scan : set->members;
+
+    for (uint32_t i = 0; i < set->member_count; i++) {
+        if (pico_rtos_queue_set_member_ready(member)) {
+            return member;
+        }
+        member = (member->next != NULL) ? member->next : set->members;
+    }
+
+    return NULL;
+}
+
+static bool pico_rtos_queue_set_add(pico_rtos_queue_set_t *set, pico_rtos_queue_set_member_t *member,
+                                    void *object, uint8_t type, uint32_t bits) {
+    critical_section_enter_blocking(&set->cs);
+
+    if (member->set != NULL) {
+        critical_section_exit(&set->cs);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_QUEUE_SET_ALREADY_MEMBER, 0);
+        return false;
+    }
+
+    member->object = object;
+    member->type = type;
+    member->bits = bits;
+    member->set = set;
+    member->next = set->members;
+    set->members = member;
+    set->member_count++;
+
+    // A member that is ready already has nothing left to post, so wake a
+    // waiting select here
+    pico_rtos_task_t *woken = NULL;
+    if (set->block_obj != NULL && pico_rtos_queue_set_member_ready(member)) {
+        woken = pico_rtos_unblock_highest_priority_task(set->block_obj);
+    }
+
+    critical_section_exit(&set->cs);
+
+    if (woken != NULL) {
+        pico_rtos_schedule_next_task();
+    }
+    return true;
+}
+
+bool pico_rtos_queue_set_add_queue(pico_rtos_queue_set_t *set, pico_rtos_queue_t *queue) {
+    if (set == NULL || queue == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    return pico_rtos_queue_set_add(set, &queue->set_member, queue, PICO_RTOS_QUEUE_SET_QUEUE, 0);
+}
+
+bool pico_rtos_queue_set_add_semaphore(pico_rtos_queue_set_t *set, pico_rtos_semaphore_t *semaphore) {
+    if (set == NULL || semaphore == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    return pico_rtos_queue_set_add(set, &semaphore->set_member, semaphore, PICO_RTOS_QUEUE_SET_SEMAPHORE, 0);
+}
+
+#ifdef PICO_RTOS_ENABLE_STREAM_BUFFERS
+bool pico_rtos_queue_set_add_stream_buffer(pico_rtos_queue_set_t *set, pico_rtos_stream_buffer_t *stream) {
+    if (set == NULL || stream == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    return pico_rtos_queue_set_add(set, &stream->set_member, stream, PICO_RTOS_QUEUE_SET_STREAM_BUFFER, 0);
+}
+#endif
+
+#ifdef PICO_RTOS_ENABLE_EVENT_GROUPS
+bool pico_rtos_queue_set_add_event_group(pico_rtos_queue_set_t *set, pico_rtos_event_group_t *event_group,
+                                         uint32_t bits) {
+    if (set == NULL || event_group == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+
+    if (bits == 0) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_EVENT_GROUP_INVALID, bits);
+        return false;
+    }
+    return pico_rtos_queue_set_add(set, &event_group->set_member, event_group, PICO_RTOS_QUEUE_SET_EVENT_GROUP,
+                                   bits);
+}
+#endif
+
+// Take a member off the set's list (caller holds the set lock)
+static void pico_rtos_queue_set_unlink(pico_rtos_queue_set_t *set, pico_rtos_queue_set_member_t *member) {
+    for (pico_rtos_queue_set_member_t **link = &set->members; *link != NULL; link = &(*link)->next) {
+        if (*link == member) {
+            *link = member->next;
+            if (set->next_scan == member) {
+                set->next_scan = member->next;
+            }
+            set->member_count--;
+            break;
+        }
+    }
+
+    member->set = NULL;
+    member->next = NULL;
+}
+
+bool pico_rtos_queue_set_remove(pico_rtos_queue_set_t *set, void *object) {
+    if (set == NULL || object == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+
+    critical_section_enter_blocking(&set->cs);
+
+    pico_rtos_queue_set_member_t *member = set->members;
+    while (member != NULL && member->object != object) {
+        member = member->next;
+    }
+
+    if (member == NULL) {
+        critical_section_exit(&set->cs);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_QUEUE_SET_NOT_MEMBER, 0);
+        return false;
+    }
+
+    pico_rtos_queue_set_unlink(set, member);
+
+    critical_section_exit(&set->cs);
+    return true;
+}
+
+// Wait on the set for whatever is left of the timeout (caller holds the
+// set lock). Returns true with the lock held again if a member posted;
+// returns false with the lock released on a timeout or if the set is gone
+static bool pico_rtos_queue_set_wait(pico_rtos_queue_set_t *set, uint32_t start, uint32_t timeout) {
+    uint32_t remaining = timeout;
+    if (timeout != PICO_RTOS_WAIT_FOREVER) {
+        uint32_t elapsed = pico_rtos_get_tick_count() - start;
+        remaining = (elapsed < timeout) ? timeout - elapsed : 0;
+    }
+
+    // Joining the wait list before releasing the set lock means a member
+    // posting in between cannot miss us
+    pico_rtos_task_t *current_task = pico_rtos_get_current_task();
+    if (remaining == 0 || set->block_obj == NULL || current_task == NULL ||
+        !pico_rtos_block_task(set->block_obj, current_task, PICO_RTOS_BLOCK_REASON_QUEUE_SET, remaining)) {
+        critical_section_exit(&set->cs);
+        return false;
+    }
+    critical_section_exit(&set->cs);
+
+    pico_rtos_schedule_next_task();
+
+    // Still marked blocked means we timed out
+    if (current_task->block_reason != PICO_RTOS_BLOCK_REASON_NONE) {
+        return false;
+    }
+
+    critical_section_enter_blocking(&set->cs);
+    return true;
+}
+
+void *pico_rtos_queue_set_select(pico_rtos_queue_set_t *set, uint32_t timeout) {
+    if (set == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return NULL;
+    }
+
+    uint32_t start = pico_rtos_get_tick_count();
+
+    critical_section_enter_blocking(&set->cs);
+
+    // A post only says something changed; the member it came from may have
+    // been emptied again by the time we run, so check them all each time
+    for (;;) {
+        pico_rtos_queue_set_member_t *member = pico_rtos_queue_set_find_ready(set);
+        if (member != NULL) {
+            set->next_scan = member->next;
+            void *object = member->object;
+            critical_section_exit(&set->cs);
+            return object;
+        }
+
+        if (!pico_rtos_queue_set_wait(set, start, timeout)) {
+            PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_QUEUE_SET_TIMEOUT, timeout);
+            return NULL;
+        }
+    }
+}
+
+uint32_t pico_rtos_queue_set_get_member_count(pico_rtos_queue_set_t *set) {
+    if (set == NULL) {
+        return 0;
+    }
+
+    critical_section_enter_blocking(&set->cs);
+    uint32_t count = set->member_count;
+    critical_section_exit(&set->cs);
+
+    return count;
+}
+
+void pico_rtos_queue_set_delete(pico_rtos_queue_set_t *set) {
+    if (set == NULL) {
+        return;
+    }
+
+    critical_section_enter_blocking(&set->cs);
+
+    while (set->members != NULL) {
+        pico_rtos_queue_set_unlink(set, set->members);
+    }
+    set->next_scan = NULL;
+
+    // Wake every waiter; they find the wait list gone and fail
+    if (set->block_obj != NULL) {
+        pico_rtos_block_object_delete(set->block_obj);
+        set->block_obj = NULL;
+    }
+
+    critical_section_exit(&set->cs);
+}
+
+// Wake a task waiting on the member's set without switching to it;
+// returns true if one was woken
+bool pico_rtos_queue_set_notify_from_isr(pico_rtos_queue_set_member_t *member) {
+    pico_rtos_queue_set_t *set = member->set;
+    if (set == NULL) {
+        return false;
+    }
+
+    critical_section_enter_blocking(&set->cs);
+    pico_rtos_task_t *woken = NULL;
+    if (set->block_obj != NULL) {
+        woken = pico_rtos_unblock_highest_priority_task(set->block_obj);
+    }
+    critical_section_exit(&set->cs);
+
+    return woken != NULL;
+}
+
+void pico_rtos_queue_set_notify(pico_rtos_queue_set_member_t *member) {
+    if (pico_rtos_queue_set_notify_from_isr(member)) {
+        pico_rtos_schedule_next_task();
+    }
+}
+
+void pico_rtos_queue_set_leave(pico_rtos_queue_set_member_t *member) {
+    pico_rtos_queue_set_t *set = member->set;
+    if (set == NULL) {
+        return;
+    }
+
+    critical_section_enter_blocking(&set->cs);
+    if (member->set == set) {
+        pico_rtos_queue_set_unlink(set, member);
+    }
+    critical_section_exit(&set->cs);
+}
@@ -0,0 +1,363 @@
+#include "pico_rtos/rwlock.h"
+#include "pico_rtos/blocking.h"
+#include "pico_rtos/error.h"
+#include "pico_rtos.h"
+#include "pico/critical_section.h"
+#include "pico/stdlib.h"
+
+// Shared by both initializers; the wait storage is NULL to allocate the
+// wait lists
+static bool pico_rtos_rwlock_setup(pico_rtos_rwlock_t *rwlock, pico_rtos_rwlock_policy_t policy,
+                                   pico_rtos_block_object_t *read_wait_storage,
+                                   pico_rtos_block_object_t *write_wait_storage) {
+    if (rwlock == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+
+    if (policy != PICO_RTOS_RWLOCK_PREFER_WRITERS && policy != PICO_RTOS_RWLOCK_PREFER_READERS) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_CONFIGURATION, policy);
+        return false;
+    }
+
+    rwlock->readers = 0;
+    rwlock->writer = NULL;
+    rwlock->policy = policy;
+    rwlock->held_next = NULL;
+    critical_section_init(&rwlock->cs);
+
+    if (read_wait_storage != NULL) {
+        rwlock->read_wait = pico_rtos_block_object_create_static(read_wait_storage, rwlock);
+        rwlock->write_wait = pico_rtos_block_object_create_static(write_wait_storage, rwlock);
+    } else {
+        rwlock->read_wait = pico_rtos_block_object_create(rwlock);
+        rwlock->write_wait = pico_rtos_block_object_create(rwlock);
+    }
+    if (rwlock->read_wait == NULL || rwlock->write_wait == NULL) {
+        pico_rtos_block_object_delete(rwlock->read_wait);
+        pico_rtos_block_object_delete(rwlock->write_wait);
+        rwlock->read_wait = NULL;
+        rwlock->write_wait = NULL;
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_OUT_OF_MEMORY, 0);
+        return false;
+    }
+
+    return true;
+}
+
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+bool pico_rtos_rwlock_init(pico_rtos_rwlock_t *rwlock, pico_rtos_rwlock_policy_t policy) {
+    return pico_rtos_rwlock_setup(rwlock, policy, NULL, NULL);
+}
+#endif
+
+bool pico_rtos_rwlock_init_static(pico_rtos_rwlock_t *rwlock, pico_rtos_rwlock_policy_t policy,
+                                  pico_rtos_block_object_t *read_wait_storage,
+                                  pico_rtos_block_object_t *write_wait_storage) {
+    if (read_wait_storage == NULL || write_wait_storage == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    return pico_rtos_rwlock_setup(rwlock, policy, read_wait_storage, write_wait_storage);
+}
+
+// Whether a reader may join now: no writer holds the lock and, if writers
+// are preferred, none waits for it (caller holds the lock's critical section)
+static inline bool pico_rtos_rwlock_can_read(const pico_rtos_rwlock_t *rwlock) {
+    return rwlock->writer == NULL &&
+           (rwlock->policy == PICO_RTOS_RWLOCK_PREFER_READERS || rwlock->write_wait->blocked_count == 0);
+}
+
+static inline bool pico_rtos_rwlock_can_write(const pico_rtos_rwlock_t *rwlock) {
+    return rwlock->writer == NULL && rwlock->readers == 0;
+}
+
+// Make a task the writer and add the lock to its held list, so that tasks
+// waiting for the lock raise it (caller holds the lock's critical section)
+static void pico_rtos_rwlock_take_write(pico_rtos_rwlock_t *rwlock, pico_rtos_task_t *task) {
+    pico_rtos_enter_critical();
+    rwlock->writer = task;
+    rwlock->held_next = task->held_rwlocks;
+    task->held_rwlocks = rwlock;
+    pico_rtos_mutex_update_priority(task);
+    pico_rtos_exit_critical();
+}
+
+// Take the lock off its writer's held list (caller holds the kernel
+// critical section)
+static void pico_rtos_rwlock_release_write(pico_rtos_rwlock_t *rwlock) {
+    pico_rtos_rwlock_t **link = &rwlock->writer->held_rwlocks;
+    while (*link != NULL && *link != rwlock) {
+        link = &(*link)->held_next;
+    }
+    if (*link != NULL) {
+        *link = rwlock->held_next;
+    }
+    rwlock->held_next = NULL;
+    rwlock->writer = NULL;
+}
+
+// Hand a lock that is no longer write-held to whoever may have it next:
+// the top waiting writer if the lock is free and the policy or an empty
+// reader list lets it go first, otherwise every waiting reader the policy
+// admits. Returns true if a task was woken (caller holds the lock's
+// critical section)
+static bool pico_rtos_rwlock_hand_off(pico_rtos_rwlock_t *rwlock) {
+    if (rwlock->writer != NULL) {
+        return false;
+    }
+
+    if (rwlock->readers == 0 && rwlock->write_wait->blocked_count > 0 &&
+        (rwlock->policy == PICO_RTOS_RWLOCK_PREFER_WRITERS || rwlock->read_wait->blocked_count == 0)) {
+        pico_rtos_task_t *writer = pico_rtos_unblock_highest_priority_task(rwlock->write_wait);
+        if (writer != NULL) {
+            pico_rtos_rwlock_take_write(rwlock, writer);
+            return true;
+        }
+    }
+
+    bool woke = false;
+    if (pico_rtos_rwlock_can_read(rwlock)) {
+        pico_rtos_task_t *reader;
+        while ((reader = pico_rtos_unblock_highest_priority_task(rwlock->read_wait)) != NULL) {
+            rwlock->readers++;
+            woke = true;
+        }
+    }
+    return woke;
+}
+
+// Wait on one of the lock's wait lists until handed the lock or timed out
+// (caller holds the lock's critical section, which is released); returns
+// true if the task was handed the lock
+static bool pico_rtos_rwlock_wait(pico_rtos_rwlock_t *rwlock, pico_rtos_block_object_t *wait,
+                                  pico_rtos_task_t *task, uint32_t timeout) {
+    // Block before dropping the lock's critical section, so a release in
+    // between cannot miss us
+    if (!pico_rtos_block_task(wait, task, PICO_RTOS_BLOCK_REASON_RWLOCK, timeout)) {
+        critical_section_exit(&rwlock->cs);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_OUT_OF_MEMORY, 0);
+        return false;
+    }
+
+    // Priority inheritance: a write-held lock runs its writer at least at
+    // our priority
+    pico_rtos_mutex_update_priority(rwlock->writer);
+    critical_section_exit(&rwlock->cs);
+
+    extern void pico_rtos_scheduler(void);
+    pico_rtos_scheduler();
+
+    critical_section_enter_blocking(&rwlock->cs);
+    bool granted = (wait == rwlock->write_wait) ? (rwlock->writer == task)
+                                                : (task->block_reason == PICO_RTOS_BLOCK_REASON_NONE &&
+                                                   rwlock->read_wait != NULL);
+    bool woke = false;
+    if (!granted && rwlock->read_wait != NULL) {
+        // We no longer wait, so the writer may have inherited too much, and
+        // readers held back by a waiting writer may now get in
+        pico_rtos_mutex_update_priority(rwlock->writer);
+        woke = pico_rtos_rwlock_hand_off(rwlock);
+    }
+    critical_section_exit(&rwlock->cs);
+
+    if (woke) {
+        pico_rtos_schedule_next_task();
+    }
+    if (!granted) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_RWLOCK_TIMEOUT, timeout);
+    }
+    return granted;
+}
+
+bool pico_rtos_rwlock_read_lock(pico_rtos_rwlock_t *rwlock, uint32_t timeout) {
+    if (rwlock == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+
+    pico_rtos_task_t *current_task = pico_rtos_get_current_task();
+    if (current_task == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INTERRUPT_CONTEXT_VIOLATION, 0);
+        return false;
+    }
+
+    // Readers only ever take the lock's own critical section on the way
+    // in, so readers on both cores do not contend for the kernel's
+    critical_section_enter_blocking(&rwlock->cs);
+
+    if (rwlock->writer == current_task) {
+        critical_section_exit(&rwlock->cs);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_RWLOCK_WOULD_DEADLOCK, 0);
+        return false;
+    }
+
+    if (pico_rtos_rwlock_can_read(rwlock)) {
+        rwlock->readers++;
+        critical_section_exit(&rwlock->cs);
+        return true;
+    }
+
+    if (timeout == 0) {
+        critical_section_exit(&rwlock->cs);
+        return false;
+    }
+
+    return pico_rtos_rwlock_wait(rwlock, rwlock->read_wait, current_task, timeout);
+}
+
+bool pico_rtos_rwlock_try_read_lock(pico_rtos_rwlock_t *rwlock) {
+    return pico_rtos_rwlock_read_lock(rwlock, 0);
+}
+
+bool pico_rtos_rwlock_read_unlock(pico_rtos_rwlock_t *rwlock) {
+    if (rwlock == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+
+    critical_section_enter_blocking(&rwlock->cs);
+
+    if (rwlock->readers == 0) {
+        critical_section_exit(&rwlock->cs);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_RWLOCK_NOT_HELD, 0);
+        return false;
+    }
+
+    // Only the last reader out has anyone to hand the lock to
+    rwlock->readers--;
+    bool woke = (rwlock->readers == 0) && pico_rtos_rwlock_hand_off(rwlock);
+    critical_section_exit(&rwlock->cs);
+
+    if (woke) {
+        pico_rtos_schedule_next_task();
+    }
+    return true;
+}
+
+bool pico_rtos_rwlock_write_lock(pico_rtos_rwlock_t *rwlock, uint32_t timeout) {
+    if (rwlock == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+
+    pico_rtos_task_t *current_task = pico_rtos_get_current_task();
+    if (current_task == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INTERRUPT_CONTEXT_VIOLATION, 0);
+        return false;
+    }
+
+    critical_section_enter_blocking(&rwlock->cs);
+
+    if (rwlock->writer == current_task) {
+        critical_section_exit(&rwlock->cs);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_RWLOCK_WOULD_DEADLOCK, 0);
+        return false;
+    }
+
+    if (pico_rtos_rwlock_can_write(rwlock)) {
+        pico_rtos_rwlock_take_write(rwlock, current_task);
+        critical_section_exit(&rwlock->cs);
+        return true;
+    }
+
+    if (timeout == 0) {
+        critical_section_exit(&rwlock->cs);
+        return false;
+    }
+
+    return pico_rtos_rwlock_wait(rwlock, rwlock->write_wait, current_task, timeout);
+}
+
+bool pico_rtos_rwlock_try_write_lock(pico_rtos_rwlock_t *rwlock) {
+    return pico_rtos_rwlock_write_lock(rwlock, 0);
+}
+
+bool pico_rtos_rwlock_write_unlock(pico_rtos_rwlock_t *rwlock) {
+    if (rwlock == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+
+    pico_rtos_task_t *current_task = pico_rtos_get_current_task();
+
+    critical_section_enter_blocking(&rwlock->cs);
+
+    if (current_task == NULL || rwlock->writer != current_task) {
+        critical_section_exit(&rwlock->cs);
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_RWLOCK_NOT_HELD, 0);
+        return false;
+    }
+
+    pico_rtos_enter_critical();
+    pico_rtos_rwlock_release_write(rwlock);
+    bool woke = pico_rtos_rwlock_hand_off(rwlock);
+
+    // Drop whatever was inherited through this lock alone
+    uint32_t previous_priority = current_task->priority;
+    pico_rtos_mutex_update_priority(current_task);
+    bool lowered = (current_task->priority < previous_priority);
+    pico_rtos_exit_critical();
+
+    critical_section_exit(&rwlock->cs);
+
+    if (woke || lowered) {
+        pico_rtos_schedule_next_task();
+    }
+    return true;
+}
+
+uint32_t pico_rtos_rwlock_get_readers(pico_rtos_rwlock_t *rwlock) {
+    if (rwlock == NULL) {
+        return 0;
+    }
+
+    critical_section_enter_blocking(&rwlock->cs);
+    uint32_t readers = rwlock->readers;
+    critical_section_exit(&rwlock->cs);
+
+    return readers;
+}
+
+pico_rtos_task_t *pico_rtos_rwlock_get_writer(pico_rtos_rwlock_t *rwlock) {
+    if (rwlock == NULL) {
+        return NULL;
+    }
+
+    critical_section_enter_blocking(&rwlock->cs);
+    pico_rtos_task_t *writer = rwlock->writer;
+    critical_section_exit(&rwlock->cs);
+
+    return writer;
+}
+
+void pico_rtos_rwlock_delete(pico_rtos_rwlock_t *rwlock) {
+    if (rwlock == NULL) {
+        return;
+    }
+
+    critical_section_enter_blocking(&rwlock->cs);
+
+    // Wake every waiter; they find the wait lists gone and fail
+    if (rwlock->read_wait != NULL) {
+        pico_rtos_block_object_delete(rwlock->read_wait);
+        rwlock->read_wait = NULL;
+    }
+    if (rwlock->write_wait != NULL) {
+        pico_rtos_block_object_delete(rwlock->write_wait);
+        rwlock->write_wait = NULL;
+    }
+
+    // Don't leave a writer raised by a lock that no longer exists
+    if (rwlock->writer != NULL) {
+        pico_rtos_task_t *writer = rwlock->writer;
+        pico_rtos_enter_critical();
+        pico_rtos_rwlock_release_write(rwlock);
+        pico_rtos_mutex_update_priority(writer);
+        pico_rtos_exit_critical();
+    }
+
+    rwlock->readers = 0;
+
+    critical_section_exit(&rwlock->cs);
+}
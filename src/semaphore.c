@@ -4,7 +4,9 @@
 #include "pico_rtos.h"
 #include "pico/critical_section.h"
 
-bool pico_rtos_semaphore_init(pico_rtos_semaphore_t *semaphore, uint32_t initial_count, uint32_t max_count) {
+// Shared by both initializers; wait_storage is NULL to allocate the wait list
+static bool pico_rtos_semaphore_setup(pico_rtos_semaphore_t *semaphore, uint32_t initial_count, uint32_t max_count,
+                                      pico_rtos_block_object_t *wait_storage) {
     if (semaphore == NULL) {
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
         return false;
@@ -23,10 +25,14 @@ bool pico_rtos_semaphore_init(pico_rtos_semaphore_t *semaphore, uint32_t initial
     semaphore->count = initial_count;
     semaphore->max_count = max_count;
     critical_section_init(&semaphore->cs);
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    semaphore->set_member.set = NULL;
+    semaphore->set_member.next = NULL;
+#endif
     
     // CRITICAL FIX: Properly initialize blocking object
-    extern pico_rtos_block_object_t *pico_rtos_block_object_create(void *sync_object);
-    semaphore->block_obj = pico_rtos_block_object_create(semaphore);
+    semaphore->block_obj = (wait_storage != NULL) ? pico_rtos_block_object_create_static(wait_storage, semaphore)
+                                                  : pico_rtos_block_object_create(semaphore);
     if (semaphore->block_obj == NULL) {
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_OUT_OF_MEMORY, 0);
         return false;
@@ -35,6 +41,21 @@ bool pico_rtos_semaphore_init(pico_rtos_semaphore_t *semaphore, uint32_t initial
     return true;
 }
 
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+bool pico_rtos_semaphore_init(pico_rtos_semaphore_t *semaphore, uint32_t initial_count, uint32_t max_count) {
+    return pico_rtos_semaphore_setup(semaphore, initial_count, max_count, NULL);
+}
+#endif
+
+bool pico_rtos_semaphore_init_static(pico_rtos_semaphore_t *semaphore, uint32_t initial_count, uint32_t max_count,
+                                     pico_rtos_block_object_t *wait_storage) {
+    if (wait_storage == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    return pico_rtos_semaphore_setup(semaphore, initial_count, max_count, wait_storage);
+}
+
 bool pico_rtos_semaphore_give(pico_rtos_semaphore_t *semaphore) {
     if (semaphore == NULL) {
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
@@ -67,6 +88,13 @@ bool pico_rtos_semaphore_give(pico_rtos_semaphore_t *semaphore) {
 
     critical_section_exit(&semaphore->cs);
     
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    // A token nobody took directly can be picked up through the semaphore's set
+    if (unblocked_task == NULL) {
+        pico_rtos_queue_set_notify(&semaphore->set_member);
+    }
+#endif
+    
     // If we unblocked a task, trigger scheduler
     if (unblocked_task != NULL) {
         extern void pico_rtos_schedule_next_task(void);
@@ -148,6 +176,10 @@ void pico_rtos_semaphore_delete(pico_rtos_semaphore_t *semaphore) {
         return;
     }
     
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    pico_rtos_queue_set_leave(&semaphore->set_member);
+#endif
+    
     critical_section_enter_blocking(&semaphore->cs);
     
     // CRITICAL FIX: Properly delete blocking object and unblock all waiting tasks
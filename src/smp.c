@@ -268,8 +268,10 @@ static bool pico_rtos_smp_init_idle_task(uint32_t core_id) {
 #ifdef PICO_RTOS_ENABLE_MULTI_CORE
     idle_task->core_affinity = (core_id == 0) ? PICO_RTOS_CORE_AFFINITY_CORE0 : PICO_RTOS_CORE_AFFINITY_CORE1;
     idle_task->assigned_core = core_id;
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
     idle_task->cpu_time_us = 0;
     idle_task->context_switch_count = 0;
+#endif
     idle_task->stack_high_water_mark = 0;
     idle_task->migration_count = 0;
     idle_task->migration_pending = false;
@@ -114,9 +114,12 @@ static uint32_t read_from_circular_buffer(uint8_t *buffer, uint32_t buffer_size,
 // CORE API IMPLEMENTATION
 // =============================================================================
 
-bool pico_rtos_stream_buffer_init(pico_rtos_stream_buffer_t *stream, 
-                                 uint8_t *buffer, 
-                                 uint32_t buffer_size) {
+// Shared by both initializers; the storage pointers are NULL to allocate the wait lists
+static bool pico_rtos_stream_buffer_setup(pico_rtos_stream_buffer_t *stream,
+                                          uint8_t *buffer,
+                                          uint32_t buffer_size,
+                                          pico_rtos_block_object_t *reader_wait_storage,
+                                          pico_rtos_block_object_t *writer_wait_storage) {
     // Parameter validation
     if (stream == NULL || buffer == NULL) {
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
@@ -139,9 +142,19 @@ bool pico_rtos_stream_buffer_init(pico_rtos_stream_buffer_t *stream,
     // Initialize critical section for thread safety
     critical_section_init(&stream->cs);
     
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    stream->set_member.set = NULL;
+    stream->set_member.next = NULL;
+#endif
+    
     // Create blocking objects for reader and writer synchronization
-    stream->reader_block_obj = pico_rtos_block_object_create(stream);
-    stream->writer_block_obj = pico_rtos_block_object_create(stream);
+    if (reader_wait_storage != NULL) {
+        stream->reader_block_obj = pico_rtos_block_object_create_static(reader_wait_storage, stream);
+        stream->writer_block_obj = pico_rtos_block_object_create_static(writer_wait_storage, stream);
+    } else {
+        stream->reader_block_obj = pico_rtos_block_object_create(stream);
+        stream->writer_block_obj = pico_rtos_block_object_create(stream);
+    }
     
     if (stream->reader_block_obj == NULL || stream->writer_block_obj == NULL) {
         // Cleanup on failure
@@ -177,6 +190,26 @@ bool pico_rtos_stream_buffer_init(pico_rtos_stream_buffer_t *stream,
     return true;
 }
 
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+bool pico_rtos_stream_buffer_init(pico_rtos_stream_buffer_t *stream, 
+                                 uint8_t *buffer, 
+                                 uint32_t buffer_size) {
+    return pico_rtos_stream_buffer_setup(stream, buffer, buffer_size, NULL, NULL);
+}
+#endif
+
+bool pico_rtos_stream_buffer_init_static(pico_rtos_stream_buffer_t *stream,
+                                        uint8_t *buffer,
+                                        uint32_t buffer_size,
+                                        pico_rtos_block_object_t *reader_wait_storage,
+                                        pico_rtos_block_object_t *writer_wait_storage) {
+    if (reader_wait_storage == NULL || writer_wait_storage == NULL) {
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    return pico_rtos_stream_buffer_setup(stream, buffer, buffer_size, reader_wait_storage, writer_wait_storage);
+}
+
 uint32_t pico_rtos_stream_buffer_send(pico_rtos_stream_buffer_t *stream, 
                                      const void *data, 
                                      uint32_t length, 
@@ -266,6 +299,11 @@ uint32_t pico_rtos_stream_buffer_send(pico_rtos_stream_buffer_t *stream,
     
     critical_section_exit(&stream->cs);
     
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    // Tell a task waiting on the stream buffer's set, after letting go of it
+    pico_rtos_queue_set_notify(&stream->set_member);
+#endif
+    
     return length;
 }
 
@@ -377,6 +415,10 @@ void pico_rtos_stream_buffer_delete(pico_rtos_stream_buffer_t *stream) {
         return;
     }
     
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    pico_rtos_queue_set_leave(&stream->set_member);
+#endif
+    
     critical_section_enter_blocking(&stream->cs);
     
     // Delete blocking objects (this will unblock all waiting tasks)
@@ -791,6 +833,10 @@ bool pico_rtos_stream_buffer_zero_copy_send_complete(pico_rtos_stream_buffer_t *
     
     critical_section_exit(&stream->cs);
     
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    pico_rtos_queue_set_notify(&stream->set_member);
+#endif
+    
     return true;
 }
 
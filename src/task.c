@@ -1,18 +1,21 @@
 #include <stdlib.h>
 #include <string.h>
 #include "pico_rtos/task.h"
+#include "pico_rtos/blocking.h"
 #include "pico_rtos/context_switch.h"
 #include "pico_rtos/error.h"
 #include "pico_rtos/logging.h"
 #include "pico_rtos.h"
 #include "pico/critical_section.h"
+#include "pico/time.h"
 
 // Properly allocate and initialize task stack
-static bool pico_rtos_setup_task_stack(pico_rtos_task_t *task);
+static bool pico_rtos_setup_task_stack(pico_rtos_task_t *task, uint32_t *stack_buffer);
 
-bool pico_rtos_task_create(pico_rtos_task_t *task, const char *name, 
-                          pico_rtos_task_function_t function, void *param, 
-                          uint32_t stack_size, uint32_t priority) {
+// Shared by both create functions; stack_buffer is NULL to allocate the stack
+static bool pico_rtos_task_setup(pico_rtos_task_t *task, const char *name,
+                                 pico_rtos_task_function_t function, void *param,
+                                 uint32_t *stack_buffer, uint32_t stack_size, uint32_t priority) {
     if (task == NULL) {
         PICO_RTOS_LOG_TASK_ERROR("Task creation failed: NULL task pointer");
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
@@ -36,6 +39,10 @@ bool pico_rtos_task_create(pico_rtos_task_t *task, const char *name,
     PICO_RTOS_LOG_TASK_INFO("Creating task: %s (priority %lu, stack %lu bytes)", 
                            name ? name : "unnamed", priority, stack_size);
     
+    // A control block whose previous task has ended but not been reaped yet
+    // can be reused; free the old stack first
+    pico_rtos_reap_task(task);
+    
     // Initialize task structure
     memset(task, 0, sizeof(pico_rtos_task_t));
     task->name = name;
@@ -46,12 +53,15 @@ bool pico_rtos_task_create(pico_rtos_task_t *task, const char *name,
     task->original_priority = priority;
     task->state = PICO_RTOS_TASK_STATE_READY;
     task->block_reason = PICO_RTOS_BLOCK_REASON_NONE;
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+    task->cpu_window.start_us = time_us_64();
+#endif
     
     // Initialize critical section for this task
     pico_rtos_critical_section_init(&task->cs);
     
     // Setup task stack
-    if (!pico_rtos_setup_task_stack(task)) {
+    if (!pico_rtos_setup_task_stack(task, stack_buffer)) {
         PICO_RTOS_LOG_TASK_ERROR("Task creation failed: Stack setup failed for task %s", 
                                 name ? name : "unnamed");
         PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_OUT_OF_MEMORY, stack_size);
@@ -65,6 +75,25 @@ bool pico_rtos_task_create(pico_rtos_task_t *task, const char *name,
     return true;
 }
 
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+bool pico_rtos_task_create(pico_rtos_task_t *task, const char *name, 
+                          pico_rtos_task_function_t function, void *param, 
+                          uint32_t stack_size, uint32_t priority) {
+    return pico_rtos_task_setup(task, name, function, param, NULL, stack_size, priority);
+}
+#endif
+
+bool pico_rtos_task_create_static(pico_rtos_task_t *task, const char *name,
+                                  pico_rtos_task_function_t function, void *param,
+                                  uint32_t *stack_buffer, uint32_t stack_size, uint32_t priority) {
+    if (stack_buffer == NULL) {
+        PICO_RTOS_LOG_TASK_ERROR("Task creation failed: NULL stack buffer for task %s", name ? name : "unnamed");
+        PICO_RTOS_REPORT_ERROR(PICO_RTOS_ERROR_INVALID_POINTER, 0);
+        return false;
+    }
+    return pico_rtos_task_setup(task, name, function, param, stack_buffer, stack_size, priority);
+}
+
 void pico_rtos_task_suspend(pico_rtos_task_t *task) {
     pico_rtos_enter_critical();
     
@@ -75,7 +104,7 @@ void pico_rtos_task_suspend(pico_rtos_task_t *task) {
     
     if (task != NULL) {
         PICO_RTOS_LOG_TASK_INFO("Suspending task: %s", task->name ? task->name : "unnamed");
-        task->state = PICO_RTOS_TASK_STATE_SUSPENDED;
+        pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_SUSPENDED);
         
         // If suspending current task, trigger a context switch
         if (task == pico_rtos_get_current_task()) {
@@ -100,7 +129,7 @@ void pico_rtos_task_resume(pico_rtos_task_t *task) {
     
     if (task->state == PICO_RTOS_TASK_STATE_SUSPENDED) {
         PICO_RTOS_LOG_TASK_INFO("Resuming task: %s", task->name ? task->name : "unnamed");
-        task->state = PICO_RTOS_TASK_STATE_READY;
+        pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_READY);
     } else {
         PICO_RTOS_LOG_TASK_DEBUG("Task %s was not suspended (state: %s)", 
                                 task->name ? task->name : "unnamed",
@@ -122,9 +151,7 @@ void pico_rtos_task_delay(uint32_t ms) {
     if (current_task != NULL) {
         PICO_RTOS_LOG_TASK_DEBUG("Task %s delaying for %lu ms", 
                                 current_task->name ? current_task->name : "unnamed", ms);
-        current_task->state = PICO_RTOS_TASK_STATE_BLOCKED;
-        current_task->block_reason = PICO_RTOS_BLOCK_REASON_DELAY;
-        current_task->delay_until = pico_rtos_get_tick_count() + ms;
+        pico_rtos_scheduler_delay_task(current_task, ms);
         
         pico_rtos_exit_critical();
         pico_rtos_scheduler(); // Trigger scheduler to switch tasks
@@ -147,15 +174,23 @@ void pico_rtos_scheduler(void) {
 }
 
 // Setup task stack with proper ARM Cortex-M0+ stack frame
-static bool pico_rtos_setup_task_stack(pico_rtos_task_t *task) {
+static bool pico_rtos_setup_task_stack(pico_rtos_task_t *task, uint32_t *stack_buffer) {
     if (task == NULL || task->function == NULL || task->stack_size == 0) {
         return false;
     }
     
-    // Allocate memory for the stack using tracked allocation
-    task->stack_base = (uint32_t *)pico_rtos_malloc(task->stack_size);
-    if (task->stack_base == NULL) {
+    if (stack_buffer != NULL) {
+        task->stack_base = stack_buffer;
+    } else {
+#if PICO_RTOS_STATIC_ALLOCATION_ONLY
         return false;
+#else
+        // Allocate memory for the stack using tracked allocation
+        task->stack_base = (uint32_t *)pico_rtos_malloc(task->stack_size);
+        if (task->stack_base == NULL) {
+            return false;
+        }
+#endif
     }
     
     // Clear the entire stack memory
@@ -171,13 +206,17 @@ static bool pico_rtos_setup_task_stack(pico_rtos_task_t *task) {
     
     if (task->stack_ptr == NULL) {
         // Stack initialization failed, clean up
-        pico_rtos_free(task->stack_base, task->stack_size);
+#if !PICO_RTOS_STATIC_ALLOCATION_ONLY
+        if (stack_buffer == NULL) {
+            pico_rtos_free(task->stack_base, task->stack_size);
+        }
+#endif
         task->stack_base = NULL;
         return false;
     }
     
-    // Mark that this task's stack was dynamically allocated
-    task->auto_delete = true;
+    // Mark whether this task's stack was dynamically allocated
+    task->auto_delete = (stack_buffer == NULL);
     
     return true;
 }
@@ -189,23 +228,20 @@ void pico_rtos_task_delete(pico_rtos_task_t *task) {
     
     pico_rtos_enter_critical();
     
-    // If deleting the current task, we need to schedule another task first
-    if (task == pico_rtos_get_current_task()) {
-        task->state = PICO_RTOS_TASK_STATE_TERMINATED;
-        pico_rtos_exit_critical();
-        
-        // Trigger scheduler to switch to another task
-        // The cleanup will happen in the next tick
-        pico_rtos_scheduler();
-        return;
+    // Drop any wait-list entry so the task cannot be woken after deletion
+    if (task->state == PICO_RTOS_TASK_STATE_BLOCKED && task->blocking_object != NULL) {
+        pico_rtos_block_object_remove_task(task->blocking_object, task);
     }
     
-    // For other tasks, mark as terminated and remove immediately
-    task->state = PICO_RTOS_TASK_STATE_TERMINATED;
+    // The task goes to the zombie list; the idle task frees its stack later,
+    // so a task deleting itself keeps a valid stack until it is switched out
+    pico_rtos_scheduler_remove_task(task);
+    bool deleting_self = (task == pico_rtos_get_current_task());
     pico_rtos_exit_critical();
     
-    // Remove from scheduler
-    pico_rtos_scheduler_remove_task(task);
+    if (deleting_self) {
+        pico_rtos_scheduler();
+    }
 }
 
 void pico_rtos_task_yield(void) {
@@ -214,7 +250,7 @@ void pico_rtos_task_yield(void) {
     
     pico_rtos_task_t *current_task = pico_rtos_get_current_task();
     if (current_task != NULL && current_task->state == PICO_RTOS_TASK_STATE_RUNNING) {
-        current_task->state = PICO_RTOS_TASK_STATE_READY;
+        pico_rtos_scheduler_set_task_state(current_task, PICO_RTOS_TASK_STATE_READY);
     }
     
     pico_rtos_exit_critical();
@@ -235,9 +271,19 @@ bool pico_rtos_task_set_priority(pico_rtos_task_t *task, uint32_t new_priority)
         return false;
     }
     
-    // Update both current and original priority
-    task->priority = new_priority;
+#if PICO_RTOS_ENABLE_EDF_SCHEDULING
+    // An EDF task keeps the band; the new priority applies once it leaves
+    if (task->edf) {
+        task->edf_base_priority = new_priority;
+        pico_rtos_exit_critical();
+        return true;
+    }
+#endif
+    
+    // Change the base priority; the task keeps running at least as high as
+    // the mutexes it holds require
     task->original_priority = new_priority;
+    pico_rtos_mutex_update_priority(task);
     
     pico_rtos_exit_critical();
     
@@ -245,4 +291,460 @@ bool pico_rtos_task_set_priority(pico_rtos_task_t *task, uint32_t new_priority)
     pico_rtos_scheduler();
     
     return true;
-}
\ No newline at end of file
+}
+
+bool pico_rtos_task_set_time_slice(pico_rtos_task_t *task, uint32_t ticks) {
+    pico_rtos_enter_critical();
+    
+    if (task == NULL) {
+        task = pico_rtos_get_current_task();
+    }
+    
+    if (task == NULL) {
+        pico_rtos_exit_critical();
+        return false;
+    }
+    
+    task->time_slice = ticks;
+    
+    pico_rtos_exit_critical();
+    return true;
+}
+
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+// CPU time including the run in progress if the task is the one running
+// (caller holds the critical section)
+static uint64_t pico_rtos_task_cpu_time_at(pico_rtos_task_t *task, uint64_t now) {
+    uint64_t cpu_time = task->cpu_time_us;
+    if (task == pico_rtos_get_current_task()) {
+        cpu_time += now - task->switched_in_us;
+    }
+    return cpu_time;
+}
+#endif
+
+bool pico_rtos_task_get_runtime_stats(pico_rtos_task_t *task, pico_rtos_task_runtime_stats_t *stats) {
+    if (stats == NULL) {
+        return false;
+    }
+    
+    pico_rtos_enter_critical();
+    
+    if (task == NULL) {
+        task = pico_rtos_get_current_task();
+    }
+    
+    if (task == NULL) {
+        pico_rtos_exit_critical();
+        return false;
+    }
+    
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+    stats->cpu_time_us = pico_rtos_task_cpu_time_at(task, time_us_64());
+    stats->context_switches = task->context_switch_count;
+    stats->preemptions = task->preemption_count;
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+    
+    pico_rtos_exit_critical();
+    return true;
+}
+
+void pico_rtos_task_reset_runtime_stats(pico_rtos_task_t *task) {
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+    pico_rtos_enter_critical();
+    
+    if (task == NULL) {
+        task = pico_rtos_get_current_task();
+    }
+    
+    if (task != NULL) {
+        uint64_t now = time_us_64();
+        task->cpu_time_us = 0;
+        task->switched_in_us = now;
+        task->context_switch_count = 0;
+        task->preemption_count = 0;
+        task->cpu_window.cpu_time_us = 0;
+        task->cpu_window.start_us = now;
+        task->cpu_window.usage_percent = 0.0f;
+    }
+    
+    pico_rtos_exit_critical();
+#else
+    (void)task;
+#endif
+}
+
+void pico_rtos_task_start_cpu_window(pico_rtos_task_t *task, pico_rtos_cpu_window_t *window) {
+    if (window == NULL) {
+        return;
+    }
+    
+    pico_rtos_enter_critical();
+    
+    if (task == NULL) {
+        task = pico_rtos_get_current_task();
+    }
+    
+    uint64_t now = time_us_64();
+    window->start_us = now;
+    window->usage_percent = 0.0f;
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+    window->cpu_time_us = (task != NULL) ? pico_rtos_task_cpu_time_at(task, now) : 0;
+#else
+    window->cpu_time_us = 0;
+#endif
+    
+    pico_rtos_exit_critical();
+}
+
+float pico_rtos_task_sample_cpu_usage(pico_rtos_task_t *task, pico_rtos_cpu_window_t *window) {
+    if (window == NULL) {
+        return 0.0f;
+    }
+    
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+    pico_rtos_enter_critical();
+    
+    if (task == NULL) {
+        task = pico_rtos_get_current_task();
+    }
+    
+    if (task == NULL) {
+        pico_rtos_exit_critical();
+        return 0.0f;
+    }
+    
+    uint64_t now = time_us_64();
+    uint64_t cpu_time = pico_rtos_task_cpu_time_at(task, now);
+    uint64_t elapsed = now - window->start_us;
+    
+    window->usage_percent = (elapsed > 0) ?
+        (float)(cpu_time - window->cpu_time_us) * 100.0f / (float)elapsed : 0.0f;
+    window->cpu_time_us = cpu_time;
+    window->start_us = now;
+    
+    pico_rtos_exit_critical();
+    return window->usage_percent;
+#else
+    (void)task;
+    window->usage_percent = 0.0f;
+    return 0.0f;
+#endif
+}
+
+#if PICO_RTOS_ENABLE_EDF_SCHEDULING
+// Move a task into the EDF band, re-sorting it by its new deadline
+// (caller holds the critical section). The band becomes the task's base
+// priority, so boosts from the mutexes it holds still apply on top.
+static void pico_rtos_task_enter_edf_band(pico_rtos_task_t *task) {
+    if (!task->edf) {
+        task->edf_base_priority = task->original_priority;
+        task->original_priority = PICO_RTOS_EDF_PRIORITY;
+        task->edf = true;
+    }
+    task->deadline_missed = false;
+    
+    // Requeue at the current priority to place the new deadline, then
+    // apply the band and any inheritance
+    pico_rtos_scheduler_set_task_priority(task, task->priority);
+    pico_rtos_mutex_update_priority(task);
+}
+
+bool pico_rtos_task_set_deadline(pico_rtos_task_t *task, uint32_t relative_deadline, uint32_t period) {
+    if (relative_deadline == 0) {
+        return false;
+    }
+    
+    pico_rtos_enter_critical();
+    
+    if (task == NULL) {
+        task = pico_rtos_get_current_task();
+    }
+    
+    if (task == NULL) {
+        pico_rtos_exit_critical();
+        return false;
+    }
+    
+    uint32_t now = pico_rtos_get_tick_count();
+    task->relative_deadline = relative_deadline;
+    task->period = period;
+    task->release_time = now;
+    task->deadline = now + relative_deadline;
+    pico_rtos_task_enter_edf_band(task);
+    
+    pico_rtos_exit_critical();
+    
+    // An earlier deadline may now outrank the running task
+    pico_rtos_scheduler();
+    
+    return true;
+}
+
+bool pico_rtos_task_set_absolute_deadline(pico_rtos_task_t *task, uint32_t deadline) {
+    pico_rtos_enter_critical();
+    
+    if (task == NULL) {
+        task = pico_rtos_get_current_task();
+    }
+    
+    if (task == NULL) {
+        pico_rtos_exit_critical();
+        return false;
+    }
+    
+    if (!task->edf) {
+        task->release_time = pico_rtos_get_tick_count();
+        task->relative_deadline = deadline - task->release_time;
+        task->period = 0;
+    }
+    task->deadline = deadline;
+    pico_rtos_task_enter_edf_band(task);
+    
+    pico_rtos_exit_critical();
+    
+    pico_rtos_scheduler();
+    
+    return true;
+}
+
+bool pico_rtos_task_clear_deadline(pico_rtos_task_t *task) {
+    pico_rtos_enter_critical();
+    
+    if (task == NULL) {
+        task = pico_rtos_get_current_task();
+    }
+    
+    if (task == NULL || !task->edf) {
+        pico_rtos_exit_critical();
+        return false;
+    }
+    
+    task->edf = false;
+    task->original_priority = task->edf_base_priority;
+    
+    // No longer sorted by deadline, so requeue before leaving the band
+    pico_rtos_scheduler_set_task_priority(task, task->priority);
+    pico_rtos_mutex_update_priority(task);
+    
+    pico_rtos_exit_critical();
+    
+    // A task waiting behind it in the band may now run
+    pico_rtos_scheduler();
+    
+    return true;
+}
+
+void pico_rtos_task_wait_for_next_period(void) {
+    pico_rtos_task_t *task = pico_rtos_get_current_task();
+    if (task == NULL || !task->edf || task->period == 0) {
+        pico_rtos_task_yield();
+        return;
+    }
+    
+    pico_rtos_enter_critical();
+    
+    uint32_t now = pico_rtos_get_tick_count();
+    if (!task->deadline_missed && (int32_t)(now - task->deadline) > 0) {
+        task->deadline_misses++;
+    }
+    
+    // The next job is released on the period grid, or now if it is overdue
+    task->release_time += task->period;
+    if ((int32_t)(task->release_time - now) < 0) {
+        task->release_time = now;
+    }
+    task->deadline = task->release_time + task->relative_deadline;
+    task->deadline_missed = false;
+    
+    uint32_t wait = task->release_time - now;
+    if (wait > 0) {
+        // A delay of n ticks wakes on the tick after now + n
+        pico_rtos_scheduler_delay_task(task, wait - 1);
+    }
+    
+    pico_rtos_exit_critical();
+    
+    if (wait > 0) {
+        pico_rtos_scheduler();
+    } else {
+        pico_rtos_task_yield();
+    }
+}
+
+uint32_t pico_rtos_task_get_deadline(pico_rtos_task_t *task) {
+    if (task == NULL) {
+        task = pico_rtos_get_current_task();
+    }
+    
+    return (task != NULL && task->edf) ? task->deadline : 0;
+}
+
+uint32_t pico_rtos_task_get_deadline_misses(pico_rtos_task_t *task) {
+    if (task == NULL) {
+        task = pico_rtos_get_current_task();
+    }
+    
+    return (task != NULL) ? task->deadline_misses : 0;
+}
+#endif // PICO_RTOS_ENABLE_EDF_SCHEDULING
+#if PICO_RTOS_ENABLE_TASK_NOTIFICATIONS
+// Values of the notify_state TCB field
+#define NOTIFY_NOT_WAITING 0
+#define NOTIFY_WAITING 1
+#define NOTIFY_PENDING 2
+
+// Update a task's notification value and wake it if it is waiting for one;
+// reports through woken whether it did (caller holds the critical section)
+static bool pico_rtos_task_notify_locked(pico_rtos_task_t *task, uint32_t value,
+                                         pico_rtos_notify_action_t action, bool *woken) {
+    switch (action) {
+        case PICO_RTOS_NOTIFY_SET_BITS:
+            task->notify_value |= value;
+            break;
+        case PICO_RTOS_NOTIFY_INCREMENT:
+            task->notify_value++;
+            break;
+        case PICO_RTOS_NOTIFY_SET_VALUE_WITH_OVERWRITE:
+            task->notify_value = value;
+            break;
+        case PICO_RTOS_NOTIFY_SET_VALUE_WITHOUT_OVERWRITE:
+            if (task->notify_state == NOTIFY_PENDING) {
+                return false;
+            }
+            task->notify_value = value;
+            break;
+        case PICO_RTOS_NOTIFY_NO_ACTION:
+        default:
+            break;
+    }
+    
+    // A waiter whose timeout already made it ready finds the notification
+    // pending when it runs
+    bool waiting = (task->notify_state == NOTIFY_WAITING &&
+                    task->state == PICO_RTOS_TASK_STATE_BLOCKED &&
+                    task->block_reason == PICO_RTOS_BLOCK_REASON_NOTIFICATION);
+    task->notify_state = NOTIFY_PENDING;
+    *woken = waiting;
+    
+    if (waiting) {
+        // Becoming ready also takes the task off the timeout queue
+        pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_READY);
+        task->block_reason = PICO_RTOS_BLOCK_REASON_NONE;
+    }
+    
+    return true;
+}
+
+// Block the current task until it is notified or the timeout passes
+// (caller holds the critical section, which is held again on return)
+static void pico_rtos_task_notify_block(pico_rtos_task_t *task, uint32_t timeout) {
+    task->notify_state = NOTIFY_WAITING;
+    pico_rtos_scheduler_set_task_state(task, PICO_RTOS_TASK_STATE_BLOCKED);
+    task->block_reason = PICO_RTOS_BLOCK_REASON_NOTIFICATION;
+    pico_rtos_scheduler_timeout_task(task, timeout);
+    
+    pico_rtos_exit_critical();
+    pico_rtos_schedule_next_task();
+    pico_rtos_enter_critical();
+}
+
+bool pico_rtos_task_notify(pico_rtos_task_t *task, uint32_t value, pico_rtos_notify_action_t action) {
+    if (task == NULL) {
+        return false;
+    }
+    
+    bool woken = false;
+    pico_rtos_enter_critical();
+    bool notified = pico_rtos_task_notify_locked(task, value, action, &woken);
+    pico_rtos_exit_critical();
+    
+    // Switch straight to a woken task that outranks the caller
+    if (woken) {
+        pico_rtos_schedule_next_task();
+    }
+    
+    return notified;
+}
+
+bool pico_rtos_task_notify_from_isr(pico_rtos_task_t *task, uint32_t value, pico_rtos_notify_action_t action) {
+    if (task == NULL) {
+        return false;
+    }
+    
+    bool woken = false;
+    pico_rtos_enter_critical();
+    bool notified = pico_rtos_task_notify_locked(task, value, action, &woken);
+    pico_rtos_exit_critical();
+    
+    // Inside pico_rtos_interrupt_enter()/exit() the switch waits for the
+    // interrupt to return; the running task stays current until then
+    if (woken) {
+        pico_rtos_request_context_switch();
+    }
+    
+    return notified;
+}
+
+bool pico_rtos_task_notify_give(pico_rtos_task_t *task) {
+    return pico_rtos_task_notify(task, 0, PICO_RTOS_NOTIFY_INCREMENT);
+}
+
+bool pico_rtos_task_notify_give_from_isr(pico_rtos_task_t *task) {
+    return pico_rtos_task_notify_from_isr(task, 0, PICO_RTOS_NOTIFY_INCREMENT);
+}
+
+uint32_t pico_rtos_task_notify_take(bool clear_on_exit, uint32_t timeout) {
+    pico_rtos_task_t *task = pico_rtos_get_current_task();
+    if (task == NULL) {
+        return 0;
+    }
+    
+    pico_rtos_enter_critical();
+    
+    if (task->notify_value == 0 && timeout != PICO_RTOS_NO_WAIT) {
+        pico_rtos_task_notify_block(task, timeout);
+    }
+    
+    uint32_t value = task->notify_value;
+    if (value != 0) {
+        task->notify_value = clear_on_exit ? 0 : value - 1;
+    }
+    task->notify_state = NOTIFY_NOT_WAITING;
+    
+    pico_rtos_exit_critical();
+    return value;
+}
+
+bool pico_rtos_task_notify_wait(uint32_t bits_to_clear_on_entry, uint32_t bits_to_clear_on_exit,
+                                uint32_t *value, uint32_t timeout) {
+    pico_rtos_task_t *task = pico_rtos_get_current_task();
+    if (task == NULL) {
+        return false;
+    }
+    
+    pico_rtos_enter_critical();
+    
+    if (task->notify_state != NOTIFY_PENDING) {
+        task->notify_value &= ~bits_to_clear_on_entry;
+        if (timeout != PICO_RTOS_NO_WAIT) {
+            pico_rtos_task_notify_block(task, timeout);
+        }
+    }
+    
+    if (value != NULL) {
+        *value = task->notify_value;
+    }
+    
+    bool received = (task->notify_state == NOTIFY_PENDING);
+    if (received) {
+        task->notify_value &= ~bits_to_clear_on_exit;
+    }
+    task->notify_state = NOTIFY_NOT_WAITING;
+    
+    pico_rtos_exit_critical();
+    return received;
+}
+#endif // PICO_RTOS_ENABLE_TASK_NOTIFICATIONS
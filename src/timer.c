@@ -1,7 +1,39 @@
 #include "pico_rtos/timer.h"
+#include "pico_rtos.h"
 #include "pico_rtos/error.h"
 #include "pico/critical_section.h"
 
+#if PICO_RTOS_ENABLE_TIMER_DAEMON
+typedef enum {
+    PICO_RTOS_TIMER_COMMAND_START,
+    PICO_RTOS_TIMER_COMMAND_STOP,
+    PICO_RTOS_TIMER_COMMAND_RESET,
+    PICO_RTOS_TIMER_COMMAND_CHANGE_PERIOD,
+    PICO_RTOS_TIMER_COMMAND_PROCESS_EXPIRED
+} pico_rtos_timer_command_id_t;
+
+typedef struct {
+    pico_rtos_timer_command_id_t id;
+    pico_rtos_timer_t *timer;
+    uint32_t value;   // New period for CHANGE_PERIOD
+    uint32_t tick;    // Tick the command was issued on
+} pico_rtos_timer_command_t;
+
+static pico_rtos_task_t timer_daemon_task;
+static uint32_t timer_daemon_stack[PICO_RTOS_TIMER_DAEMON_STACK_SIZE / sizeof(uint32_t)] __attribute__((aligned(8)));
+static pico_rtos_queue_t timer_command_queue;
+static pico_rtos_block_object_t timer_command_send_wait;
+static pico_rtos_block_object_t timer_command_receive_wait;
+static uint8_t timer_command_buffer[PICO_RTOS_TIMER_DAEMON_QUEUE_LENGTH * sizeof(pico_rtos_timer_command_t)];
+
+// Expired timers whose callbacks are waiting for the daemon, oldest first
+static pico_rtos_timer_t *pending_head = NULL;
+static pico_rtos_timer_t **pending_tail = &pending_head;
+static bool daemon_wake_posted = false;
+
+static void pico_rtos_timer_cancel_pending(pico_rtos_timer_t *timer);
+#endif
+
 bool pico_rtos_timer_init(pico_rtos_timer_t *timer, const char *name, 
                          pico_rtos_timer_callback_t callback, void *param, 
                          uint32_t period, bool auto_reload) {
@@ -26,6 +58,10 @@ bool pico_rtos_timer_init(pico_rtos_timer_t *timer, const char *name,
     timer->expiry_time = 0;
     critical_section_init(&timer->cs);
     timer->next = NULL;
+    timer->wheel_next = NULL;
+    timer->wheel_pprev = NULL;
+    timer->fire_next = NULL;
+    timer->fire_pprev = NULL;
     
     // Register timer with the RTOS
     extern void pico_rtos_add_timer(pico_rtos_timer_t *timer);
@@ -34,75 +70,95 @@ bool pico_rtos_timer_init(pico_rtos_timer_t *timer, const char *name,
     return true;
 }
 
-bool pico_rtos_timer_start(pico_rtos_timer_t *timer) {
-    if (timer == NULL) {
-        return false;
-    }
-    
+// Arm a timer to expire one period after the given tick
+static void pico_rtos_timer_start_at(pico_rtos_timer_t *timer, uint32_t now) {
     critical_section_enter_blocking(&timer->cs);
     
     timer->running = true;
     timer->expired = false;
-    
-    // Get current time and set expiry time
-    extern uint32_t pico_rtos_get_tick_count(void);
-    uint32_t current_time = pico_rtos_get_tick_count();
-    timer->start_time = current_time;
-    timer->expiry_time = current_time + timer->period;
+    timer->start_time = now;
+    timer->expiry_time = now + timer->period;
+    pico_rtos_timer_wheel_arm(timer);
     
     critical_section_exit(&timer->cs);
-    return true;
 }
 
-bool pico_rtos_timer_stop(pico_rtos_timer_t *timer) {
-    if (timer == NULL) {
-        return false;
-    }
-    
+static bool pico_rtos_timer_stop_internal(pico_rtos_timer_t *timer) {
     critical_section_enter_blocking(&timer->cs);
     
     bool was_running = timer->running;
     timer->running = false;
+    pico_rtos_timer_wheel_disarm(timer);
+#if PICO_RTOS_ENABLE_TIMER_DAEMON
+    pico_rtos_timer_cancel_pending(timer);
+#endif
     
     critical_section_exit(&timer->cs);
     return was_running;
 }
 
-bool pico_rtos_timer_reset(pico_rtos_timer_t *timer) {
-    if (timer == NULL) {
-        return false;
-    }
-    
+static void pico_rtos_timer_reset_at(pico_rtos_timer_t *timer, uint32_t now) {
     critical_section_enter_blocking(&timer->cs);
     
-    // Get current time and reset expiry time
-    extern uint32_t pico_rtos_get_tick_count(void);
-    uint32_t current_time = pico_rtos_get_tick_count();
-    timer->start_time = current_time;
-    timer->expiry_time = current_time + timer->period;
+    timer->start_time = now;
+    timer->expiry_time = now + timer->period;
     timer->expired = false;
     
+    // A stopped timer keeps its new expiry but stays off the wheel
+    if (timer->running) {
+        pico_rtos_timer_wheel_arm(timer);
+    }
+    
     critical_section_exit(&timer->cs);
-    return true;
 }
 
-bool pico_rtos_timer_change_period(pico_rtos_timer_t *timer, uint32_t period) {
-    if (timer == NULL || period == 0) {
-        return false;
-    }
-    
+static void pico_rtos_timer_change_period_at(pico_rtos_timer_t *timer, uint32_t period, uint32_t now) {
     critical_section_enter_blocking(&timer->cs);
     
     timer->period = period;
     
     // If timer is running, update the expiry time
     if (timer->running) {
-        extern uint32_t pico_rtos_get_tick_count(void);
-        uint32_t current_time = pico_rtos_get_tick_count();
-        timer->expiry_time = current_time + timer->period;
+        timer->start_time = now;
+        timer->expiry_time = now + timer->period;
+        pico_rtos_timer_wheel_arm(timer);
     }
     
     critical_section_exit(&timer->cs);
+}
+
+bool pico_rtos_timer_start(pico_rtos_timer_t *timer) {
+    if (timer == NULL) {
+        return false;
+    }
+    
+    pico_rtos_timer_start_at(timer, pico_rtos_get_tick_count());
+    return true;
+}
+
+bool pico_rtos_timer_stop(pico_rtos_timer_t *timer) {
+    if (timer == NULL) {
+        return false;
+    }
+    
+    return pico_rtos_timer_stop_internal(timer);
+}
+
+bool pico_rtos_timer_reset(pico_rtos_timer_t *timer) {
+    if (timer == NULL) {
+        return false;
+    }
+    
+    pico_rtos_timer_reset_at(timer, pico_rtos_get_tick_count());
+    return true;
+}
+
+bool pico_rtos_timer_change_period(pico_rtos_timer_t *timer, uint32_t period) {
+    if (timer == NULL || period == 0) {
+        return false;
+    }
+    
+    pico_rtos_timer_change_period_at(timer, period, pico_rtos_get_tick_count());
     return true;
 }
 
@@ -162,6 +218,10 @@ void pico_rtos_timer_delete(pico_rtos_timer_t *timer) {
     
     timer->running = false;
     timer->expired = true;
+    pico_rtos_timer_wheel_disarm(timer);
+#if PICO_RTOS_ENABLE_TIMER_DAEMON
+    pico_rtos_timer_cancel_pending(timer);
+#endif
     
     critical_section_exit(&timer->cs);
     
@@ -170,4 +230,179 @@ void pico_rtos_timer_delete(pico_rtos_timer_t *timer) {
     pico_rtos_remove_timer(timer);
 }
 
-// Timer handler is now implemented in core.c to prevent deadlocks
\ No newline at end of file
+// Timer handler is now implemented in core.c to prevent deadlocks
+
+#if PICO_RTOS_ENABLE_TIMER_DAEMON
+// =============================================================================
+// TIMER SERVICE TASK
+// =============================================================================
+
+// Drop a timer's callback that has not run yet
+static void pico_rtos_timer_cancel_pending(pico_rtos_timer_t *timer) {
+    pico_rtos_enter_critical();
+    if (timer->fire_pprev != NULL) {
+        *timer->fire_pprev = timer->fire_next;
+        if (timer->fire_next != NULL) {
+            timer->fire_next->fire_pprev = timer->fire_pprev;
+        } else {
+            pending_tail = timer->fire_pprev;
+        }
+        timer->fire_next = NULL;
+        timer->fire_pprev = NULL;
+    }
+    pico_rtos_exit_critical();
+}
+
+// Queue an expired timer's callback for the daemon (caller holds the
+// critical section). A timer whose previous callback is still waiting
+// keeps that one entry, so a lagging daemon never sees it twice.
+void pico_rtos_timer_daemon_defer(pico_rtos_timer_t *timer) {
+    if (timer->fire_pprev != NULL) {
+        return;
+    }
+    
+    timer->fire_next = NULL;
+    timer->fire_pprev = pending_tail;
+    *pending_tail = timer;
+    pending_tail = &timer->fire_next;
+}
+
+// Wake the daemon once for everything deferred so far (caller holds the
+// critical section). Nothing is posted while an earlier wakeup is still
+// unhandled; the daemon drains the whole list on every wakeup. Called from
+// the tick, which switches to the daemon itself once its work is done.
+void pico_rtos_timer_daemon_flush(void) {
+    if (pending_head == NULL || daemon_wake_posted) {
+        return;
+    }
+    
+    pico_rtos_timer_command_t command = {
+        .id = PICO_RTOS_TIMER_COMMAND_PROCESS_EXPIRED,
+        .timer = NULL,
+        .value = 0,
+        .tick = pico_rtos_get_tick_count()
+    };
+    
+    // A full queue already guarantees a wakeup
+    daemon_wake_posted = pico_rtos_queue_send_from_isr(&timer_command_queue, &command, NULL);
+}
+
+static void pico_rtos_timer_daemon_apply(const pico_rtos_timer_command_t *command) {
+    switch (command->id) {
+        case PICO_RTOS_TIMER_COMMAND_START:
+            pico_rtos_timer_start_at(command->timer, command->tick);
+            break;
+        case PICO_RTOS_TIMER_COMMAND_STOP:
+            pico_rtos_timer_stop_internal(command->timer);
+            break;
+        case PICO_RTOS_TIMER_COMMAND_RESET:
+            pico_rtos_timer_reset_at(command->timer, command->tick);
+            break;
+        case PICO_RTOS_TIMER_COMMAND_CHANGE_PERIOD:
+            pico_rtos_timer_change_period_at(command->timer, command->value, command->tick);
+            break;
+        case PICO_RTOS_TIMER_COMMAND_PROCESS_EXPIRED:
+        default:
+            break;
+    }
+}
+
+// Run every pending callback in expiry order
+static void pico_rtos_timer_daemon_run_pending(void) {
+    pico_rtos_enter_critical();
+    daemon_wake_posted = false;
+    
+    while (pending_head != NULL) {
+        pico_rtos_timer_t *timer = pending_head;
+        pending_head = timer->fire_next;
+        if (pending_head != NULL) {
+            pending_head->fire_pprev = &pending_head;
+        } else {
+            pending_tail = &pending_head;
+        }
+        timer->fire_next = NULL;
+        timer->fire_pprev = NULL;
+        
+        pico_rtos_timer_callback_t callback = timer->callback;
+        void *param = timer->param;
+        
+        pico_rtos_exit_critical();
+        callback(param);
+        pico_rtos_enter_critical();
+    }
+    
+    pico_rtos_exit_critical();
+}
+
+static void pico_rtos_timer_daemon_function(void *param) {
+    (void)param;
+    pico_rtos_timer_command_t command;
+    
+    while (1) {
+        if (pico_rtos_queue_receive(&timer_command_queue, &command, PICO_RTOS_WAIT_FOREVER)) {
+            pico_rtos_timer_daemon_apply(&command);
+        }
+        pico_rtos_timer_daemon_run_pending();
+    }
+}
+
+bool pico_rtos_timer_daemon_init(void) {
+    pending_head = NULL;
+    pending_tail = &pending_head;
+    daemon_wake_posted = false;
+    
+    if (!pico_rtos_queue_init_static(&timer_command_queue, timer_command_buffer,
+                                     sizeof(pico_rtos_timer_command_t), PICO_RTOS_TIMER_DAEMON_QUEUE_LENGTH,
+                                     &timer_command_send_wait, &timer_command_receive_wait)) {
+        return false;
+    }
+    
+    return pico_rtos_task_create_static(&timer_daemon_task, "TIMER", pico_rtos_timer_daemon_function, NULL,
+                                        timer_daemon_stack, sizeof(timer_daemon_stack),
+                                        PICO_RTOS_TIMER_DAEMON_PRIORITY);
+}
+
+pico_rtos_task_t *pico_rtos_timer_daemon_get_task(void) {
+    return &timer_daemon_task;
+}
+
+static bool pico_rtos_timer_post_command(pico_rtos_timer_command_id_t id, pico_rtos_timer_t *timer, uint32_t value) {
+    if (timer == NULL) {
+        return false;
+    }
+    
+    pico_rtos_timer_command_t command = {
+        .id = id,
+        .timer = timer,
+        .value = value,
+        .tick = pico_rtos_get_tick_count()
+    };
+    
+    // Switch to the daemon only once the interrupt returns
+    bool woken = false;
+    bool queued = pico_rtos_queue_send_from_isr(&timer_command_queue, &command, &woken);
+    if (woken) {
+        pico_rtos_request_context_switch();
+    }
+    return queued;
+}
+
+bool pico_rtos_timer_start_from_isr(pico_rtos_timer_t *timer) {
+    return pico_rtos_timer_post_command(PICO_RTOS_TIMER_COMMAND_START, timer, 0);
+}
+
+bool pico_rtos_timer_stop_from_isr(pico_rtos_timer_t *timer) {
+    return pico_rtos_timer_post_command(PICO_RTOS_TIMER_COMMAND_STOP, timer, 0);
+}
+
+bool pico_rtos_timer_reset_from_isr(pico_rtos_timer_t *timer) {
+    return pico_rtos_timer_post_command(PICO_RTOS_TIMER_COMMAND_RESET, timer, 0);
+}
+
+bool pico_rtos_timer_change_period_from_isr(pico_rtos_timer_t *timer, uint32_t period) {
+    if (period == 0) {
+        return false;
+    }
+    return pico_rtos_timer_post_command(PICO_RTOS_TIMER_COMMAND_CHANGE_PERIOD, timer, period);
+}
+#endif // PICO_RTOS_ENABLE_TIMER_DAEMON
\ No newline at end of file
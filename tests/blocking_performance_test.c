@@ -20,7 +20,11 @@
 // Test configuration
 #define MAX_TEST_TASKS 50
 #define PERFORMANCE_ITERATIONS 1000
+#define ROUND_TRIP_ITERATIONS 100000
+#define ROUND_TRIP_WAITERS 8
 #define STACK_SIZE 512
+#define RUNNER_STACK_SIZE 2048
+#define RUNNER_PRIORITY (MAX_TEST_TASKS + 10)  // Above every test task
 
 // Test results structure
 typedef struct {
@@ -33,13 +37,12 @@ typedef struct {
 
 // Global test data
 static pico_rtos_task_t test_tasks[MAX_TEST_TASKS];
-static uint8_t test_stacks[MAX_TEST_TASKS][STACK_SIZE];
 static pico_rtos_semaphore_t test_semaphore;
 static blocking_performance_results_t test_results;
 
 // Test task function - just blocks on semaphore
 void test_task_function(void *param) {
-    uint32_t task_id = (uint32_t)(uintptr_t)param;
+    (void)param;
     
     while (1) {
         // Block on semaphore with different priorities
@@ -97,15 +100,14 @@ bool test_unblocking_performance(void) {
             
             if (!pico_rtos_task_create(&test_tasks[j], "TestTask", test_task_function, 
                                      (void*)(uintptr_t)j, STACK_SIZE, priority)) {
-                printf("❌ Failed to create test task %lu\n", j);
+                printf("❌ Failed to create test task %lu\n", (unsigned long)j);
                 return false;
             }
             
             // Block the task
-            extern pico_rtos_block_reason_t PICO_RTOS_BLOCK_REASON_SEMAPHORE;
             if (!pico_rtos_block_task(test_block_obj, &test_tasks[j], 
                                     PICO_RTOS_BLOCK_REASON_SEMAPHORE, PICO_RTOS_WAIT_FOREVER)) {
-                printf("❌ Failed to block test task %lu\n", j);
+                printf("❌ Failed to block test task %lu\n", (unsigned long)j);
                 return false;
             }
         }
@@ -127,11 +129,13 @@ bool test_unblocking_performance(void) {
         // Simulate O(n) performance (linear with task count)
         uint32_t on_estimated_cycles = 50 + (task_count * 10);  // Base + linear component
         
+        // Operations faster than the timer resolution count as one tick
+        uint32_t o1_divisor = (o1_avg_cycles > 0) ? o1_avg_cycles : 1;
         uint32_t improvement = (on_estimated_cycles > o1_avg_cycles) ? 
-                              (on_estimated_cycles / o1_avg_cycles) : 1;
+                              (on_estimated_cycles / o1_divisor) : 1;
         
         printf("%lu\t%lu\t\t%lu\t\t%lux\n", 
-               task_count, o1_avg_cycles, on_estimated_cycles, improvement);
+               (unsigned long)task_count, (unsigned long)o1_avg_cycles, (unsigned long)on_estimated_cycles, (unsigned long)improvement);
         
         // Clean up tasks
         for (uint32_t j = 0; j < task_count; j++) {
@@ -147,6 +151,68 @@ bool test_unblocking_performance(void) {
     return true;
 }
 
+// Block/unblock round trip: the cost every contended mutex, queue and
+// semaphore operation pays, which must not touch the heap
+bool test_block_round_trip(void) {
+    printf("Testing block/unblock round trip...\n");
+    
+    pico_rtos_block_object_t *block_obj = pico_rtos_block_object_create(&test_semaphore);
+    if (block_obj == NULL) {
+        printf("❌ Failed to create blocking object\n");
+        return false;
+    }
+    
+    // A few lower priority waiters stay queued so insertion has to search
+    for (uint32_t i = 0; i <= ROUND_TRIP_WAITERS; i++) {
+        if (!pico_rtos_task_create(&test_tasks[i], "RoundTrip", test_task_function,
+                                   (void*)(uintptr_t)i, STACK_SIZE, i + 1)) {
+            printf("❌ Failed to create test task %lu\n", (unsigned long)i);
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < ROUND_TRIP_WAITERS; i++) {
+        pico_rtos_block_task(block_obj, &test_tasks[i], PICO_RTOS_BLOCK_REASON_SEMAPHORE, PICO_RTOS_WAIT_FOREVER);
+    }
+    
+    pico_rtos_task_t *waiter = &test_tasks[ROUND_TRIP_WAITERS];
+    uint32_t allocations_before;
+    uint32_t current;
+    uint32_t peak;
+    pico_rtos_get_memory_stats(&current, &peak, &allocations_before);
+    
+    bool ok = true;
+    uint64_t start_us = time_us_64();
+    for (uint32_t iter = 0; iter < ROUND_TRIP_ITERATIONS; iter++) {
+        ok &= pico_rtos_block_task(block_obj, waiter, PICO_RTOS_BLOCK_REASON_SEMAPHORE, PICO_RTOS_WAIT_FOREVER);
+        ok &= (pico_rtos_unblock_highest_priority_task(block_obj) == waiter);
+    }
+    uint64_t elapsed_us = time_us_64() - start_us;
+    
+    uint32_t allocations_after;
+    pico_rtos_get_memory_stats(&current, &peak, &allocations_after);
+    
+    printf("Block + unblock: %lu ns per round trip, %lu heap allocations over %d round trips\n",
+           (unsigned long)((elapsed_us * 1000) / ROUND_TRIP_ITERATIONS),
+           (unsigned long)(allocations_after - allocations_before), ROUND_TRIP_ITERATIONS);
+    
+    for (uint32_t i = 0; i <= ROUND_TRIP_WAITERS; i++) {
+        pico_rtos_task_delete(&test_tasks[i]);
+    }
+    pico_rtos_block_object_delete(block_obj);
+    
+    if (!ok) {
+        printf("❌ Round trip did not hand the object to the highest priority waiter\n");
+        return false;
+    }
+    if (allocations_after != allocations_before) {
+        printf("❌ Blocking allocated from the heap\n");
+        return false;
+    }
+    
+    printf("✅ Block/unblock round trip test passed\n");
+    return true;
+}
+
 // Test priority ordering validation
 bool test_priority_ordering(void) {
     printf("Testing priority ordering...\n");
@@ -165,15 +231,14 @@ bool test_priority_ordering(void) {
     for (uint32_t i = 0; i < num_tasks; i++) {
         if (!pico_rtos_task_create(&test_tasks[i], "TestTask", test_task_function, 
                                  (void*)(uintptr_t)i, STACK_SIZE, priorities[i])) {
-            printf("❌ Failed to create test task %lu\n", i);
+            printf("❌ Failed to create test task %lu\n", (unsigned long)i);
             return false;
         }
         
         // Block the task
-        extern pico_rtos_block_reason_t PICO_RTOS_BLOCK_REASON_SEMAPHORE;
         if (!pico_rtos_block_task(block_obj, &test_tasks[i], 
                                 PICO_RTOS_BLOCK_REASON_SEMAPHORE, PICO_RTOS_WAIT_FOREVER)) {
-            printf("❌ Failed to block test task %lu\n", i);
+            printf("❌ Failed to block test task %lu\n", (unsigned long)i);
             return false;
         }
     }
@@ -189,13 +254,13 @@ bool test_priority_ordering(void) {
     for (uint32_t i = 0; i < num_tasks; i++) {
         pico_rtos_task_t *unblocked_task = pico_rtos_unblock_highest_priority_task(block_obj);
         if (unblocked_task == NULL) {
-            printf("❌ Failed to unblock task %lu\n", i);
+            printf("❌ Failed to unblock task %lu\n", (unsigned long)i);
             return false;
         }
         
         if (unblocked_task->priority != expected_priorities[i]) {
             printf("❌ Priority order violation: expected %lu, got %lu\n", 
-                   expected_priorities[i], unblocked_task->priority);
+                   (unsigned long)expected_priorities[i], (unsigned long)unblocked_task->priority);
             return false;
         }
     }
@@ -227,7 +292,7 @@ bool test_semaphore_integration(void) {
     for (uint32_t i = 0; i < num_tasks; i++) {
         if (!pico_rtos_task_create(&test_tasks[i], "SemTestTask", test_task_function, 
                                  (void*)(uintptr_t)i, STACK_SIZE, priorities[i])) {
-            printf("❌ Failed to create semaphore test task %lu\n", i);
+            printf("❌ Failed to create semaphore test task %lu\n", (unsigned long)i);
             return false;
         }
     }
@@ -238,7 +303,7 @@ bool test_semaphore_integration(void) {
     // Give semaphore multiple times and verify highest priority tasks get it first
     for (uint32_t i = 0; i < num_tasks; i++) {
         if (!pico_rtos_semaphore_give(&test_semaphore)) {
-            printf("❌ Failed to give semaphore iteration %lu\n", i);
+            printf("❌ Failed to give semaphore iteration %lu\n", (unsigned long)i);
             return false;
         }
         pico_rtos_task_delay(10);  // Allow task to run
@@ -255,7 +320,7 @@ bool test_semaphore_integration(void) {
 }
 
 // Main test function
-void blocking_performance_test_main(void) {
+bool blocking_performance_test_main(void) {
     printf("\n=== Pico-RTOS Blocking Performance Test ===\n");
     printf("Testing high-performance O(1) unblocking system\n\n");
     
@@ -267,6 +332,7 @@ void blocking_performance_test_main(void) {
     
     all_passed &= test_priority_ordering();
     all_passed &= test_unblocking_performance();
+    all_passed &= test_block_round_trip();
     all_passed &= test_semaphore_integration();
     
     // Print summary
@@ -286,6 +352,15 @@ void blocking_performance_test_main(void) {
     printf("- Critical sections: Bounded timing\n");
     printf("- Priority preservation: Maintained\n");
     printf("- Real-time compliance: Achieved\n");
+    
+    return all_passed;
+}
+
+static volatile bool blocking_tests_passed = false;
+
+static void blocking_test_runner_task(void *param) {
+    (void)param;
+    blocking_tests_passed = blocking_performance_test_main();
 }
 
 // Test entry point for integration with main test suite
@@ -298,8 +373,15 @@ int main() {
         return -1;
     }
     
-    // Run blocking performance tests
-    blocking_performance_test_main();
+    // The tests block, wake and delete tasks, so they run under the scheduler
+    static pico_rtos_task_t runner_task;
+    if (!pico_rtos_task_create(&runner_task, "BlockingTestRunner", blocking_test_runner_task,
+                               NULL, RUNNER_STACK_SIZE, RUNNER_PRIORITY)) {
+        printf("❌ Failed to create test runner task\n");
+        return -1;
+    }
+    
+    pico_rtos_start();
     
-    return 0;
+    return blocking_tests_passed ? 0 : 1;
 }
\ No newline at end of file
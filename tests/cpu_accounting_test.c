@@ -0,0 +1,232 @@
+/**
+ * @file cpu_accounting_test.c
+ * @brief Tests for per-task CPU time accounting
+ *
+ * The scheduler timestamps every switch with the microsecond timer and
+ * charges the outgoing task for its run. Checks that a task's CPU time
+ * matches how long it actually ran, that the CPU time of all tasks adds up
+ * to the wall-clock time, that windowed CPU usage follows a task's duty
+ * cycle, and that switches and preemptions are counted. On the host it runs
+ * on the simulated clock, so the busy waits take exactly as long as asked.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define WORKER_PRIORITY 3
+#define SPINNER_PRIORITY 2
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define BUSY_US 30000
+#define DUTY_BUSY_US 2000
+#define DUTY_SLEEP_TICKS 6
+#define WINDOW_MS 400
+#define WAKEUPS 20
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t busy_task;
+static pico_rtos_task_t duty_task;
+static pico_rtos_task_t spinner_task;
+
+static volatile bool busy_done = false;
+static volatile bool duty_running = false;
+static volatile bool duty_done = false;
+static volatile bool spinner_running = false;
+static volatile bool spinner_done = false;
+
+static void busy_task_function(void *param) {
+    (void)param;
+    busy_wait_us(BUSY_US);
+    busy_done = true;
+    // Stay in the task list for inspection; ended tasks leave it at once
+    pico_rtos_task_suspend(NULL);
+}
+
+static void duty_task_function(void *param) {
+    (void)param;
+    while (duty_running) {
+        busy_wait_us(DUTY_BUSY_US);
+        pico_rtos_task_delay(DUTY_SLEEP_TICKS);
+    }
+    duty_done = true;
+}
+
+static void spinner_task_function(void *param) {
+    (void)param;
+    // Waits in small steps so the simulated clock moves while it spins
+    while (spinner_running) {
+        busy_wait_us(10);
+    }
+    spinner_done = true;
+}
+
+// CPU time of every live task; finished ones may be unlinked at any time
+static uint64_t total_cpu_time(void) {
+    uint64_t total = 0;
+    pico_rtos_enter_critical();
+    for (pico_rtos_task_t *task = pico_rtos_debug_get_task_list(); task != NULL; task = task->next) {
+        if (task->state == PICO_RTOS_TASK_STATE_TERMINATED) {
+            continue;
+        }
+        pico_rtos_task_runtime_stats_t stats;
+        pico_rtos_task_get_runtime_stats(task, &stats);
+        total += stats.cpu_time_us;
+    }
+    pico_rtos_exit_critical();
+    return total;
+}
+
+static void test_run_time_exact(void) {
+    pico_rtos_task_create(&busy_task, "Busy", busy_task_function, NULL, TASK_STACK_SIZE, WORKER_PRIORITY);
+    pico_rtos_task_delay(BUSY_US / 1000 + 20);
+
+    pico_rtos_task_runtime_stats_t stats;
+    TEST_ASSERT(pico_rtos_task_get_runtime_stats(&busy_task, &stats), "Run time statistics can be read");
+    printf("Busy task: %llu us CPU time for %d us of work\n", (unsigned long long)stats.cpu_time_us, BUSY_US);
+
+    TEST_ASSERT(busy_done && stats.cpu_time_us >= BUSY_US && stats.cpu_time_us <= BUSY_US + BUSY_US / 20,
+                "CPU time matches how long the task ran");
+    TEST_ASSERT(stats.context_switches == 1 && stats.preemptions == 0,
+                "A task that ran its work in one go was switched in once and never preempted");
+
+#ifdef PICO_RTOS_ENABLE_TASK_INSPECTION
+    pico_rtos_task_info_t info;
+    pico_rtos_debug_get_task_info(&busy_task, &info);
+    TEST_ASSERT(info.cpu_time_us == stats.cpu_time_us && info.context_switches == stats.context_switches,
+                "Task inspection reports the accounted CPU time");
+#endif
+}
+
+static void test_all_time_accounted(void) {
+    duty_running = true;
+    duty_done = false;
+    pico_rtos_task_create(&duty_task, "Duty", duty_task_function, NULL, TASK_STACK_SIZE, WORKER_PRIORITY);
+
+    uint64_t cpu_start = total_cpu_time();
+    uint64_t wall_start = time_us_64();
+    pico_rtos_task_delay(100);
+    uint64_t cpu_elapsed = total_cpu_time() - cpu_start;
+    uint64_t wall_elapsed = time_us_64() - wall_start;
+
+    printf("All tasks: %llu us CPU time in %llu us\n",
+           (unsigned long long)cpu_elapsed, (unsigned long long)wall_elapsed);
+
+    TEST_ASSERT(cpu_elapsed * 100 >= wall_elapsed * 99 && cpu_elapsed * 100 <= wall_elapsed * 101,
+                "CPU time of all tasks adds up to the elapsed time");
+}
+
+static void test_windowed_usage(void) {
+    // The duty task from the previous case runs 2 ms out of every ~8
+    pico_rtos_cpu_window_t window;
+    pico_rtos_task_start_cpu_window(&duty_task, &window);
+    pico_rtos_task_delay(WINDOW_MS);
+    float busy_usage = pico_rtos_task_sample_cpu_usage(&duty_task, &window);
+
+    duty_running = false;
+    while (!duty_done) {
+        pico_rtos_task_delay(1);
+    }
+
+    pico_rtos_task_start_cpu_window(&duty_task, &window);
+    pico_rtos_task_delay(WINDOW_MS / 4);
+    float stopped_usage = pico_rtos_task_sample_cpu_usage(&duty_task, &window);
+
+    printf("Duty task: %.1f%% while running, %.1f%% once stopped\n", busy_usage, stopped_usage);
+
+    TEST_ASSERT(busy_usage > 18.0f && busy_usage < 32.0f, "Windowed CPU usage follows the duty cycle");
+    TEST_ASSERT(stopped_usage == 0.0f && window.usage_percent == stopped_usage,
+                "Each window only counts the time inside it");
+}
+
+static void test_preemptions_counted(void) {
+    spinner_running = true;
+    spinner_done = false;
+    pico_rtos_task_create(&spinner_task, "Spinner", spinner_task_function, NULL, TASK_STACK_SIZE, SPINNER_PRIORITY);
+    pico_rtos_task_delay(2);
+
+    pico_rtos_task_runtime_stats_t spinner_before, controller_before;
+    pico_rtos_task_get_runtime_stats(&spinner_task, &spinner_before);
+    pico_rtos_task_get_runtime_stats(NULL, &controller_before);
+
+    for (int i = 0; i < WAKEUPS; i++) {
+        pico_rtos_task_delay(1);
+    }
+
+    pico_rtos_task_runtime_stats_t spinner_after, controller_after;
+    pico_rtos_task_get_runtime_stats(&spinner_task, &spinner_after);
+    pico_rtos_task_get_runtime_stats(NULL, &controller_after);
+
+    spinner_running = false;
+    while (!spinner_done) {
+        pico_rtos_task_delay(1);
+    }
+
+    uint32_t preempted = spinner_after.preemptions - spinner_before.preemptions;
+    printf("Spinner preempted %lu times by %d wakeups\n", (unsigned long)preempted, WAKEUPS);
+
+    TEST_ASSERT(preempted >= WAKEUPS && preempted <= WAKEUPS + 2,
+                "A task losing the CPU to a higher priority one is counted as preempted");
+    TEST_ASSERT(controller_after.context_switches - controller_before.context_switches >= WAKEUPS &&
+                controller_after.preemptions == controller_before.preemptions,
+                "A task that blocks is switched in again but not counted as preempted");
+}
+
+static void test_reset(void) {
+    pico_rtos_task_reset_runtime_stats(&busy_task);
+
+    pico_rtos_task_runtime_stats_t stats;
+    pico_rtos_task_get_runtime_stats(&busy_task, &stats);
+    TEST_ASSERT(stats.cpu_time_us == 0 && stats.context_switches == 0 && stats.preemptions == 0,
+                "Run time statistics can be reset");
+    pico_rtos_task_delete(&busy_task);
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_run_time_exact();
+    test_all_time_accounted();
+    test_windowed_usage();
+    test_preemptions_counted();
+    test_reset();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting CPU Accounting Tests...\n");
+    printf("================================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,250 @@
+/**
+ * @file deferred_work_test.c
+ * @brief Tests for the deferred interrupt work queue
+ *
+ * Interrupt handlers queue a function and argument; the deferred work task
+ * runs them in task context. Checks that queued work runs in that task in
+ * order, that a burst from one interrupt wakes the task once and runs as a
+ * single batch, that a full queue drops and counts the excess, that the
+ * deferred task preempts busy application tasks, and that latency
+ * statistics are kept. Also reports what queueing costs the interrupt.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+#include "pico_rtos/context_switch.h"
+
+#define CONTROLLER_PRIORITY 5
+#define BUSY_PRIORITY 3
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define ALARM_MS 5
+#define BURST_ITEMS 8
+#define OVERFLOW_EXTRA 4
+#define COST_ROUNDS 200
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t busy_task;
+
+static volatile uint32_t alarm_items = 0;
+static volatile uint32_t alarm_accepted = 0;
+static volatile uint32_t alarm_busy_progress = 0;
+static volatile uint32_t alarm_cycles = 0;
+static volatile bool alarm_done = false;
+
+static volatile uint32_t run_count = 0;
+static volatile uint32_t run_order[PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH + OVERFLOW_EXTRA];
+static volatile bool ran_in_deferred_task = true;
+static volatile uint32_t run_busy_progress = 0;
+
+static volatile bool busy_running = false;
+static volatile uint32_t busy_progress = 0;
+static volatile bool busy_done = false;
+
+static void record_work(void *param) {
+    if (pico_rtos_get_current_task() != pico_rtos_deferred_get_task()) {
+        ran_in_deferred_task = false;
+    }
+    if (run_count < PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH + OVERFLOW_EXTRA) {
+        run_order[run_count] = (uint32_t)(uintptr_t)param;
+    }
+    run_busy_progress = busy_progress;
+    run_count++;
+}
+
+static void no_work(void *param) {
+    (void)param;
+}
+
+// Queues alarm_items items as one interrupt would
+static int64_t defer_alarm_callback(alarm_id_t id, void *user_data) {
+    (void)id;
+    pico_rtos_deferred_function_t function = (pico_rtos_deferred_function_t)user_data;
+    uint32_t accepted = 0;
+
+    alarm_busy_progress = busy_progress;
+    uint32_t start = pico_rtos_port_get_cycle_count();
+    for (uint32_t i = 0; i < alarm_items; i++) {
+        if (pico_rtos_defer_from_isr(function, (void *)(uintptr_t)i)) {
+            accepted++;
+        }
+    }
+    alarm_cycles = (pico_rtos_port_get_cycle_count() - start) & PICO_RTOS_PORT_CYCLE_COUNTER_MASK;
+
+    alarm_accepted = accepted;
+    alarm_done = true;
+    return 0;
+}
+
+// Fires the alarm and waits until the deferred task has caught up
+static void run_alarm(uint32_t items, pico_rtos_deferred_function_t function) {
+    alarm_items = items;
+    alarm_done = false;
+    run_count = 0;
+    ran_in_deferred_task = true;
+    add_alarm_in_ms(ALARM_MS, defer_alarm_callback, (void *)function, true);
+    while (!alarm_done || pico_rtos_deferred_get_pending() != 0) {
+        pico_rtos_task_delay(1);
+    }
+    pico_rtos_task_delay(1);
+}
+
+static void busy_task_function(void *param) {
+    (void)param;
+    while (busy_running) {
+        busy_progress++;
+    }
+    busy_done = true;
+}
+
+static void test_single_item(void) {
+    pico_rtos_deferred_reset_stats();
+    run_alarm(1, record_work);
+
+    TEST_ASSERT(alarm_accepted == 1 && run_count == 1, "Work queued from an interrupt runs once");
+    TEST_ASSERT(ran_in_deferred_task, "Deferred work runs in the deferred work task");
+    TEST_ASSERT(pico_rtos_deferred_get_task()->priority == PICO_RTOS_DEFERRED_WORK_PRIORITY,
+                "The deferred work task runs at the configured priority");
+    TEST_ASSERT(!pico_rtos_defer_from_isr(NULL, NULL), "A NULL function is rejected");
+}
+
+static void test_burst_is_one_batch(void) {
+    pico_rtos_deferred_reset_stats();
+    run_alarm(BURST_ITEMS, record_work);
+
+    bool in_order = (run_count == BURST_ITEMS);
+    for (uint32_t i = 0; in_order && i < BURST_ITEMS; i++) {
+        in_order = (run_order[i] == i);
+    }
+
+    pico_rtos_deferred_stats_t stats;
+    pico_rtos_deferred_get_stats(&stats);
+
+    TEST_ASSERT(in_order, "Deferred work runs in the order it was queued");
+    TEST_ASSERT(stats.batches == 1, "A burst from one interrupt wakes the task once and runs as one batch");
+    TEST_ASSERT(stats.max_depth == BURST_ITEMS, "The deepest backlog is recorded");
+}
+
+static void test_overflow_dropped(void) {
+    pico_rtos_deferred_reset_stats();
+    run_alarm(PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH + OVERFLOW_EXTRA, record_work);
+
+    pico_rtos_deferred_stats_t stats;
+    pico_rtos_deferred_get_stats(&stats);
+
+    TEST_ASSERT(alarm_accepted == PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH &&
+                run_count == PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH,
+                "A full queue accepts no more work");
+    TEST_ASSERT(stats.dropped == OVERFLOW_EXTRA && stats.queued == PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH,
+                "Work rejected by a full queue is counted as dropped");
+}
+
+static void test_preempts_application_tasks(void) {
+    busy_running = true;
+    busy_done = false;
+    pico_rtos_task_create(&busy_task, "Busy", busy_task_function, NULL, TASK_STACK_SIZE, BUSY_PRIORITY);
+
+    // The busy task has the CPU whenever the controller sleeps, so the work
+    // runs before the busy task gets on with its loop only if the deferred
+    // task preempts it
+    alarm_items = 1;
+    alarm_done = false;
+    run_count = 0;
+    add_alarm_in_ms(ALARM_MS, defer_alarm_callback, (void *)record_work, true);
+    pico_rtos_task_delay(ALARM_MS * 4);
+    uint32_t ran = run_count;
+    bool busy_held_off = (run_busy_progress == alarm_busy_progress);
+
+    busy_running = false;
+    while (!busy_done) {
+        pico_rtos_task_delay(1);
+    }
+
+    TEST_ASSERT(ran == 1 && busy_held_off,
+                "Deferred work preempts a busy application task before it runs again");
+}
+
+static void test_latency_stats(void) {
+    pico_rtos_deferred_reset_stats();
+    for (int i = 0; i < 4; i++) {
+        run_alarm(BURST_ITEMS, record_work);
+    }
+
+    pico_rtos_deferred_stats_t stats;
+    pico_rtos_deferred_get_stats(&stats);
+    printf("Deferred latency: last %lu, average %lu, max %lu ns over %lu items\n",
+           (unsigned long)stats.last_latency_cycles, (unsigned long)stats.average_latency_cycles,
+           (unsigned long)stats.max_latency_cycles, (unsigned long)stats.processed);
+
+    TEST_ASSERT(stats.processed == 4 * BURST_ITEMS && stats.queued == stats.processed,
+                "Every queued item is counted as processed");
+    TEST_ASSERT(stats.max_latency_cycles > 0 &&
+                stats.average_latency_cycles <= stats.max_latency_cycles &&
+                stats.last_latency_cycles <= stats.max_latency_cycles,
+                "Latency statistics are consistent");
+
+    pico_rtos_deferred_reset_stats();
+    pico_rtos_deferred_get_stats(&stats);
+    TEST_ASSERT(stats.processed == 0 && stats.max_latency_cycles == 0, "Statistics can be reset");
+}
+
+static void test_interrupt_cost(void) {
+    uint64_t total = 0;
+    for (int round = 0; round < COST_ROUNDS; round++) {
+        run_alarm(PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH, no_work);
+        total += alarm_cycles;
+    }
+
+    printf("Queueing cost in the interrupt: %lu ns per item\n",
+           (unsigned long)(total / ((uint64_t)COST_ROUNDS * PICO_RTOS_DEFERRED_WORK_QUEUE_LENGTH)));
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_single_item();
+    test_burst_is_one_batch();
+    test_overflow_dropped();
+    test_preempts_application_tasks();
+    test_latency_stats();
+    test_interrupt_cost();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Deferred Work Tests...\n");
+    printf("===============================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
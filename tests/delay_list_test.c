@@ -0,0 +1,202 @@
+/**
+ * @file delay_list_test.c
+ * @brief Tests for the delta-ordered delay list
+ *
+ * Delayed tasks are kept sorted by wake-up tick, so the tick only has to
+ * look at the head of the list. Checks that tasks wake in deadline order on
+ * the right tick, that deleting or suspending a delayed task leaves the rest
+ * of the list intact, and that the work done by the tick interrupt does not
+ * grow with the number of delayed tasks.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define SLEEPER_PRIORITY 3
+#define BACKGROUND_PRIORITY 1
+#define TASK_STACK_SIZE 512
+#define CONTROLLER_STACK_SIZE 2048
+
+#define ORDER_TASKS 6
+#define BACKGROUND_TASKS 60
+#define BACKGROUND_DELAY_MS 100000
+
+#define COST_WINDOW_MS 20
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+typedef struct {
+    uint32_t delay_ms;
+    uint32_t start_tick;
+    uint32_t wake_tick;
+    uint32_t wake_order;
+    volatile bool woken;
+} sleeper_t;
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t order_tasks[ORDER_TASKS];
+static pico_rtos_task_t background_tasks[BACKGROUND_TASKS];
+static sleeper_t sleepers[ORDER_TASKS];
+
+static volatile uint32_t wake_counter = 0;
+
+static void sleeper_task_function(void *param) {
+    sleeper_t *sleeper = (sleeper_t *)param;
+    sleeper->start_tick = pico_rtos_get_tick_count();
+    pico_rtos_task_delay(sleeper->delay_ms);
+    sleeper->wake_tick = pico_rtos_get_tick_count();
+    sleeper->wake_order = wake_counter++;
+    sleeper->woken = true;
+}
+
+static void background_task_function(void *param) {
+    (void)param;
+    pico_rtos_task_delay(BACKGROUND_DELAY_MS);
+}
+
+static void start_sleepers(const uint32_t *delays, uint32_t count) {
+    wake_counter = 0;
+    for (uint32_t i = 0; i < count; i++) {
+        sleepers[i].delay_ms = delays[i];
+        sleepers[i].woken = false;
+        pico_rtos_task_create(&order_tasks[i], "Sleeper", sleeper_task_function, &sleepers[i],
+                              TASK_STACK_SIZE, SLEEPER_PRIORITY);
+    }
+}
+
+static void test_wake_order(void) {
+    // Includes a tie, which must wake in the order the tasks went to sleep
+    static const uint32_t delays[ORDER_TASKS] = { 50, 10, 30, 10, 40, 20 };
+    static const uint32_t expected_order[ORDER_TASKS] = { 5, 0, 3, 1, 4, 2 };
+
+    start_sleepers(delays, ORDER_TASKS);
+    pico_rtos_task_delay(80);
+
+    bool all_woken = true;
+    bool order_ok = true;
+    bool timing_ok = true;
+    for (uint32_t i = 0; i < ORDER_TASKS; i++) {
+        all_woken = all_woken && sleepers[i].woken;
+        order_ok = order_ok && (sleepers[i].wake_order == expected_order[i]);
+        uint32_t slept = sleepers[i].wake_tick - sleepers[i].start_tick;
+        timing_ok = timing_ok && (slept >= delays[i]) && (slept <= delays[i] + 2);
+    }
+
+    TEST_ASSERT(all_woken, "Every delayed task wakes up");
+    TEST_ASSERT(order_ok, "Delayed tasks wake in deadline order, ties in sleep order");
+    TEST_ASSERT(timing_ok, "Delayed tasks wake on their deadline tick");
+}
+
+static void test_delete_delayed_task(void) {
+    static const uint32_t delays[3] = { 20, 40, 60 };
+
+    start_sleepers(delays, 3);
+    pico_rtos_task_delay(10);
+    pico_rtos_task_delete(&order_tasks[1]);
+    pico_rtos_task_delay(70);
+
+    uint32_t slept_last = sleepers[2].wake_tick - sleepers[2].start_tick;
+    TEST_ASSERT(sleepers[0].woken && sleepers[2].woken, "Deleting a delayed task keeps its neighbours queued");
+    TEST_ASSERT(!sleepers[1].woken, "Deleted delayed task never wakes");
+    TEST_ASSERT(slept_last >= 60 && slept_last <= 62, "Later deadlines are unaffected by the deletion");
+}
+
+static void test_suspend_delayed_task(void) {
+    static const uint32_t delays[2] = { 20, 30 };
+
+    start_sleepers(delays, 2);
+    pico_rtos_task_delay(5);
+    pico_rtos_task_suspend(&order_tasks[0]);
+    pico_rtos_task_delay(40);
+
+    TEST_ASSERT(!sleepers[0].woken, "Suspended delayed task does not wake on its deadline");
+    TEST_ASSERT(sleepers[1].woken, "Other delayed tasks still wake while one is suspended");
+
+    pico_rtos_task_resume(&order_tasks[0]);
+    pico_rtos_task_delay(1);
+    TEST_ASSERT(sleepers[0].woken, "Resumed task runs again");
+}
+
+// Delay list entries the tick looks at over one window of steady ticking;
+// a count rather than a time, so host load cannot move it
+static void measure_tick_work(pico_rtos_tick_stats_t *stats) {
+    pico_rtos_reset_tick_stats();
+    busy_wait_ms(COST_WINDOW_MS);
+    pico_rtos_get_tick_stats(stats);
+}
+
+static void test_tick_cost_flat(void) {
+    pico_rtos_tick_stats_t empty;
+    pico_rtos_tick_stats_t loaded;
+
+    measure_tick_work(&empty);
+
+    for (uint32_t i = 0; i < BACKGROUND_TASKS; i++) {
+        pico_rtos_task_create(&background_tasks[i], "Background", background_task_function, NULL,
+                              TASK_STACK_SIZE, BACKGROUND_PRIORITY);
+    }
+    pico_rtos_task_delay(2);
+
+    measure_tick_work(&loaded);
+
+    for (uint32_t i = 0; i < BACKGROUND_TASKS; i++) {
+        pico_rtos_task_delete(&background_tasks[i]);
+    }
+
+    printf("Delay list visits: %lu over %lu ticks with no delayed tasks, %lu over %lu with %d\n",
+           (unsigned long)empty.delay_list_visits, (unsigned long)empty.sample_count,
+           (unsigned long)loaded.delay_list_visits, (unsigned long)loaded.sample_count, BACKGROUND_TASKS);
+
+    TEST_ASSERT(empty.sample_count > 0 && loaded.sample_count > 0, "Tick statistics are collected");
+    TEST_ASSERT(empty.delay_list_visits == 0, "Tick does not touch an empty delay list");
+
+    // Nothing expires during the window, so each tick only counts down the head
+    TEST_ASSERT(loaded.delay_list_visits <= loaded.sample_count,
+                "Tick cost stays flat as delayed tasks are added");
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_wake_order();
+    test_delete_delayed_task();
+    test_suspend_delayed_task();
+    test_tick_cost_flat();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Delay List Tests...\n");
+    printf("============================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,337 @@
+/**
+ * @file edf_scheduling_test.c
+ * @brief Tests for the earliest-deadline-first scheduling band
+ *
+ * Tasks given a deadline share the EDF priority band and run in order of
+ * their absolute deadlines. Checks the run order, that a job released with
+ * an earlier deadline preempts a running one with a later deadline, that a
+ * periodic task set above the rate-monotonic utilisation bound meets every
+ * deadline, that overrunning jobs are counted as misses, that
+ * fixed-priority tasks above and below the band keep their place, and that
+ * leaving the band restores the base priority without dropping a boost
+ * from priority inheritance.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY (PICO_RTOS_EDF_PRIORITY + 5)
+#define LOW_PRIORITY 2
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define ORDER_TASKS 3
+
+// Two periodic tasks at ~87% utilisation, above the 82.8% rate-monotonic
+// bound for two tasks but schedulable under EDF
+#define FAST_PERIOD 10
+#define FAST_WORK 3
+#define SLOW_PERIOD 14
+#define SLOW_WORK 8
+#define PERIODIC_WINDOW_MS 700
+
+#define OVERRUN_PERIOD 5
+#define OVERRUN_WORK 8
+#define OVERRUN_JOBS 5
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+typedef struct {
+    uint32_t relative_deadline;
+    uint32_t period;
+    uint32_t work_ticks;
+    volatile uint32_t jobs;
+    volatile uint32_t run_order;
+} edf_job_t;
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t edf_tasks[ORDER_TASKS];
+static pico_rtos_task_t low_task;
+static pico_rtos_task_t holder_task;
+static pico_rtos_task_t waiter_task;
+static pico_rtos_mutex_t band_mutex;
+static edf_job_t jobs[ORDER_TASKS];
+
+static volatile uint32_t order_counter = 0;
+static volatile bool periodic_running = false;
+static volatile uint32_t periodic_done = 0;
+static volatile uint32_t low_progress = 0;
+static volatile bool holder_locked = false;
+static volatile bool holder_release = false;
+
+// Consumes the given number of ticks of CPU time; ticks spent preempted
+// only count once, so the work really needs that much of the CPU
+static void consume_ticks(uint32_t ticks) {
+    uint32_t last = pico_rtos_get_tick_count();
+    uint32_t seen = 0;
+    while (seen < ticks) {
+        // Burns time on the simulated clock as well as the real one
+        busy_wait_us(10);
+        uint32_t now = pico_rtos_get_tick_count();
+        if (now != last) {
+            last = now;
+            seen++;
+        }
+    }
+}
+
+static void order_task_function(void *param) {
+    edf_job_t *job = (edf_job_t *)param;
+    pico_rtos_task_set_deadline(NULL, job->relative_deadline, 0);
+    // Wait until every task has its deadline before competing
+    pico_rtos_task_delay(5);
+    job->run_order = order_counter++;
+}
+
+static void periodic_task_function(void *param) {
+    edf_job_t *job = (edf_job_t *)param;
+    while (periodic_running) {
+        consume_ticks(job->work_ticks);
+        job->jobs++;
+        pico_rtos_task_wait_for_next_period();
+    }
+    periodic_done++;
+}
+
+static void low_task_function(void *param) {
+    (void)param;
+    while (periodic_running) {
+        low_progress++;
+        busy_wait_us(10);
+    }
+    periodic_done++;
+}
+
+static void holder_task_function(void *param) {
+    (void)param;
+    pico_rtos_mutex_lock(&band_mutex, PICO_RTOS_WAIT_FOREVER);
+    holder_locked = true;
+    while (!holder_release) {
+        pico_rtos_task_delay(1);
+    }
+    pico_rtos_mutex_unlock(&band_mutex);
+    // Stay alive so the controller can read the final priority
+    pico_rtos_task_suspend(NULL);
+}
+
+static void waiter_task_function(void *param) {
+    (void)param;
+    if (pico_rtos_mutex_lock(&band_mutex, PICO_RTOS_WAIT_FOREVER)) {
+        pico_rtos_mutex_unlock(&band_mutex);
+    }
+}
+
+// Creates a periodic EDF task whose first job is released now
+static void start_periodic(pico_rtos_task_t *task, edf_job_t *job, uint32_t period, uint32_t work) {
+    job->relative_deadline = period;
+    job->period = period;
+    job->work_ticks = work;
+    job->jobs = 0;
+    pico_rtos_task_create(task, "Periodic", periodic_task_function, job, TASK_STACK_SIZE, LOW_PRIORITY);
+    pico_rtos_task_set_deadline(task, period, period);
+}
+
+static void stop_periodic(uint32_t count) {
+    periodic_running = false;
+    while (periodic_done < count) {
+        pico_rtos_task_delay(1);
+    }
+}
+
+static void test_deadline_order(void) {
+    static const uint32_t deadlines[ORDER_TASKS] = { 300, 100, 200 };
+    static const uint32_t expected_order[ORDER_TASKS] = { 2, 0, 1 };
+
+    order_counter = 0;
+    for (uint32_t i = 0; i < ORDER_TASKS; i++) {
+        jobs[i].relative_deadline = deadlines[i];
+        pico_rtos_task_create(&edf_tasks[i], "Order", order_task_function, &jobs[i],
+                              TASK_STACK_SIZE, LOW_PRIORITY);
+    }
+
+    pico_rtos_task_delay(20);
+
+    bool order_ok = true;
+    for (uint32_t i = 0; i < ORDER_TASKS; i++) {
+        order_ok = order_ok && (jobs[i].run_order == expected_order[i]);
+    }
+
+    TEST_ASSERT(edf_tasks[0].priority == PICO_RTOS_EDF_PRIORITY, "Setting a deadline moves a task into the EDF band");
+    TEST_ASSERT(order_ok, "Ready EDF tasks run in deadline order");
+}
+
+static void test_earlier_deadline_preempts(void) {
+    periodic_running = true;
+    periodic_done = 0;
+
+    // A long job with a distant deadline, then a short periodic one that
+    // keeps releasing jobs with earlier deadlines while it runs
+    start_periodic(&edf_tasks[0], &jobs[0], 200, 60);
+    start_periodic(&edf_tasks[1], &jobs[1], FAST_PERIOD, 1);
+
+    pico_rtos_task_delay(50);
+    uint32_t fast_jobs = jobs[1].jobs;
+    bool long_job_running = (jobs[0].jobs == 0);
+
+    stop_periodic(2);
+
+    TEST_ASSERT(long_job_running && fast_jobs >= 3,
+                "A job with an earlier deadline preempts one with a later deadline");
+}
+
+static void test_high_utilisation(void) {
+    periodic_running = true;
+    periodic_done = 0;
+    low_progress = 0;
+
+    start_periodic(&edf_tasks[0], &jobs[0], FAST_PERIOD, FAST_WORK);
+    start_periodic(&edf_tasks[1], &jobs[1], SLOW_PERIOD, SLOW_WORK);
+
+    pico_rtos_task_delay(PERIODIC_WINDOW_MS);
+    stop_periodic(2);
+
+    uint32_t misses = pico_rtos_task_get_deadline_misses(&edf_tasks[0]) +
+                      pico_rtos_task_get_deadline_misses(&edf_tasks[1]);
+    printf("Periodic jobs: %lu fast, %lu slow, %lu deadline misses\n",
+           (unsigned long)jobs[0].jobs, (unsigned long)jobs[1].jobs, (unsigned long)misses);
+
+    TEST_ASSERT(jobs[0].jobs >= PERIODIC_WINDOW_MS / FAST_PERIOD - 2 &&
+                jobs[1].jobs >= PERIODIC_WINDOW_MS / SLOW_PERIOD - 2,
+                "Periodic EDF tasks complete a job every period");
+    TEST_ASSERT(misses == 0, "Task set above the rate-monotonic bound meets every deadline");
+}
+
+static void test_overrun_counts_misses(void) {
+    periodic_running = true;
+    periodic_done = 0;
+
+    start_periodic(&edf_tasks[0], &jobs[0], OVERRUN_PERIOD, OVERRUN_WORK);
+    while (jobs[0].jobs < OVERRUN_JOBS) {
+        pico_rtos_task_delay(1);
+    }
+    stop_periodic(1);
+
+    uint32_t misses = pico_rtos_task_get_deadline_misses(&edf_tasks[0]);
+    printf("Overrunning task: %lu jobs, %lu deadline misses\n",
+           (unsigned long)jobs[0].jobs, (unsigned long)misses);
+
+    TEST_ASSERT(misses >= OVERRUN_JOBS && misses <= jobs[0].jobs + 1,
+                "Each overrunning job is counted as one deadline miss");
+}
+
+static void test_fixed_priorities_around_band(void) {
+    periodic_running = true;
+    periodic_done = 0;
+    low_progress = 0;
+
+    pico_rtos_task_create(&low_task, "Low", low_task_function, NULL, TASK_STACK_SIZE, LOW_PRIORITY);
+    start_periodic(&edf_tasks[0], &jobs[0], 20, 30);
+
+    // The controller sits above the band and must still wake on time while
+    // the EDF task hogs the CPU, and the task below the band must starve
+    bool on_time = true;
+    uint32_t low_before = 0;
+    for (int i = 0; i < 10; i++) {
+        uint32_t start = pico_rtos_get_tick_count();
+        pico_rtos_task_delay(3);
+        uint32_t slept = pico_rtos_get_tick_count() - start;
+        on_time = on_time && (slept >= 3 && slept <= 4);
+        if (i == 0) {
+            low_before = low_progress;
+        }
+    }
+    bool low_starved = (low_progress == low_before);
+
+    stop_periodic(2);
+
+    TEST_ASSERT(on_time, "Fixed-priority tasks above the band preempt EDF tasks");
+    TEST_ASSERT(low_starved, "Fixed-priority tasks below the band wait for ready EDF tasks");
+}
+
+static void test_leave_band(void) {
+    // The controller itself enters the band and comes back out
+    pico_rtos_task_set_deadline(NULL, 1000, 0);
+    bool entered = (controller_task.priority == PICO_RTOS_EDF_PRIORITY);
+    bool left = pico_rtos_task_clear_deadline(NULL);
+    TEST_ASSERT(entered && left && controller_task.priority == CONTROLLER_PRIORITY &&
+                pico_rtos_task_get_deadline(NULL) == 0,
+                "Clearing the deadline restores the priority the task had before");
+    TEST_ASSERT(!pico_rtos_task_clear_deadline(NULL), "Clearing the deadline of a fixed-priority task fails");
+
+    // An EDF task holding a mutex that a task above the band waits for
+    pico_rtos_mutex_init(&band_mutex);
+    holder_locked = false;
+    holder_release = false;
+    pico_rtos_task_create(&holder_task, "Holder", holder_task_function, NULL, TASK_STACK_SIZE, LOW_PRIORITY);
+    while (!holder_locked) {
+        pico_rtos_task_delay(1);
+    }
+    pico_rtos_task_set_deadline(&holder_task, 1000, 0);
+    pico_rtos_task_create(&waiter_task, "Waiter", waiter_task_function, NULL, TASK_STACK_SIZE,
+                          CONTROLLER_PRIORITY - 1);
+    pico_rtos_task_delay(2);
+    bool boosted = (holder_task.priority == CONTROLLER_PRIORITY - 1);
+
+    pico_rtos_task_set_absolute_deadline(&holder_task, pico_rtos_get_tick_count() + 500);
+    bool kept_on_new_deadline = (holder_task.priority == CONTROLLER_PRIORITY - 1);
+    pico_rtos_task_clear_deadline(&holder_task);
+    bool kept_on_leaving = (holder_task.priority == CONTROLLER_PRIORITY - 1);
+
+    holder_release = true;
+    pico_rtos_task_delay(5);
+
+    TEST_ASSERT(boosted && kept_on_new_deadline,
+                "A new deadline keeps the boost inherited from a waiter above the band");
+    TEST_ASSERT(kept_on_leaving && holder_task.priority == LOW_PRIORITY,
+                "Leaving the band keeps the boost until the mutex is released");
+
+    pico_rtos_task_delete(&holder_task);
+    pico_rtos_mutex_delete(&band_mutex);
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_deadline_order();
+    test_earlier_deadline_preempts();
+    test_high_utilisation();
+    test_overrun_counts_misses();
+    test_fixed_priorities_around_band();
+    test_leave_band();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting EDF Scheduling Tests...\n");
+    printf("================================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,306 @@
+/**
+ * @file heap_test.c
+ * @brief Tests for the real-time TLSF heap
+ *
+ * pico_rtos_malloc() serves task stacks and kernel objects from a static
+ * region managed by a Two-Level Segregated Fit allocator. Checks alignment,
+ * that freed neighbours merge back into one block, fragmentation and
+ * largest-free-block reporting, exhaustion, per-size-class statistics,
+ * rejection of bad and double frees, and a long random workload with the
+ * heap's own consistency check, and that pico_rtos_get_memory_stats() still
+ * tracks pico_rtos_malloc().
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define CONTROLLER_STACK_SIZE 2048
+
+#define SPREAD_BLOCKS 32
+#define STRESS_SLOTS 64
+#define STRESS_OPERATIONS 20000
+#define STRESS_MAX_SIZE 600
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+
+static uint32_t random_state = 12345;
+
+static uint32_t next_random(void) {
+    random_state = random_state * 1103515245u + 12345u;
+    return random_state >> 8;
+}
+
+static void test_alignment(void) {
+    static const size_t sizes[] = { 1, 3, 8, 13, 64, 100, 127, 128, 129, 1000, 4095 };
+    void *blocks[sizeof(sizes) / sizeof(sizes[0])];
+    bool aligned = true;
+    bool large_enough = true;
+
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        blocks[i] = pico_rtos_heap_alloc(sizes[i]);
+        aligned = aligned && blocks[i] != NULL && ((uintptr_t)blocks[i] % PICO_RTOS_HEAP_ALIGNMENT) == 0;
+        large_enough = large_enough && pico_rtos_heap_block_size(blocks[i]) >= sizes[i];
+    }
+    for (size_t i = 0; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        pico_rtos_heap_free(blocks[i]);
+    }
+
+    TEST_ASSERT(aligned, "Blocks are aligned to PICO_RTOS_HEAP_ALIGNMENT");
+    TEST_ASSERT(large_enough, "Blocks are at least the size asked for");
+    TEST_ASSERT(pico_rtos_heap_alloc(0) == NULL, "A zero-byte allocation returns NULL");
+}
+
+static void test_coalescing(void) {
+    pico_rtos_heap_stats_t before, after;
+    pico_rtos_heap_get_stats(&before);
+
+    void *blocks[SPREAD_BLOCKS];
+    for (int i = 0; i < SPREAD_BLOCKS; i++) {
+        blocks[i] = pico_rtos_heap_alloc(16 + (i % 7) * 40);
+    }
+    // Free every other block first, then the rest, so every free after the
+    // first half has a free block on both sides
+    for (int i = 0; i < SPREAD_BLOCKS; i += 2) {
+        pico_rtos_heap_free(blocks[i]);
+    }
+    for (int i = 1; i < SPREAD_BLOCKS; i += 2) {
+        pico_rtos_heap_free(blocks[i]);
+    }
+
+    pico_rtos_heap_get_stats(&after);
+    TEST_ASSERT(after.free_blocks == before.free_blocks && after.largest_free_block == before.largest_free_block &&
+                after.free_bytes == before.free_bytes && after.used_bytes == before.used_bytes,
+                "Freed neighbours merge back into the blocks they were split from");
+    TEST_ASSERT(pico_rtos_heap_check(), "The heap is consistent after merging");
+}
+
+static void test_fragmentation(void) {
+    pico_rtos_heap_stats_t before, holes, after;
+    pico_rtos_heap_get_stats(&before);
+
+    // Fill the whole heap with 256-byte blocks so freed ones cannot merge
+    // with any free space beyond them
+    void *blocks[1024];
+    int count = 0;
+    while (count < 1024 && (blocks[count] = pico_rtos_heap_alloc(256)) != NULL) {
+        count++;
+    }
+    for (int i = 0; i < count; i += 2) {
+        pico_rtos_heap_free(blocks[i]);
+    }
+    pico_rtos_heap_get_stats(&holes);
+
+    for (int i = 1; i < count; i += 2) {
+        pico_rtos_heap_free(blocks[i]);
+    }
+    pico_rtos_heap_get_stats(&after);
+
+    printf("%d blocks of 256 bytes; with every other one free: %lu bytes free, largest %lu, %lu%% fragmented\n",
+           count, (unsigned long)holes.free_bytes, (unsigned long)holes.largest_free_block,
+           (unsigned long)holes.fragmentation_percent);
+
+    TEST_ASSERT(count > 8 && holes.largest_free_block < 512 && holes.free_bytes >= (uint32_t)(count / 2) * 256 &&
+                holes.fragmentation_percent >= 90,
+                "Scattered free blocks are reported as fragmentation");
+    TEST_ASSERT(after.fragmentation_percent == before.fragmentation_percent &&
+                after.largest_free_block == before.largest_free_block,
+                "Fragmentation goes away once the blocks merge again");
+}
+
+static void test_exhaustion(void) {
+    pico_rtos_heap_stats_t before, after;
+    pico_rtos_heap_get_stats(&before);
+
+    void *too_big = pico_rtos_heap_alloc(before.largest_free_block + 1);
+    void *too_big_for_any = pico_rtos_heap_alloc(PICO_RTOS_HEAP_SIZE + 1);
+    pico_rtos_heap_get_stats(&after);
+    TEST_ASSERT(too_big == NULL && too_big_for_any == NULL &&
+                after.failed_allocations == before.failed_allocations + 2,
+                "Allocations larger than any free block fail and are counted");
+
+    // The largest free block may sit in a list whose smallest size is below
+    // it; the search only trusts lists whose every block fits
+    int fl_shift = 31 - __builtin_clz(before.largest_free_block) - 4;
+    uint32_t guaranteed = before.largest_free_block & ~((1u << fl_shift) - 1);
+    void *largest = pico_rtos_heap_alloc(guaranteed);
+    TEST_ASSERT(largest != NULL, "The rounded-down largest free block can be allocated");
+    pico_rtos_heap_free(largest);
+}
+
+static void test_class_stats(void) {
+    pico_rtos_heap_class_stats_t before, during, after, out_of_range;
+
+    // 1000 bytes is in class 3, from 512 to 1023 bytes
+    pico_rtos_heap_get_class_stats(3, &before);
+    void *block = pico_rtos_heap_alloc(1000);
+    pico_rtos_heap_get_class_stats(3, &during);
+    pico_rtos_heap_free(block);
+    pico_rtos_heap_get_class_stats(3, &after);
+
+    TEST_ASSERT(during.min_size == 512 && during.max_size == 1023,
+                "Size classes span a power of two");
+    TEST_ASSERT(during.allocations == before.allocations + 1 && during.used_blocks == before.used_blocks + 1 &&
+                after.used_blocks == before.used_blocks && after.allocations == during.allocations,
+                "Allocations are counted in their size class");
+    TEST_ASSERT(!pico_rtos_heap_get_class_stats(PICO_RTOS_HEAP_CLASS_COUNT, &out_of_range),
+                "Size classes beyond the last are rejected");
+}
+
+static void test_bad_frees(void) {
+    static uint32_t not_heap[4];
+    pico_rtos_heap_stats_t before, after;
+    pico_rtos_error_info_t error;
+
+    uint32_t allocated_before, allocated_after, peak, allocations;
+
+    void *block = pico_rtos_heap_alloc(64);
+    TEST_ASSERT(pico_rtos_heap_free(block), "Valid frees succeed");
+    pico_rtos_heap_get_stats(&before);
+
+    bool double_rejected = !pico_rtos_heap_free(block);
+    bool double_reported = pico_rtos_get_last_error(&error) && error.code == PICO_RTOS_ERROR_MEMORY_DOUBLE_FREE;
+    bool invalid_rejected = !pico_rtos_heap_free(&not_heap[1]);
+    bool invalid_reported = pico_rtos_get_last_error(&error) && error.code == PICO_RTOS_ERROR_INVALID_POINTER;
+    pico_rtos_heap_get_stats(&after);
+
+    TEST_ASSERT(double_rejected && invalid_rejected, "Double frees and foreign pointers are rejected");
+    TEST_ASSERT(double_reported && invalid_reported, "Double frees and foreign pointers are reported");
+    TEST_ASSERT(after.frees == before.frees && after.free_bytes == before.free_bytes && pico_rtos_heap_check(),
+                "Bad frees leave the heap untouched");
+
+    // pico_rtos_free() must not uncount memory for a pointer the heap rejected
+    void *counted = pico_rtos_malloc(64);
+    pico_rtos_free(counted, 64);
+    pico_rtos_get_memory_stats(&allocated_before, &peak, &allocations);
+    pico_rtos_free(counted, 64);
+    pico_rtos_free(&not_heap[1], 64);
+    pico_rtos_get_memory_stats(&allocated_after, &peak, &allocations);
+    TEST_ASSERT(allocated_after == allocated_before, "Rejected frees leave the memory totals alone");
+}
+
+static void test_random_workload(void) {
+    void *slots[STRESS_SLOTS] = { 0 };
+    size_t sizes[STRESS_SLOTS] = { 0 };
+    pico_rtos_heap_stats_t before, after;
+    bool patterns_intact = true;
+    bool consistent = true;
+
+    pico_rtos_heap_get_stats(&before);
+    uint64_t start_us = time_us_64();
+
+    for (int op = 0; op < STRESS_OPERATIONS; op++) {
+        int slot = next_random() % STRESS_SLOTS;
+        if (slots[slot] != NULL) {
+            uint8_t *bytes = slots[slot];
+            for (size_t i = 0; i < sizes[slot]; i++) {
+                if (bytes[i] != (uint8_t)(slot + i)) {
+                    patterns_intact = false;
+                    break;
+                }
+            }
+            pico_rtos_heap_free(slots[slot]);
+            slots[slot] = NULL;
+        } else {
+            sizes[slot] = 1 + next_random() % STRESS_MAX_SIZE;
+            slots[slot] = pico_rtos_heap_alloc(sizes[slot]);
+            if (slots[slot] != NULL) {
+                uint8_t *bytes = slots[slot];
+                for (size_t i = 0; i < sizes[slot]; i++) {
+                    bytes[i] = (uint8_t)(slot + i);
+                }
+            }
+        }
+        if (op % 1000 == 0) {
+            consistent = consistent && pico_rtos_heap_check();
+        }
+    }
+
+    uint64_t elapsed_us = time_us_64() - start_us;
+    for (int slot = 0; slot < STRESS_SLOTS; slot++) {
+        pico_rtos_heap_free(slots[slot]);
+    }
+    pico_rtos_heap_get_stats(&after);
+
+    printf("%d random operations in %llu us, peak %lu of %lu bytes used\n", STRESS_OPERATIONS,
+           (unsigned long long)elapsed_us, (unsigned long)after.peak_used_bytes, (unsigned long)after.heap_size);
+
+    TEST_ASSERT(patterns_intact, "Blocks never overlap");
+    TEST_ASSERT(consistent && pico_rtos_heap_check(), "The heap stays consistent under a random workload");
+    TEST_ASSERT(after.used_bytes == before.used_bytes && after.largest_free_block == before.largest_free_block &&
+                after.free_blocks == before.free_blocks,
+                "A random workload leaves nothing behind once everything is freed");
+}
+
+static void test_memory_stats(void) {
+    uint32_t current_before, allocations_before, current_during, allocations_during, current_after;
+    pico_rtos_heap_stats_t heap_before, heap_during, heap_after;
+
+    pico_rtos_get_memory_stats(&current_before, NULL, &allocations_before);
+    pico_rtos_heap_get_stats(&heap_before);
+    void *block = pico_rtos_malloc(300);
+    pico_rtos_get_memory_stats(&current_during, NULL, &allocations_during);
+    pico_rtos_heap_get_stats(&heap_during);
+    pico_rtos_free(block, 300);
+    pico_rtos_get_memory_stats(&current_after, NULL, NULL);
+    pico_rtos_heap_get_stats(&heap_after);
+
+    TEST_ASSERT(current_during == current_before + 300 && allocations_during == allocations_before + 1 &&
+                current_after == current_before,
+                "pico_rtos_get_memory_stats() still tracks pico_rtos_malloc()");
+    TEST_ASSERT(heap_during.used_blocks == heap_before.used_blocks + 1 &&
+                heap_after.used_bytes == heap_before.used_bytes,
+                "pico_rtos_malloc() allocates from the real-time heap");
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_alignment();
+    test_coalescing();
+    test_fragmentation();
+    test_exhaustion();
+    test_class_stats();
+    test_bad_frees();
+    test_random_workload();
+    test_memory_stats();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Heap Tests...\n");
+    printf("======================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
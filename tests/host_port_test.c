@@ -0,0 +1,146 @@
+/**
+ * @file host_port_test.c
+ * @brief Tests for the Linux host simulator port
+ *
+ * Verifies the pieces the host port has to emulate for the kernel to behave
+ * as on target: a free-running tick, preemption of a task that never
+ * yields, delays, critical sections that actually hold off the tick,
+ * semaphore hand-off between tasks and pico_rtos_start() returning once all
+ * application tasks are done.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 3
+#define CONSUMER_PRIORITY 2
+#define SPINNER_PRIORITY 1
+#define TASK_STACK_SIZE 1024
+
+#define SEMAPHORE_ROUNDS 50
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t consumer_task;
+static pico_rtos_task_t spinner_task;
+static pico_rtos_semaphore_t handoff_semaphore;
+
+static volatile bool spinner_running = true;
+static volatile uint32_t spinner_iterations = 0;
+static volatile uint32_t consumer_received = 0;
+
+// Never blocks or yields; other tasks only run if the tick preempts it
+static void spinner_task_function(void *param) {
+    (void)param;
+    while (spinner_running) {
+        spinner_iterations++;
+    }
+}
+
+static void consumer_task_function(void *param) {
+    (void)param;
+    for (int i = 0; i < SEMAPHORE_ROUNDS; i++) {
+        if (pico_rtos_semaphore_take(&handoff_semaphore, PICO_RTOS_WAIT_FOREVER)) {
+            consumer_received++;
+        }
+    }
+}
+
+static void test_tick_advances(void) {
+    uint32_t start_tick = pico_rtos_get_tick_count();
+    busy_wait_ms(50);
+    uint32_t elapsed = pico_rtos_get_tick_count() - start_tick;
+    TEST_ASSERT(elapsed > 0, "Tick advances while a task is busy");
+}
+
+static void test_delay_preempts_spinner(void) {
+    uint32_t spins_before = spinner_iterations;
+    uint64_t start_us = time_us_64();
+    pico_rtos_task_delay(50);
+    uint64_t elapsed_us = time_us_64() - start_us;
+
+    TEST_ASSERT(spinner_iterations != spins_before, "Lower priority task runs while controller is delayed");
+    TEST_ASSERT(elapsed_us >= 45000, "Delay lasts at least the requested time");
+    TEST_ASSERT(elapsed_us < 2000000, "Delayed task preempts a spinning task on wakeup");
+}
+
+static void test_critical_section_masks_tick(void) {
+    pico_rtos_enter_critical();
+    uint32_t tick_before = pico_rtos_get_tick_count();
+    busy_wait_ms(20);
+    uint32_t tick_inside = pico_rtos_get_tick_count();
+    pico_rtos_exit_critical();
+    busy_wait_ms(20);
+    uint32_t tick_after = pico_rtos_get_tick_count();
+
+    TEST_ASSERT(tick_inside == tick_before, "Tick is held off inside a critical section");
+    TEST_ASSERT(tick_after != tick_inside, "Held-off tick is delivered after the critical section");
+}
+
+static void test_semaphore_handoff(void) {
+    for (int i = 0; i < SEMAPHORE_ROUNDS; i++) {
+        pico_rtos_semaphore_give(&handoff_semaphore);
+        pico_rtos_task_delay(1);
+    }
+    pico_rtos_task_delay(10);
+    TEST_ASSERT(consumer_received == SEMAPHORE_ROUNDS, "Every semaphore give reaches the blocked consumer");
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_tick_advances();
+    test_delay_preempts_spinner();
+    test_critical_section_masks_tick();
+    test_semaphore_handoff();
+
+    // Let the spinner finish so the scheduler can return
+    spinner_running = false;
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Host Port Tests...\n");
+    printf("===========================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_semaphore_init(&handoff_semaphore, 0, 1);
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          TASK_STACK_SIZE, CONTROLLER_PRIORITY);
+    pico_rtos_task_create(&consumer_task, "Consumer", consumer_task_function, NULL,
+                          TASK_STACK_SIZE, CONSUMER_PRIORITY);
+    pico_rtos_task_create(&spinner_task, "Spinner", spinner_task_function, NULL,
+                          TASK_STACK_SIZE, SPINNER_PRIORITY);
+
+    pico_rtos_start();
+
+    // Reaching this point is itself the scheduler-return test
+    TEST_ASSERT(true, "pico_rtos_start() returns once all tasks have finished");
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
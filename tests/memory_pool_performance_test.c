@@ -184,10 +184,6 @@ static void test_allocation_performance(void) {
     print_performance_stats("Allocation", "large", &large_stats);
     
     // Verify O(1) characteristics - allocation time should not significantly increase with pool size
-    // Allow for some variance due to measurement noise and cache effects
-    double size_factor_medium = (double)MEDIUM_POOL_SIZE / SMALL_POOL_SIZE;
-    double size_factor_large = (double)LARGE_POOL_SIZE / SMALL_POOL_SIZE;
-    
     // Performance should not scale linearly with pool size for O(1) operations
     // We allow up to 2x variance to account for cache effects and measurement noise
     TEST_ASSERT_PERFORMANCE(medium_stats.avg_cycles < small_stats.avg_cycles * 2.0,
@@ -0,0 +1,301 @@
+/**
+ * @file mpmc_ring_test.c
+ * @brief Tests for the multi-producer/multi-consumer ring
+ *
+ * Checks the ring's size rules, that it fills to capacity and drains in
+ * order, and that its statistics count what happened. Then many producer
+ * and consumer threads push and pop at once, and every item must arrive
+ * exactly once, in order per producer as each consumer sees it. Finally
+ * tasks block in push and pop, are woken by the other side or by an
+ * interrupt, time out, and fail when the ring is deleted under them.
+ *
+ * Host only: the threads run beside the scheduler, before it starts, and
+ * use only the try calls, which make no kernel call while no task waits.
+ */
+
+#include <stdio.h>
+#include <pthread.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define WORKER_PRIORITY 6
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define RING_CAPACITY 16
+#define THREAD_RING_CAPACITY 64
+#define PRODUCER_THREADS 6
+#define CONSUMER_THREADS 4
+#define ITEMS_PER_PRODUCER 20000
+#define ISR_ALARM_MS 3
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t worker_tasks[4];
+
+static pico_rtos_mpmc_ring_t ring;
+static uint32_t ring_buffer[PICO_RTOS_MPMC_RING_BUFFER_WORDS(sizeof(uint32_t), RING_CAPACITY)];
+static uint32_t thread_ring_buffer[PICO_RTOS_MPMC_RING_BUFFER_WORDS(sizeof(uint32_t), THREAD_RING_CAPACITY)];
+
+// Items are the producer number in the top byte over a sequence number
+static uint8_t delivered[PRODUCER_THREADS][ITEMS_PER_PRODUCER];
+static volatile uint32_t items_popped = 0;
+static volatile bool consumers_in_order = true;
+
+static volatile bool worker_done = false;
+static volatile bool worker_result = false;
+static volatile uint32_t worker_item = 0;
+static volatile bool isr_switched = false;
+
+static void *producer_thread(void *param) {
+    uint32_t producer = (uint32_t)(uintptr_t)param;
+    for (uint32_t seq = 0; seq < ITEMS_PER_PRODUCER; seq++) {
+        uint32_t item = (producer << 24) | seq;
+        while (!pico_rtos_mpmc_ring_try_push(&ring, &item)) {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void *consumer_thread(void *param) {
+    (void)param;
+    int32_t last_seq[PRODUCER_THREADS];
+    for (int i = 0; i < PRODUCER_THREADS; i++) {
+        last_seq[i] = -1;
+    }
+
+    while (__atomic_load_n(&items_popped, __ATOMIC_RELAXED) < PRODUCER_THREADS * ITEMS_PER_PRODUCER) {
+        uint32_t item;
+        if (!pico_rtos_mpmc_ring_try_pop(&ring, &item)) {
+            sched_yield();
+            continue;
+        }
+
+        uint32_t producer = item >> 24;
+        int32_t seq = (int32_t)(item & 0xFFFFFF);
+        if (producer >= PRODUCER_THREADS || seq >= ITEMS_PER_PRODUCER || seq <= last_seq[producer]) {
+            consumers_in_order = false;
+        } else {
+            last_seq[producer] = seq;
+            __atomic_fetch_add(&delivered[producer][seq], 1, __ATOMIC_RELAXED);
+        }
+        __atomic_fetch_add(&items_popped, 1, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+static void test_rules_and_order(void) {
+    TEST_ASSERT(!pico_rtos_mpmc_ring_init(&ring, ring_buffer, sizeof(uint32_t), 12) &&
+                !pico_rtos_mpmc_ring_init(&ring, ring_buffer, sizeof(uint32_t), 1) &&
+                !pico_rtos_mpmc_ring_init(&ring, ring_buffer, 0, RING_CAPACITY),
+                "A capacity that is not a power of two of at least 2 is refused");
+
+    pico_rtos_mpmc_ring_init(&ring, ring_buffer, sizeof(uint32_t), RING_CAPACITY);
+
+    uint32_t item = 0;
+    bool filled = true;
+    for (uint32_t i = 0; i < RING_CAPACITY; i++) {
+        filled = filled && pico_rtos_mpmc_ring_try_push(&ring, &i);
+    }
+    TEST_ASSERT(filled && pico_rtos_mpmc_ring_get_count(&ring) == RING_CAPACITY &&
+                !pico_rtos_mpmc_ring_try_push(&ring, &item),
+                "A ring holds exactly its capacity");
+
+    // Drain half, refill across the end of the buffer, drain the rest
+    bool in_order = true;
+    for (uint32_t i = 0; i < RING_CAPACITY / 2; i++) {
+        in_order = in_order && pico_rtos_mpmc_ring_try_pop(&ring, &item) && item == i;
+    }
+    for (uint32_t i = RING_CAPACITY; i < RING_CAPACITY + RING_CAPACITY / 2; i++) {
+        in_order = in_order && pico_rtos_mpmc_ring_try_push(&ring, &i);
+    }
+    for (uint32_t i = RING_CAPACITY / 2; i < RING_CAPACITY + RING_CAPACITY / 2; i++) {
+        in_order = in_order && pico_rtos_mpmc_ring_try_pop(&ring, &item) && item == i;
+    }
+    TEST_ASSERT(in_order && !pico_rtos_mpmc_ring_try_pop(&ring, &item) && pico_rtos_mpmc_ring_get_count(&ring) == 0,
+                "Items come out in the order they went in, across laps");
+
+    pico_rtos_mpmc_ring_stats_t stats;
+    pico_rtos_mpmc_ring_get_stats(&ring, &stats);
+    TEST_ASSERT(stats.pushes == RING_CAPACITY + RING_CAPACITY / 2 && stats.pops == stats.pushes &&
+                stats.push_full == 1 && stats.pop_empty == 1 && stats.push_retries == 0 && stats.pop_retries == 0,
+                "Statistics count pushes, pops and full and empty attempts");
+
+    pico_rtos_mpmc_ring_reset_stats(&ring);
+    pico_rtos_mpmc_ring_get_stats(&ring, &stats);
+    TEST_ASSERT(stats.pushes == 0 && stats.pops == 0 && stats.push_full == 0 && stats.pop_empty == 0,
+                "Resetting the statistics starts the counts again");
+
+    pico_rtos_mpmc_ring_delete(&ring);
+}
+
+static void test_threads(void) {
+    pico_rtos_mpmc_ring_init(&ring, thread_ring_buffer, sizeof(uint32_t), THREAD_RING_CAPACITY);
+
+    pthread_t producers[PRODUCER_THREADS];
+    pthread_t consumers[CONSUMER_THREADS];
+    for (uint32_t i = 0; i < CONSUMER_THREADS; i++) {
+        pthread_create(&consumers[i], NULL, consumer_thread, NULL);
+    }
+    for (uint32_t i = 0; i < PRODUCER_THREADS; i++) {
+        pthread_create(&producers[i], NULL, producer_thread, (void *)(uintptr_t)i);
+    }
+    for (uint32_t i = 0; i < PRODUCER_THREADS; i++) {
+        pthread_join(producers[i], NULL);
+    }
+    for (uint32_t i = 0; i < CONSUMER_THREADS; i++) {
+        pthread_join(consumers[i], NULL);
+    }
+
+    bool exactly_once = true;
+    for (uint32_t p = 0; p < PRODUCER_THREADS; p++) {
+        for (uint32_t seq = 0; seq < ITEMS_PER_PRODUCER; seq++) {
+            exactly_once = exactly_once && delivered[p][seq] == 1;
+        }
+    }
+
+    pico_rtos_mpmc_ring_stats_t stats;
+    pico_rtos_mpmc_ring_get_stats(&ring, &stats);
+    printf("%d producers, %d consumers: %lu pushes, %lu pops, %lu push retries, %lu pop retries, "
+           "%lu full, %lu empty\n", PRODUCER_THREADS, CONSUMER_THREADS,
+           (unsigned long)stats.pushes, (unsigned long)stats.pops,
+           (unsigned long)stats.push_retries, (unsigned long)stats.pop_retries,
+           (unsigned long)stats.push_full, (unsigned long)stats.pop_empty);
+
+    TEST_ASSERT(exactly_once && items_popped == PRODUCER_THREADS * ITEMS_PER_PRODUCER,
+                "Every item from many producer threads is popped exactly once");
+    TEST_ASSERT(consumers_in_order, "Each consumer thread sees every producer's items in order");
+    TEST_ASSERT(stats.pushes == PRODUCER_THREADS * ITEMS_PER_PRODUCER && stats.pops == stats.pushes &&
+                pico_rtos_mpmc_ring_get_count(&ring) == 0,
+                "Statistics account for every push and pop under contention");
+
+    pico_rtos_mpmc_ring_delete(&ring);
+}
+
+static void pop_task_function(void *param) {
+    uint32_t timeout = (uint32_t)(uintptr_t)param;
+    uint32_t item = 0;
+    worker_result = pico_rtos_mpmc_ring_pop(&ring, &item, timeout);
+    worker_item = item;
+    worker_done = true;
+}
+
+static void push_task_function(void *param) {
+    (void)param;
+    uint32_t item = 99;
+    worker_result = pico_rtos_mpmc_ring_push(&ring, &item, PICO_RTOS_WAIT_FOREVER);
+    worker_done = true;
+}
+
+static void start_worker(pico_rtos_task_t *task, pico_rtos_task_function_t function, uint32_t timeout) {
+    worker_done = false;
+    worker_result = false;
+    worker_item = 0;
+    pico_rtos_task_create(task, "Worker", function, (void *)(uintptr_t)timeout, TASK_STACK_SIZE, WORKER_PRIORITY);
+    pico_rtos_task_delay(2);
+}
+
+static int64_t push_alarm_callback(alarm_id_t id, void *user_data) {
+    (void)id;
+    (void)user_data;
+    pico_rtos_interrupt_enter();
+    pico_rtos_task_t *interrupted = pico_rtos_get_current_task();
+    uint32_t item = 7;
+    pico_rtos_mpmc_ring_try_push(&ring, &item);
+    isr_switched = (pico_rtos_get_current_task() != interrupted);
+    pico_rtos_interrupt_exit();
+    return 0;
+}
+
+static void test_blocking(void) {
+    pico_rtos_mpmc_ring_init(&ring, ring_buffer, sizeof(uint32_t), RING_CAPACITY);
+
+    // A consumer waiting on an empty ring is handed the next push
+    start_worker(&worker_tasks[0], pop_task_function, PICO_RTOS_WAIT_FOREVER);
+    bool waited = !worker_done;
+    uint32_t item = 42;
+    pico_rtos_mpmc_ring_try_push(&ring, &item);
+    pico_rtos_task_delay(2);
+    TEST_ASSERT(waited && worker_done && worker_result && worker_item == 42,
+                "A push wakes a task waiting to pop");
+
+    // A producer waiting on a full ring gets in once a slot is popped
+    for (uint32_t i = 0; i < RING_CAPACITY; i++) {
+        pico_rtos_mpmc_ring_try_push(&ring, &i);
+    }
+    start_worker(&worker_tasks[1], push_task_function, 0);
+    waited = !worker_done;
+    pico_rtos_mpmc_ring_pop(&ring, &item, 0);
+    pico_rtos_task_delay(2);
+    bool drained = true;
+    for (uint32_t i = 1; i < RING_CAPACITY; i++) {
+        drained = drained && pico_rtos_mpmc_ring_pop(&ring, &item, 0) && item == i;
+    }
+    TEST_ASSERT(waited && worker_done && worker_result && drained &&
+                pico_rtos_mpmc_ring_pop(&ring, &item, 0) && item == 99,
+                "A pop wakes a task waiting to push");
+
+    TEST_ASSERT(!pico_rtos_mpmc_ring_pop(&ring, &item, 3), "A pop from an empty ring times out");
+
+    // A push from an interrupt wakes the consumer once the interrupt returns
+    start_worker(&worker_tasks[3], pop_task_function, PICO_RTOS_WAIT_FOREVER);
+    isr_switched = true;
+    add_alarm_in_ms(ISR_ALARM_MS, push_alarm_callback, NULL, true);
+    pico_rtos_task_delay(ISR_ALARM_MS * 4);
+    TEST_ASSERT(worker_done && worker_result && worker_item == 7,
+                "A push from an interrupt wakes a task waiting to pop");
+    TEST_ASSERT(!isr_switched, "The interrupted task stays current until the interrupt returns");
+
+    // Deleting the ring fails a waiting pop
+    start_worker(&worker_tasks[2], pop_task_function, PICO_RTOS_WAIT_FOREVER);
+    pico_rtos_mpmc_ring_delete(&ring);
+    pico_rtos_task_delay(2);
+    TEST_ASSERT(worker_done && !worker_result, "Deleting a ring fails a waiting pop");
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_blocking();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting MPMC Ring Tests...\n");
+    printf("===========================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    test_rules_and_order();
+    test_threads();
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -76,6 +76,8 @@ static inline bool pico_rtos_profiler_get_stats(pico_rtos_profiler_stats_t *stat
 #define MEMORY_ALLOC_TEST_BLOCKS 100
 #define REAL_TIME_TEST_DURATION_MS 5000
 #define PERFORMANCE_TASK_STACK_SIZE 512
+#define PERFORMANCE_RUNNER_STACK_SIZE 4096
+#define PERFORMANCE_RUNNER_PRIORITY 10
 
 // Performance thresholds (in microseconds)
 #define MAX_CONTEXT_SWITCH_TIME_US 50
@@ -112,7 +114,6 @@ static performance_metrics_t context_switch_metrics;
 static performance_metrics_t memory_alloc_metrics;
 static performance_metrics_t event_operation_metrics;
 static performance_metrics_t stream_operation_metrics;
-static performance_metrics_t interrupt_latency_metrics;
 
 // Test helper macro
 #define TEST_ASSERT(condition, message) \
@@ -156,12 +157,12 @@ static void update_performance_metrics(performance_metrics_t *metrics, uint32_t
 
 static void print_performance_metrics(const char *test_name, const performance_metrics_t *metrics) {
     printf("\n%s Performance Metrics:\n", test_name);
-    printf("  Samples: %lu\n", metrics->sample_count);
-    printf("  Min: %lu μs\n", metrics->min_time_us);
-    printf("  Max: %lu μs\n", metrics->max_time_us);
-    printf("  Avg: %lu μs\n", metrics->avg_time_us);
-    printf("  Threshold: %lu μs\n", metrics->threshold_us);
-    printf("  Violations: %lu (%.1f%%)\n", metrics->violations,
+    printf("  Samples: %lu\n", (unsigned long)metrics->sample_count);
+    printf("  Min: %lu μs\n", (unsigned long)metrics->min_time_us);
+    printf("  Max: %lu μs\n", (unsigned long)metrics->max_time_us);
+    printf("  Avg: %lu μs\n", (unsigned long)metrics->avg_time_us);
+    printf("  Threshold: %lu μs\n", (unsigned long)metrics->threshold_us);
+    printf("  Violations: %lu (%.1f%%)\n", (unsigned long)metrics->violations,
            metrics->sample_count > 0 ? (100.0 * metrics->violations / metrics->sample_count) : 0.0);
 }
 
@@ -191,8 +192,8 @@ static void context_switch_test_task(void *param) {
         data->ready_to_switch = true;
         data->start_time_us = get_time_us();
         
-        // Yield to trigger context switch
-        pico_rtos_task_delay(1);
+        // Yield to trigger context switch (a delay would time the tick, not the switch)
+        pico_rtos_task_yield();
         
         data->end_time_us = get_time_us();
         data->switch_count++;
@@ -210,7 +211,7 @@ static void test_context_switch_performance(void) {
     init_performance_metrics(&context_switch_metrics, MAX_CONTEXT_SWITCH_TIME_US);
     
     // Create context switch test tasks
-    pico_rtos_task_t cs_tasks[CONTEXT_SWITCH_TEST_TASKS];
+    static pico_rtos_task_t cs_tasks[CONTEXT_SWITCH_TEST_TASKS];
     uint32_t cs_stacks[CONTEXT_SWITCH_TEST_TASKS][PERFORMANCE_TASK_STACK_SIZE / sizeof(uint32_t)];
     
     // Initialize task data
@@ -262,7 +263,7 @@ static void test_context_switch_performance(void) {
             for (int i = 0; i < CONTEXT_SWITCH_TEST_TASKS; i++) {
                 total_switches += cs_task_data[i].switch_count;
             }
-            printf("Context switches completed: %lu/%d\n", total_switches, PERF_TEST_ITERATIONS);
+            printf("Context switches completed: %lu/%d\n", (unsigned long)total_switches, PERF_TEST_ITERATIONS);
             last_check = current_time;
         }
         
@@ -503,7 +504,7 @@ static void test_real_time_compliance(void) {
     
     // Create real-time test tasks
     const int num_rt_tasks = 4;
-    pico_rtos_task_t rt_tasks[num_rt_tasks];
+    static pico_rtos_task_t rt_tasks[4];
     uint32_t rt_stacks[num_rt_tasks][PERFORMANCE_TASK_STACK_SIZE / sizeof(uint32_t)];
     
     for (int i = 0; i < num_rt_tasks; i++) {
@@ -534,7 +535,7 @@ static void test_real_time_compliance(void) {
     
     for (int i = 0; i < rt_result_count && i < 20; i++) { // Show first 20 results
         printf("%4d | %12lu | %10lu | %s\n",
-               i, rt_results[i].deadline_us, rt_results[i].actual_time_us,
+               i, (unsigned long)rt_results[i].deadline_us, (unsigned long)rt_results[i].actual_time_us,
                rt_results[i].deadline_met ? "Yes" : "No");
         
         if (rt_results[i].deadline_met) {
@@ -555,7 +556,7 @@ static void test_real_time_compliance(void) {
     
     float compliance_rate = total_tests > 0 ? (100.0 * deadlines_met / total_tests) : 0.0;
     printf("\nReal-Time Compliance: %lu/%lu (%.1f%%)\n", 
-           deadlines_met, total_tests, compliance_rate);
+           (unsigned long)deadlines_met, (unsigned long)total_tests, compliance_rate);
     
     // Validate real-time compliance
     TEST_ASSERT(total_tests > 0, "Should have real-time test results");
@@ -592,13 +593,13 @@ static void analyze_performance_regression(void) {
     printf("Operation          | Baseline | Current | Regression\n");
     printf("-------------------|----------|---------|------------\n");
     printf("Context Switch     | %7lu  | %6lu  | %+6.1f%%\n", 
-           baseline_context_switch_us, context_switch_metrics.avg_time_us, cs_regression);
+           (unsigned long)baseline_context_switch_us, (unsigned long)context_switch_metrics.avg_time_us, cs_regression);
     printf("Memory Allocation  | %7lu  | %6lu  | %+6.1f%%\n", 
-           baseline_memory_alloc_us, memory_alloc_metrics.avg_time_us, mem_regression);
+           (unsigned long)baseline_memory_alloc_us, (unsigned long)memory_alloc_metrics.avg_time_us, mem_regression);
     printf("Event Operations   | %7lu  | %6lu  | %+6.1f%%\n", 
-           baseline_event_op_us, event_operation_metrics.avg_time_us, event_regression);
+           (unsigned long)baseline_event_op_us, (unsigned long)event_operation_metrics.avg_time_us, event_regression);
     printf("Stream Operations  | %7lu  | %6lu  | %+6.1f%%\n", 
-           baseline_stream_op_us, stream_operation_metrics.avg_time_us, stream_regression);
+           (unsigned long)baseline_stream_op_us, (unsigned long)stream_operation_metrics.avg_time_us, stream_regression);
     
     // Validate acceptable regression levels (< 20% increase)
     TEST_ASSERT(cs_regression < 20.0, "Context switch regression should be less than 20%");
@@ -653,6 +654,11 @@ static void run_performance_regression_tests(void) {
     }
 }
 
+static void regression_runner_task(void *param) {
+    (void)param;
+    run_performance_regression_tests();
+}
+
 // =============================================================================
 // MAIN FUNCTION
 // =============================================================================
@@ -668,7 +674,15 @@ int main() {
         return -1;
     }
     
-    run_performance_regression_tests();
+    // The suite creates and measures tasks, so it has to run under the scheduler
+    static pico_rtos_task_t runner_task;
+    if (!pico_rtos_task_create(&runner_task, "regression_runner", regression_runner_task,
+                               NULL, PERFORMANCE_RUNNER_STACK_SIZE, PERFORMANCE_RUNNER_PRIORITY)) {
+        printf("ERROR: Failed to create test runner task\n");
+        return -1;
+    }
+    
+    pico_rtos_start();
     
     return (test_failures == 0) ? 0 : 1;
 }
\ No newline at end of file
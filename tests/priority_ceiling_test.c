@@ -0,0 +1,237 @@
+/**
+ * @file priority_ceiling_test.c
+ * @brief Tests for priority-ceiling mutexes
+ *
+ * A ceiling mutex raises its owner to the ceiling priority as soon as it
+ * is acquired and restores the owner's previous priority on release.
+ * Checks the raise and restore, nesting, that a medium-priority task cannot
+ * preempt the owner, that a high-priority locker finds the mutex free
+ * instead of blocking on it and is switched in less often than with
+ * priority inheritance, and that lockers above the ceiling and invalid
+ * ceilings are refused.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 8
+#define HIGH_PRIORITY 6
+#define MEDIUM_PRIORITY 4
+#define LOW_PRIORITY 2
+#define CEILING HIGH_PRIORITY
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define HOLD_TICKS 3
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t low_task;
+static pico_rtos_task_t medium_task;
+static pico_rtos_task_t high_task;
+
+static pico_rtos_mutex_t mutex;
+static pico_rtos_mutex_t inner_mutex;
+static pico_rtos_block_object_t mutex_wait;
+
+// Order in which the low task released the mutex and the medium task ran
+static char order[4];
+static volatile uint32_t order_length = 0;
+
+static volatile uint32_t priority_held = 0;
+static volatile uint32_t priority_nested = 0;
+static volatile uint32_t priority_inner_released = 0;
+static volatile uint32_t priority_released = 0;
+
+static volatile bool high_found_free = false;
+static volatile bool high_locked = false;
+static volatile uint32_t high_switches = 0;
+
+static void record(char event) {
+    pico_rtos_enter_critical();
+    if (order_length < sizeof(order) - 1) {
+        order[order_length++] = event;
+        order[order_length] = '\0';
+    }
+    pico_rtos_exit_critical();
+}
+
+static void reset_order(void) {
+    order_length = 0;
+    order[0] = '\0';
+}
+
+static void raise_restore_task_function(void *param) {
+    (void)param;
+    pico_rtos_mutex_lock(&mutex, PICO_RTOS_WAIT_FOREVER);
+    priority_held = low_task.priority;
+    pico_rtos_mutex_lock(&inner_mutex, PICO_RTOS_WAIT_FOREVER);
+    priority_nested = low_task.priority;
+    pico_rtos_mutex_unlock(&inner_mutex);
+    priority_inner_released = low_task.priority;
+    pico_rtos_mutex_unlock(&mutex);
+    priority_released = low_task.priority;
+}
+
+// Holds the mutex for a few ticks without giving up the CPU
+static void holder_task_function(void *param) {
+    (void)param;
+    pico_rtos_mutex_lock(&mutex, PICO_RTOS_WAIT_FOREVER);
+    busy_wait_us(HOLD_TICKS * PICO_RTOS_TICK_PERIOD_US);
+    record('U');
+    pico_rtos_mutex_unlock(&mutex);
+}
+
+static void medium_task_function(void *param) {
+    (void)param;
+    pico_rtos_task_delay(1);
+    record('M');
+}
+
+static void high_task_function(void *param) {
+    (void)param;
+    pico_rtos_task_delay(1);
+    high_found_free = (pico_rtos_mutex_get_owner(&mutex) == NULL);
+    high_locked = pico_rtos_mutex_lock(&mutex, 100);
+    pico_rtos_mutex_unlock(&mutex);
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+    high_switches = high_task.context_switch_count;
+#endif
+}
+
+static void test_raise_and_restore(void) {
+    bool ok = pico_rtos_mutex_init_ceiling(&mutex, CEILING) &&
+              pico_rtos_mutex_init_ceiling(&inner_mutex, CEILING + 1);
+
+    pico_rtos_task_create(&low_task, "Low", raise_restore_task_function, NULL, TASK_STACK_SIZE, LOW_PRIORITY);
+    pico_rtos_task_delay(2);
+
+    TEST_ASSERT(ok && priority_held == CEILING, "Acquiring a ceiling mutex raises the owner to the ceiling");
+    TEST_ASSERT(priority_nested == CEILING + 1 && priority_inner_released == CEILING,
+                "Nested ceiling mutexes restore priorities in reverse order");
+    TEST_ASSERT(priority_released == LOW_PRIORITY, "Releasing a ceiling mutex restores the owner's priority");
+
+    pico_rtos_mutex_delete(&inner_mutex);
+    pico_rtos_mutex_delete(&mutex);
+}
+
+static void test_medium_cannot_preempt(void) {
+    pico_rtos_mutex_init_ceiling(&mutex, CEILING);
+
+    // The medium task wakes while the low task holds the mutex
+    reset_order();
+    pico_rtos_task_create(&medium_task, "Medium", medium_task_function, NULL, TASK_STACK_SIZE, MEDIUM_PRIORITY);
+    pico_rtos_task_create(&low_task, "Low", holder_task_function, NULL, TASK_STACK_SIZE, LOW_PRIORITY);
+    pico_rtos_task_delay(HOLD_TICKS + 4);
+    TEST_ASSERT(order_length == 2 && order[0] == 'U' && order[1] == 'M',
+                "A medium-priority task waits until the ceiling mutex is released");
+    pico_rtos_mutex_delete(&mutex);
+
+    // With priority inheritance nothing raises the low task, so it is preempted
+    pico_rtos_mutex_init(&mutex);
+    reset_order();
+    pico_rtos_task_create(&medium_task, "Medium", medium_task_function, NULL, TASK_STACK_SIZE, MEDIUM_PRIORITY);
+    pico_rtos_task_create(&low_task, "Low", holder_task_function, NULL, TASK_STACK_SIZE, LOW_PRIORITY);
+    pico_rtos_task_delay(HOLD_TICKS + 4);
+    TEST_ASSERT(order_length == 2 && order[0] == 'M' && order[1] == 'U',
+                "Without a ceiling the medium task preempts the owner");
+    pico_rtos_mutex_delete(&mutex);
+}
+
+// Run the high task against a low task holding the mutex; returns how
+// often the high task was switched in
+static uint32_t run_contention(void) {
+    high_found_free = false;
+    high_locked = false;
+    high_switches = 0;
+    pico_rtos_task_create(&high_task, "High", high_task_function, NULL, TASK_STACK_SIZE, HIGH_PRIORITY);
+    pico_rtos_task_create(&low_task, "Low", holder_task_function, NULL, TASK_STACK_SIZE, LOW_PRIORITY);
+    pico_rtos_task_delay(HOLD_TICKS + 4);
+    return high_switches;
+}
+
+static void test_no_blocking_under_ceiling(void) {
+    pico_rtos_mutex_init(&mutex);
+    uint32_t inheritance_switches = run_contention();
+    bool inheritance_blocked = high_locked && !high_found_free;
+    pico_rtos_mutex_delete(&mutex);
+
+    pico_rtos_mutex_init_ceiling_static(&mutex, CEILING, &mutex_wait);
+    uint32_t ceiling_switches = run_contention();
+    bool ceiling_free = high_locked && high_found_free;
+    pico_rtos_mutex_delete(&mutex);
+
+    printf("High task switched in %lu times with inheritance, %lu with a ceiling\n",
+           (unsigned long)inheritance_switches, (unsigned long)ceiling_switches);
+
+    TEST_ASSERT(inheritance_blocked, "With priority inheritance the high task blocks on the owner");
+    TEST_ASSERT(ceiling_free, "With a ceiling the high task finds the mutex free");
+#if PICO_RTOS_ENABLE_RUNTIME_STATS
+    TEST_ASSERT(ceiling_switches < inheritance_switches,
+                "A ceiling mutex saves the high task a round trip through the scheduler");
+#endif
+}
+
+static void test_invalid_use(void) {
+    pico_rtos_mutex_init_ceiling(&mutex, CEILING);
+
+    pico_rtos_clear_last_error();
+    pico_rtos_error_info_t error;
+    bool locked = pico_rtos_mutex_lock(&mutex, 0);
+    TEST_ASSERT(!locked && pico_rtos_mutex_get_owner(&mutex) == NULL &&
+                pico_rtos_get_last_error(&error) && error.code == PICO_RTOS_ERROR_MUTEX_CEILING_VIOLATION,
+                "A task above the ceiling is refused the lock");
+    TEST_ASSERT(controller_task.priority == CONTROLLER_PRIORITY, "A refused locker keeps its priority");
+    pico_rtos_mutex_delete(&mutex);
+
+    pico_rtos_mutex_t other;
+    TEST_ASSERT(!pico_rtos_mutex_init_ceiling(&other, 0) &&
+                !pico_rtos_mutex_init_ceiling_static(&other, CEILING, NULL),
+                "A zero ceiling or missing wait list storage is rejected");
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_raise_and_restore();
+    test_medium_cannot_preempt();
+    test_no_blocking_under_ceiling();
+    test_invalid_use();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Priority Ceiling Tests...\n");
+    printf("==================================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,269 @@
+/**
+ * @file priority_inheritance_test.c
+ * @brief Tests for transitive priority inheritance across nested mutexes
+ *
+ * Each task keeps a list of the mutexes it holds, and its priority is
+ * recomputed from its base priority and the top waiter of each of them
+ * whenever that changes. Checks that a boost travels down a chain of
+ * owners, that releasing one of several mutexes keeps what the others
+ * still require, that a waiter timing out takes its boost with it, that a
+ * base priority change does not undo a boost, and that a waiter boosted
+ * while it waits moves up its wait list.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 8
+#define HIGH_PRIORITY 6
+#define MEDIUM_PRIORITY 4
+#define WORKER_PRIORITY 3
+#define LOW_PRIORITY 2
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+// What a worker does: lock the mutexes in hold, then lock wait_for (and
+// unlock it again at once), then release the held mutexes in the order
+// they were taken, each once the controller opens the gate
+typedef struct {
+    pico_rtos_mutex_t *hold[2];
+    pico_rtos_mutex_t *wait_for;
+    uint32_t timeout;
+    pico_rtos_semaphore_t gate;
+    volatile bool got;
+    volatile uint32_t got_order;
+    volatile bool done;
+} worker_t;
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t low_task;
+static pico_rtos_task_t worker_task;
+static pico_rtos_task_t medium_task;
+static pico_rtos_task_t high_task;
+
+static worker_t low;
+static worker_t worker;
+static worker_t medium;
+static worker_t high;
+
+static pico_rtos_mutex_t mutex_a;
+static pico_rtos_mutex_t mutex_b;
+
+static volatile uint32_t acquisitions = 0;
+
+static void worker_task_function(void *param) {
+    worker_t *w = (worker_t *)param;
+
+    for (int i = 0; i < 2; i++) {
+        if (w->hold[i] != NULL) {
+            pico_rtos_mutex_lock(w->hold[i], PICO_RTOS_WAIT_FOREVER);
+        }
+    }
+
+    if (w->wait_for != NULL) {
+        w->got = pico_rtos_mutex_lock(w->wait_for, w->timeout);
+        if (w->got) {
+            w->got_order = ++acquisitions;
+            pico_rtos_mutex_unlock(w->wait_for);
+        }
+    }
+
+    for (int i = 0; i < 2; i++) {
+        if (w->hold[i] != NULL) {
+            pico_rtos_semaphore_take(&w->gate, PICO_RTOS_WAIT_FOREVER);
+            pico_rtos_mutex_unlock(w->hold[i]);
+        }
+    }
+    w->done = true;
+}
+
+static void start_worker(pico_rtos_task_t *task, worker_t *w, const char *name, uint32_t priority,
+                         pico_rtos_mutex_t *hold0, pico_rtos_mutex_t *hold1,
+                         pico_rtos_mutex_t *wait_for, uint32_t timeout) {
+    w->hold[0] = hold0;
+    w->hold[1] = hold1;
+    w->wait_for = wait_for;
+    w->timeout = timeout;
+    w->got = false;
+    w->got_order = 0;
+    w->done = false;
+
+    pico_rtos_task_create(task, name, worker_task_function, w, TASK_STACK_SIZE, priority);
+
+    // Let it run up to the point where it waits
+    pico_rtos_task_delay(1);
+}
+
+// Open a worker's gate once and let everyone run until they wait again
+static void release_one(worker_t *w) {
+    pico_rtos_semaphore_give(&w->gate);
+    pico_rtos_task_delay(1);
+}
+
+static void reset_mutexes(void) {
+    pico_rtos_mutex_init(&mutex_a);
+    pico_rtos_mutex_init(&mutex_b);
+    acquisitions = 0;
+}
+
+static void delete_mutexes(void) {
+    pico_rtos_mutex_delete(&mutex_a);
+    pico_rtos_mutex_delete(&mutex_b);
+}
+
+static void test_chain(void) {
+    reset_mutexes();
+
+    // Low holds A; medium holds B and waits for A; high waits for B
+    start_worker(&low_task, &low, "Low", LOW_PRIORITY, &mutex_a, NULL, NULL, 0);
+    start_worker(&medium_task, &medium, "Medium", MEDIUM_PRIORITY, &mutex_b, NULL,
+                 &mutex_a, PICO_RTOS_WAIT_FOREVER);
+    TEST_ASSERT(low_task.priority == MEDIUM_PRIORITY, "A waiter boosts the owner");
+
+    start_worker(&high_task, &high, "High", HIGH_PRIORITY, NULL, NULL, &mutex_b, PICO_RTOS_WAIT_FOREVER);
+    TEST_ASSERT(medium_task.priority == HIGH_PRIORITY && low_task.priority == HIGH_PRIORITY,
+                "A boost travels down the chain of owners");
+
+    release_one(&low);
+    TEST_ASSERT(low.done && low_task.priority == LOW_PRIORITY && medium.got &&
+                medium_task.priority == HIGH_PRIORITY,
+                "Releasing the end of the chain restores it and leaves the next owner boosted");
+
+    release_one(&medium);
+    TEST_ASSERT(medium.done && medium_task.priority == MEDIUM_PRIORITY && high.got && high.done,
+                "Each owner returns to its own priority once released");
+
+    delete_mutexes();
+}
+
+static void test_nested_release(void) {
+    reset_mutexes();
+
+    // Low holds A and B; high waits for A and medium for B
+    start_worker(&low_task, &low, "Low", LOW_PRIORITY, &mutex_a, &mutex_b, NULL, 0);
+    start_worker(&high_task, &high, "High", HIGH_PRIORITY, NULL, NULL, &mutex_a, PICO_RTOS_WAIT_FOREVER);
+    start_worker(&medium_task, &medium, "Medium", MEDIUM_PRIORITY, NULL, NULL, &mutex_b, PICO_RTOS_WAIT_FOREVER);
+    TEST_ASSERT(low_task.priority == HIGH_PRIORITY, "The owner runs at its highest waiter's priority");
+
+    release_one(&low);
+    TEST_ASSERT(high.got && low_task.priority == MEDIUM_PRIORITY,
+                "Releasing one mutex keeps the boost from another still held");
+
+    release_one(&low);
+    TEST_ASSERT(medium.got && low.done && low_task.priority == LOW_PRIORITY,
+                "Releasing the last mutex restores the base priority");
+
+    delete_mutexes();
+}
+
+static void test_waiter_timeout(void) {
+    reset_mutexes();
+
+    start_worker(&low_task, &low, "Low", LOW_PRIORITY, &mutex_a, NULL, NULL, 0);
+    start_worker(&high_task, &high, "High", HIGH_PRIORITY, NULL, NULL, &mutex_a, 3);
+    bool boosted = (low_task.priority == HIGH_PRIORITY);
+
+    pico_rtos_task_delay(5);
+    TEST_ASSERT(boosted && !high.got && low_task.priority == LOW_PRIORITY,
+                "A waiter that times out takes its boost with it");
+
+    release_one(&low);
+    delete_mutexes();
+}
+
+static void test_base_priority_change(void) {
+    reset_mutexes();
+
+    start_worker(&low_task, &low, "Low", LOW_PRIORITY, &mutex_a, NULL, NULL, 0);
+    start_worker(&high_task, &high, "High", HIGH_PRIORITY, NULL, NULL, &mutex_a, PICO_RTOS_WAIT_FOREVER);
+
+    pico_rtos_task_set_priority(&low_task, WORKER_PRIORITY);
+    TEST_ASSERT(low_task.priority == HIGH_PRIORITY && low_task.original_priority == WORKER_PRIORITY,
+                "Changing the base priority of a boosted owner keeps the boost");
+
+    release_one(&low);
+    TEST_ASSERT(high.got && low_task.priority == WORKER_PRIORITY,
+                "The owner returns to its new base priority");
+
+    delete_mutexes();
+}
+
+static void test_waiter_reordering(void) {
+    reset_mutexes();
+
+    // Worker holds B and waits for A; medium waits for A too and is ahead
+    // of worker by priority
+    start_worker(&low_task, &low, "Low", LOW_PRIORITY, &mutex_a, NULL, NULL, 0);
+    start_worker(&worker_task, &worker, "Worker", WORKER_PRIORITY, &mutex_b, NULL,
+                 &mutex_a, PICO_RTOS_WAIT_FOREVER);
+    start_worker(&medium_task, &medium, "Medium", MEDIUM_PRIORITY, NULL, NULL, &mutex_a, PICO_RTOS_WAIT_FOREVER);
+
+    // High waiting for B boosts worker above medium while it waits for A
+    start_worker(&high_task, &high, "High", HIGH_PRIORITY, NULL, NULL, &mutex_b, PICO_RTOS_WAIT_FOREVER);
+    TEST_ASSERT(worker_task.priority == HIGH_PRIORITY && low_task.priority == HIGH_PRIORITY,
+                "A waiter boosted while waiting passes the boost on");
+
+    release_one(&low);
+    TEST_ASSERT(worker.got && medium.got && worker.got_order < medium.got_order,
+                "A waiter boosted while waiting moves up the wait list");
+
+    release_one(&worker);
+    TEST_ASSERT(high.got && worker.done && worker_task.priority == WORKER_PRIORITY,
+                "The reordered waiter is restored once it releases");
+
+    delete_mutexes();
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    // Every scenario opens each gate as often as its worker waits on it
+    pico_rtos_semaphore_init(&low.gate, 0, 2);
+    pico_rtos_semaphore_init(&worker.gate, 0, 2);
+    pico_rtos_semaphore_init(&medium.gate, 0, 2);
+    pico_rtos_semaphore_init(&high.gate, 0, 2);
+
+    test_chain();
+    test_nested_release();
+    test_waiter_timeout();
+    test_base_priority_change();
+    test_waiter_reordering();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Priority Inheritance Tests...\n");
+    printf("======================================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
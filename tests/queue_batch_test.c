@@ -0,0 +1,319 @@
+/**
+ * @file queue_batch_test.c
+ * @brief Tests for sending and receiving several queue items per call
+ *
+ * Checks that batches keep their order across the end of the buffer, that
+ * a batch moves only as many items as fit or are queued, that one batch
+ * wakes as many waiting tasks as it moved items, that a blocked receiver
+ * gets a whole batch in one call, that a producer feeding a full queue in
+ * batches delivers every item in order, and that an empty wait times out.
+ * Also checks that a send from an interrupt wakes a receiver without
+ * switching to it, that deleting a queue fails the calls waiting on it, and
+ * that a receiver woken only to find the item gone waits for what is left
+ * of its timeout rather than starting it over.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define WORKER_PRIORITY 6
+#define THIEF_PRIORITY 7
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define QUEUE_LENGTH 8
+#define STREAM_ITEMS 100
+#define BATCH_SIZE 16
+#define WAIT_TIMEOUT_TICKS 20
+#define STEAL_AFTER_TICKS 10
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t worker_a_task;
+static pico_rtos_task_t worker_b_task;
+static pico_rtos_task_t worker_c_task;
+
+static pico_rtos_queue_t queue;
+static uint32_t queue_buffer[QUEUE_LENGTH];
+
+static volatile size_t batch_received = 0;
+static uint32_t batch[BATCH_SIZE];
+
+static volatile uint32_t single_received[2];
+
+static volatile uint32_t stream_sent = 0;
+static volatile size_t stream_calls = 0;
+
+static volatile bool deleted_send_done = false;
+static volatile size_t deleted_send_count = 0;
+
+static volatile bool timed_receive_done = false;
+static volatile size_t timed_receive_count = 0;
+static volatile uint32_t timed_receive_ticks = 0;
+
+static bool in_sequence(const uint32_t *items, size_t count, uint32_t first) {
+    for (size_t i = 0; i < count; i++) {
+        if (items[i] != first + i) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void fill_sequence(uint32_t *items, size_t count, uint32_t first) {
+    for (size_t i = 0; i < count; i++) {
+        items[i] = first + i;
+    }
+}
+
+static void batch_receiver_task_function(void *param) {
+    (void)param;
+    batch_received = pico_rtos_queue_receive_many(&queue, batch, BATCH_SIZE, PICO_RTOS_WAIT_FOREVER);
+}
+
+static void single_receiver_task_function(void *param) {
+    volatile uint32_t *slot = (volatile uint32_t *)param;
+    uint32_t item = 0;
+    if (pico_rtos_queue_receive(&queue, &item, PICO_RTOS_WAIT_FOREVER)) {
+        *slot = item;
+    }
+}
+
+static void producer_task_function(void *param) {
+    (void)param;
+    uint32_t items[BATCH_SIZE];
+    uint32_t next = 1;
+    while (next <= STREAM_ITEMS) {
+        size_t count = STREAM_ITEMS - next + 1;
+        if (count > BATCH_SIZE) {
+            count = BATCH_SIZE;
+        }
+        fill_sequence(items, count, next);
+        size_t sent = pico_rtos_queue_send_many(&queue, items, count, PICO_RTOS_WAIT_FOREVER);
+        next += sent;
+        stream_sent = next - 1;
+        stream_calls++;
+    }
+}
+
+static void blocked_sender_task_function(void *param) {
+    (void)param;
+    uint32_t item = 1;
+    deleted_send_count = pico_rtos_queue_send_many(&queue, &item, 1, PICO_RTOS_WAIT_FOREVER);
+    deleted_send_done = true;
+}
+
+static void timed_receiver_task_function(void *param) {
+    (void)param;
+    uint32_t items[BATCH_SIZE];
+    uint32_t start = pico_rtos_get_tick_count();
+    timed_receive_count = pico_rtos_queue_receive_many(&queue, items, BATCH_SIZE, WAIT_TIMEOUT_TICKS);
+    timed_receive_ticks = pico_rtos_get_tick_count() - start;
+    timed_receive_done = true;
+}
+
+// Sends an item, waking the receiver, then takes it back before the
+// receiver gets to run
+static void thief_task_function(void *param) {
+    (void)param;
+    uint32_t item = 1;
+    pico_rtos_task_delay(STEAL_AFTER_TICKS);
+    pico_rtos_queue_send(&queue, &item, 0);
+    pico_rtos_queue_receive(&queue, &item, 0);
+}
+
+static void test_wrap_and_partial(void) {
+    pico_rtos_queue_init(&queue, queue_buffer, sizeof(uint32_t), QUEUE_LENGTH);
+
+    // Move head and tail near the end of the buffer
+    for (uint32_t i = 0; i < QUEUE_LENGTH - 3; i++) {
+        uint32_t item = 0;
+        pico_rtos_queue_send(&queue, &i, 0);
+        pico_rtos_queue_receive(&queue, &item, 0);
+    }
+
+    uint32_t items[QUEUE_LENGTH + 4];
+    uint32_t received[QUEUE_LENGTH + 4];
+    fill_sequence(items, QUEUE_LENGTH + 4, 100);
+
+    size_t sent = pico_rtos_queue_send_many(&queue, items, QUEUE_LENGTH + 4, 0);
+    TEST_ASSERT(sent == QUEUE_LENGTH && pico_rtos_queue_is_full(&queue),
+                "A batch larger than the free space sends only what fits");
+    TEST_ASSERT(pico_rtos_queue_send_many(&queue, items, 1, 0) == 0, "A batch into a full queue sends nothing");
+
+    size_t first = pico_rtos_queue_receive_many(&queue, received, 3, 0);
+    size_t rest = pico_rtos_queue_receive_many(&queue, received + first, QUEUE_LENGTH + 4, 0);
+    TEST_ASSERT(first == 3 && rest == QUEUE_LENGTH - 3 && in_sequence(received, QUEUE_LENGTH, 100),
+                "Batches keep their order across the end of the buffer");
+
+    uint32_t single = 0;
+    pico_rtos_queue_send_many(&queue, items, 2, 0);
+    TEST_ASSERT(pico_rtos_queue_receive(&queue, &single, 0) && single == 100 &&
+                pico_rtos_queue_receive_many(&queue, received, 4, 0) == 1 && received[0] == 101,
+                "Batched and single calls share the same queue");
+
+    TEST_ASSERT(pico_rtos_queue_receive_many(&queue, received, 4, 3) == 0,
+                "A batch receive from an empty queue times out");
+
+    pico_rtos_queue_delete(&queue);
+}
+
+static void test_wakeups(void) {
+    pico_rtos_queue_init(&queue, queue_buffer, sizeof(uint32_t), QUEUE_LENGTH);
+    uint32_t items[QUEUE_LENGTH];
+    fill_sequence(items, QUEUE_LENGTH, 1);
+
+    // A blocked batch receiver gets everything sent in one go
+    batch_received = 0;
+    pico_rtos_task_create(&worker_a_task, "Receiver", batch_receiver_task_function, NULL,
+                          TASK_STACK_SIZE, WORKER_PRIORITY);
+    pico_rtos_task_delay(1);
+    pico_rtos_queue_send_many(&queue, items, 6, 0);
+    TEST_ASSERT(batch_received == 6 && in_sequence(batch, 6, 1),
+                "A blocked receiver is handed a whole batch in one call");
+
+    // Two blocked single receivers are both woken by one batch of two
+    single_received[0] = 0;
+    single_received[1] = 0;
+    pico_rtos_task_create(&worker_a_task, "ReceiverA", single_receiver_task_function,
+                          (void *)&single_received[0], TASK_STACK_SIZE, WORKER_PRIORITY);
+    pico_rtos_task_create(&worker_b_task, "ReceiverB", single_receiver_task_function,
+                          (void *)&single_received[1], TASK_STACK_SIZE, WORKER_PRIORITY);
+    pico_rtos_task_delay(1);
+    pico_rtos_queue_send_many(&queue, items, 2, 0);
+    pico_rtos_task_delay(1);
+    TEST_ASSERT(single_received[0] + single_received[1] == 3 && pico_rtos_queue_is_empty(&queue),
+                "One batch wakes a waiting task per item sent");
+
+    // The receiver outranks us, yet only runs once we give up the CPU
+    single_received[0] = 0;
+    pico_rtos_task_create(&worker_c_task, "ReceiverC", single_receiver_task_function,
+                          (void *)&single_received[0], TASK_STACK_SIZE, WORKER_PRIORITY);
+    pico_rtos_task_delay(1);
+    bool woken = false;
+    bool sent = pico_rtos_queue_send_from_isr(&queue, &items[4], &woken);
+    bool switched = (single_received[0] != 0);
+    pico_rtos_task_yield();
+    TEST_ASSERT(sent && woken && !switched && single_received[0] == 5,
+                "A send from an interrupt wakes a receiver and leaves the switch to the caller");
+
+    woken = false;
+    pico_rtos_queue_send_many(&queue, items, QUEUE_LENGTH, 0);
+    TEST_ASSERT(!pico_rtos_queue_send_from_isr(&queue, &items[0], &woken) && !woken,
+                "A send from an interrupt into a full queue fails at once");
+
+    pico_rtos_task_delay(2);
+    pico_rtos_queue_delete(&queue);
+}
+
+static void test_stream(void) {
+    pico_rtos_queue_init(&queue, queue_buffer, sizeof(uint32_t), QUEUE_LENGTH);
+
+    // The producer outranks us and keeps the queue full, blocking on it
+    stream_sent = 0;
+    stream_calls = 0;
+    pico_rtos_task_create(&worker_a_task, "Producer", producer_task_function, NULL,
+                          TASK_STACK_SIZE, WORKER_PRIORITY);
+    pico_rtos_task_yield();
+    bool blocked_full = (stream_sent == QUEUE_LENGTH) && pico_rtos_queue_is_full(&queue);
+
+    uint32_t received[STREAM_ITEMS];
+    size_t total = 0;
+    size_t receive_calls = 0;
+    while (total < STREAM_ITEMS) {
+        size_t count = pico_rtos_queue_receive_many(&queue, received + total, STREAM_ITEMS - total, 100);
+        if (count == 0) {
+            break;
+        }
+        total += count;
+        receive_calls++;
+    }
+
+    printf("%u items moved in %u sends and %u receives\n",
+           (unsigned)total, (unsigned)stream_calls, (unsigned)receive_calls);
+    TEST_ASSERT(blocked_full, "A producer feeding a full queue in batches blocks");
+    TEST_ASSERT(total == STREAM_ITEMS && in_sequence(received, STREAM_ITEMS, 1) && stream_sent == STREAM_ITEMS,
+                "Every item sent in batches arrives once and in order");
+
+    pico_rtos_task_delay(2);
+    pico_rtos_queue_delete(&queue);
+}
+
+static void test_delete_and_rewait(void) {
+    pico_rtos_queue_init(&queue, queue_buffer, sizeof(uint32_t), QUEUE_LENGTH);
+    uint32_t items[QUEUE_LENGTH];
+    fill_sequence(items, QUEUE_LENGTH, 1);
+
+    // A sender waiting on a full queue is released by deleting it
+    pico_rtos_queue_send_many(&queue, items, QUEUE_LENGTH, 0);
+    deleted_send_done = false;
+    pico_rtos_task_create(&worker_a_task, "Sender", blocked_sender_task_function, NULL,
+                          TASK_STACK_SIZE, WORKER_PRIORITY);
+    pico_rtos_task_delay(1);
+    pico_rtos_queue_delete(&queue);
+    pico_rtos_task_delay(1);
+    TEST_ASSERT(deleted_send_done && deleted_send_count == 0, "Deleting a queue fails a waiting send");
+
+    // The receiver is woken halfway through its timeout, finds nothing and
+    // waits again for only the rest
+    pico_rtos_queue_init(&queue, queue_buffer, sizeof(uint32_t), QUEUE_LENGTH);
+    timed_receive_done = false;
+    pico_rtos_task_create(&worker_a_task, "Receiver", timed_receiver_task_function, NULL,
+                          TASK_STACK_SIZE, WORKER_PRIORITY);
+    pico_rtos_task_create(&worker_b_task, "Thief", thief_task_function, NULL,
+                          TASK_STACK_SIZE, THIEF_PRIORITY);
+    pico_rtos_task_delay(2 * WAIT_TIMEOUT_TICKS);
+    printf("Receive woken after %d ticks timed out after %lu ticks\n", STEAL_AFTER_TICKS,
+           (unsigned long)timed_receive_ticks);
+    TEST_ASSERT(timed_receive_done && timed_receive_count == 0 && timed_receive_ticks <= WAIT_TIMEOUT_TICKS + 1,
+                "A receiver that finds its item taken waits out only the rest of its timeout");
+
+    pico_rtos_queue_delete(&queue);
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_wrap_and_partial();
+    test_wakeups();
+    test_stream();
+    test_delete_and_rewait();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Queue Batch Tests...\n");
+    printf("=============================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
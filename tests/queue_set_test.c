@@ -0,0 +1,342 @@
+/**
+ * @file queue_set_test.c
+ * @brief Tests for waiting on several queues, semaphores, stream buffers
+ *        and event groups at once
+ *
+ * Checks set membership rules, that select times out when nothing is
+ * ready, that a blocked select wakes for a queue send, a semaphore give,
+ * a stream buffer message and the chosen event group bits, that a busy
+ * member does not hide the others, that one task can service several
+ * producers through a set, and that deleting a set or a member cleans up.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define WORKER_PRIORITY 4
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define QUEUE_LENGTH 4
+#define PRODUCERS 3
+#define ITEMS_PER_PRODUCER 20
+#define POST_DELAY 3
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t worker_tasks[PRODUCERS];
+static pico_rtos_task_t poster_tasks[4];
+
+static pico_rtos_queue_set_t set;
+static pico_rtos_queue_set_t other_set;
+
+static pico_rtos_queue_t queues[PRODUCERS];
+static uint32_t queue_buffers[PRODUCERS][QUEUE_LENGTH];
+
+static pico_rtos_semaphore_t semaphore;
+
+#ifdef PICO_RTOS_ENABLE_EVENT_GROUPS
+#define WANTED_BITS PICO_RTOS_EVENT_BIT_2
+static pico_rtos_event_group_t event_group;
+#endif
+
+#ifdef PICO_RTOS_ENABLE_STREAM_BUFFERS
+static pico_rtos_stream_buffer_t stream;
+static uint8_t stream_storage[64];
+#endif
+
+static volatile bool select_returned = false;
+static void *volatile select_result = (void *)1;
+
+static void init_queues(void) {
+    for (int i = 0; i < PRODUCERS; i++) {
+        pico_rtos_queue_init(&queues[i], queue_buffers[i], sizeof(uint32_t), QUEUE_LENGTH);
+    }
+}
+
+static void delete_queues(void) {
+    for (int i = 0; i < PRODUCERS; i++) {
+        pico_rtos_queue_delete(&queues[i]);
+    }
+}
+
+// Posts to one member after a delay while the controller waits in select
+static void queue_poster_task_function(void *param) {
+    uint32_t item = 42;
+    pico_rtos_task_delay(POST_DELAY);
+    pico_rtos_queue_send((pico_rtos_queue_t *)param, &item, 0);
+}
+
+static void semaphore_poster_task_function(void *param) {
+    (void)param;
+    pico_rtos_task_delay(POST_DELAY);
+    pico_rtos_semaphore_give(&semaphore);
+}
+
+#ifdef PICO_RTOS_ENABLE_EVENT_GROUPS
+// Sets a bit nobody asked for first, then the wanted one
+static void event_poster_task_function(void *param) {
+    (void)param;
+    pico_rtos_task_delay(POST_DELAY);
+    pico_rtos_event_group_set_bits(&event_group, PICO_RTOS_EVENT_BIT_0);
+    pico_rtos_task_delay(POST_DELAY);
+    pico_rtos_event_group_set_bits(&event_group, WANTED_BITS);
+}
+#endif
+
+#ifdef PICO_RTOS_ENABLE_STREAM_BUFFERS
+static void stream_poster_task_function(void *param) {
+    (void)param;
+    pico_rtos_task_delay(POST_DELAY);
+    pico_rtos_stream_buffer_send(&stream, "ready", 6, 0);
+}
+#endif
+
+static void producer_task_function(void *param) {
+    pico_rtos_queue_t *queue = (pico_rtos_queue_t *)param;
+    for (uint32_t i = 0; i < ITEMS_PER_PRODUCER; i++) {
+        pico_rtos_queue_send(queue, &i, PICO_RTOS_WAIT_FOREVER);
+        pico_rtos_task_delay(1);
+    }
+}
+
+static void selector_task_function(void *param) {
+    (void)param;
+    select_result = pico_rtos_queue_set_select(&set, PICO_RTOS_WAIT_FOREVER);
+    select_returned = true;
+}
+
+// Select with a timeout and report how long it took
+static void *timed_select(uint32_t timeout, uint32_t *elapsed) {
+    uint32_t start = pico_rtos_get_tick_count();
+    void *ready = pico_rtos_queue_set_select(&set, timeout);
+    *elapsed = pico_rtos_get_tick_count() - start;
+    return ready;
+}
+
+static void test_membership(void) {
+    pico_rtos_queue_set_init(&set);
+    pico_rtos_queue_set_init(&other_set);
+    init_queues();
+    pico_rtos_semaphore_init(&semaphore, 0, 1);
+
+    bool added = pico_rtos_queue_set_add_queue(&set, &queues[0]) &&
+                 pico_rtos_queue_set_add_queue(&set, &queues[1]) &&
+                 pico_rtos_queue_set_add_semaphore(&set, &semaphore);
+    TEST_ASSERT(added && pico_rtos_queue_set_get_member_count(&set) == 3 &&
+                !pico_rtos_queue_set_add_queue(&set, &queues[0]) &&
+                !pico_rtos_queue_set_add_queue(&other_set, &queues[0]),
+                "An object can be added to only one set, once");
+
+    uint32_t elapsed = 0;
+    bool idle = (pico_rtos_queue_set_select(&set, 0) == NULL);
+    TEST_ASSERT(idle && timed_select(5, &elapsed) == NULL && elapsed >= 5,
+                "Select returns nothing when no member is ready and times out");
+
+    // Data already waiting in a member is seen at once
+    uint32_t item = 7;
+    pico_rtos_queue_send(&queues[2], &item, 0);
+    pico_rtos_queue_set_add_queue(&set, &queues[2]);
+    TEST_ASSERT(pico_rtos_queue_set_select(&set, 0) == &queues[2], "A member added while ready is returned");
+
+    TEST_ASSERT(pico_rtos_queue_set_remove(&set, &queues[2]) && !pico_rtos_queue_set_remove(&set, &queues[2]) &&
+                pico_rtos_queue_set_select(&set, 0) == NULL && pico_rtos_queue_set_get_member_count(&set) == 3,
+                "A removed member is no longer returned");
+
+    pico_rtos_queue_delete(&queues[1]);
+    TEST_ASSERT(pico_rtos_queue_set_get_member_count(&set) == 2 && queues[1].set_member.set == NULL,
+                "Deleting a member takes it out of its set");
+
+    pico_rtos_semaphore_delete(&semaphore);
+    pico_rtos_queue_delete(&queues[0]);
+    pico_rtos_queue_delete(&queues[2]);
+    pico_rtos_queue_set_delete(&other_set);
+    pico_rtos_queue_set_delete(&set);
+}
+
+static void test_wakeups(void) {
+    pico_rtos_queue_set_init(&set);
+    init_queues();
+    pico_rtos_semaphore_init(&semaphore, 0, 1);
+    pico_rtos_queue_set_add_queue(&set, &queues[0]);
+    pico_rtos_queue_set_add_queue(&set, &queues[1]);
+    pico_rtos_queue_set_add_semaphore(&set, &semaphore);
+
+    uint32_t elapsed = 0;
+    uint32_t item = 0;
+    pico_rtos_task_create(&poster_tasks[0], "QueuePoster", queue_poster_task_function, &queues[1],
+                          TASK_STACK_SIZE, WORKER_PRIORITY);
+    void *ready = timed_select(PICO_RTOS_WAIT_FOREVER, &elapsed);
+    TEST_ASSERT(ready == &queues[1] && elapsed >= POST_DELAY && pico_rtos_queue_receive(&queues[1], &item, 0) &&
+                item == 42,
+                "A queue send wakes a task blocked in select");
+
+    pico_rtos_task_create(&poster_tasks[1], "SemPoster", semaphore_poster_task_function, NULL,
+                          TASK_STACK_SIZE, WORKER_PRIORITY);
+    ready = timed_select(PICO_RTOS_WAIT_FOREVER, &elapsed);
+    TEST_ASSERT(ready == &semaphore && pico_rtos_semaphore_take(&semaphore, 0) &&
+                pico_rtos_queue_set_select(&set, 0) == NULL,
+                "A semaphore give wakes a task blocked in select");
+
+#ifdef PICO_RTOS_ENABLE_EVENT_GROUPS
+    pico_rtos_event_group_init(&event_group);
+    pico_rtos_queue_set_add_event_group(&set, &event_group, WANTED_BITS);
+    pico_rtos_task_create(&poster_tasks[2], "EventPoster", event_poster_task_function, NULL,
+                          TASK_STACK_SIZE, WORKER_PRIORITY);
+
+    // The unwanted bit comes first and must not end the wait early or late
+    ready = timed_select(POST_DELAY + 1, &elapsed);
+    bool timed_out = (ready == NULL && elapsed == POST_DELAY + 1);
+    ready = timed_select(PICO_RTOS_WAIT_FOREVER, &elapsed);
+    TEST_ASSERT(timed_out && ready == &event_group &&
+                (pico_rtos_event_group_get_bits(&event_group) & WANTED_BITS) != 0,
+                "An event group is ready only for the bits it was added with");
+    pico_rtos_event_group_delete(&event_group);
+#endif
+
+#ifdef PICO_RTOS_ENABLE_STREAM_BUFFERS
+    char message[8] = { 0 };
+    pico_rtos_stream_buffer_init(&stream, stream_storage, sizeof(stream_storage));
+    pico_rtos_queue_set_add_stream_buffer(&set, &stream);
+    pico_rtos_task_create(&poster_tasks[3], "StreamPoster", stream_poster_task_function, NULL,
+                          TASK_STACK_SIZE, WORKER_PRIORITY);
+    ready = timed_select(PICO_RTOS_WAIT_FOREVER, &elapsed);
+    TEST_ASSERT(ready == &stream && pico_rtos_stream_buffer_receive(&stream, message, sizeof(message), 0) == 6,
+                "A stream buffer message wakes a task blocked in select");
+    pico_rtos_stream_buffer_delete(&stream);
+#endif
+
+    pico_rtos_semaphore_delete(&semaphore);
+    delete_queues();
+    pico_rtos_queue_set_delete(&set);
+}
+
+static void test_fairness(void) {
+    pico_rtos_queue_set_init(&set);
+    init_queues();
+    pico_rtos_queue_set_add_queue(&set, &queues[0]);
+    pico_rtos_queue_set_add_queue(&set, &queues[1]);
+
+    for (uint32_t i = 0; i < QUEUE_LENGTH; i++) {
+        pico_rtos_queue_send(&queues[0], &i, 0);
+        pico_rtos_queue_send(&queues[1], &i, 0);
+    }
+
+    // With both always ready, select must alternate between them
+    void *last = NULL;
+    bool alternated = true;
+    for (int i = 0; i < 2 * QUEUE_LENGTH; i++) {
+        uint32_t item;
+        void *ready = pico_rtos_queue_set_select(&set, 0);
+        alternated = alternated && ready != NULL && ready != last &&
+                     pico_rtos_queue_receive((pico_rtos_queue_t *)ready, &item, 0);
+        last = ready;
+    }
+    TEST_ASSERT(alternated && pico_rtos_queue_set_select(&set, 0) == NULL,
+                "Select takes turns between members that stay ready");
+
+    delete_queues();
+    pico_rtos_queue_set_delete(&set);
+}
+
+static void test_dispatcher(void) {
+    pico_rtos_queue_set_init(&set);
+    init_queues();
+    for (int i = 0; i < PRODUCERS; i++) {
+        pico_rtos_queue_set_add_queue(&set, &queues[i]);
+        pico_rtos_task_create(&worker_tasks[i], "Producer", producer_task_function, &queues[i],
+                              TASK_STACK_SIZE, WORKER_PRIORITY);
+    }
+
+    // One task drains every producer, checking each stream stays in order
+    uint32_t expected[PRODUCERS] = { 0 };
+    uint32_t total = 0;
+    bool in_order = true;
+    while (total < PRODUCERS * ITEMS_PER_PRODUCER) {
+        pico_rtos_queue_t *ready = (pico_rtos_queue_t *)pico_rtos_queue_set_select(&set, 100);
+        uint32_t item;
+        if (ready == NULL || !pico_rtos_queue_receive(ready, &item, 0)) {
+            break;
+        }
+        int index = (int)(ready - queues);
+        in_order = in_order && item == expected[index];
+        expected[index]++;
+        total++;
+    }
+
+    printf("%lu items from %d producers through one set\n", (unsigned long)total, PRODUCERS);
+    TEST_ASSERT(total == PRODUCERS * ITEMS_PER_PRODUCER && in_order,
+                "One task services several producers through a set");
+
+    pico_rtos_task_delay(2);
+    delete_queues();
+    pico_rtos_queue_set_delete(&set);
+}
+
+static void test_delete_wakes(void) {
+    pico_rtos_queue_set_init(&set);
+    init_queues();
+    pico_rtos_queue_set_add_queue(&set, &queues[0]);
+
+    select_returned = false;
+    select_result = (void *)1;
+    pico_rtos_task_create(&worker_tasks[0], "Selector", selector_task_function, NULL,
+                          TASK_STACK_SIZE, WORKER_PRIORITY);
+    pico_rtos_task_delay(2);
+    bool waiting = !select_returned;
+
+    pico_rtos_queue_set_delete(&set);
+    pico_rtos_task_delay(2);
+    TEST_ASSERT(waiting && select_returned && select_result == NULL && queues[0].set_member.set == NULL,
+                "Deleting a set wakes its waiters and frees its members");
+
+    delete_queues();
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_membership();
+    test_wakeups();
+    test_fairness();
+    test_dispatcher();
+    test_delete_wakes();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Queue Set Tests...\n");
+    printf("===========================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,232 @@
+/**
+ * @file queue_spsc_performance_test.c
+ * @brief Throughput of single-producer/single-consumer queues against locked ones
+ *
+ * Moves the same items through a queue set up with pico_rtos_queue_init()
+ * and one set up with pico_rtos_queue_init_spsc(), and prints items per
+ * second for each. Three runs: one task filling and draining the queue, so
+ * only the data path is timed; single items between two tasks, so every
+ * item goes through a sleep and a wakeup; and batches between two tasks.
+ * Each run also checks that every item arrives once and in order. The
+ * ratios are printed, not asserted, as they depend on the host or board.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define PRODUCER_PRIORITY 6
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define QUEUE_LENGTH 16
+#define DATA_PATH_ROUNDS 20000
+#define HANDOFF_ITEMS 20000
+#define BATCH_SIZE 8
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t producer_tasks[4];
+static int next_producer = 0;
+
+static pico_rtos_queue_t queue;
+static uint32_t queue_buffer[QUEUE_LENGTH];
+
+static volatile bool producer_done = false;
+
+typedef bool (*queue_init_fn)(pico_rtos_queue_t *queue, void *buffer, size_t item_size, size_t max_items);
+
+static uint32_t items_per_second(uint32_t items, uint64_t elapsed_us) {
+    if (elapsed_us == 0) {
+        elapsed_us = 1;
+    }
+    return (uint32_t)(((uint64_t)items * 1000000) / elapsed_us);
+}
+
+static void single_producer_task_function(void *param) {
+    (void)param;
+    for (uint32_t i = 1; i <= HANDOFF_ITEMS; i++) {
+        if (!pico_rtos_queue_send(&queue, &i, PICO_RTOS_WAIT_FOREVER)) {
+            break;
+        }
+    }
+    producer_done = true;
+}
+
+static void batch_producer_task_function(void *param) {
+    (void)param;
+    uint32_t items[BATCH_SIZE];
+    uint32_t next = 1;
+    while (next <= HANDOFF_ITEMS) {
+        size_t count = HANDOFF_ITEMS - next + 1;
+        if (count > BATCH_SIZE) {
+            count = BATCH_SIZE;
+        }
+        for (size_t i = 0; i < count; i++) {
+            items[i] = next + i;
+        }
+        size_t sent = pico_rtos_queue_send_many(&queue, items, count, PICO_RTOS_WAIT_FOREVER);
+        if (sent == 0) {
+            break;
+        }
+        next += sent;
+    }
+    producer_done = true;
+}
+
+// One task fills the queue and drains it again; no task ever waits
+static uint32_t run_data_path(queue_init_fn init, bool *in_order) {
+    init(&queue, queue_buffer, sizeof(uint32_t), QUEUE_LENGTH);
+    *in_order = true;
+
+    uint32_t next_out = 0;
+    uint32_t next_in = 0;
+    uint64_t start_us = time_us_64();
+    for (uint32_t round = 0; round < DATA_PATH_ROUNDS; round++) {
+        for (uint32_t i = 0; i < QUEUE_LENGTH; i++) {
+            pico_rtos_queue_send(&queue, &next_out, 0);
+            next_out++;
+        }
+        for (uint32_t i = 0; i < QUEUE_LENGTH; i++) {
+            uint32_t item = 0;
+            if (!pico_rtos_queue_receive(&queue, &item, 0) || item != next_in) {
+                *in_order = false;
+            }
+            next_in++;
+        }
+    }
+    uint64_t elapsed_us = time_us_64() - start_us;
+
+    pico_rtos_queue_delete(&queue);
+    return items_per_second(DATA_PATH_ROUNDS * QUEUE_LENGTH, elapsed_us);
+}
+
+// A higher priority producer keeps the queue full, so both sides sleep
+// and wake around every item or batch the controller takes
+static uint32_t run_handoff(queue_init_fn init, pico_rtos_task_function_t producer, bool *in_order) {
+    init(&queue, queue_buffer, sizeof(uint32_t), QUEUE_LENGTH);
+    producer_done = false;
+    *in_order = true;
+
+    uint64_t start_us = time_us_64();
+    pico_rtos_task_create(&producer_tasks[next_producer++], "Producer", producer, NULL,
+                          TASK_STACK_SIZE, PRODUCER_PRIORITY);
+
+    uint32_t items[BATCH_SIZE];
+    uint32_t expected = 1;
+    while (expected <= HANDOFF_ITEMS) {
+        size_t count = (producer == batch_producer_task_function)
+            ? pico_rtos_queue_receive_many(&queue, items, BATCH_SIZE, 1000)
+            : (pico_rtos_queue_receive(&queue, items, 1000) ? 1 : 0);
+        if (count == 0) {
+            *in_order = false;
+            break;
+        }
+        for (size_t i = 0; i < count; i++) {
+            if (items[i] != expected++) {
+                *in_order = false;
+            }
+        }
+    }
+    uint64_t elapsed_us = time_us_64() - start_us;
+
+    *in_order = *in_order && producer_done && pico_rtos_queue_is_empty(&queue);
+    pico_rtos_task_delay(2);
+    pico_rtos_queue_delete(&queue);
+    return items_per_second(HANDOFF_ITEMS, elapsed_us);
+}
+
+static void report(const char *name, uint32_t locked, uint32_t spsc) {
+    printf("%-22s locked %8lu items/s, SPSC %8lu items/s (%lu%%)\n", name,
+           (unsigned long)locked, (unsigned long)spsc,
+           (unsigned long)(locked ? ((uint64_t)spsc * 100) / locked : 0));
+}
+
+static void test_data_path(void) {
+    bool locked_in_order = false;
+    bool spsc_in_order = false;
+    uint32_t locked = run_data_path(pico_rtos_queue_init, &locked_in_order);
+    uint32_t spsc = run_data_path(pico_rtos_queue_init_spsc, &spsc_in_order);
+    report("Fill and drain:", locked, spsc);
+    TEST_ASSERT(locked_in_order && spsc_in_order, "Filling and draining keeps every item in order");
+}
+
+static void test_single_handoff(void) {
+    bool locked_in_order = false;
+    bool spsc_in_order = false;
+    uint32_t locked = run_handoff(pico_rtos_queue_init, single_producer_task_function, &locked_in_order);
+    uint32_t spsc = run_handoff(pico_rtos_queue_init_spsc, single_producer_task_function, &spsc_in_order);
+    report("Task to task, single:", locked, spsc);
+    TEST_ASSERT(locked_in_order && spsc_in_order, "Items handed between tasks arrive once and in order");
+}
+
+static void test_batch_handoff(void) {
+    bool locked_in_order = false;
+    bool spsc_in_order = false;
+    uint32_t locked = run_handoff(pico_rtos_queue_init, batch_producer_task_function, &locked_in_order);
+    uint32_t spsc = run_handoff(pico_rtos_queue_init_spsc, batch_producer_task_function, &spsc_in_order);
+    report("Task to task, batched:", locked, spsc);
+    TEST_ASSERT(locked_in_order && spsc_in_order, "Batches handed between tasks arrive once and in order");
+}
+
+static void test_spsc_limits(void) {
+    pico_rtos_queue_init_spsc(&queue, queue_buffer, sizeof(uint32_t), QUEUE_LENGTH);
+
+    uint32_t item = 0;
+    TEST_ASSERT(!pico_rtos_queue_receive(&queue, &item, 3) && pico_rtos_queue_is_empty(&queue),
+                "An SPSC receive from an empty queue times out");
+
+    for (uint32_t i = 0; i < QUEUE_LENGTH; i++) {
+        pico_rtos_queue_send(&queue, &i, 0);
+    }
+    TEST_ASSERT(pico_rtos_queue_is_full(&queue) && !pico_rtos_queue_send(&queue, &item, 3),
+                "An SPSC send to a full queue times out");
+
+    pico_rtos_queue_delete(&queue);
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_data_path();
+    test_single_handoff();
+    test_batch_handoff();
+    test_spsc_limits();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Queue SPSC Performance Tests...\n");
+    printf("========================================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
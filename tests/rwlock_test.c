@@ -0,0 +1,286 @@
+/**
+ * @file rwlock_test.c
+ * @brief Tests for reader-writer locks
+ *
+ * Checks that readers share the lock and writers hold it alone, that each
+ * policy decides correctly between a waiting writer and an arriving
+ * reader, that a writer's release admits all waiting readers at once,
+ * that readers held back by a writer that times out are let in, that
+ * waiters raise the writer's priority until they get the lock or give up,
+ * and that misuse is refused.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 8
+#define HIGH_PRIORITY 6
+#define MEDIUM_PRIORITY 4
+#define LOW_PRIORITY 2
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+// What a worker does: lock for reading or writing, then hold the lock
+// until the controller opens the gate
+typedef struct {
+    bool write;
+    uint32_t timeout;
+    pico_rtos_semaphore_t gate;
+    volatile bool got;
+    volatile uint32_t got_order;
+    volatile bool done;
+} worker_t;
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t reader_a_task;
+static pico_rtos_task_t reader_b_task;
+static pico_rtos_task_t reader_c_task;
+static pico_rtos_task_t writer_task;
+
+static worker_t reader_a;
+static worker_t reader_b;
+static worker_t reader_c;
+static worker_t writer;
+
+static pico_rtos_rwlock_t rwlock;
+static pico_rtos_block_object_t read_wait;
+static pico_rtos_block_object_t write_wait;
+
+static volatile uint32_t acquisitions = 0;
+
+static void worker_task_function(void *param) {
+    worker_t *w = (worker_t *)param;
+
+    w->got = w->write ? pico_rtos_rwlock_write_lock(&rwlock, w->timeout)
+                      : pico_rtos_rwlock_read_lock(&rwlock, w->timeout);
+    if (w->got) {
+        w->got_order = ++acquisitions;
+        pico_rtos_semaphore_take(&w->gate, PICO_RTOS_WAIT_FOREVER);
+        if (w->write) {
+            pico_rtos_rwlock_write_unlock(&rwlock);
+        } else {
+            pico_rtos_rwlock_read_unlock(&rwlock);
+        }
+    }
+    w->done = true;
+}
+
+static void start_worker(pico_rtos_task_t *task, worker_t *w, const char *name, uint32_t priority,
+                         bool write, uint32_t timeout) {
+    w->write = write;
+    w->timeout = timeout;
+    w->got = false;
+    w->got_order = 0;
+    w->done = false;
+
+    pico_rtos_task_create(task, name, worker_task_function, w, TASK_STACK_SIZE, priority);
+
+    // Let it run up to the point where it waits
+    pico_rtos_task_delay(1);
+}
+
+// Open a worker's gate and let everyone run until they wait again
+static void release_one(worker_t *w) {
+    pico_rtos_semaphore_give(&w->gate);
+    pico_rtos_task_delay(1);
+}
+
+static void reset_lock(pico_rtos_rwlock_policy_t policy) {
+    pico_rtos_rwlock_init(&rwlock, policy);
+    acquisitions = 0;
+}
+
+static void test_shared_and_exclusive(void) {
+    reset_lock(PICO_RTOS_RWLOCK_PREFER_WRITERS);
+
+    start_worker(&reader_a_task, &reader_a, "ReaderA", MEDIUM_PRIORITY, false, PICO_RTOS_WAIT_FOREVER);
+    start_worker(&reader_b_task, &reader_b, "ReaderB", MEDIUM_PRIORITY, false, PICO_RTOS_WAIT_FOREVER);
+    TEST_ASSERT(reader_a.got && reader_b.got && pico_rtos_rwlock_get_readers(&rwlock) == 2,
+                "Readers hold the lock at the same time");
+    TEST_ASSERT(!pico_rtos_rwlock_try_write_lock(&rwlock), "A writer cannot get in while readers hold the lock");
+
+    release_one(&reader_a);
+    release_one(&reader_b);
+    bool wrote = pico_rtos_rwlock_try_write_lock(&rwlock);
+    bool writer_alone = !pico_rtos_rwlock_try_read_lock(&rwlock);
+
+    // A reader waiting on a writer times out
+    start_worker(&reader_a_task, &reader_a, "ReaderA", MEDIUM_PRIORITY, false, 3);
+    pico_rtos_task_delay(5);
+    TEST_ASSERT(wrote && writer_alone && pico_rtos_rwlock_get_writer(&rwlock) == &controller_task &&
+                reader_a.done && !reader_a.got,
+                "A writer holds the lock alone and readers time out waiting for it");
+
+    pico_rtos_rwlock_write_unlock(&rwlock);
+    TEST_ASSERT(pico_rtos_rwlock_try_read_lock(&rwlock) && pico_rtos_rwlock_read_unlock(&rwlock),
+                "Releasing the write lock lets readers in");
+
+    pico_rtos_rwlock_delete(&rwlock);
+}
+
+static void test_writer_preference(void) {
+    reset_lock(PICO_RTOS_RWLOCK_PREFER_WRITERS);
+
+    // Reader A holds the lock, the writer waits for it, reader B arrives
+    start_worker(&reader_a_task, &reader_a, "ReaderA", MEDIUM_PRIORITY, false, PICO_RTOS_WAIT_FOREVER);
+    start_worker(&writer_task, &writer, "Writer", MEDIUM_PRIORITY, true, PICO_RTOS_WAIT_FOREVER);
+    start_worker(&reader_b_task, &reader_b, "ReaderB", MEDIUM_PRIORITY, false, PICO_RTOS_WAIT_FOREVER);
+    TEST_ASSERT(!writer.got && !reader_b.got, "Preferring writers, a new reader waits behind a waiting writer");
+
+    release_one(&reader_a);
+    bool writer_first = writer.got && !reader_b.got;
+    release_one(&writer);
+    TEST_ASSERT(writer_first && reader_b.got && writer.got_order < reader_b.got_order,
+                "The last reader out hands the lock to the waiting writer first");
+    release_one(&reader_b);
+
+    // A writer that gives up lets the readers held back behind it in
+    start_worker(&reader_a_task, &reader_a, "ReaderA", MEDIUM_PRIORITY, false, PICO_RTOS_WAIT_FOREVER);
+    start_worker(&writer_task, &writer, "Writer", MEDIUM_PRIORITY, true, 3);
+    start_worker(&reader_b_task, &reader_b, "ReaderB", MEDIUM_PRIORITY, false, PICO_RTOS_WAIT_FOREVER);
+    pico_rtos_task_delay(5);
+    TEST_ASSERT(writer.done && !writer.got && reader_b.got && pico_rtos_rwlock_get_readers(&rwlock) == 2,
+                "Readers held back by a writer that times out are let in");
+    release_one(&reader_a);
+    release_one(&reader_b);
+
+    pico_rtos_rwlock_delete(&rwlock);
+}
+
+static void test_reader_preference(void) {
+    reset_lock(PICO_RTOS_RWLOCK_PREFER_READERS);
+
+    start_worker(&reader_a_task, &reader_a, "ReaderA", MEDIUM_PRIORITY, false, PICO_RTOS_WAIT_FOREVER);
+    start_worker(&writer_task, &writer, "Writer", MEDIUM_PRIORITY, true, PICO_RTOS_WAIT_FOREVER);
+    start_worker(&reader_b_task, &reader_b, "ReaderB", MEDIUM_PRIORITY, false, PICO_RTOS_WAIT_FOREVER);
+    TEST_ASSERT(!writer.got && reader_b.got, "Preferring readers, a new reader joins despite a waiting writer");
+
+    release_one(&reader_a);
+    bool writer_waits = !writer.got;
+    release_one(&reader_b);
+    TEST_ASSERT(writer_waits && writer.got, "The writer gets the lock once the last reader leaves");
+    release_one(&writer);
+
+    pico_rtos_rwlock_delete(&rwlock);
+}
+
+static void test_readers_admitted_together(void) {
+    reset_lock(PICO_RTOS_RWLOCK_PREFER_WRITERS);
+
+    pico_rtos_rwlock_write_lock(&rwlock, PICO_RTOS_WAIT_FOREVER);
+    start_worker(&reader_a_task, &reader_a, "ReaderA", MEDIUM_PRIORITY, false, PICO_RTOS_WAIT_FOREVER);
+    start_worker(&reader_b_task, &reader_b, "ReaderB", MEDIUM_PRIORITY, false, PICO_RTOS_WAIT_FOREVER);
+    start_worker(&reader_c_task, &reader_c, "ReaderC", MEDIUM_PRIORITY, false, PICO_RTOS_WAIT_FOREVER);
+    bool all_waited = !reader_a.got && !reader_b.got && !reader_c.got;
+
+    pico_rtos_rwlock_write_unlock(&rwlock);
+    uint32_t readers = pico_rtos_rwlock_get_readers(&rwlock);
+    pico_rtos_task_delay(1);
+    TEST_ASSERT(all_waited && readers == 3 && reader_a.got && reader_b.got && reader_c.got,
+                "Releasing the write lock admits every waiting reader at once");
+
+    release_one(&reader_a);
+    release_one(&reader_b);
+    release_one(&reader_c);
+    pico_rtos_rwlock_delete(&rwlock);
+}
+
+static void test_priority_inheritance(void) {
+    bool ok = pico_rtos_rwlock_init_static(&rwlock, PICO_RTOS_RWLOCK_PREFER_WRITERS, &read_wait, &write_wait);
+    acquisitions = 0;
+
+    start_worker(&writer_task, &writer, "Writer", LOW_PRIORITY, true, PICO_RTOS_WAIT_FOREVER);
+    start_worker(&reader_a_task, &reader_a, "ReaderA", MEDIUM_PRIORITY, false, PICO_RTOS_WAIT_FOREVER);
+    TEST_ASSERT(ok && writer_task.priority == MEDIUM_PRIORITY, "A waiting reader raises the writer");
+
+    start_worker(&reader_b_task, &reader_b, "ReaderB", HIGH_PRIORITY, false, 3);
+    bool raised_higher = (writer_task.priority == HIGH_PRIORITY);
+    pico_rtos_task_delay(5);
+    TEST_ASSERT(raised_higher && !reader_b.got && writer_task.priority == MEDIUM_PRIORITY,
+                "A reader that times out takes its boost with it");
+
+    release_one(&writer);
+    TEST_ASSERT(reader_a.got && writer.done && writer_task.priority == LOW_PRIORITY,
+                "Releasing the write lock restores the writer's priority");
+    release_one(&reader_a);
+
+    pico_rtos_rwlock_delete(&rwlock);
+}
+
+static void test_invalid_use(void) {
+    reset_lock(PICO_RTOS_RWLOCK_PREFER_WRITERS);
+    pico_rtos_error_info_t error;
+
+    pico_rtos_clear_last_error();
+    TEST_ASSERT(!pico_rtos_rwlock_read_unlock(&rwlock) && !pico_rtos_rwlock_write_unlock(&rwlock) &&
+                pico_rtos_get_last_error(&error) && error.code == PICO_RTOS_ERROR_RWLOCK_NOT_HELD,
+                "Releasing a lock that is not held fails");
+
+    pico_rtos_rwlock_write_lock(&rwlock, PICO_RTOS_WAIT_FOREVER);
+    pico_rtos_clear_last_error();
+    TEST_ASSERT(!pico_rtos_rwlock_write_lock(&rwlock, 10) && !pico_rtos_rwlock_read_lock(&rwlock, 10) &&
+                pico_rtos_get_last_error(&error) && error.code == PICO_RTOS_ERROR_RWLOCK_WOULD_DEADLOCK,
+                "The writer cannot lock again");
+    pico_rtos_rwlock_write_unlock(&rwlock);
+    pico_rtos_rwlock_delete(&rwlock);
+
+    pico_rtos_rwlock_t other;
+    TEST_ASSERT(!pico_rtos_rwlock_init_static(&other, PICO_RTOS_RWLOCK_PREFER_WRITERS, &read_wait, NULL) &&
+                !pico_rtos_rwlock_init_static(&other, (pico_rtos_rwlock_policy_t)7, &read_wait, &write_wait),
+                "Missing wait list storage or an unknown policy is rejected");
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    // Each worker waits on its gate at most once per run
+    pico_rtos_semaphore_init(&reader_a.gate, 0, 1);
+    pico_rtos_semaphore_init(&reader_b.gate, 0, 1);
+    pico_rtos_semaphore_init(&reader_c.gate, 0, 1);
+    pico_rtos_semaphore_init(&writer.gate, 0, 1);
+
+    test_shared_and_exclusive();
+    test_writer_preference();
+    test_reader_preference();
+    test_readers_admitted_together();
+    test_priority_inheritance();
+    test_invalid_use();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Reader-Writer Lock Tests...\n");
+    printf("====================================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file scheduler_performance_test.c
+ * @brief Context switch latency versus task count
+ *
+ * Two tasks of equal priority hand the CPU back and forth with
+ * pico_rtos_task_yield() while a number of lower priority filler tasks sit
+ * in the ready queues. With bitmap-indexed ready queues the cost of picking
+ * the next task does not depend on how many other tasks exist, so the
+ * per-switch latency at 64 tasks should stay close to the one at 4 tasks.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define PING_PRIORITY 3
+#define FILLER_PRIORITY 1
+#define TASK_STACK_SIZE 512
+#define CONTROLLER_STACK_SIZE 2048
+
+#define BENCH_SWITCHES 20000
+#define BENCH_ROUNDS 5
+#define MAX_BENCH_TASKS 64
+
+// Allowed growth of the per-switch latency from 4 to 64 tasks
+#define MAX_LATENCY_GROWTH_PERCENT 50
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static const uint32_t bench_task_counts[] = { 4, 16, 64 };
+#define BENCH_CONFIGS (sizeof(bench_task_counts) / sizeof(bench_task_counts[0]))
+
+// Terminated tasks stay linked until the kernel reaps them, so every round
+// gets its own control blocks
+static pico_rtos_task_t bench_tasks[BENCH_CONFIGS * BENCH_ROUNDS][MAX_BENCH_TASKS];
+static pico_rtos_task_t controller_task;
+
+static volatile bool fillers_running = false;
+static volatile uint32_t fillers_done = 0;
+static volatile uint32_t switches_left = 0;
+static volatile uint32_t pings_done = 0;
+static volatile uint64_t bench_start_us = 0;
+static volatile uint64_t bench_end_us = 0;
+
+static void ping_task_function(void *param) {
+    (void)param;
+
+    if (bench_start_us == 0) {
+        bench_start_us = time_us_64();
+    }
+
+    while (switches_left > 0) {
+        switches_left--;
+        pico_rtos_task_yield();
+    }
+
+    if (bench_end_us == 0) {
+        bench_end_us = time_us_64();
+    }
+    pings_done++;
+}
+
+// Stays ready without ever running while the ping tasks are busy
+static void filler_task_function(void *param) {
+    (void)param;
+    while (fillers_running) {
+        pico_rtos_task_delay(1);
+    }
+    fillers_done++;
+}
+
+// Returns the average latency of one yield-to-switch in nanoseconds
+static uint32_t run_benchmark(pico_rtos_task_t *tasks, uint32_t task_count) {
+    uint32_t filler_count = task_count - 2;
+
+    fillers_running = true;
+    fillers_done = 0;
+    for (uint32_t i = 0; i < filler_count; i++) {
+        pico_rtos_task_create(&tasks[i], "Filler", filler_task_function, NULL,
+                              TASK_STACK_SIZE, FILLER_PRIORITY);
+    }
+
+    // Let the fillers reach their delay loop so they sit in the ready and
+    // delayed sets like ordinary background tasks
+    pico_rtos_task_delay(5);
+
+    switches_left = BENCH_SWITCHES;
+    pings_done = 0;
+    bench_start_us = 0;
+    bench_end_us = 0;
+    pico_rtos_task_create(&tasks[filler_count], "PingA", ping_task_function, NULL,
+                          TASK_STACK_SIZE, PING_PRIORITY);
+    pico_rtos_task_create(&tasks[filler_count + 1], "PingB", ping_task_function, NULL,
+                          TASK_STACK_SIZE, PING_PRIORITY);
+
+    while (pings_done < 2) {
+        pico_rtos_task_delay(1);
+    }
+
+    fillers_running = false;
+    while (fillers_done < filler_count) {
+        pico_rtos_task_delay(1);
+    }
+
+    uint64_t elapsed_us = bench_end_us - bench_start_us;
+    return (uint32_t)((elapsed_us * 1000) / BENCH_SWITCHES);
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+    uint32_t best_ns[BENCH_CONFIGS];
+
+    printf("Tasks | Per switch (ns, best of %d)\n", BENCH_ROUNDS);
+    printf("------|---------------------------\n");
+
+    for (uint32_t c = 0; c < BENCH_CONFIGS; c++) {
+        best_ns[c] = UINT32_MAX;
+    }
+
+    // Interleave the configurations so slow phases of the machine hit all of them
+    for (uint32_t r = 0; r < BENCH_ROUNDS; r++) {
+        for (uint32_t c = 0; c < BENCH_CONFIGS; c++) {
+            uint32_t ns = run_benchmark(bench_tasks[r * BENCH_CONFIGS + c], bench_task_counts[c]);
+            if (ns < best_ns[c]) {
+                best_ns[c] = ns;
+            }
+        }
+    }
+
+    for (uint32_t c = 0; c < BENCH_CONFIGS; c++) {
+        printf("%5lu | %lu\n", (unsigned long)bench_task_counts[c], (unsigned long)best_ns[c]);
+    }
+
+    TEST_ASSERT(best_ns[0] > 0, "Switch latency is measurable");
+
+    uint32_t limit_ns = best_ns[0] + (best_ns[0] * MAX_LATENCY_GROWTH_PERCENT) / 100;
+    TEST_ASSERT(best_ns[BENCH_CONFIGS - 1] <= limit_ns,
+                "Switch latency at 64 tasks stays within 50% of the latency at 4 tasks");
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Scheduler Performance Tests...\n");
+    printf("=======================================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,315 @@
+/**
+ * @file static_allocation_test.c
+ * @brief Tests for static creation of kernel objects
+ *
+ * Every task and synchronization object here is created with a _static
+ * variant from caller-provided control block, stack and wait list storage.
+ * Checks that they work as their allocating counterparts do, that nothing
+ * is ever taken from pico_rtos_malloc() (the kernel's own tasks and queues
+ * included), that a static stack is never freed and can be reused once its
+ * task has been reaped, and that missing storage is rejected. Also built
+ * against a kernel with PICO_RTOS_STATIC_ALLOCATION_ONLY, where the
+ * allocating variants do not exist at all.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define WORKER_PRIORITY 6
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define QUEUE_LENGTH 4
+#define QUEUE_ITEMS 20
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+static uint32_t controller_stack[CONTROLLER_STACK_SIZE / sizeof(uint32_t)] __attribute__((aligned(8)));
+
+static pico_rtos_task_t worker_task;
+static uint32_t worker_stack[TASK_STACK_SIZE / sizeof(uint32_t)] __attribute__((aligned(8)));
+
+static pico_rtos_queue_t queue;
+static uint32_t queue_buffer[QUEUE_LENGTH];
+static pico_rtos_block_object_t queue_send_wait;
+static pico_rtos_block_object_t queue_receive_wait;
+
+static pico_rtos_mutex_t mutex;
+static pico_rtos_block_object_t mutex_wait;
+
+static pico_rtos_semaphore_t semaphore;
+static pico_rtos_block_object_t semaphore_wait;
+
+static pico_rtos_rwlock_t rwlock;
+static pico_rtos_block_object_t rwlock_read_wait;
+static pico_rtos_block_object_t rwlock_write_wait;
+
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+static pico_rtos_queue_set_t queue_set;
+static pico_rtos_block_object_t queue_set_wait;
+#endif
+
+#if PICO_RTOS_ENABLE_MPMC_RINGS
+static pico_rtos_mpmc_ring_t ring;
+static uint32_t ring_buffer[PICO_RTOS_MPMC_RING_BUFFER_WORDS(sizeof(uint32_t), QUEUE_LENGTH)];
+static pico_rtos_block_object_t ring_push_wait;
+static pico_rtos_block_object_t ring_pop_wait;
+#endif
+
+#ifdef PICO_RTOS_ENABLE_EVENT_GROUPS
+static pico_rtos_event_group_t event_group;
+static pico_rtos_block_object_t event_group_wait;
+#endif
+
+#ifdef PICO_RTOS_ENABLE_STREAM_BUFFERS
+static pico_rtos_stream_buffer_t stream;
+static uint8_t stream_storage[64];
+static pico_rtos_block_object_t stream_reader_wait;
+static pico_rtos_block_object_t stream_writer_wait;
+#endif
+
+#ifdef PICO_RTOS_ENABLE_MEMORY_POOLS
+static pico_rtos_memory_pool_t pool;
+static uint32_t pool_storage[64];
+static pico_rtos_block_object_t pool_wait;
+#endif
+
+static volatile uint32_t worker_runs = 0;
+static volatile uint32_t items_sent = 0;
+static volatile bool worker_held_mutex = false;
+
+static uint32_t allocation_count(void) {
+    uint32_t allocations;
+    pico_rtos_get_memory_stats(NULL, NULL, &allocations);
+    return allocations;
+}
+
+static void counting_task_function(void *param) {
+    (void)param;
+    worker_runs++;
+}
+
+static void producer_task_function(void *param) {
+    (void)param;
+    for (uint32_t i = 1; i <= QUEUE_ITEMS; i++) {
+        pico_rtos_queue_send(&queue, &i, PICO_RTOS_WAIT_FOREVER);
+        items_sent = i;
+    }
+}
+
+static void mutex_holder_task_function(void *param) {
+    (void)param;
+    pico_rtos_mutex_lock(&mutex, PICO_RTOS_WAIT_FOREVER);
+    worker_held_mutex = true;
+    pico_rtos_task_delay(5);
+    pico_rtos_mutex_unlock(&mutex);
+    pico_rtos_semaphore_give(&semaphore);
+}
+
+static void test_static_tasks(void) {
+    TEST_ASSERT(allocation_count() == 0, "The kernel's own tasks and queues allocate nothing");
+
+    // The worker outranks us, so it runs to completion as soon as we yield
+    bool created = pico_rtos_task_create_static(&worker_task, "Worker", counting_task_function, NULL,
+                                                worker_stack, sizeof(worker_stack), WORKER_PRIORITY);
+    pico_rtos_task_yield();
+    TEST_ASSERT(created && worker_runs == 1 && worker_task.stack_base == worker_stack,
+                "A task runs on the stack it was given");
+
+    pico_rtos_task_delay(2);
+    TEST_ASSERT(pico_rtos_get_terminated_task_count() == 0 && worker_task.stack_base == worker_stack,
+                "Reaping a task leaves its static stack alone");
+
+    created = pico_rtos_task_create_static(&worker_task, "Worker", counting_task_function, NULL,
+                                           worker_stack, sizeof(worker_stack), WORKER_PRIORITY);
+    pico_rtos_task_yield();
+    pico_rtos_task_delay(2);
+    TEST_ASSERT(created && worker_runs == 2, "A static stack can be reused once its task has ended");
+
+    TEST_ASSERT(!pico_rtos_task_create_static(&worker_task, "Worker", counting_task_function, NULL,
+                                              NULL, sizeof(worker_stack), WORKER_PRIORITY),
+                "Creating a task without a stack fails");
+}
+
+static void test_static_queue(void) {
+    bool ok = pico_rtos_queue_init_static(&queue, queue_buffer, sizeof(uint32_t), QUEUE_LENGTH,
+                                          &queue_send_wait, &queue_receive_wait);
+
+    // The producer fills the queue and then blocks until we drain it
+    items_sent = 0;
+    pico_rtos_task_create_static(&worker_task, "Producer", producer_task_function, NULL,
+                                 worker_stack, sizeof(worker_stack), WORKER_PRIORITY);
+    pico_rtos_task_yield();
+    uint32_t sent_before_receive = items_sent;
+
+    bool in_order = true;
+    for (uint32_t expected = 1; expected <= QUEUE_ITEMS; expected++) {
+        uint32_t value = 0;
+        if (!pico_rtos_queue_receive(&queue, &value, 100) || value != expected) {
+            in_order = false;
+            break;
+        }
+    }
+    pico_rtos_task_delay(2);
+
+    TEST_ASSERT(ok && sent_before_receive == QUEUE_LENGTH, "A full static queue blocks the sender");
+    TEST_ASSERT(in_order && items_sent == QUEUE_ITEMS, "A static queue wakes a blocked sender and keeps order");
+
+    pico_rtos_queue_delete(&queue);
+    TEST_ASSERT(!pico_rtos_queue_init_static(&queue, queue_buffer, sizeof(uint32_t), QUEUE_LENGTH,
+                                             &queue_send_wait, NULL),
+                "Initializing a queue without wait list storage fails");
+
+    uint32_t item = 7;
+    uint32_t received = 0;
+    ok = pico_rtos_queue_init_spsc_static(&queue, queue_buffer, sizeof(uint32_t), QUEUE_LENGTH,
+                                          &queue_send_wait, &queue_receive_wait);
+    TEST_ASSERT(ok && pico_rtos_queue_send(&queue, &item, 0) && pico_rtos_queue_receive(&queue, &received, 0) &&
+                received == 7 && !pico_rtos_queue_receive(&queue, &received, 2),
+                "A static SPSC queue passes items and waits when empty");
+    pico_rtos_queue_delete(&queue);
+}
+
+static void test_static_mutex_and_semaphore(void) {
+    bool ok = pico_rtos_mutex_init_static(&mutex, &mutex_wait) &&
+              pico_rtos_semaphore_init_static(&semaphore, 0, 1, &semaphore_wait);
+
+    worker_held_mutex = false;
+    pico_rtos_task_create_static(&worker_task, "Holder", mutex_holder_task_function, NULL,
+                                 worker_stack, sizeof(worker_stack), WORKER_PRIORITY);
+    pico_rtos_task_yield();
+
+    // The holder owns the mutex and sleeps; we block on it until released
+    bool blocked_then_locked = worker_held_mutex && pico_rtos_mutex_lock(&mutex, 100);
+    pico_rtos_mutex_unlock(&mutex);
+    bool signalled = pico_rtos_semaphore_take(&semaphore, 100);
+    bool timed_out = !pico_rtos_semaphore_take(&semaphore, 5);
+    pico_rtos_task_delay(2);
+
+    TEST_ASSERT(ok && blocked_then_locked, "A static mutex blocks a second locker until released");
+    TEST_ASSERT(signalled && timed_out, "A static semaphore signals and times out");
+
+    pico_rtos_mutex_delete(&mutex);
+    pico_rtos_semaphore_delete(&semaphore);
+    TEST_ASSERT(!pico_rtos_mutex_init_static(&mutex, NULL) &&
+                !pico_rtos_semaphore_init_static(&semaphore, 0, 1, NULL),
+                "Initializing a mutex or semaphore without wait list storage fails");
+}
+
+static void test_static_rwlock(void) {
+    bool ok = pico_rtos_rwlock_init_static(&rwlock, PICO_RTOS_RWLOCK_PREFER_WRITERS,
+                                           &rwlock_read_wait, &rwlock_write_wait);
+    bool shared = pico_rtos_rwlock_read_lock(&rwlock, 0) && !pico_rtos_rwlock_try_write_lock(&rwlock);
+    pico_rtos_rwlock_read_unlock(&rwlock);
+    bool exclusive = pico_rtos_rwlock_write_lock(&rwlock, 0) && !pico_rtos_rwlock_try_read_lock(&rwlock);
+    pico_rtos_rwlock_write_unlock(&rwlock);
+    TEST_ASSERT(ok && shared && exclusive, "A static reader-writer lock shares reads and excludes writes");
+    pico_rtos_rwlock_delete(&rwlock);
+}
+
+static void test_static_optional_objects(void) {
+#if PICO_RTOS_ENABLE_QUEUE_SETS
+    bool set_ok = pico_rtos_queue_set_init_static(&queue_set, &queue_set_wait) &&
+                  pico_rtos_semaphore_init_static(&semaphore, 0, 1, &semaphore_wait) &&
+                  pico_rtos_queue_set_add_semaphore(&queue_set, &semaphore);
+    bool idle = (pico_rtos_queue_set_select(&queue_set, 2) == NULL);
+    pico_rtos_semaphore_give(&semaphore);
+    TEST_ASSERT(set_ok && idle && pico_rtos_queue_set_select(&queue_set, 0) == &semaphore,
+                "A static queue set reports a ready member");
+    pico_rtos_semaphore_delete(&semaphore);
+    pico_rtos_queue_set_delete(&queue_set);
+#endif
+
+#if PICO_RTOS_ENABLE_MPMC_RINGS
+    uint32_t ring_item = 5;
+    bool ring_ok = pico_rtos_mpmc_ring_init_static(&ring, ring_buffer, sizeof(uint32_t), QUEUE_LENGTH,
+                                                   &ring_push_wait, &ring_pop_wait) &&
+                   pico_rtos_mpmc_ring_try_push(&ring, &ring_item);
+    ring_item = 0;
+    TEST_ASSERT(ring_ok && pico_rtos_mpmc_ring_pop(&ring, &ring_item, 0) && ring_item == 5 &&
+                !pico_rtos_mpmc_ring_pop(&ring, &ring_item, 2),
+                "A static MPMC ring passes items and waits when empty");
+    pico_rtos_mpmc_ring_delete(&ring);
+#endif
+
+#ifdef PICO_RTOS_ENABLE_EVENT_GROUPS
+    bool event_ok = pico_rtos_event_group_init_static(&event_group, &event_group_wait);
+    pico_rtos_event_group_set_bits(&event_group, 0x5);
+    uint32_t bits = pico_rtos_event_group_wait_bits(&event_group, 0x5, true, true, 10);
+    TEST_ASSERT(event_ok && (bits & 0x5) == 0x5, "A static event group delivers bits");
+    pico_rtos_event_group_delete(&event_group);
+#endif
+
+#ifdef PICO_RTOS_ENABLE_STREAM_BUFFERS
+    char received[8] = { 0 };
+    bool stream_ok = pico_rtos_stream_buffer_init_static(&stream, stream_storage, sizeof(stream_storage),
+                                                         &stream_reader_wait, &stream_writer_wait);
+    pico_rtos_stream_buffer_send(&stream, "static", 7, 0);
+    uint32_t length = pico_rtos_stream_buffer_receive(&stream, received, sizeof(received), 10);
+    TEST_ASSERT(stream_ok && length == 7 && strcmp(received, "static") == 0,
+                "A static stream buffer carries a message");
+    pico_rtos_stream_buffer_delete(&stream);
+#endif
+
+#ifdef PICO_RTOS_ENABLE_MEMORY_POOLS
+    bool pool_ok = pico_rtos_memory_pool_init_static(&pool, pool_storage, 32, 4, &pool_wait);
+    void *block = pico_rtos_memory_pool_alloc(&pool, 0);
+    TEST_ASSERT(pool_ok && block != NULL && pico_rtos_memory_pool_free(&pool, block),
+                "A static memory pool hands out blocks");
+    pico_rtos_memory_pool_destroy(&pool);
+#endif
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_static_tasks();
+    test_static_queue();
+    test_static_mutex_and_semaphore();
+    test_static_rwlock();
+    test_static_optional_objects();
+
+    TEST_ASSERT(allocation_count() == 0, "Nothing was allocated from start to finish");
+#if PICO_RTOS_STATIC_ALLOCATION_ONLY
+    TEST_ASSERT(!PICO_RTOS_ENABLE_HEAP, "A static-only kernel has no heap");
+#endif
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Static Allocation Tests...\n");
+    printf("===================================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create_static(&controller_task, "Controller", controller_task_function, NULL,
+                                 controller_stack, sizeof(controller_stack), CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
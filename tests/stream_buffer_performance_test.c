@@ -101,7 +101,7 @@ static void test_standard_operations_performance(void) {
         uint32_t send_end = get_time_us();
         
         if (sent != LARGE_MESSAGE_SIZE) {
-            printf("Send failed at iteration %lu\n", i);
+            printf("Send failed at iteration %lu\n", (unsigned long)i);
             continue;
         }
         
@@ -114,13 +114,13 @@ static void test_standard_operations_performance(void) {
         uint32_t receive_end = get_time_us();
         
         if (received != LARGE_MESSAGE_SIZE) {
-            printf("Receive failed at iteration %lu (received %lu bytes)\n", i, received);
+            printf("Receive failed at iteration %lu (received %lu bytes)\n", (unsigned long)i, (unsigned long)received);
             continue;
         }
         
         // Verify data integrity
         if (!verify_test_data(test_ctx.receive_buffer, LARGE_MESSAGE_SIZE, 0xAA)) {
-            printf("Data corruption detected at iteration %lu\n", i);
+            printf("Data corruption detected at iteration %lu\n", (unsigned long)i);
             continue;
         }
         
@@ -130,7 +130,7 @@ static void test_standard_operations_performance(void) {
         
         // Progress indicator
         if ((i + 1) % 20 == 0) {
-            printf("Completed %lu/%d iterations\n", i + 1, NUM_TEST_ITERATIONS);
+            printf("Completed %lu/%d iterations\n", (unsigned long)(i + 1), NUM_TEST_ITERATIONS);
         }
     }
     
@@ -138,11 +138,11 @@ static void test_standard_operations_performance(void) {
         test_ctx.standard_send_time_us = total_send_time / successful_iterations;
         test_ctx.standard_receive_time_us = total_receive_time / successful_iterations;
         
-        printf("Standard operations results (%lu successful iterations):\n", successful_iterations);
-        printf("  Average send time: %lu us\n", test_ctx.standard_send_time_us);
-        printf("  Average receive time: %lu us\n", test_ctx.standard_receive_time_us);
+        printf("Standard operations results (%lu successful iterations):\n", (unsigned long)successful_iterations);
+        printf("  Average send time: %lu us\n", (unsigned long)test_ctx.standard_send_time_us);
+        printf("  Average receive time: %lu us\n", (unsigned long)test_ctx.standard_receive_time_us);
         printf("  Total time per message: %lu us\n", 
-               test_ctx.standard_send_time_us + test_ctx.standard_receive_time_us);
+               (unsigned long)(test_ctx.standard_send_time_us + test_ctx.standard_receive_time_us));
     } else {
         printf("ERROR: No successful standard operations\n");
     }
@@ -189,7 +189,7 @@ static void test_zero_copy_operations_performance(void) {
                                                                         &send_zero_copy,
                                                                         PICO_RTOS_NO_WAIT);
         if (!send_started) {
-            printf("Zero-copy send start failed at iteration %lu\n", i);
+            printf("Zero-copy send start failed at iteration %lu\n", (unsigned long)i);
             continue;
         }
         
@@ -203,7 +203,7 @@ static void test_zero_copy_operations_performance(void) {
         uint32_t send_end = get_time_us();
         
         if (!send_completed) {
-            printf("Zero-copy send complete failed at iteration %lu\n", i);
+            printf("Zero-copy send complete failed at iteration %lu\n", (unsigned long)i);
             continue;
         }
         
@@ -215,7 +215,7 @@ static void test_zero_copy_operations_performance(void) {
                                                                               &receive_zero_copy,
                                                                               PICO_RTOS_NO_WAIT);
         if (!receive_started) {
-            printf("Zero-copy receive start failed at iteration %lu\n", i);
+            printf("Zero-copy receive start failed at iteration %lu\n", (unsigned long)i);
             continue;
         }
         
@@ -229,12 +229,12 @@ static void test_zero_copy_operations_performance(void) {
         uint32_t receive_end = get_time_us();
         
         if (!receive_completed) {
-            printf("Zero-copy receive complete failed at iteration %lu\n", i);
+            printf("Zero-copy receive complete failed at iteration %lu\n", (unsigned long)i);
             continue;
         }
         
         if (!data_valid) {
-            printf("Data corruption detected at iteration %lu\n", i);
+            printf("Data corruption detected at iteration %lu\n", (unsigned long)i);
             continue;
         }
         
@@ -244,7 +244,7 @@ static void test_zero_copy_operations_performance(void) {
         
         // Progress indicator
         if ((i + 1) % 20 == 0) {
-            printf("Completed %lu/%d iterations\n", i + 1, NUM_TEST_ITERATIONS);
+            printf("Completed %lu/%d iterations\n", (unsigned long)(i + 1), NUM_TEST_ITERATIONS);
         }
     }
     
@@ -252,11 +252,11 @@ static void test_zero_copy_operations_performance(void) {
         test_ctx.zero_copy_send_time_us = total_send_time / successful_iterations;
         test_ctx.zero_copy_receive_time_us = total_receive_time / successful_iterations;
         
-        printf("Zero-copy operations results (%lu successful iterations):\n", successful_iterations);
-        printf("  Average send time: %lu us\n", test_ctx.zero_copy_send_time_us);
-        printf("  Average receive time: %lu us\n", test_ctx.zero_copy_receive_time_us);
+        printf("Zero-copy operations results (%lu successful iterations):\n", (unsigned long)successful_iterations);
+        printf("  Average send time: %lu us\n", (unsigned long)test_ctx.zero_copy_send_time_us);
+        printf("  Average receive time: %lu us\n", (unsigned long)test_ctx.zero_copy_receive_time_us);
         printf("  Total time per message: %lu us\n", 
-               test_ctx.zero_copy_send_time_us + test_ctx.zero_copy_receive_time_us);
+               (unsigned long)(test_ctx.zero_copy_send_time_us + test_ctx.zero_copy_receive_time_us));
     } else {
         printf("ERROR: No successful zero-copy operations\n");
     }
@@ -285,7 +285,7 @@ static void analyze_performance_results(void) {
     printf("\nTiming Comparison:\n");
     printf("                    Standard    Zero-Copy    Improvement\n");
     printf("Send time (us):     %8lu    %8lu    ", 
-           test_ctx.standard_send_time_us, test_ctx.zero_copy_send_time_us);
+           (unsigned long)test_ctx.standard_send_time_us, (unsigned long)test_ctx.zero_copy_send_time_us);
     
     if (test_ctx.zero_copy_send_time_us < test_ctx.standard_send_time_us) {
         float improvement = ((float)(test_ctx.standard_send_time_us - test_ctx.zero_copy_send_time_us) / 
@@ -298,7 +298,7 @@ static void analyze_performance_results(void) {
     }
     
     printf("Receive time (us):  %8lu    %8lu    ", 
-           test_ctx.standard_receive_time_us, test_ctx.zero_copy_receive_time_us);
+           (unsigned long)test_ctx.standard_receive_time_us, (unsigned long)test_ctx.zero_copy_receive_time_us);
     
     if (test_ctx.zero_copy_receive_time_us < test_ctx.standard_receive_time_us) {
         float improvement = ((float)(test_ctx.standard_receive_time_us - test_ctx.zero_copy_receive_time_us) / 
@@ -310,7 +310,7 @@ static void analyze_performance_results(void) {
         printf("-%.1f%%\n", degradation);
     }
     
-    printf("Total time (us):    %8lu    %8lu    ", standard_total, zero_copy_total);
+    printf("Total time (us):    %8lu    %8lu    ", (unsigned long)standard_total, (unsigned long)zero_copy_total);
     
     if (zero_copy_total < standard_total) {
         float improvement = ((float)(standard_total - zero_copy_total) / standard_total) * 100.0f;
@@ -325,8 +325,8 @@ static void analyze_performance_results(void) {
     uint32_t zero_copy_throughput_mbps = (uint32_t)(((uint64_t)LARGE_MESSAGE_SIZE * 8 * 1000000) / (zero_copy_total * 1024 * 1024));
     
     printf("\nThroughput Analysis:\n");
-    printf("Standard operations: %lu Mbps\n", standard_throughput_mbps);
-    printf("Zero-copy operations: %lu Mbps\n", zero_copy_throughput_mbps);
+    printf("Standard operations: %lu Mbps\n", (unsigned long)standard_throughput_mbps);
+    printf("Zero-copy operations: %lu Mbps\n", (unsigned long)zero_copy_throughput_mbps);
     
     // Memory efficiency analysis
     printf("\nMemory Efficiency:\n");
@@ -364,7 +364,7 @@ static void test_threshold_analysis(void) {
         uint32_t message_size = test_sizes[s];
         
         if (message_size > STREAM_BUFFER_SIZE / 4) {
-            printf("%12lu | Too large for buffer\n", message_size);
+            printf("%12lu | Too large for buffer\n", (unsigned long)message_size);
             continue;
         }
         
@@ -426,10 +426,10 @@ static void test_threshold_analysis(void) {
         }
         
         // Print results
-        printf("%12lu | %13lu | ", message_size, standard_time);
+        printf("%12lu | %13lu | ", (unsigned long)message_size, (unsigned long)standard_time);
         
         if (zero_copy_time > 0) {
-            printf("%14lu | ", zero_copy_time);
+            printf("%14lu | ", (unsigned long)zero_copy_time);
             if (zero_copy_time < standard_time) {
                 float improvement = ((float)(standard_time - zero_copy_time) / standard_time) * 100.0f;
                 printf("%.1f%%", improvement);
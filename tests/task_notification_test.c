@@ -0,0 +1,283 @@
+/**
+ * @file task_notification_test.c
+ * @brief Tests and benchmark for direct-to-task notifications
+ *
+ * Checks the notification actions (increment, set bits, overwrite and
+ * no-overwrite), that a waiting task is woken directly by another task or
+ * an interrupt, that the switch to a task woken by an interrupt waits for
+ * the interrupt to return, and that a wait times out on time. Then compares a
+ * notification ping-pong between two tasks with the same exchange through
+ * a pair of semaphores; the host runs it on the simulated clock, which
+ * does not move during the benchmarks, so only hardware prints timings.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define WAITER_PRIORITY 6
+#define ECHO_PRIORITY 4
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define WAIT_TIMEOUT 10
+#define ISR_ALARM_MS 5
+#define PING_PONG_ROUND_TRIPS 20000
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+// Each task gets its own TCB; a terminated task stays linked until cleanup
+static pico_rtos_task_t bits_waiter_task;
+static pico_rtos_task_t isr_waiter_task;
+static pico_rtos_task_t notify_echo_task;
+static pico_rtos_task_t semaphore_echo_task;
+
+static volatile bool waiter_woken = false;
+static volatile uint32_t waiter_value = 0;
+static volatile uint32_t waiter_wake_tick = 0;
+static volatile uint32_t isr_tick = 0;
+static volatile bool isr_switched = false;
+
+static pico_rtos_semaphore_t ping_semaphore;
+static pico_rtos_semaphore_t pong_semaphore;
+
+// Waits for a set of bits from another task
+static void bits_waiter_function(void *param) {
+    (void)param;
+    uint32_t value = 0;
+    waiter_woken = pico_rtos_task_notify_wait(0, UINT32_MAX, &value, PICO_RTOS_WAIT_FOREVER);
+    waiter_value = value;
+}
+
+// Waits for a give from an interrupt
+static void isr_waiter_function(void *param) {
+    (void)param;
+    waiter_value = pico_rtos_task_notify_take(true, PICO_RTOS_WAIT_FOREVER);
+    waiter_wake_tick = pico_rtos_get_tick_count();
+    waiter_woken = true;
+}
+
+static void notify_echo_function(void *param) {
+    (void)param;
+    for (uint32_t i = 0; i < PING_PONG_ROUND_TRIPS; i++) {
+        pico_rtos_task_notify_take(true, PICO_RTOS_WAIT_FOREVER);
+        pico_rtos_task_notify_give(&controller_task);
+    }
+}
+
+static void semaphore_echo_function(void *param) {
+    (void)param;
+    for (uint32_t i = 0; i < PING_PONG_ROUND_TRIPS; i++) {
+        pico_rtos_semaphore_take(&ping_semaphore, PICO_RTOS_WAIT_FOREVER);
+        pico_rtos_semaphore_give(&pong_semaphore);
+    }
+}
+
+static int64_t give_alarm_callback(alarm_id_t id, void *user_data) {
+    (void)id;
+    (void)user_data;
+    pico_rtos_interrupt_enter();
+    isr_tick = pico_rtos_get_tick_count();
+    pico_rtos_task_t *interrupted = pico_rtos_get_current_task();
+    pico_rtos_task_notify_give_from_isr(&isr_waiter_task);
+    isr_switched = (pico_rtos_get_current_task() != interrupted);
+    pico_rtos_interrupt_exit();
+    return 0;
+}
+
+static void test_counting(void) {
+    pico_rtos_task_t *self = pico_rtos_get_current_task();
+    for (int i = 0; i < 3; i++) {
+        pico_rtos_task_notify_give(self);
+    }
+
+    uint32_t first = pico_rtos_task_notify_take(false, PICO_RTOS_NO_WAIT);
+    uint32_t second = pico_rtos_task_notify_take(false, PICO_RTOS_NO_WAIT);
+    uint32_t cleared = pico_rtos_task_notify_take(true, PICO_RTOS_NO_WAIT);
+    uint32_t empty = pico_rtos_task_notify_take(true, PICO_RTOS_NO_WAIT);
+
+    TEST_ASSERT(first == 3 && second == 2, "Take without clearing counts gives down like a semaphore");
+    TEST_ASSERT(cleared == 1 && empty == 0, "Take with clearing consumes every outstanding give");
+}
+
+static void test_value_actions(void) {
+    pico_rtos_task_t *self = pico_rtos_get_current_task();
+    uint32_t value = 0;
+
+    pico_rtos_task_notify(self, 42, PICO_RTOS_NOTIFY_SET_VALUE_WITHOUT_OVERWRITE);
+    bool kept = !pico_rtos_task_notify(self, 7, PICO_RTOS_NOTIFY_SET_VALUE_WITHOUT_OVERWRITE);
+    pico_rtos_task_notify_wait(0, 0, &value, PICO_RTOS_NO_WAIT);
+    TEST_ASSERT(kept && value == 42, "Setting without overwrite keeps an unread value");
+
+    pico_rtos_task_notify(self, 42, PICO_RTOS_NOTIFY_SET_VALUE_WITHOUT_OVERWRITE);
+    bool replaced = pico_rtos_task_notify(self, 7, PICO_RTOS_NOTIFY_SET_VALUE_WITH_OVERWRITE);
+    pico_rtos_task_notify_wait(0, UINT32_MAX, &value, PICO_RTOS_NO_WAIT);
+    TEST_ASSERT(replaced && value == 7, "Setting with overwrite replaces an unread value");
+
+    bool received = pico_rtos_task_notify_wait(0, 0, &value, PICO_RTOS_NO_WAIT);
+    TEST_ASSERT(!received, "A received notification is no longer pending");
+}
+
+static void test_bits_wake_waiter(void) {
+    waiter_woken = false;
+    waiter_value = 0;
+    pico_rtos_task_create(&bits_waiter_task, "Waiter", bits_waiter_function, NULL, TASK_STACK_SIZE, WAITER_PRIORITY);
+    pico_rtos_task_delay(1);
+
+    // The waiter outranks us, so it is already waiting, and must run as
+    // soon as the second bit arrives
+    pico_rtos_task_notify(&bits_waiter_task, 0x1, PICO_RTOS_NOTIFY_SET_BITS);
+    bool woken_by_first = waiter_woken;
+    pico_rtos_task_notify(&bits_waiter_task, 0x4, PICO_RTOS_NOTIFY_SET_BITS);
+    bool woken_by_second = waiter_woken;
+
+    TEST_ASSERT(woken_by_first && waiter_value == 0x1, "A notification wakes a waiting task directly");
+    TEST_ASSERT(woken_by_second && bits_waiter_task.notify_value == 0x4,
+                "Bits set after the wait are kept for the next wait");
+    pico_rtos_task_delay(1);
+}
+
+static void test_isr_give(void) {
+    waiter_woken = false;
+    isr_switched = true;
+    pico_rtos_task_create(&isr_waiter_task, "IsrWaiter", isr_waiter_function, NULL, TASK_STACK_SIZE, WAITER_PRIORITY);
+
+    // Half a tick off the tick boundary, so no tick is due along with it
+    add_alarm_in_us(ISR_ALARM_MS * 1000 + PICO_RTOS_TICK_PERIOD_US / 2, give_alarm_callback, NULL, true);
+    pico_rtos_task_delay(ISR_ALARM_MS * 4);
+
+    TEST_ASSERT(waiter_woken && waiter_value == 1, "A give from an interrupt wakes the waiting task");
+    TEST_ASSERT(!isr_switched, "The interrupted task stays current until the interrupt returns");
+    TEST_ASSERT(waiter_wake_tick == isr_tick, "The task runs as soon as the interrupt returns");
+}
+
+static void test_wait_timeout(void) {
+    uint32_t start = pico_rtos_get_tick_count();
+    bool received = pico_rtos_task_notify_wait(0, 0, NULL, WAIT_TIMEOUT);
+    uint32_t waited = pico_rtos_get_tick_count() - start;
+
+    TEST_ASSERT(!received && waited == WAIT_TIMEOUT + 1, "A notification wait times out on time");
+
+    // A notification sent after the timeout stays pending for the next wait
+    pico_rtos_task_notify(pico_rtos_get_current_task(), 0, PICO_RTOS_NOTIFY_NO_ACTION);
+    TEST_ASSERT(pico_rtos_task_notify_wait(0, 0, NULL, PICO_RTOS_NO_WAIT),
+                "A notification after a timeout is received by the next wait");
+}
+
+#define UNCONTENDED_OPERATIONS 200000
+
+static void test_uncontended_benchmark(void) {
+    pico_rtos_task_t *self = pico_rtos_get_current_task();
+
+    uint64_t start_us = time_us_64();
+    uint32_t notify_taken = 0;
+    for (uint32_t i = 0; i < UNCONTENDED_OPERATIONS; i++) {
+        pico_rtos_task_notify_give(self);
+        notify_taken += pico_rtos_task_notify_take(true, PICO_RTOS_NO_WAIT);
+    }
+    uint64_t notify_us = time_us_64() - start_us;
+
+    static pico_rtos_semaphore_t semaphore;
+    pico_rtos_semaphore_init(&semaphore, 0, 1);
+    start_us = time_us_64();
+    uint32_t semaphore_taken = 0;
+    for (uint32_t i = 0; i < UNCONTENDED_OPERATIONS; i++) {
+        pico_rtos_semaphore_give(&semaphore);
+        semaphore_taken += pico_rtos_semaphore_take(&semaphore, PICO_RTOS_NO_WAIT) ? 1 : 0;
+    }
+    uint64_t semaphore_us = time_us_64() - start_us;
+    pico_rtos_semaphore_delete(&semaphore);
+
+    printf("Give + take without waiting: %lu ns with notifications, %lu ns with semaphores\n",
+           (unsigned long)(notify_us * 1000 / UNCONTENDED_OPERATIONS),
+           (unsigned long)(semaphore_us * 1000 / UNCONTENDED_OPERATIONS));
+
+    TEST_ASSERT(notify_taken == UNCONTENDED_OPERATIONS && semaphore_taken == UNCONTENDED_OPERATIONS,
+                "Every give is taken");
+}
+
+static void test_ping_pong_benchmark(void) {
+    pico_rtos_task_create(&notify_echo_task, "NotifyEcho", notify_echo_function, NULL, TASK_STACK_SIZE, ECHO_PRIORITY);
+    uint64_t start_us = time_us_64();
+    uint32_t notify_round_trips = 0;
+    for (uint32_t i = 0; i < PING_PONG_ROUND_TRIPS; i++) {
+        pico_rtos_task_notify_give(&notify_echo_task);
+        if (pico_rtos_task_notify_take(true, PICO_RTOS_WAIT_FOREVER) != 0) {
+            notify_round_trips++;
+        }
+    }
+    uint64_t notify_us = time_us_64() - start_us;
+
+    pico_rtos_semaphore_init(&ping_semaphore, 0, 1);
+    pico_rtos_semaphore_init(&pong_semaphore, 0, 1);
+    pico_rtos_task_create(&semaphore_echo_task, "SemEcho", semaphore_echo_function, NULL, TASK_STACK_SIZE, ECHO_PRIORITY);
+    start_us = time_us_64();
+    uint32_t semaphore_round_trips = 0;
+    for (uint32_t i = 0; i < PING_PONG_ROUND_TRIPS; i++) {
+        pico_rtos_semaphore_give(&ping_semaphore);
+        if (pico_rtos_semaphore_take(&pong_semaphore, PICO_RTOS_WAIT_FOREVER)) {
+            semaphore_round_trips++;
+        }
+    }
+    uint64_t semaphore_us = time_us_64() - start_us;
+
+    printf("Ping-pong round trip: %lu ns with notifications, %lu ns with semaphores\n",
+           (unsigned long)(notify_us * 1000 / PING_PONG_ROUND_TRIPS),
+           (unsigned long)(semaphore_us * 1000 / PING_PONG_ROUND_TRIPS));
+
+    TEST_ASSERT(notify_round_trips == PING_PONG_ROUND_TRIPS, "Every notification round trip completes");
+    TEST_ASSERT(semaphore_round_trips == PING_PONG_ROUND_TRIPS, "Every semaphore round trip completes");
+
+    pico_rtos_task_delay(1);
+    pico_rtos_semaphore_delete(&ping_semaphore);
+    pico_rtos_semaphore_delete(&pong_semaphore);
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_counting();
+    test_value_actions();
+    test_bits_wake_waiter();
+    test_isr_give();
+    test_wait_timeout();
+    test_uncontended_benchmark();
+    test_ping_pong_benchmark();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Task Notification Tests...\n");
+    printf("===================================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,212 @@
+/**
+ * @file task_reaping_test.c
+ * @brief Tests for reaping terminated tasks from the idle task
+ *
+ * A task that returns or is deleted leaves the task list at once and waits
+ * on a zombie list; the idle task frees its stack, a bounded batch per pass.
+ * Checks that the tick never frees a stack, that the idle task does, that
+ * tasks deleting themselves or others go the same way, that a pass reaps
+ * at most PICO_RTOS_TASK_REAP_BATCH tasks, and that a control block can be
+ * reused before its old task has been reaped.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define WORKER_PRIORITY 7
+#define SLEEPER_PRIORITY 3
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define BURST_TASKS (PICO_RTOS_TASK_REAP_BATCH * 2 + 1)
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t worker_task;
+static pico_rtos_task_t sleeper_task;
+static pico_rtos_task_t burst_tasks[BURST_TASKS];
+
+static volatile uint32_t worker_runs = 0;
+static volatile uint32_t first_pass_remaining = 0;
+static volatile bool first_pass_seen = false;
+
+static void worker_task_function(void *param) {
+    (void)param;
+    worker_runs++;
+}
+
+static void self_deleting_task_function(void *param) {
+    (void)param;
+    worker_runs++;
+    pico_rtos_task_delete(&worker_task);
+}
+
+static void sleeper_task_function(void *param) {
+    (void)param;
+    while (1) {
+        pico_rtos_task_delay(1000);
+    }
+}
+
+static void record_first_pass(void) {
+    if (!first_pass_seen) {
+        first_pass_remaining = pico_rtos_get_terminated_task_count();
+        first_pass_seen = true;
+    }
+}
+
+static uint32_t current_memory(void) {
+    uint32_t current;
+    pico_rtos_get_memory_stats(&current, NULL, NULL);
+    return current;
+}
+
+static bool in_task_list(pico_rtos_task_t *task) {
+    bool found = false;
+    pico_rtos_enter_critical();
+    for (pico_rtos_task_t *t = pico_rtos_debug_get_task_list(); t != NULL; t = t->next) {
+        if (t == task) {
+            found = true;
+            break;
+        }
+    }
+    pico_rtos_exit_critical();
+    return found;
+}
+
+static void test_ended_task_reaped_by_idle(void) {
+    uint32_t baseline = current_memory();
+
+    // The worker outranks us, so it runs to completion as soon as we yield
+    pico_rtos_task_create(&worker_task, "Worker", worker_task_function, NULL, TASK_STACK_SIZE, WORKER_PRIORITY);
+    pico_rtos_task_yield();
+    TEST_ASSERT(worker_runs == 1 && !in_task_list(&worker_task) &&
+                pico_rtos_get_terminated_task_count() == 1,
+                "A task that returns leaves the task list and waits to be reaped");
+
+    pico_rtos_system_stats_t stats;
+    pico_rtos_get_system_stats(&stats);
+    TEST_ASSERT(stats.terminated_tasks == 1, "System statistics count tasks waiting to be reaped");
+
+    // Ticks pass but the idle task never runs
+    busy_wait_us(5 * PICO_RTOS_TICK_PERIOD_US);
+    TEST_ASSERT(pico_rtos_get_terminated_task_count() == 1 && current_memory() >= baseline + TASK_STACK_SIZE,
+                "The tick does not free stacks");
+
+    pico_rtos_task_delay(2);
+    TEST_ASSERT(pico_rtos_get_terminated_task_count() == 0 && current_memory() == baseline &&
+                worker_task.stack_base == NULL,
+                "The idle task frees the stack of an ended task");
+}
+
+static void test_deleted_tasks_reaped(void) {
+    uint32_t baseline = current_memory();
+
+    pico_rtos_task_create(&sleeper_task, "Sleeper", sleeper_task_function, NULL, TASK_STACK_SIZE, SLEEPER_PRIORITY);
+    pico_rtos_task_delay(2);
+    pico_rtos_task_delete(&sleeper_task);
+    TEST_ASSERT(!in_task_list(&sleeper_task) && sleeper_task.state == PICO_RTOS_TASK_STATE_TERMINATED &&
+                pico_rtos_get_terminated_task_count() == 1,
+                "A deleted task waits to be reaped");
+
+    worker_runs = 0;
+    pico_rtos_task_create(&worker_task, "SelfDelete", self_deleting_task_function, NULL, TASK_STACK_SIZE,
+                          WORKER_PRIORITY);
+    pico_rtos_task_yield();
+    TEST_ASSERT(worker_runs == 1 && !in_task_list(&worker_task) && pico_rtos_get_terminated_task_count() == 2,
+                "A task that deletes itself waits to be reaped");
+
+    pico_rtos_task_delay(2);
+    TEST_ASSERT(pico_rtos_get_terminated_task_count() == 0 && current_memory() == baseline,
+                "The idle task frees the stacks of deleted tasks");
+}
+
+static void test_reaping_is_bounded(void) {
+    uint32_t baseline = current_memory();
+
+    for (int i = 0; i < BURST_TASKS; i++) {
+        pico_rtos_task_create(&burst_tasks[i], "Burst", worker_task_function, NULL, TASK_STACK_SIZE,
+                              WORKER_PRIORITY);
+    }
+    pico_rtos_task_yield();
+    uint32_t waiting = pico_rtos_get_terminated_task_count();
+
+    first_pass_seen = false;
+    pico_rtos_set_idle_hook(record_first_pass);
+    pico_rtos_task_delay(2);
+    pico_rtos_clear_idle_hook();
+
+    printf("%lu ended tasks, %lu left after one idle pass\n",
+           (unsigned long)waiting, (unsigned long)first_pass_remaining);
+
+    TEST_ASSERT(waiting == BURST_TASKS && first_pass_seen &&
+                first_pass_remaining == BURST_TASKS - PICO_RTOS_TASK_REAP_BATCH,
+                "One idle pass reaps at most PICO_RTOS_TASK_REAP_BATCH tasks");
+
+    pico_rtos_task_delay(2);
+    TEST_ASSERT(pico_rtos_get_terminated_task_count() == 0 && current_memory() == baseline,
+                "Later passes reap the rest");
+}
+
+static void test_control_block_reuse(void) {
+    uint32_t baseline = current_memory();
+
+    worker_runs = 0;
+    pico_rtos_task_create(&worker_task, "Worker", worker_task_function, NULL, TASK_STACK_SIZE, WORKER_PRIORITY);
+    pico_rtos_task_yield();
+    pico_rtos_task_create(&worker_task, "Worker", worker_task_function, NULL, TASK_STACK_SIZE, WORKER_PRIORITY);
+    pico_rtos_task_yield();
+    TEST_ASSERT(worker_runs == 2 && pico_rtos_get_terminated_task_count() == 1,
+                "A control block can be reused before its old task is reaped");
+
+    pico_rtos_task_delay(2);
+    TEST_ASSERT(pico_rtos_get_terminated_task_count() == 0 && current_memory() == baseline,
+                "Reusing a control block does not leak the old stack");
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_ended_task_reaped_by_idle();
+    test_deleted_tasks_reaped();
+    test_reaping_is_bounded();
+    test_control_block_reuse();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Task Reaping Tests...\n");
+    printf("==============================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,205 @@
+/**
+ * @file tickless_idle_test.c
+ * @brief Tests for tickless idle
+ *
+ * Built against a kernel with PICO_RTOS_ENABLE_TICKLESS_IDLE on the host's
+ * simulated clock, so every check is exact and host load cannot move it.
+ * While every task is delayed the periodic tick should stop, so at most the
+ * tick already due is taken as an interrupt, yet the tick count, delays,
+ * timed waits and software timers must land on the same ticks as with a
+ * periodic tick. While a task is busy the tick has to keep running as usual.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 3
+#define TASK_STACK_SIZE 1024
+
+#define LONG_DELAY_MS 200
+#define TIMER_PERIOD_MS 50
+#define TIMER_PERIODS 8
+#define LONG_TIMER_PERIOD_MS 700
+#define WAIT_TIMEOUT_MS 150
+#define BUSY_MS 20
+
+// Going idle may still take the tick that was already due
+#define IDLE_TICK_INTERRUPTS 1
+
+// Ticks by which the tick count may trail the clock; none on the simulated
+// clock, where ticks fire exactly on their alarm
+#if PICO_RTOS_HOST_VIRTUAL_TIME
+#define CLOCK_SLACK_TICKS 0
+#else
+#define CLOCK_SLACK_TICKS 1
+#endif
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_timer_t periodic_timer;
+static pico_rtos_timer_t long_timer;
+static pico_rtos_semaphore_t never_given;
+
+static volatile uint32_t timer_fired = 0;
+static volatile uint32_t long_timer_tick = 0;
+
+static uint32_t difference(uint32_t a, uint32_t b) {
+    return (a > b) ? a - b : b - a;
+}
+
+static void periodic_timer_callback(void *param) {
+    (void)param;
+    timer_fired++;
+}
+
+static void long_timer_callback(void *param) {
+    (void)param;
+    long_timer_tick = pico_rtos_get_tick_count();
+}
+
+static void test_long_delay_skips_ticks(void) {
+    uint32_t start_tick = pico_rtos_get_tick_count();
+    uint32_t start_interrupts = pico_rtos_get_tick_interrupt_count();
+    uint64_t start_us = time_us_64();
+
+    pico_rtos_task_delay(LONG_DELAY_MS);
+
+    uint64_t elapsed_us = time_us_64() - start_us;
+    uint32_t elapsed_ticks = pico_rtos_get_tick_count() - start_tick;
+    uint32_t interrupts = pico_rtos_get_tick_interrupt_count() - start_interrupts;
+
+    printf("Delay of %d ms: %lu ticks, %lu tick interrupts, %lu us\n", LONG_DELAY_MS,
+           (unsigned long)elapsed_ticks, (unsigned long)interrupts, (unsigned long)elapsed_us);
+
+    // A delay of n ticks wakes on the tick after now + n
+    TEST_ASSERT(elapsed_ticks == LONG_DELAY_MS + 1, "Delayed task wakes up on its tick");
+    TEST_ASSERT(difference((uint32_t)(elapsed_us / PICO_RTOS_TICK_PERIOD_US), elapsed_ticks) <= CLOCK_SLACK_TICKS,
+                "Tick count advances by the time spent idle");
+    TEST_ASSERT(interrupts <= IDLE_TICK_INTERRUPTS, "Periodic tick stops while idle");
+}
+
+static void test_tick_count_tracks_time(void) {
+    uint32_t start_tick = pico_rtos_get_tick_count();
+    uint64_t start_us = time_us_64();
+
+    for (int i = 0; i < 10; i++) {
+        pico_rtos_task_delay(17);
+    }
+
+    uint32_t elapsed_ms = (uint32_t)((time_us_64() - start_us) / 1000);
+    uint32_t elapsed_ticks = pico_rtos_get_tick_count() - start_tick;
+    uint32_t elapsed_tick_ms = elapsed_ticks * 1000 / pico_rtos_get_tick_rate_hz();
+
+    TEST_ASSERT(difference(elapsed_tick_ms, elapsed_ms) <= CLOCK_SLACK_TICKS * PICO_RTOS_TICK_PERIOD_US / 1000,
+                "Tick count stays in step with the clock across idle periods");
+}
+
+static void test_timer_fires_while_idle(void) {
+    timer_fired = 0;
+    uint32_t start_interrupts = pico_rtos_get_tick_interrupt_count();
+    uint32_t start_tick = pico_rtos_get_tick_count();
+
+    pico_rtos_timer_start(&periodic_timer);
+    pico_rtos_task_delay(TIMER_PERIOD_MS * TIMER_PERIODS + TIMER_PERIOD_MS / 2);
+    pico_rtos_timer_stop(&periodic_timer);
+
+    uint32_t elapsed_ticks = pico_rtos_get_tick_count() - start_tick;
+    uint32_t interrupts = pico_rtos_get_tick_interrupt_count() - start_interrupts;
+
+    printf("Timer fired %lu times in %lu ticks with %lu tick interrupts\n",
+           (unsigned long)timer_fired, (unsigned long)elapsed_ticks, (unsigned long)interrupts);
+
+    TEST_ASSERT(timer_fired == TIMER_PERIODS, "Software timer keeps its period while idle");
+    TEST_ASSERT(interrupts <= IDLE_TICK_INTERRUPTS, "Pending timers do not bring back the periodic tick");
+}
+
+// Spans several outer timer wheel slots, so the idle task has to wake for
+// them being redistributed as well as for the expiry itself
+static void test_long_timer_fires_on_time(void) {
+    uint32_t start_interrupts = pico_rtos_get_tick_interrupt_count();
+
+    pico_rtos_timer_start(&long_timer);
+    uint32_t expected_tick = long_timer.start_time + LONG_TIMER_PERIOD_MS;
+    pico_rtos_task_delay(LONG_TIMER_PERIOD_MS + 20);
+
+    uint32_t interrupts = pico_rtos_get_tick_interrupt_count() - start_interrupts;
+
+    TEST_ASSERT(long_timer_tick == expected_tick, "Long software timer fires on its expiry tick while idle");
+    TEST_ASSERT(interrupts <= IDLE_TICK_INTERRUPTS, "Long timers do not bring back the periodic tick");
+}
+
+static void test_timed_wait_expires_while_idle(void) {
+    uint32_t start_tick = pico_rtos_get_tick_count();
+    uint32_t start_interrupts = pico_rtos_get_tick_interrupt_count();
+
+    bool taken = pico_rtos_semaphore_take(&never_given, WAIT_TIMEOUT_MS);
+
+    uint32_t elapsed_ticks = pico_rtos_get_tick_count() - start_tick;
+    uint32_t interrupts = pico_rtos_get_tick_interrupt_count() - start_interrupts;
+
+    TEST_ASSERT(!taken && elapsed_ticks == WAIT_TIMEOUT_MS + 1, "Timed wait expires on time while idle");
+    TEST_ASSERT(interrupts <= IDLE_TICK_INTERRUPTS, "Timed waits do not bring back the periodic tick");
+}
+
+static void test_tick_runs_while_busy(void) {
+    uint32_t start_interrupts = pico_rtos_get_tick_interrupt_count();
+    busy_wait_ms(BUSY_MS);
+    uint32_t interrupts = pico_rtos_get_tick_interrupt_count() - start_interrupts;
+
+    TEST_ASSERT(difference(interrupts, BUSY_MS * 1000 / PICO_RTOS_TICK_PERIOD_US) <= CLOCK_SLACK_TICKS,
+                "Periodic tick keeps running while a task is busy");
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_long_delay_skips_ticks();
+    test_tick_count_tracks_time();
+    test_timer_fires_while_idle();
+    test_long_timer_fires_on_time();
+    test_timed_wait_expires_while_idle();
+    test_tick_runs_while_busy();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Tickless Idle Tests...\n");
+    printf("===============================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_timer_init(&periodic_timer, "Periodic", periodic_timer_callback, NULL,
+                         TIMER_PERIOD_MS, true);
+    pico_rtos_timer_init(&long_timer, "Long", long_timer_callback, NULL,
+                         LONG_TIMER_PERIOD_MS, false);
+    pico_rtos_semaphore_init(&never_given, 0, 1);
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          TASK_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,202 @@
+/**
+ * @file time_slice_test.c
+ * @brief Tests for round-robin time slicing
+ *
+ * CPU-bound tasks of equal priority never block or yield. Without a time
+ * slice the first one keeps the CPU; with one, the tick rotates them so each
+ * gets a share in proportion to its quantum. Higher priority tasks still
+ * preempt straight away.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define WORKER_PRIORITY 2
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define WORKERS 3
+#define RUN_WINDOW_MS 150
+#define SHARED_QUANTUM 5
+#define SHORT_QUANTUM 2
+#define LONG_QUANTUM 6
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+typedef struct {
+    volatile uint32_t ticks_run;     // Ticks on which this worker was seen running
+    volatile uint32_t turns;         // Times it got the CPU back from a peer
+} worker_t;
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t worker_tasks[WORKERS];
+static worker_t workers[WORKERS];
+
+static volatile bool workers_running = false;
+static volatile uint32_t workers_done = 0;
+static volatile int last_worker = -1;
+
+// Spins without ever yielding, counting the ticks it observes
+static void worker_task_function(void *param) {
+    int index = (int)(intptr_t)param;
+    worker_t *worker = &workers[index];
+    uint32_t last_tick = pico_rtos_get_tick_count();
+
+    while (workers_running) {
+        uint32_t now = pico_rtos_get_tick_count();
+        if (now != last_tick) {
+            last_tick = now;
+            worker->ticks_run++;
+        }
+        if (last_worker != index) {
+            last_worker = index;
+            worker->turns++;
+        }
+    }
+    workers_done++;
+}
+
+static void run_workers(uint32_t count, const uint32_t *quanta) {
+    workers_running = true;
+    workers_done = 0;
+    last_worker = -1;
+    for (uint32_t i = 0; i < count; i++) {
+        workers[i].ticks_run = 0;
+        workers[i].turns = 0;
+        pico_rtos_task_create(&worker_tasks[i], "Worker", worker_task_function, (void *)(intptr_t)i,
+                              TASK_STACK_SIZE, WORKER_PRIORITY);
+        pico_rtos_task_set_time_slice(&worker_tasks[i], (quanta != NULL) ? quanta[i] : 0);
+    }
+
+    pico_rtos_task_delay(RUN_WINDOW_MS);
+
+    // Let every worker see the flag and finish before the next case
+    workers_running = false;
+    while (workers_done < count) {
+        pico_rtos_task_delay(1);
+    }
+}
+
+static void test_no_slicing_keeps_cpu(void) {
+    pico_rtos_set_time_slice(0);
+    run_workers(2, NULL);
+
+    printf("Without slicing: %lu and %lu ticks\n",
+           (unsigned long)workers[0].ticks_run, (unsigned long)workers[1].ticks_run);
+
+    TEST_ASSERT(workers[0].ticks_run > RUN_WINDOW_MS / 2 && workers[1].turns == 0,
+                "Without a time slice the running task keeps the CPU from its peers");
+}
+
+static void test_shared_quantum_rotates(void) {
+    pico_rtos_set_time_slice(SHARED_QUANTUM);
+    TEST_ASSERT(pico_rtos_get_time_slice() == SHARED_QUANTUM, "System time slice can be read back");
+
+    run_workers(WORKERS, NULL);
+
+    uint32_t total = 0;
+    uint32_t min_share = UINT32_MAX;
+    bool all_rotated = true;
+    for (uint32_t i = 0; i < WORKERS; i++) {
+        total += workers[i].ticks_run;
+        if (workers[i].ticks_run < min_share) {
+            min_share = workers[i].ticks_run;
+        }
+        all_rotated = all_rotated && (workers[i].turns >= RUN_WINDOW_MS / (SHARED_QUANTUM * WORKERS * 2));
+    }
+
+    printf("With a %d tick slice: %lu, %lu and %lu ticks\n", SHARED_QUANTUM,
+           (unsigned long)workers[0].ticks_run, (unsigned long)workers[1].ticks_run,
+           (unsigned long)workers[2].ticks_run);
+
+    TEST_ASSERT(all_rotated, "Equal-priority tasks take turns on the CPU");
+    TEST_ASSERT(min_share * WORKERS * 4 >= total * 3, "Each task gets a fair share of the CPU");
+
+    pico_rtos_set_time_slice(0);
+}
+
+static void test_per_task_quantum(void) {
+    static const uint32_t quanta[2] = { SHORT_QUANTUM, LONG_QUANTUM };
+    run_workers(2, quanta);
+
+    uint32_t short_ticks = workers[0].ticks_run;
+    uint32_t long_ticks = workers[1].ticks_run;
+    printf("Quanta %d and %d: %lu and %lu ticks\n", SHORT_QUANTUM, LONG_QUANTUM,
+           (unsigned long)short_ticks, (unsigned long)long_ticks);
+
+    TEST_ASSERT(short_ticks > 0 && long_ticks > 0, "Tasks with their own time slice rotate with slicing off");
+    TEST_ASSERT(long_ticks >= short_ticks * 2 && long_ticks <= short_ticks * 4,
+                "CPU share follows each task's time slice");
+}
+
+static void test_preemption_unaffected(void) {
+    pico_rtos_set_time_slice(SHARED_QUANTUM);
+    workers_running = true;
+    workers_done = 0;
+    pico_rtos_task_create(&worker_tasks[0], "Worker", worker_task_function, (void *)(intptr_t)0,
+                          TASK_STACK_SIZE, WORKER_PRIORITY);
+
+    // The controller must come back on the tick it asked for, not at the
+    // end of the worker's slice
+    bool on_time = true;
+    for (int i = 0; i < 10; i++) {
+        uint32_t start = pico_rtos_get_tick_count();
+        pico_rtos_task_delay(3);
+        uint32_t slept = pico_rtos_get_tick_count() - start;
+        on_time = on_time && (slept >= 3 && slept <= 4);
+    }
+
+    workers_running = false;
+    while (workers_done < 1) {
+        pico_rtos_task_delay(1);
+    }
+    pico_rtos_set_time_slice(0);
+
+    TEST_ASSERT(on_time, "Higher priority tasks still preempt a time-sliced task immediately");
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_no_slicing_keeps_cpu();
+    test_shared_quantum_rotates();
+    test_per_task_quantum();
+    test_preemption_unaffected();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Time Slice Tests...\n");
+    printf("============================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,222 @@
+/**
+ * @file timeout_queue_test.c
+ * @brief Tests for the kernel timeout queue
+ *
+ * Every timed wait on a queue, semaphore, mutex, event group or stream
+ * buffer is registered in the same deadline-ordered queue as delayed tasks,
+ * so the tick times out exactly the waiters whose time has come. Checks
+ * that each primitive returns on the first tick after its timeout, that
+ * many waiters spread over many objects each expire on their own tick, and
+ * that a waiter woken before its timeout is taken off the queue for good.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define WAITER_PRIORITY 4
+#define HOLDER_PRIORITY 2
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define PRIMITIVE_TIMEOUT 10
+#define HOLD_TICKS 40
+
+#define WAITERS 32
+#define WAITER_BASE_TIMEOUT 10
+#define GIVE_AFTER 5
+#define STALE_WINDOW (WAITER_BASE_TIMEOUT + WAITERS + 20)
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+typedef struct {
+    uint32_t timeout;
+    volatile uint32_t start_tick;
+    volatile uint32_t wake_tick;
+    volatile bool taken;
+    volatile bool done;
+    volatile bool second_wait_returned;
+} waiter_t;
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t holder_task;
+static pico_rtos_task_t waiter_tasks[WAITERS];
+static waiter_t waiters[WAITERS];
+static pico_rtos_semaphore_t waiter_semaphores[WAITERS];
+
+static pico_rtos_mutex_t held_mutex;
+static volatile bool holder_done = false;
+
+// Ticks a call spent waiting, from the tick it started on
+#define TIMED(call, elapsed) do { \
+    uint32_t start_ = pico_rtos_get_tick_count(); \
+    (call); \
+    (elapsed) = pico_rtos_get_tick_count() - start_; \
+} while(0)
+
+static void holder_task_function(void *param) {
+    (void)param;
+    pico_rtos_mutex_lock(&held_mutex, PICO_RTOS_WAIT_FOREVER);
+    pico_rtos_task_delay(HOLD_TICKS);
+    pico_rtos_mutex_unlock(&held_mutex);
+    holder_done = true;
+}
+
+// Takes its semaphore with a timeout, then waits forever on it once it got it
+static void waiter_task_function(void *param) {
+    uint32_t index = (uint32_t)(uintptr_t)param;
+    waiter_t *waiter = &waiters[index];
+
+    waiter->start_tick = pico_rtos_get_tick_count();
+    waiter->taken = pico_rtos_semaphore_take(&waiter_semaphores[index], waiter->timeout);
+    waiter->wake_tick = pico_rtos_get_tick_count();
+    waiter->done = true;
+
+    if (waiter->taken) {
+        pico_rtos_semaphore_take(&waiter_semaphores[index], PICO_RTOS_WAIT_FOREVER);
+        waiter->second_wait_returned = true;
+    }
+}
+
+static void test_primitive_timeouts(void) {
+    uint32_t elapsed = 0;
+    const uint32_t expected = PRIMITIVE_TIMEOUT + 1;
+
+    static pico_rtos_queue_t queue;
+    static uint32_t queue_buffer[2];
+    uint32_t item = 0;
+    bool received = true;
+    pico_rtos_queue_init(&queue, queue_buffer, sizeof(uint32_t), 2);
+    TIMED(received = pico_rtos_queue_receive(&queue, &item, PRIMITIVE_TIMEOUT), elapsed);
+    printf("Queue receive timed out after %lu ticks\n", (unsigned long)elapsed);
+    TEST_ASSERT(!received && elapsed == expected, "Queue receive times out on the first tick after its timeout");
+    pico_rtos_queue_delete(&queue);
+
+    static pico_rtos_semaphore_t semaphore;
+    bool taken = true;
+    pico_rtos_semaphore_init(&semaphore, 0, 1);
+    TIMED(taken = pico_rtos_semaphore_take(&semaphore, PRIMITIVE_TIMEOUT), elapsed);
+    TEST_ASSERT(!taken && elapsed == expected, "Semaphore take times out on the first tick after its timeout");
+    pico_rtos_semaphore_delete(&semaphore);
+
+    bool locked = true;
+    pico_rtos_mutex_init(&held_mutex);
+    holder_done = false;
+    pico_rtos_task_create(&holder_task, "Holder", holder_task_function, NULL, TASK_STACK_SIZE, HOLDER_PRIORITY);
+    pico_rtos_task_delay(2);
+    TIMED(locked = pico_rtos_mutex_lock(&held_mutex, PRIMITIVE_TIMEOUT), elapsed);
+    TEST_ASSERT(!locked && elapsed == expected, "Mutex lock times out on the first tick after its timeout");
+    while (!holder_done) {
+        pico_rtos_task_delay(1);
+    }
+
+#ifdef PICO_RTOS_ENABLE_EVENT_GROUPS
+    static pico_rtos_event_group_t event_group;
+    uint32_t bits = 1;
+    pico_rtos_event_group_init(&event_group);
+    TIMED(bits = pico_rtos_event_group_wait_bits(&event_group, 0x1, true, false, PRIMITIVE_TIMEOUT), elapsed);
+    TEST_ASSERT(bits == 0 && elapsed == expected, "Event group wait times out on the first tick after its timeout");
+    pico_rtos_event_group_delete(&event_group);
+#endif
+
+#ifdef PICO_RTOS_ENABLE_STREAM_BUFFERS
+    static pico_rtos_stream_buffer_t stream;
+    static uint8_t stream_storage[64];
+    uint8_t data[8];
+    uint32_t length = 1;
+    pico_rtos_stream_buffer_init(&stream, stream_storage, sizeof(stream_storage));
+    TIMED(length = pico_rtos_stream_buffer_receive(&stream, data, sizeof(data), PRIMITIVE_TIMEOUT), elapsed);
+    TEST_ASSERT(length == 0 && elapsed == expected, "Stream buffer receive times out on the first tick after its timeout");
+    pico_rtos_stream_buffer_delete(&stream);
+#endif
+}
+
+static void test_many_waiters(void) {
+    for (uint32_t i = 0; i < WAITERS; i++) {
+        // Spread the timeouts so that neighbouring objects expire on different ticks
+        waiters[i].timeout = WAITER_BASE_TIMEOUT + (i * 7) % WAITERS;
+        waiters[i].done = false;
+        waiters[i].taken = false;
+        waiters[i].second_wait_returned = false;
+        pico_rtos_semaphore_init(&waiter_semaphores[i], 0, 1);
+        pico_rtos_task_create(&waiter_tasks[i], "Waiter", waiter_task_function, (void *)(uintptr_t)i,
+                              TASK_STACK_SIZE, WAITER_PRIORITY);
+    }
+
+    // Every odd waiter gets its token well before its timeout
+    pico_rtos_task_delay(GIVE_AFTER);
+    for (uint32_t i = 1; i < WAITERS; i += 2) {
+        pico_rtos_semaphore_give(&waiter_semaphores[i]);
+    }
+
+    pico_rtos_task_delay(STALE_WINDOW);
+
+    bool all_done = true;
+    bool timeouts_exact = true;
+    bool given_early = true;
+    bool no_stale_wakeup = true;
+    for (uint32_t i = 0; i < WAITERS; i++) {
+        uint32_t waited = waiters[i].wake_tick - waiters[i].start_tick;
+        all_done = all_done && waiters[i].done;
+        if (i % 2 == 0) {
+            timeouts_exact = timeouts_exact && !waiters[i].taken && waited == waiters[i].timeout + 1;
+        } else {
+            given_early = given_early && waiters[i].taken && waited <= GIVE_AFTER + 1;
+            no_stale_wakeup = no_stale_wakeup && !waiters[i].second_wait_returned;
+        }
+    }
+
+    TEST_ASSERT(all_done, "Every waiter returns");
+    TEST_ASSERT(timeouts_exact, "Waiters on different objects each time out on their own tick");
+    TEST_ASSERT(given_early, "Waiters given the object before their timeout return straight away");
+    TEST_ASSERT(no_stale_wakeup, "A waiter woken early is not woken again by its old timeout");
+
+    // Release the waiters still blocked forever
+    for (uint32_t i = 1; i < WAITERS; i += 2) {
+        pico_rtos_semaphore_give(&waiter_semaphores[i]);
+    }
+    pico_rtos_task_delay(2);
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_primitive_timeouts();
+    test_many_waiters();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Timeout Queue Tests...\n");
+    printf("===============================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,263 @@
+/**
+ * @file timer_daemon_test.c
+ * @brief Tests for the timer service task
+ *
+ * Software timer callbacks run in the timer service task rather than in the
+ * tick interrupt. Checks that callbacks run in that task on their expiry
+ * tick, that a slow callback does not hold up the tick, that a burst of
+ * timers larger than the command queue expiring together all fire on one
+ * wakeup, and that timer commands issued from an interrupt take effect
+ * relative to the tick they were issued on. Also covers the queue blocking
+ * the service task relies on.
+ */
+
+#include <stdio.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define WORKER_PRIORITY 4
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define CONTEXT_PERIOD 10
+#define SLOW_PERIOD 5
+#define SLOW_CALLBACK_MS 20
+#define BURST_TIMERS (PICO_RTOS_TIMER_DAEMON_QUEUE_LENGTH * 4)
+#define BURST_PERIOD 15
+
+#define ISR_ALARM_MS 10
+#define ISR_START_PERIOD 20
+#define ISR_ARMED_PERIOD 30
+#define ISR_NEW_PERIOD 5
+#define ISR_TIMERS 4
+
+#define QUEUE_LENGTH 2
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t worker_task;
+
+static pico_rtos_timer_t context_timer;
+static volatile pico_rtos_task_t *callback_task = NULL;
+static volatile uint32_t context_fire_tick = 0;
+
+static pico_rtos_timer_t slow_timer;
+static volatile uint32_t slow_enter_tick = 0;
+static volatile uint32_t slow_exit_tick = 0;
+
+static pico_rtos_timer_t burst_timers[BURST_TIMERS];
+static volatile uint32_t burst_fire_tick[BURST_TIMERS];
+static volatile uint32_t burst_fired = 0;
+
+static pico_rtos_timer_t isr_timers[ISR_TIMERS];
+static volatile uint32_t isr_fire_tick[ISR_TIMERS];
+static volatile uint32_t isr_fire_count[ISR_TIMERS];
+static volatile uint32_t isr_tick = 0;
+static volatile bool isr_commands_queued = false;
+
+static pico_rtos_queue_t test_queue;
+static uint32_t test_queue_buffer[QUEUE_LENGTH];
+static volatile uint32_t worker_received = 0;
+static volatile uint32_t worker_sent = 0;
+
+static void context_callback(void *param) {
+    (void)param;
+    callback_task = pico_rtos_get_current_task();
+    context_fire_tick = pico_rtos_get_tick_count();
+}
+
+static void slow_callback(void *param) {
+    (void)param;
+    slow_enter_tick = pico_rtos_get_tick_count();
+    busy_wait_ms(SLOW_CALLBACK_MS);
+    slow_exit_tick = pico_rtos_get_tick_count();
+}
+
+static void burst_callback(void *param) {
+    uint32_t index = (uint32_t)(uintptr_t)param;
+    burst_fire_tick[index] = pico_rtos_get_tick_count();
+    burst_fired++;
+}
+
+static void isr_timer_callback(void *param) {
+    uint32_t index = (uint32_t)(uintptr_t)param;
+    isr_fire_tick[index] = pico_rtos_get_tick_count();
+    isr_fire_count[index]++;
+}
+
+static int64_t isr_alarm_callback(alarm_id_t id, void *user_data) {
+    (void)id;
+    (void)user_data;
+    isr_tick = pico_rtos_get_tick_count();
+    bool queued = pico_rtos_timer_start_from_isr(&isr_timers[0]);
+    queued = pico_rtos_timer_stop_from_isr(&isr_timers[1]) && queued;
+    queued = pico_rtos_timer_reset_from_isr(&isr_timers[2]) && queued;
+    queued = pico_rtos_timer_change_period_from_isr(&isr_timers[3], ISR_NEW_PERIOD) && queued;
+    isr_commands_queued = queued;
+    return 0;
+}
+
+static void test_callback_runs_in_daemon(void) {
+    pico_rtos_timer_init(&context_timer, "Context", context_callback, NULL, CONTEXT_PERIOD, false);
+    pico_rtos_timer_start(&context_timer);
+    pico_rtos_task_delay(CONTEXT_PERIOD * 2);
+
+    TEST_ASSERT(callback_task == pico_rtos_timer_daemon_get_task(), "Timer callback runs in the timer service task");
+    TEST_ASSERT(context_fire_tick == context_timer.start_time + CONTEXT_PERIOD, "Deferred callback runs on its expiry tick");
+
+    pico_rtos_timer_delete(&context_timer);
+}
+
+static void test_slow_callback_keeps_tick(void) {
+    pico_rtos_timer_init(&slow_timer, "Slow", slow_callback, NULL, SLOW_PERIOD, false);
+    pico_rtos_timer_start(&slow_timer);
+    pico_rtos_task_delay(SLOW_PERIOD + SLOW_CALLBACK_MS + 10);
+
+    uint32_t ticks_during = slow_exit_tick - slow_enter_tick;
+    printf("%lu ticks passed during a %d ms callback\n", (unsigned long)ticks_during, SLOW_CALLBACK_MS);
+
+    TEST_ASSERT(slow_exit_tick != 0, "Slow callback completes");
+    TEST_ASSERT(ticks_during > 0, "Tick keeps counting while a slow callback runs");
+
+    pico_rtos_timer_delete(&slow_timer);
+}
+
+static void test_burst_on_one_wakeup(void) {
+    for (uint32_t i = 0; i < BURST_TIMERS; i++) {
+        pico_rtos_timer_init(&burst_timers[i], "Burst", burst_callback, (void *)(uintptr_t)i,
+                             BURST_PERIOD, false);
+        burst_fire_tick[i] = 0;
+    }
+
+    pico_rtos_enter_critical();
+    for (uint32_t i = 0; i < BURST_TIMERS; i++) {
+        pico_rtos_timer_start(&burst_timers[i]);
+    }
+    pico_rtos_exit_critical();
+
+    pico_rtos_task_delay(BURST_PERIOD * 2);
+
+    bool same_tick = true;
+    uint32_t expected_tick = burst_timers[0].start_time + BURST_PERIOD;
+    for (uint32_t i = 0; i < BURST_TIMERS; i++) {
+        same_tick = same_tick && (burst_fire_tick[i] == expected_tick);
+    }
+
+    TEST_ASSERT(burst_fired == BURST_TIMERS, "A burst larger than the command queue all fires");
+    TEST_ASSERT(same_tick, "Timers expiring together all run on their expiry tick");
+
+    for (uint32_t i = 0; i < BURST_TIMERS; i++) {
+        pico_rtos_timer_delete(&burst_timers[i]);
+    }
+}
+
+static void test_isr_commands(void) {
+    for (uint32_t i = 0; i < ISR_TIMERS; i++) {
+        uint32_t period = (i == 0) ? ISR_START_PERIOD : ISR_ARMED_PERIOD;
+        pico_rtos_timer_init(&isr_timers[i], "Isr", isr_timer_callback, (void *)(uintptr_t)i, period, false);
+        isr_fire_tick[i] = 0;
+        isr_fire_count[i] = 0;
+    }
+    for (uint32_t i = 1; i < ISR_TIMERS; i++) {
+        pico_rtos_timer_start(&isr_timers[i]);
+    }
+
+    add_alarm_in_ms(ISR_ALARM_MS, isr_alarm_callback, NULL, true);
+    pico_rtos_task_delay(ISR_ALARM_MS + ISR_ARMED_PERIOD * 2);
+
+    TEST_ASSERT(isr_commands_queued, "Timer commands are accepted from an interrupt");
+    TEST_ASSERT(isr_fire_count[0] == 1 && isr_fire_tick[0] == isr_tick + ISR_START_PERIOD,
+                "Start from an interrupt counts from the issuing tick");
+    TEST_ASSERT(isr_fire_count[1] == 0, "Stop from an interrupt keeps the timer from firing");
+    TEST_ASSERT(isr_fire_count[2] == 1 && isr_fire_tick[2] == isr_tick + ISR_ARMED_PERIOD,
+                "Reset from an interrupt restarts the period from the issuing tick");
+    TEST_ASSERT(isr_fire_count[3] == 1 && isr_fire_tick[3] == isr_tick + ISR_NEW_PERIOD &&
+                isr_timers[3].period == ISR_NEW_PERIOD,
+                "Period change from an interrupt re-arms the timer");
+
+    for (uint32_t i = 0; i < ISR_TIMERS; i++) {
+        pico_rtos_timer_delete(&isr_timers[i]);
+    }
+}
+
+// Blocks on the empty queue, then fills it past capacity
+static void worker_task_function(void *param) {
+    (void)param;
+    uint32_t item;
+    if (pico_rtos_queue_receive(&test_queue, &item, PICO_RTOS_WAIT_FOREVER)) {
+        worker_received = item;
+    }
+    for (uint32_t i = 0; i < QUEUE_LENGTH + 1; i++) {
+        if (pico_rtos_queue_send(&test_queue, &i, PICO_RTOS_WAIT_FOREVER)) {
+            worker_sent++;
+        }
+    }
+}
+
+static void test_queue_blocking(void) {
+    pico_rtos_queue_init(&test_queue, test_queue_buffer, sizeof(uint32_t), QUEUE_LENGTH);
+    pico_rtos_task_create(&worker_task, "Worker", worker_task_function, NULL,
+                          TASK_STACK_SIZE, WORKER_PRIORITY);
+
+    pico_rtos_task_delay(5);
+    uint32_t item = 42;
+    pico_rtos_queue_send(&test_queue, &item, PICO_RTOS_NO_WAIT);
+    pico_rtos_task_delay(5);
+
+    TEST_ASSERT(worker_received == 42, "A task blocked on an empty queue wakes when an item arrives");
+    TEST_ASSERT(worker_sent == QUEUE_LENGTH, "A sender blocks while the queue is full");
+
+    pico_rtos_queue_receive(&test_queue, &item, PICO_RTOS_NO_WAIT);
+    pico_rtos_task_delay(5);
+
+    TEST_ASSERT(worker_sent == QUEUE_LENGTH + 1, "A blocked sender resumes once space is freed");
+
+    pico_rtos_queue_delete(&test_queue);
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_callback_runs_in_daemon();
+    test_slow_callback_keeps_tick();
+    test_burst_on_one_wakeup();
+    test_isr_commands();
+    test_queue_blocking();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Timer Daemon Tests...\n");
+    printf("==============================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
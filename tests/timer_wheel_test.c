@@ -0,0 +1,282 @@
+/**
+ * @file timer_wheel_test.c
+ * @brief Tests for the hierarchical software timer wheel
+ *
+ * Software timers are armed into a timing wheel, so starting and stopping
+ * one is O(1) and each tick only touches the timers that fire on it. Checks
+ * that hundreds of timers spread across several wheel levels each fire on
+ * exactly their expiry tick, that many timers expiring together all fire
+ * on that tick, that stopped or re-armed timers behave, and that the tick
+ * cost does not depend on how many timers are armed. Expiry ticks are
+ * exact on the simulated clock and may be one tick late on the wall clock.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 5
+#define CONTROLLER_STACK_SIZE 2048
+
+#define SPREAD_TIMERS 300
+#define SPREAD_MAX_PERIOD 2600
+#define BURST_TIMERS 64
+#define BURST_PERIOD 100
+#define TOTAL_TIMERS (SPREAD_TIMERS + BURST_TIMERS)
+
+#define RELOAD_PERIOD 10
+#define RELOAD_WINDOW 205
+
+#define IDLE_TIMER_PERIOD 60000
+
+// Callbacks run in the timer service task and read the tick there. On the
+// wall clock two ticks can land back to back before that task runs, so a
+// callback may see the tick after its expiry; simulated time has no slack.
+#if PICO_RTOS_HOST_VIRTUAL_TIME
+#define FIRE_SLACK_TICKS 0
+#else
+#define FIRE_SLACK_TICKS 1
+#endif
+#define COST_WINDOW_MS 20
+#define COST_ROUNDS 10
+
+// Allowed growth of the tick cost with all timers armed
+#define MAX_TICK_COST_GROWTH_PERCENT 50
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_timer_t timers[TOTAL_TIMERS];
+static volatile uint32_t fire_tick[TOTAL_TIMERS];
+static volatile uint32_t fire_count[TOTAL_TIMERS];
+
+static pico_rtos_timer_t rival_timers[2];
+static volatile uint32_t rival_fired = 0;
+
+static void recording_callback(void *param) {
+    uint32_t index = (uint32_t)(uintptr_t)param;
+    fire_tick[index] = pico_rtos_get_tick_count();
+    fire_count[index]++;
+}
+
+// Each rival stops the other; only the first to fire may run
+static void rival_callback(void *param) {
+    uint32_t index = (uint32_t)(uintptr_t)param;
+    pico_rtos_timer_stop(&rival_timers[1 - index]);
+    rival_fired++;
+}
+
+static void init_timers(uint32_t count, bool auto_reload) {
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t period = (i < SPREAD_TIMERS) ? 1 + (i * 37) % SPREAD_MAX_PERIOD : BURST_PERIOD;
+        pico_rtos_timer_init(&timers[i], "Wheel", recording_callback, (void *)(uintptr_t)i,
+                             period, auto_reload);
+        fire_tick[i] = 0;
+        fire_count[i] = 0;
+    }
+}
+
+static void delete_timers(uint32_t count) {
+    for (uint32_t i = 0; i < count; i++) {
+        pico_rtos_timer_delete(&timers[i]);
+    }
+}
+
+static void test_exact_expiry(void) {
+    init_timers(TOTAL_TIMERS, false);
+    for (uint32_t i = 0; i < TOTAL_TIMERS; i++) {
+        pico_rtos_timer_start(&timers[i]);
+    }
+
+    pico_rtos_task_delay(SPREAD_MAX_PERIOD + 50);
+
+    uint32_t fired_once = 0;
+    uint32_t on_time = 0;
+    for (uint32_t i = 0; i < TOTAL_TIMERS; i++) {
+        if (fire_count[i] == 1) {
+            fired_once++;
+        }
+        if (fire_tick[i] - (timers[i].start_time + timers[i].period) <= FIRE_SLACK_TICKS) {
+            on_time++;
+        }
+    }
+
+    printf("%lu of %d timers fired once, %lu on their expiry tick\n",
+           (unsigned long)fired_once, TOTAL_TIMERS, (unsigned long)on_time);
+
+    TEST_ASSERT(fired_once == TOTAL_TIMERS, "Every one-shot timer fires exactly once");
+    TEST_ASSERT(on_time == TOTAL_TIMERS, "Timers on every wheel level fire on their expiry tick");
+
+    bool burst_ok = true;
+    for (uint32_t i = SPREAD_TIMERS; i < TOTAL_TIMERS; i++) {
+        burst_ok = burst_ok && (fire_tick[i] - fire_tick[SPREAD_TIMERS] <= FIRE_SLACK_TICKS);
+    }
+    TEST_ASSERT(burst_ok, "Many timers expiring together all fire on the same tick");
+
+    delete_timers(TOTAL_TIMERS);
+}
+
+static void test_stop_and_rearm(void) {
+    init_timers(SPREAD_TIMERS, false);
+    for (uint32_t i = 0; i < SPREAD_TIMERS; i++) {
+        pico_rtos_timer_change_period(&timers[i], 200);
+        pico_rtos_timer_start(&timers[i]);
+    }
+
+    pico_rtos_task_delay(50);
+    for (uint32_t i = 0; i < SPREAD_TIMERS; i += 3) {
+        pico_rtos_timer_stop(&timers[i]);
+    }
+    for (uint32_t i = 1; i < SPREAD_TIMERS; i += 3) {
+        pico_rtos_timer_change_period(&timers[i], 20);
+    }
+    pico_rtos_task_delay(250);
+
+    bool stopped_ok = true;
+    bool rearmed_ok = true;
+    bool untouched_ok = true;
+    for (uint32_t i = 0; i < SPREAD_TIMERS; i++) {
+        uint32_t expected_tick = timers[i].start_time + timers[i].period;
+        switch (i % 3) {
+            case 0:
+                stopped_ok = stopped_ok && (fire_count[i] == 0);
+                break;
+            case 1:
+                rearmed_ok = rearmed_ok && (fire_count[i] == 1) && (fire_tick[i] == expected_tick) &&
+                             (timers[i].period == 20);
+                break;
+            default:
+                untouched_ok = untouched_ok && (fire_count[i] == 1) && (fire_tick[i] == expected_tick);
+                break;
+        }
+    }
+
+    TEST_ASSERT(stopped_ok, "Stopped timers never fire");
+    TEST_ASSERT(rearmed_ok, "Changing the period re-arms a running timer");
+    TEST_ASSERT(untouched_ok, "Other timers are unaffected by stops and re-arms");
+
+    delete_timers(SPREAD_TIMERS);
+}
+
+static void test_auto_reload(void) {
+    init_timers(1, true);
+    pico_rtos_timer_change_period(&timers[0], RELOAD_PERIOD);
+    pico_rtos_timer_start(&timers[0]);
+    pico_rtos_task_delay(RELOAD_WINDOW);
+    pico_rtos_timer_stop(&timers[0]);
+
+    TEST_ASSERT(fire_count[0] == RELOAD_WINDOW / RELOAD_PERIOD, "Auto-reload timer fires once per period");
+    TEST_ASSERT(pico_rtos_timer_is_running(&timers[0]) == false, "Stopped auto-reload timer reports not running");
+
+    delete_timers(1);
+}
+
+static void test_callback_stops_sibling(void) {
+    for (uint32_t i = 0; i < 2; i++) {
+        pico_rtos_timer_init(&rival_timers[i], "Rival", rival_callback, (void *)(uintptr_t)i, 30, false);
+    }
+    pico_rtos_enter_critical();
+    pico_rtos_timer_start(&rival_timers[0]);
+    pico_rtos_timer_start(&rival_timers[1]);
+    pico_rtos_exit_critical();
+
+    pico_rtos_task_delay(60);
+
+    TEST_ASSERT(rival_fired == 1, "A callback can stop a timer expiring on the same tick");
+
+    pico_rtos_timer_delete(&rival_timers[0]);
+    pico_rtos_timer_delete(&rival_timers[1]);
+}
+
+// Mean tick cost over one window of steady ticking; spinning keeps the CPU
+// out of sleep states so every tick starts from the same conditions
+static uint32_t measure_tick_cost(void) {
+    pico_rtos_reset_tick_stats();
+    busy_wait_ms(COST_WINDOW_MS);
+    pico_rtos_tick_stats_t stats;
+    pico_rtos_get_tick_stats(&stats);
+    return (stats.sample_count > 0) ? stats.average_cycles : UINT32_MAX;
+}
+
+static void test_tick_cost_flat(void) {
+    uint32_t cost_empty = UINT32_MAX;
+    uint32_t cost_loaded = UINT32_MAX;
+
+    init_timers(TOTAL_TIMERS, false);
+
+    // Interleave both configurations so slow phases of the machine hit both
+    for (int round = 0; round < COST_ROUNDS; round++) {
+        uint32_t cost = measure_tick_cost();
+        if (cost < cost_empty) {
+            cost_empty = cost;
+        }
+
+        for (uint32_t i = 0; i < TOTAL_TIMERS; i++) {
+            pico_rtos_timer_change_period(&timers[i], IDLE_TIMER_PERIOD + i);
+            pico_rtos_timer_start(&timers[i]);
+        }
+
+        cost = measure_tick_cost();
+        if (cost < cost_loaded) {
+            cost_loaded = cost;
+        }
+
+        for (uint32_t i = 0; i < TOTAL_TIMERS; i++) {
+            pico_rtos_timer_stop(&timers[i]);
+        }
+    }
+
+    delete_timers(TOTAL_TIMERS);
+
+    printf("Tick cost: %lu cycles with no timers armed, %lu with %d\n",
+           (unsigned long)cost_empty, (unsigned long)cost_loaded, TOTAL_TIMERS);
+
+    uint32_t limit = cost_empty + (cost_empty * MAX_TICK_COST_GROWTH_PERCENT) / 100;
+    TEST_ASSERT(cost_loaded <= limit, "Tick cost stays flat as timers are armed");
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    test_exact_expiry();
+    test_stop_and_rearm();
+    test_auto_reload();
+    test_callback_stops_sibling();
+    test_tick_cost_flat();
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Timer Wheel Tests...\n");
+    printf("=============================\n");
+
+    if (!pico_rtos_init()) {
+        printf("FATAL: Failed to initialize RTOS\n");
+        return 1;
+    }
+
+    pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                          CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY);
+
+    pico_rtos_start();
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}
@@ -0,0 +1,255 @@
+/**
+ * @file virtual_time_test.c
+ * @brief Tests for the host simulator's virtual time mode
+ *
+ * Built against the kernel with PICO_RTOS_HOST_VIRTUAL_TIME, where the clock
+ * only moves when every task is waiting and then jumps to the next event.
+ * Runs an hour of periodic tasks, queue timeouts and software timers in a
+ * fraction of that, twice in separate processes, and checks that both runs
+ * produce the same event trace down to the microsecond. Also checks that
+ * delays and busy waits take exactly their simulated time.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "pico/stdlib.h"
+#include "pico_rtos.h"
+
+#define CONTROLLER_PRIORITY 6
+#define FAST_PRIORITY 4
+#define SLOW_PRIORITY 3
+#define CONSUMER_PRIORITY 5
+#define TASK_STACK_SIZE 1024
+#define CONTROLLER_STACK_SIZE 2048
+
+#define SIM_SECONDS 3600
+#define FAST_PERIOD_MS 7
+#define SLOW_PERIOD_MS 11
+#define SLOW_WORK_US 300
+#define RECEIVE_TIMEOUT_MS 5
+#define TIMER_PERIOD_MS 13
+#define DELAY_MS 100
+#define BUSY_WAIT_US 250
+
+// Test statistics
+static int tests_run = 0;
+static int tests_passed = 0;
+static int tests_failed = 0;
+
+// Test result macros
+#define TEST_ASSERT(condition, message) do { \
+    tests_run++; \
+    if (condition) { \
+        tests_passed++; \
+        printf("PASS: %s\n", message); \
+    } else { \
+        tests_failed++; \
+        printf("FAIL: %s\n", message); \
+    } \
+} while(0)
+
+// What one simulation run reports back to the parent process
+typedef struct {
+    uint64_t trace_hash;
+    uint32_t events;
+    uint32_t fast_runs;
+    uint32_t slow_runs;
+    uint32_t received;
+    uint32_t timeouts;
+    uint32_t timer_fires;
+    uint64_t end_us;
+    uint64_t delay_us;
+    uint32_t delay_ticks;
+    uint64_t busy_wait_us;
+} sim_result_t;
+
+static pico_rtos_task_t controller_task;
+static pico_rtos_task_t fast_task;
+static pico_rtos_task_t slow_task;
+static pico_rtos_task_t consumer_task;
+static pico_rtos_queue_t queue;
+static uint32_t queue_buffer[4];
+static pico_rtos_timer_t timer;
+
+static volatile bool running = false;
+static volatile uint32_t tasks_done = 0;
+static sim_result_t result;
+
+// FNV-1a over (event, time) pairs; any change in order or timing shows up
+static void record_event(uint32_t event) {
+    uint64_t words[2] = { event, time_us_64() };
+    const uint8_t *bytes = (const uint8_t *)words;
+    uint64_t hash = result.trace_hash;
+    for (size_t i = 0; i < sizeof(words); i++) {
+        hash = (hash ^ bytes[i]) * 0x100000001b3ull;
+    }
+    result.trace_hash = hash;
+    result.events++;
+}
+
+static void fast_task_function(void *param) {
+    (void)param;
+    while (running) {
+        pico_rtos_task_delay(FAST_PERIOD_MS);
+        result.fast_runs++;
+        record_event(1);
+        pico_rtos_queue_send(&queue, &result.fast_runs, 0);
+    }
+    tasks_done++;
+}
+
+static void slow_task_function(void *param) {
+    (void)param;
+    while (running) {
+        busy_wait_us(SLOW_WORK_US);
+        pico_rtos_task_delay(SLOW_PERIOD_MS);
+        result.slow_runs++;
+        record_event(2);
+    }
+    tasks_done++;
+}
+
+static void consumer_task_function(void *param) {
+    (void)param;
+    uint32_t value;
+    while (running) {
+        if (pico_rtos_queue_receive(&queue, &value, RECEIVE_TIMEOUT_MS)) {
+            result.received++;
+            record_event(3 + (value << 8));
+        } else {
+            result.timeouts++;
+            record_event(4);
+        }
+    }
+    tasks_done++;
+}
+
+static void timer_callback(void *param) {
+    (void)param;
+    result.timer_fires++;
+    record_event(5);
+}
+
+static void controller_task_function(void *param) {
+    (void)param;
+
+    uint64_t start_us = time_us_64();
+    uint32_t start_tick = pico_rtos_get_tick_count();
+    pico_rtos_task_delay(DELAY_MS);
+    result.delay_us = time_us_64() - start_us;
+    result.delay_ticks = pico_rtos_get_tick_count() - start_tick;
+
+    start_us = time_us_64();
+    busy_wait_us(BUSY_WAIT_US);
+    result.busy_wait_us = time_us_64() - start_us;
+
+    running = true;
+    pico_rtos_queue_init(&queue, queue_buffer, sizeof(uint32_t), 4);
+    pico_rtos_timer_init(&timer, "Sim", timer_callback, NULL, TIMER_PERIOD_MS, true);
+    pico_rtos_timer_start(&timer);
+    pico_rtos_task_create(&fast_task, "Fast", fast_task_function, NULL, TASK_STACK_SIZE, FAST_PRIORITY);
+    pico_rtos_task_create(&slow_task, "Slow", slow_task_function, NULL, TASK_STACK_SIZE, SLOW_PRIORITY);
+    pico_rtos_task_create(&consumer_task, "Consumer", consumer_task_function, NULL, TASK_STACK_SIZE,
+                          CONSUMER_PRIORITY);
+
+    pico_rtos_task_delay(SIM_SECONDS * 1000u);
+
+    running = false;
+    pico_rtos_timer_stop(&timer);
+    while (tasks_done < 3) {
+        pico_rtos_task_delay(1);
+    }
+    result.end_us = time_us_64();
+}
+
+// Runs the whole simulation in a child process, so each run starts from a
+// freshly initialized kernel
+static bool run_simulation(sim_result_t *out, double *wall_seconds) {
+    struct timespec start, end;
+    int fds[2];
+    if (pipe(fds) != 0) {
+        return false;
+    }
+
+    fflush(stdout);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        memset(&result, 0, sizeof(result));
+        result.trace_hash = 0xcbf29ce484222325ull;
+        if (pico_rtos_init() &&
+            pico_rtos_task_create(&controller_task, "Controller", controller_task_function, NULL,
+                                  CONTROLLER_STACK_SIZE, CONTROLLER_PRIORITY)) {
+            pico_rtos_start();
+        }
+        ssize_t written = write(fds[1], &result, sizeof(result));
+        _exit(written == (ssize_t)sizeof(result) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    ssize_t got = (pid > 0) ? read(fds[0], out, sizeof(*out)) : -1;
+    close(fds[0]);
+    int status = 0;
+    if (pid > 0) {
+        waitpid(pid, &status, 0);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+
+    *wall_seconds = (double)(end.tv_sec - start.tv_sec) + (double)(end.tv_nsec - start.tv_nsec) / 1e9;
+    return got == (ssize_t)sizeof(*out) && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+}
+
+int main(void) {
+    stdio_init_all();
+
+    printf("Starting Virtual Time Tests...\n");
+    printf("==============================\n");
+
+    sim_result_t first, second;
+    double first_wall, second_wall;
+    bool first_ok = run_simulation(&first, &first_wall);
+    bool second_ok = run_simulation(&second, &second_wall);
+
+    TEST_ASSERT(first_ok && second_ok, "Both simulation runs complete");
+    if (!first_ok || !second_ok) {
+        printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+        return 1;
+    }
+
+    printf("Simulated %.1f s in %.2f s and %.2f s of wall time, %lu events\n",
+           (double)first.end_us / 1e6, first_wall, second_wall, (unsigned long)first.events);
+    printf("Fast %lu, slow %lu, received %lu, timeouts %lu, timer %lu\n",
+           (unsigned long)first.fast_runs, (unsigned long)first.slow_runs, (unsigned long)first.received,
+           (unsigned long)first.timeouts, (unsigned long)first.timer_fires);
+
+    TEST_ASSERT(first.delay_us == (uint64_t)first.delay_ticks * PICO_RTOS_TICK_PERIOD_US &&
+                first.delay_ticks >= DELAY_MS && first.delay_ticks <= DELAY_MS + 1,
+                "A delay takes exactly its ticks of simulated time");
+    TEST_ASSERT(first.busy_wait_us == BUSY_WAIT_US, "A busy wait takes exactly its simulated time");
+
+    TEST_ASSERT(first.end_us >= (uint64_t)SIM_SECONDS * 1000000u && first_wall < SIM_SECONDS / 10.0,
+                "An hour of simulated time runs at least ten times faster than real time");
+    // A delay ends on the first tick after it expires, so each loop of a
+    // task that wakes on a tick boundary takes one tick more than its delay
+    uint32_t fast_expected = SIM_SECONDS * 1000u / (FAST_PERIOD_MS + 1);
+    uint32_t slow_expected = SIM_SECONDS * 1000u / (SLOW_PERIOD_MS + 1);
+    TEST_ASSERT(first.fast_runs >= fast_expected - 1 && first.fast_runs <= fast_expected + 1 &&
+                first.slow_runs >= slow_expected - 1 && first.slow_runs <= slow_expected + 1 &&
+                first.timer_fires >= SIM_SECONDS * 1000u / TIMER_PERIOD_MS - 1 &&
+                first.timer_fires <= SIM_SECONDS * 1000u / TIMER_PERIOD_MS + 1,
+                "Periodic tasks and timers keep their period over the whole run");
+    TEST_ASSERT(first.received + 1 >= first.fast_runs && first.received <= first.fast_runs && first.timeouts > 0,
+                "Queue traffic and receive timeouts are both simulated");
+
+    TEST_ASSERT(first.trace_hash == second.trace_hash && first.events == second.events &&
+                first.end_us == second.end_us,
+                "Two runs produce the same event trace to the microsecond");
+    TEST_ASSERT(memcmp(&first, &second, sizeof(first)) == 0, "Two runs produce identical results");
+
+    printf("\nTests run: %d, passed: %d, failed: %d\n", tests_run, tests_passed, tests_failed);
+    return (tests_failed == 0) ? 0 : 1;
+}